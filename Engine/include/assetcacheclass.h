@@ -0,0 +1,60 @@
+#ifndef ASSETCACHECLASS_H
+#define ASSETCACHECLASS_H
+
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "packfileclass.h"
+
+//
+// globals
+const char* const ASSET_CACHE_DIRECTORY = "./cache/";
+
+// derived data cache, imported assets are stored as binary blobs under a key made of
+//  the hash of the source bytes, the importer version and the import settings
+class AssetCacheClass
+{
+private:
+	struct BlobHeaderType
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned long long key;
+		unsigned long long size;
+		unsigned long long hash;		// hash of the blob data to catch truncated files
+	};
+
+public:
+	AssetCacheClass();
+	AssetCacheClass(const AssetCacheClass&) = default;
+	~AssetCacheClass() = default;
+	// rule of five
+	AssetCacheClass& operator=(const AssetCacheClass&) = default;
+	AssetCacheClass(AssetCacheClass&&) = default;
+	AssetCacheClass& operator=(AssetCacheClass&&) = default;
+
+	bool Initialize(const char*);
+	void Shutdown();
+
+	unsigned long long MakeKey(const AssetDataType&, const char*, unsigned int, const void*, int);
+	bool Load(unsigned long long, std::vector<unsigned char>&);
+	bool Store(unsigned long long, const void*, unsigned long long);
+
+	int GetHitCount();
+	int GetMissCount();
+	int GetStoreCount();
+
+	static unsigned long long Hash(const void*, unsigned long long, unsigned long long);
+
+private:
+	std::string GetBlobFilename(unsigned long long);
+
+private:
+	std::string m_directory;
+	int m_hitCount, m_missCount, m_storeCount;
+};
+
+#endif	// ASSETCACHECLASS_H
\ No newline at end of file
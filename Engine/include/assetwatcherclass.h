@@ -0,0 +1,71 @@
+#ifndef ASSETWATCHERCLASS_H
+#define ASSETWATCHERCLASS_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "filesystemclass.h"
+
+//
+// globals
+const int ASSET_WATCHER_POLL_TIME = 100;		// milliseconds between checks of the watched files
+
+// watches asset files on its own thread, imports the changed ones in the background
+//  and hands the finished resources to the render thread at a frame boundary
+class AssetWatcherClass
+{
+public:
+	// builds the new resource from the file on the watcher thread, nullptr if the import failed
+	typedef void* (*ImportCallback)(void*, int, const AssetDataType&);
+	// puts a finished resource into use on the render thread and releases the one it replaces
+	typedef void (*SwapCallback)(void*, int, void*);
+	// releases a finished resource that was never swapped in
+	typedef void (*ReleaseCallback)(void*, int, void*);
+
+private:
+	struct WatchType
+	{
+		std::string filename;
+		unsigned long long stamp;		// stamp of the last imported version
+		unsigned long long seenStamp;	// stamp seen on the last check, the file is imported once it settles
+		ImportCallback import;
+		SwapCallback swap;
+		ReleaseCallback release;
+		void* context;
+		std::atomic<void*> pending;		// imported resource waiting for the next frame boundary
+	};
+
+public:
+	AssetWatcherClass();
+	AssetWatcherClass(const AssetWatcherClass&) = delete;
+	~AssetWatcherClass();
+	// rule of five
+	AssetWatcherClass& operator=(const AssetWatcherClass&) = delete;
+	AssetWatcherClass(AssetWatcherClass&&) = delete;
+	AssetWatcherClass& operator=(AssetWatcherClass&&) = delete;
+
+	bool Initialize(FileSystemClass*, int);
+	void Shutdown();
+
+	int Register(const char*, ImportCallback, SwapCallback, ReleaseCallback, void*);
+	bool Start();
+	void ApplyChanges();
+
+	int GetReloadCount();
+	int GetFailCount();
+
+private:
+	void Run();
+
+private:
+	FileSystemClass* m_FileSystem;
+	std::vector<WatchType*> m_watches;
+	std::thread m_thread;
+	std::atomic<bool> m_quit;
+	std::atomic<int> m_reloadCount, m_failCount;
+	int m_pollTime;
+};
+
+#endif	// ASSETWATCHERCLASS_H
\ No newline at end of file
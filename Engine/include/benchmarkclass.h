@@ -0,0 +1,186 @@
+#ifndef BENCHMARKCLASS_H
+#define BENCHMARKCLASS_H
+
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+#include "packfileclass.h"
+#include "assetwatcherclass.h"
+#include "profilerclass.h"
+#include "renderdeviceclass.h"
+#include "headlessgraphicsclass.h"
+#include "scenegeneratorclass.h"
+#include "flythroughclass.h"
+#include "frustumclass.h"
+#include "randomclass.h"
+#include "jobsystemclass.h"
+#include "visibilityclass.h"
+#include "framepipelineclass.h"
+#include "frameloopclass.h"
+#include "framelimiterclass.h"
+#include "inputbackendclass.h"
+#include "framearenaclass.h"
+#include "memoryclass.h"
+#include "memorypoolclass.h"
+#include "handlepoolclass.h"
+#include "entitystoreclass.h"
+#include "transformclass.h"
+#include "texturestreamerclass.h"
+
+//
+// globals
+const char* const BENCHMARK_OUTPUT_FILENAME = "benchmark.txt";
+const int BENCHMARK_TRIALS = 15;
+const double BENCHMARK_DISK_BANDWIDTHS[] = { 50.0, 200.0, 1000.0 };		// MB/s of the simulated disk
+const int BENCHMARK_DISK_COUNT = sizeof(BENCHMARK_DISK_BANDWIDTHS) / sizeof(BENCHMARK_DISK_BANDWIDTHS[0]);
+const double BENCHMARK_ZONE_BUDGET = 50.0;		// ns a profiler zone may cost
+const double BENCHMARK_RELOAD_TIMEOUT = 5.0;		// seconds a reload may take before the run fails
+const int BENCHMARK_RELOAD_CHUNK = 4096;			// bytes the fake import copies before it lets the other threads run
+const unsigned char BENCHMARK_RELOAD_UNFINISHED = 0xff;	// byte of the part of a blob that was not imported yet
+const int BENCHMARK_RELOAD_RACE_WRITES = 100;		// versions written while the earlier ones are imported
+const int BENCHMARK_RELOAD_RACE_MAX_MS = 10;		// the racing writes come up to this far apart
+const int BENCHMARK_HEADLESS_FRAMES = 1000;
+const int BENCHMARK_FRUSTUM_OBJECTS = 100000;
+const int BENCHMARK_FRUSTUM_CASES = 1000000;		// random boxes the fast paths are checked on
+const int BENCHMARK_FRUSTUM_CAMERAS = 100;		// different frustums among them
+const float BENCHMARK_FRUSTUM_TOLERANCE = 1e-4f;	// boxes closer to a plane may round either way
+const int BENCHMARK_IDLE_MOVED = 100;				// one in this many models moves every frame of the moving runs
+const int BENCHMARK_IDLE_SWARM_MOVED = 2;			// one in this many models moves every frame of the swarm runs
+const float BENCHMARK_IDLE_DISTANCE = 1.f;			// how far a model moves from where the scene put it
+const char* const BENCHMARK_JOBS_SCENE = "uniform:1m";	// the scene the job system is scaled on if none is named
+const int BENCHMARK_JOBS_FRAMES = 20;				// frames culled per trial
+const int BENCHMARK_JOBS_EMPTY = 100000;			// jobs that do nothing, they measure the cost of a job
+const int BENCHMARK_JOBS_DATA_SIZE = 32 * 1024 * 1024;	// bytes decompressed per trial
+const char* const BENCHMARK_PIPELINE_SCENE = "uniform:100k";	// the scene the pipeline is measured on if none is named
+const int BENCHMARK_PIPELINE_MOVED = 4;				// one in this many models moves every frame
+const double BENCHMARK_LOOP_SECONDS = 10.0;			// simulated time of every run of the frame loop
+const double BENCHMARK_LOOP_FRAME_MS = 1000.0 / 60.0;	// frame time while the mouse floods the messages
+const double BENCHMARK_LOOP_MOUSE_MS = 1.0;			// a mouse reporting at 1000 hz
+const float BENCHMARK_LOOP_MIN_FRAME_MS = 4.f;		// the frame times jitter between these
+const float BENCHMARK_LOOP_MAX_FRAME_MS = 30.f;
+const double BENCHMARK_LOOP_STALL_MS = 1000.0;		// a frame the debugger held up
+const int BENCHMARK_LIMITER_TRIALS = 5;				// every trial runs for a second in each mode
+const double BENCHMARK_LIMITER_FPS = 60.0;			// refresh rate of the simulated display
+const double BENCHMARK_LIMITER_WORK_MS = 3.0;		// cpu time a frame takes from sampling to submitting
+const double BENCHMARK_LIMITER_MARGIN_MS = 1.0;		// budget on top of the work for the late sampling
+const double BENCHMARK_LIMITER_SIMULATE_MS = 1.0;	// part of the work the simulation thread does in the pipelined modes
+const int BENCHMARK_INPUT_TRIALS = 3;
+const double BENCHMARK_INPUT_SECONDS = 2.0;			// how long the made up input goes on per trial
+const double BENCHMARK_INPUT_MOUSE_MS = 0.125;		// a mouse reporting at 8000 hz
+const double BENCHMARK_INPUT_TAP_MS = 60.0;			// a key tap starts this often, give or take a half
+const float BENCHMARK_INPUT_MIN_TAP = 1.f;			// the taps are held between these milliseconds
+const float BENCHMARK_INPUT_MAX_TAP = 12.f;
+const int BENCHMARK_ARENA_WARMUP = 100;				// frames before the heap calls are counted
+const int BENCHMARK_ARENA_TEMPORARIES = 1000;		// temporaries a frame allocates
+const int BENCHMARK_ARENA_MIN_SIZE = 16;			// bytes of a temporary, like the vertices of a sentence
+const int BENCHMARK_ARENA_MAX_SIZE = 4096;
+const int BENCHMARK_MEMORY_OBJECTS = 100000;		// objects allocated and freed per trial
+const int BENCHMARK_MEMORY_OBJECT_SIZE = 64;		// bytes of every object, like the small objects of the renderer
+const int BENCHMARK_HANDLE_OBJECTS = 100000;		// objects in the handle pool
+const int BENCHMARK_ENTITY_COUNT = 10000000;		// entities that are iterated
+const int BENCHMARK_ENTITY_CHANGES = 100000;		// entities that get a component added and removed per trial
+const int BENCHMARK_TRANSFORM_NODES = 1000000;		// nodes of the hierarchy
+const int BENCHMARK_TRANSFORM_TREE = 1000;			// nodes of every tree of the forest
+const int BENCHMARK_TRANSFORM_DIRTY = 10000;		// nodes moved per frame, one percent
+const int BENCHMARK_TRANSFORM_FRAMES = 10;			// frames per trial
+const int BENCHMARK_STREAMING_TEXTURES = 64;		// textures along the camera path, one object each
+const int BENCHMARK_STREAMING_FRAMES = 2000;		// frames of the camera path per trial
+const float BENCHMARK_STREAMING_LENGTH = 400.f;		// the objects are spread along this much of the z axis
+const float BENCHMARK_STREAMING_VIEW = 150.f;		// objects ahead and nearer than this are requested
+const unsigned long long BENCHMARK_STREAMING_BUDGET = 8ull * 1024 * 1024;
+const int BENCHMARK_STREAMING_LOADS = 2;			// loads per frame like the renderer
+const int BENCHMARK_STREAMING_FAIL = 5;				// one in this many loads fails after it was handed out
+const int BENCHMARK_STREAMING_SCREEN_HEIGHT = 600;
+const float BENCHMARK_STREAMING_FOV = 3.141592654f / 4.f;
+
+// the events a frame loop handled and how long they waited for it
+struct EventLatencyType
+{
+	SyntheticPlatformClass* platform;
+	double total, worst;
+	int count;
+};
+
+// what the streamer did to the textures of the streaming benchmark, kept apart from its own state
+struct StreamingCheckType
+{
+	std::vector<int> width, height, mipCount, bitsPerPixel, blockBytes;
+	std::vector<int> residentMips;
+	std::vector<float> priorities;						// biggest screen size the texture was requested at this frame
+	std::vector<std::vector<unsigned long>> lastNeeded;	// last frame every mip of every texture was needed
+	std::vector<int> failedMips;						// mips the owner still holds of a load that failed, -1 if none
+	std::vector<bool> failed;							// the last load of the texture failed
+	unsigned long frame;
+	float lastPriority;									// priority of the last load of this update
+	int loads, outOfOrder, notLeastRecent, retried;
+};
+
+class BenchmarkClass
+{
+public:
+	BenchmarkClass();
+	BenchmarkClass(const BenchmarkClass&) = default;
+	~BenchmarkClass() = default;
+	// rule of five
+	BenchmarkClass& operator=(const BenchmarkClass&) = default;
+	BenchmarkClass(BenchmarkClass&&) = default;
+	BenchmarkClass& operator=(BenchmarkClass&&) = default;
+
+	bool Run(const char*, const char*, const char*);
+
+private:
+	bool ColdStart(std::ofstream&);
+	bool Compression(std::ofstream&);
+	bool HotReload(std::ofstream&);
+	bool Profiler(std::ofstream&);
+	bool Headless(std::ofstream&);
+	bool Flythrough(std::ofstream&);
+	bool Frustum(std::ofstream&);
+	bool Idle(std::ofstream&);
+	bool Jobs(std::ofstream&);
+	bool Pipeline(std::ofstream&);
+	bool FrameLoop(std::ofstream&);
+	bool Limiter(std::ofstream&);
+	bool Input(std::ofstream&);
+	bool Arena(std::ofstream&);
+	bool Memory(std::ofstream&);
+	bool Handles(std::ofstream&);
+	bool Entities(std::ofstream&);
+	bool Transforms(std::ofstream&);
+	bool Streaming(std::ofstream&);
+
+	static void ConstructRandomFrustum(RandomClass&, FrustumClass&);
+	static bool CheckRectangleCorners(FrustumClass&, float, float, float, float, float, float);
+	static bool CheckPointPlanes(FrustumClass&, float, float, float);
+	static void EmptyJob(void*, int, int);
+	static void FillJob(void*, int, int);
+	static void DoubleJob(void*, int, int);
+	static void SimulateFrame(FrameStateType*, const std::vector<XMFLOAT3>&);
+	static void RecordEvent(void*, const PlatformEventType&);
+	static void StepSpring(double&, double&, double);
+	static bool StreamMips(void*, int, int);
+	static unsigned long long GetStreamedBytes(const StreamingCheckType&);
+
+	static double GetTime();
+	static double GetCpuTime();
+	static double Median(std::vector<double>);
+	static void DropFileCache(const char*);
+	static void ReadThrottled(unsigned long long, double);
+
+	static void* ImportBlob(void*, int, const AssetDataType&);
+	static void SwapBlob(void*, int, void*);
+	static void ReleaseBlob(void*, int, void*);
+	void WriteResult(std::ofstream&, const char*, const char*, const char*, std::vector<double>&);
+
+private:
+	SceneSettingsType m_scene;
+	std::string m_sceneName;
+};
+
+#endif	// BENCHMARKCLASS_H
\ No newline at end of file
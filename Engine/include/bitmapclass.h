@@ -6,6 +6,7 @@
 using namespace DirectX;
 
 #include "textureclass.h"
+#include "framearenaclass.h"
 
 class BitmapClass
 {
@@ -25,7 +26,7 @@ public:
 	BitmapClass(BitmapClass&&) = default;
 	BitmapClass& operator=(BitmapClass&&) = default;
 
-	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, int, int, char*, int, int);
+	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, PackFileClass*, AssetCacheClass*, int, int, char*, int, int);
 	void Shutdown();
 	bool Render(ID3D11DeviceContext*, int, int);
 
@@ -38,7 +39,7 @@ private:
 	bool UpdateBuffers(ID3D11DeviceContext*, int, int);
 	void RenderBuffers(ID3D11DeviceContext*);
 
-	bool LoadTexture(ID3D11Device*, ID3D11DeviceContext* deviceContext, char*);
+	bool LoadTexture(ID3D11Device*, ID3D11DeviceContext* deviceContext, PackFileClass*, AssetCacheClass*, char*);
 	void ReleaseTexture();
 
 private:
@@ -8,6 +8,9 @@ using namespace DirectX;
 
 #include <fstream>
 
+#include "packfileclass.h"
+#include "renderstatsclass.h"
+
 class BumpMapShaderClass
 {
 private:
@@ -43,13 +46,13 @@ public:
 	BumpMapShaderClass(BumpMapShaderClass&&) = default;
 	BumpMapShaderClass& operator=(BumpMapShaderClass&&) = default;
 
-	bool Initialize(ID3D11Device*, HWND);
+	bool Initialize(ID3D11Device*, HWND, PackFileClass*);
 	void Shutdown();
 	bool Render(ID3D11DeviceContext*, int, XMMATRIX, XMMATRIX, XMMATRIX,
 		ID3D11ShaderResourceView**, XMFLOAT3, XMVECTOR, XMVECTOR, XMFLOAT3, XMVECTOR, float);
 
 private:
-	bool InitializeShader(ID3D11Device*, HWND, WCHAR*, WCHAR*);
+	bool InitializeShader(ID3D11Device*, HWND, PackFileClass*, WCHAR*, WCHAR*);
 	void ShutdownShader();
 	void OutputShaderErrorMessage(ID3D10Blob*, HWND, WCHAR*);
 
@@ -6,6 +6,8 @@
 #include <DirectXMath.h>
 #include <fstream>
 
+#include "renderstatsclass.h"
+
 using namespace DirectX;
 
 class ColorShaderClass
@@ -0,0 +1,53 @@
+#ifndef COMPRESSIONCLASS_H
+#define COMPRESSIONCLASS_H
+
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "jobsystemclass.h"
+
+//
+// globals
+const int COMPRESSION_BLOCK_SIZE = 64 * 1024;		// blocks are compressed independently
+const unsigned int COMPRESSION_RAW_BLOCK = 0x80000000;	// block stored without compression
+
+// lz77 block codec in the style of lz4: byte aligned sequences of literals and
+//  matches, no entropy coding, so the decoder is little more than memcpy
+class CompressionClass
+{
+private:
+	// what the threads decompressing the blocks of one stream share
+	struct DecompressJobType
+	{
+		const unsigned char* source;
+		unsigned char* destination;
+		unsigned long long destinationSize;
+		const unsigned long long* offsets;
+		std::atomic<bool> failed;
+	};
+
+public:
+	CompressionClass() = default;
+	CompressionClass(const CompressionClass&) = default;
+	~CompressionClass() = default;
+	// rule of five
+	CompressionClass& operator=(const CompressionClass&) = default;
+	CompressionClass(CompressionClass&&) = default;
+	CompressionClass& operator=(CompressionClass&&) = default;
+
+	static bool Compress(const unsigned char*, unsigned long long, std::vector<unsigned char>&);
+	static bool Decompress(const unsigned char*, unsigned long long, unsigned char*, unsigned long long, int);
+
+	static int CompressBlock(const unsigned char*, int, unsigned char*, int);
+	static bool DecompressBlock(const unsigned char*, int, unsigned char*, int);
+
+	static int GetThreadCount();
+
+private:
+	static void DecompressBlocks(void*, int, int);
+};
+
+#endif	// COMPRESSIONCLASS_H
\ No newline at end of file
@@ -9,6 +9,9 @@
 #include <DirectXMath.h>
 using namespace DirectX;
 
+#include "profilerclass.h"
+#include "renderstatsclass.h"
+
 class D3DClass
 {
 public:
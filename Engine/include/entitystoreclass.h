@@ -0,0 +1,212 @@
+#ifndef ENTITYSTORECLASS_H
+#define ENTITYSTORECLASS_H
+
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "memoryclass.h"
+#include "handlepoolclass.h"
+
+//
+// globals
+const int ENTITY_CHUNK_ROWS = 16384;			// rows a query hands out at most in one chunk, the work of one job
+const int ENTITY_MIN_CAPACITY = 64;				// rows an archetype has room for once it is first used
+const unsigned int ENTITY_FLAG_HIDDEN = 0x1;	// never visible, culling skips it
+const int ENTITY_INDEX_BITS = 24;				// up to 16 million entities, a slot is reused 255 times before its handles repeat
+
+// the components an entity can have, every one of them is a bit of the mask of an archetype
+enum ComponentIdType
+{
+	COMPONENT_POSITION,
+	COMPONENT_VELOCITY,
+	COMPONENT_RADIUS,
+	COMPONENT_COLOR,
+	COMPONENT_MESH,
+	COMPONENT_FLAGS,
+	COMPONENT_MODEL,
+	COMPONENT_COUNT
+};
+
+// the meshes live in the pool of the renderer, the entities only refer to them
+class ModelClass;
+typedef HandleType<ModelClass> MeshHandleType;
+
+// the components are plain data, they are copied bytewise when an entity changes its archetype
+struct PositionComponentType
+{
+	static const int ID = COMPONENT_POSITION;
+	float x, y, z;
+};
+
+struct VelocityComponentType
+{
+	static const int ID = COMPONENT_VELOCITY;
+	float x, y, z;				// units per second
+};
+
+struct RadiusComponentType
+{
+	static const int ID = COMPONENT_RADIUS;
+	float radius;
+};
+
+struct ColorComponentType
+{
+	static const int ID = COMPONENT_COLOR;
+	float red, green, blue, alpha;
+};
+
+struct MeshComponentType
+{
+	static const int ID = COMPONENT_MESH;
+	MeshHandleType mesh;
+};
+
+struct FlagsComponentType
+{
+	static const int ID = COMPONENT_FLAGS;
+	unsigned int flags;
+};
+
+// the index of the model the entity is in the model list
+struct ModelComponentType
+{
+	static const int ID = COMPONENT_MODEL;
+	int index;
+};
+
+// where the components of an entity are, the handles to it stay the same when it moves
+struct EntityRecordType
+{
+	int archetype;
+	int row;
+};
+typedef HandleType<EntityRecordType> EntityType;
+
+// rows of one archetype handed out by a query, the columns of the components that are not
+//  in the archetype are null
+struct EntityChunkType
+{
+	unsigned char* columns[COMPONENT_COUNT];
+	EntityType* entities;
+	int count;
+	int first;					// rows of the chunks before this one in the query
+
+	template <class T>
+	T* Get() const
+	{
+		return (T*)columns[T::ID];
+	}
+};
+
+// archetype based entity component store. the entities with the same set of components share
+//  an archetype that keeps every component in its own tightly packed column, so a system only
+//  touches the bytes it needs. adding or removing a component moves the entity to the next
+//  archetype, the last row of the one it leaves takes its place. pointers into the columns are
+//  only good until the next structural change, queries are cheap to repeat
+class EntityStoreClass
+{
+private:
+	struct ArchetypeType
+	{
+		unsigned int mask;
+		int count, capacity;
+		unsigned char* columns[COMPONENT_COUNT];
+		EntityType* entities;
+		int addEdges[COMPONENT_COUNT];		// archetype with the component added, -1 if not known yet
+		int removeEdges[COMPONENT_COUNT];
+	};
+
+public:
+	EntityStoreClass();
+	EntityStoreClass(const EntityStoreClass&) = delete;
+	~EntityStoreClass();
+	// rule of five
+	EntityStoreClass& operator=(const EntityStoreClass&) = delete;
+	EntityStoreClass(EntityStoreClass&&) = delete;
+	EntityStoreClass& operator=(EntityStoreClass&&) = delete;
+
+	bool Initialize(MemoryTagType);
+	void Shutdown();
+
+	// an entity with the components of the mask, they are all zero
+	EntityType Create(unsigned int);
+	bool Destroy(EntityType);
+	bool Reserve(unsigned int, int);
+
+	bool IsValid(EntityType);
+	unsigned int GetMask(EntityType);
+	int GetCount();
+	int GetArchetypeCount();
+
+	// the chunks of all the archetypes that have every component of the mask
+	void Query(unsigned int, std::vector<EntityChunkType>&);
+
+	template <class T>
+	T* Get(EntityType entity)
+	{
+		EntityRecordType* record;
+		ArchetypeType* archetype;
+
+		record = m_records.Get(entity);
+		if (!record)
+		{
+			return nullptr;
+		}
+
+		archetype = &m_archetypes[record->archetype];
+		if (!archetype->columns[T::ID])
+		{
+			return nullptr;
+		}
+
+		return (T*)archetype->columns[T::ID] + record->row;
+	}
+
+	template <class T>
+	bool Add(EntityType entity, const T& component)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "components are copied bytewise");
+		T* data;
+
+		data = Get<T>(entity);
+		if (!data)
+		{
+			if (!Move(entity, GetMask(entity) | (1u << T::ID), T::ID, true))
+			{
+				return false;
+			}
+			data = Get<T>(entity);
+		}
+
+		*data = component;
+		return true;
+	}
+
+	template <class T>
+	bool Remove(EntityType entity)
+	{
+		if (!Get<T>(entity))
+		{
+			return false;
+		}
+
+		return Move(entity, GetMask(entity) & ~(1u << T::ID), T::ID, false);
+	}
+
+private:
+	int FindArchetype(unsigned int);
+	bool Grow(ArchetypeType&, int);
+	int AddRow(int, EntityType);
+	void RemoveRow(int, int);
+	bool Move(EntityType, unsigned int, int, bool);
+
+private:
+	MemoryTagType m_tag;
+	std::vector<ArchetypeType> m_archetypes;
+	HandlePoolClass<EntityRecordType, ENTITY_INDEX_BITS> m_records;
+};
+
+#endif	// ENTITYSTORECLASS_H
\ No newline at end of file
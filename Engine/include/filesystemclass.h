@@ -0,0 +1,96 @@
+#ifndef FILESYSTEMCLASS_H
+#define FILESYSTEMCLASS_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "packfileclass.h"
+
+// the files the asset watcher looks at, so it can be driven by a fake file system
+class FileSystemClass
+{
+public:
+	FileSystemClass() = default;
+	FileSystemClass(const FileSystemClass&) = default;
+	virtual ~FileSystemClass() = default;
+	// rule of five
+	FileSystemClass& operator=(const FileSystemClass&) = default;
+	FileSystemClass(FileSystemClass&&) = default;
+	FileSystemClass& operator=(FileSystemClass&&) = default;
+
+	// start watching a file, Wait returns early when it may have changed
+	virtual bool Watch(const char*) = 0;
+	// a stamp that changes whenever the file is written, false if it does not exist
+	virtual bool GetStamp(const char*, unsigned long long&) = 0;
+	virtual bool Read(const char*, AssetDataType&) = 0;
+	// block for up to the given milliseconds or until a watched file changes
+	virtual void Wait(int) = 0;
+	// make a blocked Wait return now
+	virtual void Wake() = 0;
+};
+
+// the files on disk, watched with inotify on linux and polled elsewhere
+class DiskFileSystemClass : public FileSystemClass
+{
+public:
+	DiskFileSystemClass();
+	DiskFileSystemClass(const DiskFileSystemClass&) = delete;
+	~DiskFileSystemClass();
+	// rule of five
+	DiskFileSystemClass& operator=(const DiskFileSystemClass&) = delete;
+	DiskFileSystemClass(DiskFileSystemClass&&) = delete;
+	DiskFileSystemClass& operator=(DiskFileSystemClass&&) = delete;
+
+	bool Watch(const char*) override;
+	bool GetStamp(const char*, unsigned long long&) override;
+	bool Read(const char*, AssetDataType&) override;
+	void Wait(int) override;
+	void Wake() override;
+
+private:
+	int m_notify;		// inotify descriptor, -1 if files are polled
+	int m_wakePipe[2];
+};
+
+// files held in memory, every write bumps the stamp and wakes the watcher
+class MemoryFileSystemClass : public FileSystemClass
+{
+private:
+	struct FileType
+	{
+		std::vector<unsigned char> data;
+		unsigned long long stamp;
+	};
+
+public:
+	MemoryFileSystemClass();
+	MemoryFileSystemClass(const MemoryFileSystemClass&) = delete;
+	~MemoryFileSystemClass() = default;
+	// rule of five
+	MemoryFileSystemClass& operator=(const MemoryFileSystemClass&) = delete;
+	MemoryFileSystemClass(MemoryFileSystemClass&&) = delete;
+	MemoryFileSystemClass& operator=(MemoryFileSystemClass&&) = delete;
+
+	bool Watch(const char*) override;
+	bool GetStamp(const char*, unsigned long long&) override;
+	bool Read(const char*, AssetDataType&) override;
+	void Wait(int) override;
+	void Wake() override;
+
+	void Write(const char*, const void*, unsigned long long);
+	void Remove(const char*);
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_changed;
+	std::map<std::string, FileType> m_files;
+	unsigned long long m_stamp;
+	bool m_signaled;
+};
+
+#endif	// FILESYSTEMCLASS_H
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef FLYTHROUGHCLASS_H
+#define FLYTHROUGHCLASS_H
+
+#include <math.h>
+#include <fstream>
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+
+// what the system object does with the camera path
+enum FlythroughModeType
+{
+	FLYTHROUGH_OFF,
+	FLYTHROUGH_RECORD,			// the user moves the camera and the path is written at shutdown
+	FLYTHROUGH_PLAYBACK			// the path moves the camera instead of the input object
+};
+
+//
+// globals
+const char* const FLYTHROUGH_FILENAME = "flythrough.fly";
+const char* const FLYTHROUGH_LOG_FILENAME = "flythrough_frames.csv";
+const float FLYTHROUGH_STEP_MS = 1000.f / 60.f;		// simulated time between two played frames
+
+// the camera at one recorded frame, nothing in it depends on the window
+struct FlythroughFrameType
+{
+	float time;					// milliseconds since the first frame
+	XMFLOAT3 position;
+	XMFLOAT3 direction;
+	XMFLOAT3 up;
+};
+
+// records the camera path of a run and plays it back at a fixed time step, so every playback
+//  renders the same views no matter how fast the frames are
+class FlythroughClass
+{
+private:
+	struct FlythroughHeaderType
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int frameCount;
+		unsigned int reserved;
+	};
+
+public:
+	FlythroughClass();
+	FlythroughClass(const FlythroughClass&) = default;
+	~FlythroughClass() = default;
+	// rule of five
+	FlythroughClass& operator=(const FlythroughClass&) = default;
+	FlythroughClass(FlythroughClass&&) = default;
+	FlythroughClass& operator=(FlythroughClass&&) = default;
+
+	void BeginRecording();
+	void Record(float, XMFLOAT3, XMFLOAT3, XMFLOAT3);
+	bool Save(const char*);
+	bool Load(const char*);
+
+	void BeginPlayback();
+	bool Play(XMFLOAT3&, XMFLOAT3&, XMFLOAT3&);
+	bool IsFinished();
+
+	int GetFrameCount();
+	float GetDuration();
+
+	void LogFrame(float);
+	bool WriteLog(const char*);
+
+private:
+	static XMFLOAT3 Interpolate(const XMFLOAT3&, const XMFLOAT3&, float, bool);
+
+private:
+	std::vector<FlythroughFrameType> m_frames;
+	float m_recordTime;
+
+	int m_playbackFrame;
+	size_t m_segment;
+	bool m_finished;
+
+	std::vector<float> m_frameTimes;		// milliseconds every played frame took
+};
+
+#endif	// FLYTHROUGHCLASS_H
\ No newline at end of file
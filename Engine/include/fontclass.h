@@ -8,9 +8,20 @@
 using namespace DirectX;
 
 #include "textureclass.h"
+#include "packfileclass.h"
+#include "assetcacheclass.h"
+#include "memoryclass.h"
+
+//
+// globals
+const unsigned int FONT_IMPORTER_VERSION = 1;		// bump whenever the imported font data changes
+const int FONT_CHARACTER_COUNT = 95;			// printable ascii characters in the texture
 
 class FontClass
 {
+	// the regression suite times the loaders without a device
+	friend class RegressionClass;
+
 private:
 	struct FontType
 	{
@@ -33,7 +44,7 @@ public:
 	FontClass(FontClass&&) = default;
 	FontClass& operator=(FontClass&&) = default;
 
-	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, char*, char*);
+	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, PackFileClass*, AssetCacheClass*, char*, char*);
 	void Shutdown();
 
 	ID3D11ShaderResourceView* GetTexture();
@@ -41,9 +52,9 @@ public:
 	void BuildVertexArray(void*, char*, float, float);
 
 private:
-	bool LoadFontData(char*);
+	bool LoadFontData(PackFileClass*, AssetCacheClass*, char*);
 	void ReleaseFontData();
-	bool LoadTexture(ID3D11Device*, ID3D11DeviceContext*, char*);
+	bool LoadTexture(ID3D11Device*, ID3D11DeviceContext*, PackFileClass*, char*);
 	void ReleaseTexture();
 
 private:
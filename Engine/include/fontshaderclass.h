@@ -7,6 +7,9 @@
 #include <fstream>
 using namespace DirectX;
 
+#include "packfileclass.h"
+#include "renderstatsclass.h"
+
 class FontShaderClass
 {
 private:
@@ -31,12 +34,12 @@ public:
 	FontShaderClass(FontShaderClass&&) = default;
 	FontShaderClass& operator=(FontShaderClass&&) = default;
 
-	bool Initialize(ID3D11Device*, HWND);
+	bool Initialize(ID3D11Device*, HWND, PackFileClass*);
 	void Shutdown();
 	bool Render(ID3D11DeviceContext*, int, XMMATRIX, XMMATRIX, XMMATRIX, ID3D11ShaderResourceView*, XMVECTOR);
 
 private:
-	bool InitializeShader(ID3D11Device*, HWND, WCHAR*, WCHAR*);
+	bool InitializeShader(ID3D11Device*, HWND, PackFileClass*, WCHAR*, WCHAR*);
 	void ShutdownShader();
 	void OutputShaderErrorMessage(ID3D10Blob*, HWND, WCHAR*);
 
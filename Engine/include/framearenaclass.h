@@ -0,0 +1,105 @@
+#ifndef FRAMEARENACLASS_H
+#define FRAMEARENACLASS_H
+
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+
+//
+// globals
+const size_t FRAME_ARENA_BLOCK_SIZE = 256 * 1024;		// bytes every thread starts out with
+const size_t FRAME_ARENA_ALIGNMENT = 16;				// default alignment, enough for the vector math types
+const unsigned char FRAME_ARENA_POISON_BYTE = 0xCD;
+#ifdef _DEBUG
+const bool FRAME_ARENA_POISON = true;					// fill released memory so stale pointers show up
+#else
+const bool FRAME_ARENA_POISON = false;
+#endif
+
+// per thread bump allocator for the temporaries of a frame. nothing is freed on its own, the
+//  whole arena is released at once when the frame ends. the thread that renders releases its
+//  arena with EndFrame, every other thread releases its arena the first time it allocates in
+//  a later frame. memory from the arena must not be kept past the end of the frame
+class FrameArenaClass
+{
+public:
+	FrameArenaClass() = delete;
+
+	static void* Allocate(size_t, size_t = FRAME_ARENA_ALIGNMENT);
+	static void EndFrame();
+
+	// arrays of types that need no destructor, the elements are value initialized
+	template <class T>
+	static T* Allocate(size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "the frame arena never runs destructors");
+
+		T* memory = (T*)Allocate(count * sizeof(T), alignof(T) > FRAME_ARENA_ALIGNMENT ? alignof(T) : FRAME_ARENA_ALIGNMENT);
+		if (!memory)
+		{
+			return nullptr;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			new (&memory[i]) T();
+		}
+
+		return memory;
+	}
+
+	static size_t GetUsed();
+	static size_t GetPeak();
+	static size_t GetCapacity();
+	static unsigned long long GetFrame();
+
+	// calls into the global heap the calling thread made so far
+	static unsigned long long GetHeapCallCount();
+
+private:
+	static std::atomic<unsigned long long> s_frame;
+};
+
+// lets the standard containers take their memory from the frame arena of the calling thread.
+//  freed memory is only given back at the end of the frame, so reserve the size up front
+//  instead of letting a container grow
+template <class T>
+class FrameAllocatorClass
+{
+public:
+	typedef T value_type;
+
+	FrameAllocatorClass() = default;
+	template <class U>
+	FrameAllocatorClass(const FrameAllocatorClass<U>&) {}
+
+	T* allocate(size_t count)
+	{
+		T* memory = (T*)FrameArenaClass::Allocate(count * sizeof(T), alignof(T) > FRAME_ARENA_ALIGNMENT ? alignof(T) : FRAME_ARENA_ALIGNMENT);
+		if (!memory)
+		{
+			throw std::bad_alloc();
+		}
+
+		return memory;
+	}
+
+	void deallocate(T*, size_t)
+	{
+		return;
+	}
+
+	template <class U>
+	bool operator==(const FrameAllocatorClass<U>&) const { return true; }
+	template <class U>
+	bool operator!=(const FrameAllocatorClass<U>&) const { return false; }
+};
+
+template <class T>
+using FrameVectorType = std::vector<T, FrameAllocatorClass<T>>;
+
+#endif	// FRAMEARENACLASS_H
\ No newline at end of file
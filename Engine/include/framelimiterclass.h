@@ -0,0 +1,58 @@
+#ifndef FRAMELIMITERCLASS_H
+#define FRAMELIMITERCLASS_H
+
+#include <math.h>
+#include <algorithm>
+
+#include "platformclass.h"
+#include "profilerclass.h"
+
+//
+// globals
+const double FRAME_LIMITER_FPS = 120.0;			// frame rate the limiter holds without vsync
+const double FRAME_LIMITER_LATENCY_MS = 4.0;		// the input is sampled this long before the frame is due
+const double FRAME_LIMITER_MIN_SPIN_MS = 0.25;		// the last part of every wait is spun
+const double FRAME_LIMITER_SPIN_DECAY = 0.9;			// how fast a late sleep stops widening the spin
+
+// holds a frame rate without burning the cpu. it sleeps until shortly before the frame is
+//  due and spins the rest on the clock of the platform, as long as sleeps have recently been
+//  overshooting by. the input is sampled as late as the latency budget still makes the frame
+class FrameLimiterClass
+{
+public:
+	FrameLimiterClass();
+	FrameLimiterClass(const FrameLimiterClass&) = delete;
+	~FrameLimiterClass() = default;
+	// rule of five
+	FrameLimiterClass& operator=(const FrameLimiterClass&) = delete;
+	FrameLimiterClass(FrameLimiterClass&&) = delete;
+	FrameLimiterClass& operator=(FrameLimiterClass&&) = delete;
+
+	// a frame rate of zero does not wait at all, a budget of zero samples at the frame start
+	bool Initialize(PlatformClass*, double, double);
+
+	void BeginFrame();
+	void EndFrame();
+
+	double GetLatency();
+	double GetDeadline();
+	double GetSleepTime();
+	double GetSpinTime();
+	int GetMissedCount();
+
+private:
+	void WaitUntil(double);
+
+private:
+	PlatformClass* m_Platform;
+	double m_interval;			// milliseconds between two frames, zero if unlimited
+	double m_budget;			// milliseconds from sampling the input to the deadline
+	double m_deadline;			// when the current frame is due
+	double m_sampleTime;
+	double m_latency;			// milliseconds from sampling the input to submitting the last frame
+	double m_spinMargin;
+	double m_sleepTime, m_spinTime;
+	int m_missedCount;
+};
+
+#endif	// FRAMELIMITERCLASS_H
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef FRAMELOOPCLASS_H
+#define FRAMELOOPCLASS_H
+
+#include <math.h>
+#include <DirectXMath.h>
+using namespace DirectX;
+
+#include "platformclass.h"
+#include "profilerclass.h"
+
+//
+// globals
+const double FRAME_LOOP_STEP_MS = 1000.0 / 120.0;	// simulated time of one step
+const int FRAME_LOOP_MAX_STEPS = 8;					// steps taken at most per frame, a longer stall is dropped
+
+// called for every event the platform had pending, with the data given to PumpEvents
+typedef void (*FrameEventFunction)(void*, const PlatformEventType&);
+
+// runs the simulation at a fixed rate however long the frames take. the time of every frame
+//  goes into an accumulator that is spent in whole steps, what is left over says how far the
+//  renderer is between the last two steps
+class FrameLoopClass
+{
+public:
+	FrameLoopClass();
+	FrameLoopClass(const FrameLoopClass&) = delete;
+	~FrameLoopClass() = default;
+	// rule of five
+	FrameLoopClass& operator=(const FrameLoopClass&) = delete;
+	FrameLoopClass(FrameLoopClass&&) = delete;
+	FrameLoopClass& operator=(FrameLoopClass&&) = delete;
+
+	bool Initialize(PlatformClass*, double = FRAME_LOOP_STEP_MS);
+
+	int PumpEvents(FrameEventFunction, void*);
+	int Advance();
+
+	bool IsQuit();
+	double GetStepTime();
+	double GetSimulatedTime();
+	float GetAlpha();
+	double GetDroppedTime();
+	unsigned long long GetStepCount();
+
+	static XMFLOAT3 Interpolate(const XMFLOAT3&, const XMFLOAT3&, float);
+	static XMFLOAT3 InterpolateDirection(const XMFLOAT3&, const XMFLOAT3&, float);
+
+private:
+	PlatformClass* m_Platform;
+	double m_stepTime;
+	double m_lastTime;
+	double m_simulatedTime;		// the clock of the platform at the end of the last step
+	double m_accumulator;		// milliseconds not simulated yet
+	double m_droppedTime;		// milliseconds of stalls that were not caught up
+	float m_alpha;
+	unsigned long long m_stepCount;
+	bool m_quit;
+};
+
+#endif	// FRAMELOOPCLASS_H
\ No newline at end of file
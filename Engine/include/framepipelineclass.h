@@ -0,0 +1,87 @@
+#ifndef FRAMEPIPELINECLASS_H
+#define FRAMEPIPELINECLASS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+
+#include "spscqueueclass.h"
+#include "framestatsclass.h"
+#include "profilerclass.h"
+
+//
+// globals
+const unsigned int PIPELINE_STATE_COUNT = 2;		// the state being rendered and the one being simulated
+
+// a model the simulation moved, the renderer moves it before it culls
+struct ModelMoveType
+{
+	int index;
+	XMFLOAT3 position;
+};
+
+// everything the renderer needs of a frame, only the simulation writes it
+struct FrameStateType
+{
+	unsigned long long frame;
+	unsigned long long startTicks;		// when the simulation of the frame began
+	int fps, cpu;
+	float frameTime;
+	XMFLOAT3 position, direction, up;
+	std::vector<ModelMoveType> moves;
+	bool hasFrameStats;					// the percentiles of the last second are shown
+	int hudPage;
+	FrameStatsClass frameStats;
+};
+
+// hands the frame states from the simulation thread to the render thread. the simulation
+//  writes frame n + 1 while frame n is rendered, the states go back and forth through two
+//  single producer single consumer queues. without pipelining there is a single state, so
+//  every frame is rendered before the next one is simulated. a thread that finds its queue
+//  empty sleeps until the other one hands a state over
+class FramePipelineClass
+{
+public:
+	FramePipelineClass();
+	FramePipelineClass(const FramePipelineClass&) = delete;
+	~FramePipelineClass() = default;
+	// rule of five
+	FramePipelineClass& operator=(const FramePipelineClass&) = delete;
+	FramePipelineClass(FramePipelineClass&&) = delete;
+	FramePipelineClass& operator=(FramePipelineClass&&) = delete;
+
+	bool Initialize(bool);
+	void Shutdown();
+
+	FrameStateType* BeginSimulation();
+	void EndSimulation();
+	FrameStateType* BeginRender();
+	void EndRender();
+
+	void Stop();
+	bool IsStopped();
+	bool IsPipelined();
+	float GetLatency();
+
+private:
+	void Signal(std::condition_variable&);
+
+private:
+	FrameStateType m_states[PIPELINE_STATE_COUNT];
+	SpscQueueClass<int, PIPELINE_STATE_COUNT> m_readyStates;	// simulated, waiting for the renderer
+	SpscQueueClass<int, PIPELINE_STATE_COUNT> m_freeStates;		// rendered, waiting for the simulation
+	std::mutex m_mutex;
+	std::condition_variable m_stateReady, m_stateFree;
+
+	int m_simulationState, m_renderState;
+	unsigned long long m_frame;
+	std::atomic<bool> m_stopped;
+	bool m_pipelined;
+	float m_latency;		// milliseconds from the start of the simulation to the end of the rendering
+};
+
+#endif	// FRAMEPIPELINECLASS_H
\ No newline at end of file
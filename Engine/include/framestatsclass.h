@@ -0,0 +1,58 @@
+#ifndef FRAMESTATSCLASS_H
+#define FRAMESTATSCLASS_H
+
+#include <fstream>
+#include <algorithm>
+
+//
+// globals
+const float FRAME_BUDGET_MS = 1000.f / 60.f;
+const char* const FRAME_STATS_JSON_FILENAME = "frame_stats.json";
+const char* const FRAME_STATS_CSV_FILENAME = "frame_stats.csv";
+const int FRAME_STATS_SUB_BUCKET_BITS = 8;		// 256 sub buckets, values are kept to better than 1%
+const int FRAME_STATS_BUCKET_COUNT = 28;		// microseconds up to 2^35, far more than any frame
+
+// frame time histogram in the style of an hdr histogram: log2 buckets split linearly into
+//  sub buckets, so the memory is fixed and the relative error is the same at every magnitude
+class FrameStatsClass
+{
+public:
+	FrameStatsClass();
+	FrameStatsClass(const FrameStatsClass&) = default;
+	~FrameStatsClass() = default;
+	// rule of five
+	FrameStatsClass& operator=(const FrameStatsClass&) = default;
+	FrameStatsClass(FrameStatsClass&&) = default;
+	FrameStatsClass& operator=(FrameStatsClass&&) = default;
+
+	void Initialize(float);
+	void Reset();
+
+	void Record(float);
+	void Merge(const FrameStatsClass&);
+
+	float GetPercentile(double);
+	float GetMax();
+	float GetMean();
+	unsigned long long GetCount();
+	unsigned long long GetOverBudgetCount();
+
+	bool WriteJSON(const char*);
+	bool WriteCSV(const char*);
+
+private:
+	static int GetIndex(unsigned long long);
+	static unsigned long long GetHighestValue(int);
+
+private:
+	static const int SUB_BUCKET_COUNT = 1 << FRAME_STATS_SUB_BUCKET_BITS;
+	static const int SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+	static const int COUNT_SIZE = (FRAME_STATS_BUCKET_COUNT + 1) * SUB_BUCKET_HALF;
+
+	unsigned int m_counts[COUNT_SIZE];
+	unsigned long long m_count, m_overBudgetCount;
+	unsigned long long m_max, m_total;		// microseconds
+	float m_budget;
+};
+
+#endif	// FRAMESTATSCLASS_H
\ No newline at end of file
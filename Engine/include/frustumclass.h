@@ -1,13 +1,32 @@
 #ifndef FRUSTUMCLASS_H
 #define FRUSTUMCLASS_H
 
+#include <math.h>
+#include <float.h>
+#include <algorithm>
 #include <DirectXMath.h>
 using namespace DirectX;
 
+// where a volume lies relative to the view frustum
+enum FrustumResultType
+{
+	FRUSTUM_OUTSIDE,
+	FRUSTUM_INTERSECT,
+	FRUSTUM_INSIDE
+};
+
+// what the frustum remembers about one object between frames
+struct FrustumCacheType
+{
+	unsigned int epoch;		// orientation of the frustum the margin was measured with
+	float expiry;			// travel of the planes up to which the object is known to be inside
+	int plane;				// the plane that rejected the object last, it is tested first
+};
+
 class FrustumClass
 {
 public:
-	FrustumClass() = default;
+	FrustumClass();
 	FrustumClass(const FrustumClass&) = default;
 	~FrustumClass() = default;
 	// rule of five
@@ -20,13 +39,27 @@ public:
 	bool CheckPoint(float, float, float);
 	bool CheckCube(float, float, float, float);
 	bool CheckSphere(float, float, float, float);
+	bool CheckSphere(float, float, float, float, FrustumCacheType&);
 	bool CheckRectangle(float, float, float, float, float, float);
 
+	FrustumResultType ClassifyCube(float, float, float, float);
+	FrustumResultType ClassifyRectangle(float, float, float, float, float, float);
+	void ClassifyCubes(const XMFLOAT3*, const float*, int, FrustumResultType*);
+	void ClassifyRectangles(const XMFLOAT3*, const XMFLOAT3*, int, FrustumResultType*);
+
+	XMFLOAT4 GetPlane(int);
+
+	static void ResetCache(FrustumCacheType&);
+	unsigned long long GetPlaneTestCount();
+
 private:
 	XMVECTOR m_planes[6];
+	XMFLOAT4 m_planeData[6];		// the same planes as floats for the scalar tests
 
-private:
-	float distanceToPlane(int, XMFLOAT3);
+	// how far the planes moved without turning since the orientation changed last
+	unsigned int m_epoch;
+	float m_travel;
+	unsigned long long m_planeTests;
 };
 
 #endif	// FRUSTUMCLASS_H
\ No newline at end of file
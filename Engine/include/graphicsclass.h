@@ -4,12 +4,22 @@
 #include "d3dclass.h"
 #include "cameraclass.h"
 #include "modelclass.h"
+#include "texturearrayclass.h"
 #include "bumpmapshaderclass.h"
 #include "lightclass.h"
 #include "bitmapclass.h"
 #include "textclass.h"
 #include "modellistclass.h"
-#include "frustumclass.h"
+#include "visibilityclass.h"
+#include "texturestreamerclass.h"
+#include "textureloaderclass.h"
+#include "packfileclass.h"
+#include "assetcacheclass.h"
+#include "assetwatcherclass.h"
+#include "profilerclass.h"
+#include "framearenaclass.h"
+#include "memoryclass.h"
+#include "handlepoolclass.h"
 
 
 //
@@ -21,10 +31,21 @@ const float SCREEN_DEPTH = 1000.0f;
 const float	SCREEN_NEAR = 0.1f;
 const float STEP = 0.01f;
 const float STEP_LRG = 0.1f;
+const unsigned long long TEXTURE_BUDGET = 32ull * 1024 * 1024;
+const int TEXTURE_LOADS_PER_FRAME = 2;
+const bool HOT_RELOAD_ENABLED = true;
 
 
 class GraphicsClass
 {
+private:
+	// a texture imported on the watcher thread, with the mip size it was created at
+	struct TextureReloadType
+	{
+		ID3D11ShaderResourceView* texture;
+		int maxSize;
+	};
+
 public:
 	GraphicsClass();
 	GraphicsClass(const GraphicsClass&);
@@ -40,16 +61,56 @@ public:
 	bool Frame(int, int, float, XMFLOAT3, XMFLOAT3, XMFLOAT3);
 	bool Render();
 
+	bool SetFrameStats(FrameStatsClass*);
+	void SetHudPage(int);
+	void MoveModel(int, XMFLOAT3);
+
+private:
+	static bool StreamTexture(void*, int, int);
+	void ApplyStreamedTextures();
+
+	bool InitializeHotReload(char*, WCHAR**);
+
+	static void* ImportTexture(void*, int, const AssetDataType&);
+	static void SwapTexture(void*, int, void*);
+	static void ReleaseTexture(void*, int, void*);
+	static void* ImportMesh(void*, int, const AssetDataType&);
+	static void SwapMesh(void*, int, void*);
+	static void ReleaseMesh(void*, int, void*);
+	static void* ImportShader(void*, int, const AssetDataType&);
+	static void SwapShader(void*, int, void*);
+	static void ReleaseShader(void*, int, void*);
+
 private:
+	PackFileClass* m_Pack;
+	AssetCacheClass* m_AssetCache;
 	D3DClass* m_Direct3D;
 	CameraClass* m_Camera;
-	ModelClass* m_Model;
-	BumpMapShaderClass* m_BumpMapShader;
 	LightClass* m_Light;
 	BitmapClass* m_Bitmap;
 	TextClass* m_Text;
 	ModelListClass* m_ModelList;
-	FrustumClass* m_Frustum;
+	VisibilityClass* m_Visibility;
+	TextureStreamerClass* m_TextureStreamer;
+	int m_textureIds[TEXTURE_ARRAY_SIZE];
+	int m_textureSizes[TEXTURE_ARRAY_SIZE];						// mip size the streamer wants every texture at
+	int m_textureLoadedSizes[TEXTURE_ARRAY_SIZE];				// mip size of the texture that is in the array right now
+	TextureLoaderClass* m_TextureLoader;
+	unsigned int m_textureGenerations[TEXTURE_ARRAY_SIZE];		// bumped by a hot reload, older streamed loads are dropped
+	DiskFileSystemClass* m_FileSystem;
+	AssetWatcherClass* m_AssetWatcher;
+	int m_textureWatchIds[TEXTURE_ARRAY_SIZE];
+	int m_visibleModelsCounter, m_planeTestsCounter, m_cullingSkippedCounter;
+	int m_hudPage;
+
+	// the resources are kept in pools and referred to by handles, a reload swaps the object
+	//  behind a handle in place
+	HandlePoolClass<ModelClass> m_meshes;
+	HandlePoolClass<TextureArrayClass> m_textures;
+	HandlePoolClass<BumpMapShaderClass> m_shaders;
+	MeshHandleType m_mesh;
+	HandleType<TextureArrayClass> m_textureArray;
+	HandleType<BumpMapShaderClass> m_bumpMapShader;
 };
 
 #endif	// GRAPHICSCLASS_H
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifndef HANDLEPOOLCLASS_H
+#define HANDLEPOOLCLASS_H
+
+#include <vector>
+#include <utility>
+
+//
+// globals
+const int HANDLE_INDEX_BITS = 20;			// a pool holds up to a million objects unless it asks for more
+
+// refers to an object of a handle pool, the generation of the slot in the high bits and the
+//  slot in the low bits. zero is no object, the generations of the slots start at one
+template <class T>
+struct HandleType
+{
+	unsigned int value = 0;
+
+	bool IsNull() const { return value == 0; }
+	bool operator==(const HandleType& other) const { return value == other.value; }
+	bool operator!=(const HandleType& other) const { return value != other.value; }
+};
+
+// slot map of objects of one type. the objects are kept densely packed so they can be iterated
+//  like an array, a handle goes through its slot to find where the object is right now. freeing
+//  an object moves the last one into its place and bumps the generation of the slot, so handles
+//  to the freed object are caught instead of reaching whatever takes the slot next. pointers to
+//  the objects are only good until the next create or destroy, keep the handle instead. the
+//  index bits set how many objects fit, the rest how often a slot is reused before handles repeat
+template <class T, int indexBits = HANDLE_INDEX_BITS>
+class HandlePoolClass
+{
+private:
+	static const unsigned int INDEX_MASK = (1u << indexBits) - 1;		// also marks the end of the free slots
+	static const unsigned int GENERATION_MASK = (1u << (32 - indexBits)) - 1;
+
+	struct SlotType
+	{
+		unsigned int index;			// where the object is, or the next free slot
+		unsigned int generation;
+	};
+
+public:
+	HandlePoolClass() : m_freeSlot(INDEX_MASK) {}
+	HandlePoolClass(const HandlePoolClass&) = default;
+	~HandlePoolClass() = default;
+	// rule of five
+	HandlePoolClass& operator=(const HandlePoolClass&) = default;
+	HandlePoolClass(HandlePoolClass&&) = default;
+	HandlePoolClass& operator=(HandlePoolClass&&) = default;
+
+	// a default constructed object, no handle if the pool is full
+	HandleType<T> Create()
+	{
+		HandleType<T> handle;
+		unsigned int slot;
+
+		// take a free slot or add one
+		if (m_freeSlot != INDEX_MASK)
+		{
+			slot = m_freeSlot;
+			m_freeSlot = m_slots[slot].index;
+		}
+		else
+		{
+			if (m_slots.size() >= INDEX_MASK)
+			{
+				return handle;
+			}
+
+			slot = (unsigned int)m_slots.size();
+			m_slots.push_back({ 0, 1 });
+		}
+
+		// the object goes to the end of the dense array
+		m_slots[slot].index = (unsigned int)m_objects.size();
+		m_objects.emplace_back();
+		m_objectSlots.push_back(slot);
+
+		handle.value = (m_slots[slot].generation << indexBits) | slot;
+		return handle;
+	}
+
+	// the object is not shut down, only its memory is taken back
+	bool Destroy(HandleType<T> handle)
+	{
+		unsigned int slot, index, last;
+
+		if (!IsValid(handle))
+		{
+			return false;
+		}
+
+		// move the last object into the place of the destroyed one
+		slot = handle.value & INDEX_MASK;
+		index = m_slots[slot].index;
+		last = (unsigned int)m_objects.size() - 1;
+		if (index != last)
+		{
+			m_objects[index] = std::move(m_objects[last]);
+			m_objectSlots[index] = m_objectSlots[last];
+			m_slots[m_objectSlots[index]].index = index;
+		}
+		m_objects.pop_back();
+		m_objectSlots.pop_back();
+
+		// the next generation of the slot, skipping zero so no handle is ever null
+		m_slots[slot].generation = (m_slots[slot].generation + 1) & GENERATION_MASK;
+		if (m_slots[slot].generation == 0)
+		{
+			m_slots[slot].generation = 1;
+		}
+		m_slots[slot].index = m_freeSlot;
+		m_freeSlot = slot;
+
+		return true;
+	}
+
+	// null if the handle is empty or its object was destroyed
+	T* Get(HandleType<T> handle)
+	{
+		if (!IsValid(handle))
+		{
+			return nullptr;
+		}
+
+		return &m_objects[m_slots[handle.value & INDEX_MASK].index];
+	}
+
+	bool IsValid(HandleType<T> handle)
+	{
+		unsigned int slot;
+
+		slot = handle.value & INDEX_MASK;
+		return handle.value != 0 && slot < m_slots.size() && m_slots[slot].generation == handle.value >> indexBits;
+	}
+
+	// the objects in the order they are stored, not the order they were created
+	T* GetData()
+	{
+		return m_objects.data();
+	}
+
+	int GetCount()
+	{
+		return (int)m_objects.size();
+	}
+
+	HandleType<T> GetHandle(int index)
+	{
+		HandleType<T> handle;
+		unsigned int slot;
+
+		slot = m_objectSlots[index];
+		handle.value = (m_slots[slot].generation << indexBits) | slot;
+
+		return handle;
+	}
+
+	void Reserve(int count)
+	{
+		m_objects.reserve(count);
+		m_objectSlots.reserve(count);
+		m_slots.reserve(count);
+
+		return;
+	}
+
+	// destroys every object, the handles to them all go stale
+	void Clear()
+	{
+		while (!m_objects.empty())
+		{
+			Destroy(GetHandle((int)m_objects.size() - 1));
+		}
+
+		return;
+	}
+
+private:
+	std::vector<T> m_objects;
+	std::vector<unsigned int> m_objectSlots;		// the slot of every object
+	std::vector<SlotType> m_slots;
+	unsigned int m_freeSlot;
+};
+
+#endif	// HANDLEPOOLCLASS_H
\ No newline at end of file
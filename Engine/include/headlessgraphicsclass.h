@@ -0,0 +1,115 @@
+#ifndef HEADLESSGRAPHICSCLASS_H
+#define HEADLESSGRAPHICSCLASS_H
+
+#include <DirectXMath.h>
+using namespace DirectX;
+
+#include <vector>
+
+#include "cameraclass.h"
+#include "lightclass.h"
+#include "modellistclass.h"
+#include "visibilityclass.h"
+#include "packfileclass.h"
+#include "renderdeviceclass.h"
+#include "renderstatsclass.h"
+#include "profilerclass.h"
+#include "framearenaclass.h"
+#include "memoryclass.h"
+
+//
+// globals
+const int HEADLESS_SCREEN_WIDTH = 640;
+const int HEADLESS_SCREEN_HEIGHT = 480;
+const float HEADLESS_SCREEN_DEPTH = 1000.f;		// same as the window
+const float HEADLESS_SCREEN_NEAR = 0.1f;
+const int HEADLESS_TEXTURE_COUNT = 5;
+const char* const HEADLESS_MODEL_FILENAME = "./data/sphere.txt";
+const char* const HEADLESS_TEXTURE_FILENAMES[HEADLESS_TEXTURE_COUNT] = {
+	"./data/stone01_conv.dds",
+	"./data/dirt01_conv.dds",
+	"./data/alpha01_conv.dds",
+	"./data/bump01_conv.dds",
+	"./data/spec02_conv.dds"
+};
+const char* const HEADLESS_VERTEX_SHADER_FILENAME = "./shader/bumpmap.vs.hlsl";
+const char* const HEADLESS_PIXEL_SHADER_FILENAME = "./shader/specmap.ps.hlsl";
+
+// the scene of the graphics class rendered through a render device instead of d3d, so the
+//  culling, the constant buffer packing and the submission run without a gpu or a window
+class HeadlessGraphicsClass
+{
+private:
+	struct VertexType
+	{
+		XMFLOAT3 position;
+		XMFLOAT2 texture;
+		XMFLOAT3 normal;
+		XMFLOAT3 tangent;
+		XMFLOAT3 binormal;
+	};
+
+	// laid out like the constant buffers of the bumpmap shader
+	struct MatrixBufferType
+	{
+		XMMATRIX world;
+		XMMATRIX view;
+		XMMATRIX projection;
+	};
+
+	struct LightBufferType
+	{
+		XMVECTOR ambientColor;
+		XMVECTOR diffuseColor;
+		XMFLOAT3 lightDirection;
+		float specularPower;
+		XMVECTOR specularColor;
+	};
+
+	struct CameraBufferType
+	{
+		XMFLOAT3 cameraPosition;
+		float padding;
+	};
+
+public:
+	HeadlessGraphicsClass();
+	HeadlessGraphicsClass(const HeadlessGraphicsClass&) = delete;
+	~HeadlessGraphicsClass() = default;
+	// rule of five
+	HeadlessGraphicsClass& operator=(const HeadlessGraphicsClass&) = delete;
+	HeadlessGraphicsClass(HeadlessGraphicsClass&&) = delete;
+	HeadlessGraphicsClass& operator=(HeadlessGraphicsClass&&) = delete;
+
+	bool Initialize(RenderDeviceClass*, PackFileClass*, int, int, const SceneSettingsType&);
+	void Shutdown();
+	bool Frame(XMFLOAT3, XMFLOAT3, XMFLOAT3);
+	bool Render();
+
+	void SetCoherentCulling(bool);
+	void SetCullCaching(bool);
+	int GetVisibleCount();
+	ModelListClass* GetModelList();
+
+private:
+	bool LoadModel(PackFileClass*);
+	bool LoadTextures(PackFileClass*);
+	bool LoadShaders(PackFileClass*);
+
+private:
+	RenderDeviceClass* m_Device;
+	CameraClass* m_Camera;
+	LightClass* m_Light;
+	ModelListClass* m_ModelList;
+	VisibilityClass* m_Visibility;
+	XMMATRIX m_worldMatrix, m_projectionMatrix;
+
+	int m_vertexBuffer, m_indexBuffer, m_indexCount;
+	int m_matrixBuffer, m_lightBuffer, m_cameraBuffer;
+	int m_vertexShader, m_pixelShader;
+	int m_textures[HEADLESS_TEXTURE_COUNT];
+
+	int m_visibleModelsCounter, m_planeTestsCounter, m_cullingSkippedCounter;
+};
+
+#endif	// HEADLESSGRAPHICSCLASS_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef INPUTBACKENDCLASS_H
+#define INPUTBACKENDCLASS_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "inputqueueclass.h"
+#include "platformclass.h"
+
+// reads the input devices on a thread of its own and pushes what they report into the queue,
+//  like directinput, raw input or evdev would
+class InputBackendClass
+{
+public:
+	InputBackendClass() = default;
+	InputBackendClass(const InputBackendClass&) = delete;
+	virtual ~InputBackendClass() = default;
+	// rule of five
+	InputBackendClass& operator=(const InputBackendClass&) = delete;
+	InputBackendClass(InputBackendClass&&) = delete;
+	InputBackendClass& operator=(InputBackendClass&&) = delete;
+
+	// the events are stamped with the clock of the platform
+	virtual bool Start(InputQueueClass*, PlatformClass*) = 0;
+	virtual void Stop() = 0;
+};
+
+// plays back made up events at their time, so the input can be tested without devices
+class SyntheticInputClass : public InputBackendClass
+{
+public:
+	SyntheticInputClass();
+	SyntheticInputClass(const SyntheticInputClass&) = delete;
+	~SyntheticInputClass();
+	// rule of five
+	SyntheticInputClass& operator=(const SyntheticInputClass&) = delete;
+	SyntheticInputClass(SyntheticInputClass&&) = delete;
+	SyntheticInputClass& operator=(SyntheticInputClass&&) = delete;
+
+	// events have to be posted in the order of their time, before the backend is started
+	void PostEvent(const InputEventType&);
+
+	bool Start(InputQueueClass*, PlatformClass*) override;
+	void Stop() override;
+	bool IsFinished();
+
+private:
+	void ReadMain();
+
+private:
+	std::vector<InputEventType> m_events;
+	InputQueueClass* m_Queue;
+	PlatformClass* m_Platform;
+	std::thread m_thread;
+	std::atomic<bool> m_running, m_finished;
+};
+
+#endif	// INPUTBACKENDCLASS_H
\ No newline at end of file
@@ -10,41 +10,53 @@
 #include <dinput.h>
 #include <iostream>
 
-class InputClass
+#include "inputbackendclass.h"
+#include "profilerclass.h"
+
+//
+// globals
+const DWORD INPUT_DEVICE_BUFFER_SIZE = 256;		// events directinput keeps for every device between two reads
+const DWORD INPUT_MAX_EVENT_AGE = 60000;		// milliseconds, an older stamp is taken as one from after the read
+
+// the keyboard and the mouse through directinput. both devices buffer their events and signal
+//  when there are new ones, a thread of its own reads them right away. every event keeps the
+//  time directinput recorded for it, moved onto the clock of the platform
+class InputClass : public InputBackendClass
 {
 public:
 	InputClass();
-	InputClass(const InputClass&);
+	InputClass(const InputClass&) = delete;
 	~InputClass();
 	// rule of five
-	InputClass& operator=(const InputClass&) = default;
-	InputClass(InputClass&&) = default;
-	InputClass& operator=(InputClass&&) = default;
+	InputClass& operator=(const InputClass&) = delete;
+	InputClass(InputClass&&) = delete;
+	InputClass& operator=(InputClass&&) = delete;
 
 	bool Initialize(HINSTANCE, HWND, int, int);
 	void Shutdown();
-	bool Frame();
 
-	bool IsEscapePressed();
-	void GetMouseLocation(int&, int&);
-	void GetKeyPressed(unsigned char**);
+	bool Start(InputQueueClass*, PlatformClass*) override;
+	void Stop() override;
 
 private:
-	bool ReadKeyboard();
-	bool ReadMouse();
-	void ProcessInput();
+	void ReadMain();
+	bool ReadKeyboard(double, DWORD);
+	bool ReadMouse(double, DWORD);
+	static double GetEventTime(double, DWORD, DWORD);
 
 private:
 	IDirectInput8 * m_directInput;
 	IDirectInputDevice8* m_keyboard;
 	IDirectInputDevice8* m_mouse;
 
-	unsigned char m_keyboardState[256];
-	DIMOUSESTATE m_mouseState;
-
 	int m_screenWidth, m_screenHeight;
-	int m_mouseX, m_mouseY;
-	unsigned char m_key[256];
+
+	// signaled by directinput when a device has new data, the last one stops the thread
+	HANDLE m_events[3];
+	InputQueueClass* m_Queue;
+	PlatformClass* m_Platform;
+	std::thread m_thread;
+	std::atomic<bool> m_running;
 };
 
 #endif	// INPUTCLASS_H
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef INPUTQUEUECLASS_H
+#define INPUTQUEUECLASS_H
+
+#include <string.h>
+#include <atomic>
+#include <algorithm>
+
+#include "spscqueueclass.h"
+#include "profilerclass.h"
+
+//
+// globals
+const unsigned int INPUT_QUEUE_SIZE = 4096;		// events the devices may be ahead of the simulation
+const int INPUT_KEY_COUNT = 256;
+
+// key codes are the scan codes of set 1, directinput and evdev both number the keys that way
+enum InputKeyType
+{
+	INPUT_KEY_ESCAPE = 0x01,
+	INPUT_KEY_Q = 0x10,
+	INPUT_KEY_W = 0x11,
+	INPUT_KEY_E = 0x12,
+	INPUT_KEY_A = 0x1E,
+	INPUT_KEY_S = 0x1F,
+	INPUT_KEY_D = 0x20,
+	INPUT_KEY_F2 = 0x3C,
+	INPUT_KEY_F3 = 0x3D
+};
+
+enum InputDeviceType
+{
+	INPUT_DEVICE_KEYBOARD,
+	INPUT_DEVICE_MOUSE
+};
+
+struct InputEventType
+{
+	double time;				// milliseconds on the clock of the platform when the device reported it
+	InputDeviceType device;
+	int key;
+	bool down;
+	int x, y;					// mouse movement
+};
+
+// timestamped input between the thread reading the devices and the simulation. the devices
+//  push every event into a lock free ring as it happens, the simulation takes the events up
+//  to the end of every step, so a tap shorter than a frame still moves the camera for as long
+//  as the key was down
+class InputQueueClass
+{
+public:
+	InputQueueClass();
+	InputQueueClass(const InputQueueClass&) = delete;
+	~InputQueueClass() = default;
+	// rule of five
+	InputQueueClass& operator=(const InputQueueClass&) = delete;
+	InputQueueClass(InputQueueClass&&) = delete;
+	InputQueueClass& operator=(InputQueueClass&&) = delete;
+
+	void Initialize(double);
+
+	// called by the device thread
+	bool Push(const InputEventType&);
+
+	// called by the simulation
+	int Consume(double);
+	bool IsKeyDown(int);
+	bool WasKeyPressed(int);
+	const float* GetKeyTimes();
+	void GetMouseMovement(int&, int&);
+	double GetEventAge();
+	unsigned long long GetDroppedCount();
+
+private:
+	SpscQueueClass<InputEventType, INPUT_QUEUE_SIZE> m_events;
+	std::atomic<unsigned long long> m_droppedCount;
+
+	// the first event after the last step, it waits for the next one
+	InputEventType m_nextEvent;
+	bool m_hasNextEvent;
+
+	// the state at the end of the last step
+	double m_consumedTime;
+	bool m_keys[INPUT_KEY_COUNT];
+	double m_keyDownTimes[INPUT_KEY_COUNT];
+	bool m_pressedKeys[INPUT_KEY_COUNT];	// went down during the last step
+	float m_keyTimes[INPUT_KEY_COUNT];		// milliseconds the key was down during the last step
+	int m_mouseX, m_mouseY;
+	double m_eventAge;						// how long before the end of the last step its events happened
+};
+
+#endif	// INPUTQUEUECLASS_H
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef JOBSYSTEMCLASS_H
+#define JOBSYSTEMCLASS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+//
+// globals
+const int JOB_MAX_THREADS = 16;				// the thread that initializes the system and the workers
+const int JOB_DEQUE_SIZE = 4096;			// jobs one thread can have queued, a power of two
+const int JOB_SPIN_COUNT = 64;				// tries to find work before a worker goes to sleep
+const int JOB_SLEEP_TIME = 1;				// milliseconds a sleeping worker waits before it looks again
+
+// runs a job on the items [begin, end) of the data
+typedef void (*JobFunction)(void*, int, int);
+
+struct JobCounterType;
+
+struct JobType
+{
+	JobFunction function;
+	void* data;
+	int begin, end;
+	int grain;						// the range is split down to this many items, 0 runs it as a whole
+	JobCounterType* counter;		// counted down once the job is done
+};
+
+// counts the jobs that are not done yet, jobs that depend on it are queued once it drops to zero
+struct JobCounterType
+{
+	JobCounterType() : value(0) {}
+
+	std::atomic<int> value;
+	std::mutex lock;
+	std::vector<JobType> waiting;
+};
+
+// work stealing job scheduler, every thread has a chase-lev deque it pushes to and pops from
+//  at the bottom while the other threads steal from the top. waiting for a counter runs other
+//  jobs in the meantime instead of blocking the thread
+class JobSystemClass
+{
+private:
+	struct JobDequeType
+	{
+		alignas(64) std::atomic<long long> top;
+		alignas(64) std::atomic<long long> bottom;
+		JobType jobs[JOB_DEQUE_SIZE];
+	};
+
+public:
+	JobSystemClass() = delete;
+
+	static bool Initialize(int);
+	static void Shutdown();
+
+	static void Run(JobFunction, void*, int, int, JobCounterType*, JobCounterType* = nullptr);
+	static void ParallelFor(JobFunction, void*, int, int, int, JobCounterType*, JobCounterType* = nullptr);
+	static void Wait(JobCounterType*);
+
+	static int GetThreadCount();
+	static int GetThreadIndex();
+
+private:
+	static void Submit(const JobType&, JobCounterType*);
+	static void Push(const JobType&);
+	static bool Pop(JobDequeType&, JobType&);
+	static bool Steal(JobDequeType&, JobType&);
+	static bool FindJob(int, JobType&);
+	static void Execute(int, JobType&);
+	static void Finish(JobCounterType*);
+	static void WorkerMain(int);
+
+private:
+	static JobDequeType* s_deques;
+	static std::vector<std::thread> s_workers;
+	static int s_threadCount;
+	static std::atomic<bool> s_quit;
+	static std::atomic<int> s_queued, s_sleeping;
+	static std::mutex s_sleepLock;
+	static std::condition_variable s_wake;
+};
+
+#endif	// JOBSYSTEMCLASS_H
\ No newline at end of file
@@ -8,6 +8,8 @@ using namespace DirectX;
 
 #include <fstream>
 
+#include "renderstatsclass.h"
+
 class LightShaderClass
 {
 private:
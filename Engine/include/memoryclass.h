@@ -0,0 +1,152 @@
+#ifndef MEMORYCLASS_H
+#define MEMORYCLASS_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <algorithm>
+
+//
+// globals
+const bool MEMORY_TRACKING_ENABLED = true;
+const size_t MEMORY_ALIGNMENT = 16;			// every tracked allocation is aligned like this, enough for the vector math types
+const int MEMORY_MAX_THREADS = 16;			// threads that count their allocations on their own, the others share a slot
+
+// what the memory is used for, every tag is counted on its own
+enum MemoryTagType
+{
+	MEMORY_TAG_GENERAL,
+	MEMORY_TAG_GRAPHICS,			// the objects of the renderer
+	MEMORY_TAG_MESH,
+	MEMORY_TAG_TEXTURE,
+	MEMORY_TAG_TEXT,
+	MEMORY_TAG_SCENE,
+	MEMORY_TAG_COUNT
+};
+
+struct MemoryStatsType
+{
+	unsigned long long current;			// bytes allocated right now
+	unsigned long long peak;
+	unsigned long long allocations;		// allocations made so far
+	unsigned long long live;			// allocations not freed yet
+};
+
+// tracks the heap memory of the engine by what it is used for. every allocation carries a
+//  small header with its tag and size. the bytes of a tag are a single atomic so the peak is
+//  exact, the number of allocations is counted by every thread on its own without contention
+class MemoryClass
+{
+private:
+	// right in front of every allocation, the block is what the heap handed out
+	struct MemoryHeaderType
+	{
+		void* block;
+		unsigned long long size;
+		unsigned int tag;
+		unsigned int count;			// elements of an array
+	};
+
+	// every tag on its own cache line, so threads allocating for different tags do not contend
+	struct alignas(64) MemoryBytesType
+	{
+		std::atomic<unsigned long long> current;
+		std::atomic<unsigned long long> peak;
+	};
+
+	// written only by its own thread, read when the stats are taken
+	struct alignas(64) MemoryThreadCountsType
+	{
+		std::atomic<unsigned long long> allocations[MEMORY_TAG_COUNT];
+		std::atomic<unsigned long long> frees[MEMORY_TAG_COUNT];
+	};
+
+public:
+	MemoryClass() = delete;
+
+	static void* Allocate(size_t, MemoryTagType);
+	static void Free(void*);
+
+	template <class T, class... Args>
+	static T* New(MemoryTagType tag, Args&&... args)
+	{
+		static_assert(alignof(T) <= MEMORY_ALIGNMENT, "the type needs more alignment than the tracked memory has");
+
+		void* memory = Allocate(sizeof(T), tag);
+		if (!memory)
+		{
+			return nullptr;
+		}
+
+		return new (memory) T(std::forward<Args>(args)...);
+	}
+
+	template <class T>
+	static void Delete(T* object)
+	{
+		if (object)
+		{
+			object->~T();
+			Free(object);
+		}
+
+		return;
+	}
+
+	// the elements are default initialized like with new[]
+	template <class T>
+	static T* NewArray(size_t count, MemoryTagType tag)
+	{
+		static_assert(alignof(T) <= MEMORY_ALIGNMENT, "the type needs more alignment than the tracked memory has");
+
+		T* memory = (T*)Allocate(count * sizeof(T), tag);
+		if (!memory)
+		{
+			return nullptr;
+		}
+
+		GetHeader(memory)->count = (unsigned int)count;
+		for (size_t i = 0; i < count; i++)
+		{
+			new (&memory[i]) T;
+		}
+
+		return memory;
+	}
+
+	template <class T>
+	static void DeleteArray(T* memory)
+	{
+		if (memory)
+		{
+			for (unsigned int i = GetHeader(memory)->count; i > 0; i--)
+			{
+				memory[i - 1].~T();
+			}
+			Free(memory);
+		}
+
+		return;
+	}
+
+	static void GetStats(MemoryTagType, MemoryStatsType&);
+	static void GetTotalStats(MemoryStatsType&);
+	static const char* GetTagName(MemoryTagType);
+
+	static int GetLeakReport(char*, size_t);
+
+private:
+	static MemoryHeaderType* GetHeader(void*);
+	static MemoryThreadCountsType* GetThreadCounts();
+	static void Increment(std::atomic<unsigned long long>&);
+
+private:
+	static MemoryBytesType s_bytes[MEMORY_TAG_COUNT];
+	static MemoryThreadCountsType s_threads[MEMORY_MAX_THREADS + 1];
+	static std::atomic<int> s_threadCount;
+};
+
+#endif	// MEMORYCLASS_H
\ No newline at end of file
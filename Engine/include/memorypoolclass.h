@@ -0,0 +1,94 @@
+#ifndef MEMORYPOOLCLASS_H
+#define MEMORYPOOLCLASS_H
+
+#include <new>
+#include <utility>
+#include <algorithm>
+
+#include "memoryclass.h"
+
+//
+// globals
+const int MEMORY_POOL_PAGE_ELEMENTS = 64;		// elements the pool grows by if no count is given
+
+// hands out memory for objects of one size. the elements come from pages of tracked memory
+//  and freed ones are kept in a list for the next allocation, so neither costs a call into
+//  the heap once the pool is large enough. a pool may only be used by one thread at a time
+class MemoryPoolClass
+{
+private:
+	// the first bytes of a free element point to the next free one
+	struct FreeElementType
+	{
+		FreeElementType* next;
+	};
+
+	// the elements of a page follow its header
+	struct PageType
+	{
+		PageType* next;
+		unsigned long long padding;
+	};
+
+public:
+	MemoryPoolClass();
+	MemoryPoolClass(const MemoryPoolClass&) = delete;
+	~MemoryPoolClass();
+	// rule of five
+	MemoryPoolClass& operator=(const MemoryPoolClass&) = delete;
+	MemoryPoolClass(MemoryPoolClass&&) = delete;
+	MemoryPoolClass& operator=(MemoryPoolClass&&) = delete;
+
+	bool Initialize(size_t, MemoryTagType, int = MEMORY_POOL_PAGE_ELEMENTS);
+	void Shutdown();
+
+	void* Allocate();
+	void Free(void*);
+
+	template <class T, class... Args>
+	T* New(Args&&... args)
+	{
+		static_assert(alignof(T) <= MEMORY_ALIGNMENT, "the type needs more alignment than the pool has");
+
+		if (sizeof(T) > m_elementSize)
+		{
+			return nullptr;
+		}
+
+		void* memory = Allocate();
+		if (!memory)
+		{
+			return nullptr;
+		}
+
+		return new (memory) T(std::forward<Args>(args)...);
+	}
+
+	template <class T>
+	void Delete(T* object)
+	{
+		if (object)
+		{
+			object->~T();
+			Free(object);
+		}
+
+		return;
+	}
+
+	int GetUsedCount();
+	int GetCapacity();
+
+private:
+	bool AddPage();
+
+private:
+	size_t m_elementSize;
+	int m_pageElements;
+	MemoryTagType m_tag;
+	PageType* m_pages;
+	FreeElementType* m_free;
+	int m_usedCount, m_capacity;
+};
+
+#endif	// MEMORYPOOLCLASS_H
\ No newline at end of file
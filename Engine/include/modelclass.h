@@ -7,10 +7,23 @@ using namespace DirectX;
 
 #include <fstream>
 
-#include "texturearrayclass.h"
+#include "packfileclass.h"
+#include "assetcacheclass.h"
+#include "renderstatsclass.h"
+#include "jobsystemclass.h"
+#include "memoryclass.h"
+
+//
+// globals
+const unsigned int MODEL_IMPORTER_VERSION = 1;		// bump whenever the imported model data changes
+const int MODEL_FACE_GRAIN = 256;					// faces a job calculates the vectors of at least
+const int MODEL_MIN_VERTEX_BYTES = 16;				// text of a vertex at the least, eight numbers of a digit and a separator
 
 class ModelClass
 {
+	// the regression suite times the loaders without a device
+	friend class RegressionClass;
+
 private:
 	struct VertexType
 	{
@@ -51,25 +64,27 @@ public:
 	ModelClass(ModelClass&&) = default;
 	ModelClass& operator=(ModelClass&&) = default;
 
-	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, char*, WCHAR*, WCHAR*, WCHAR*, WCHAR*, WCHAR*);
+	bool Initialize(ID3D11Device*, PackFileClass*, AssetCacheClass*, char*);
 	void Shutdown();
 	void Render(ID3D11DeviceContext*);
 
 	int GetIndexCount();
-	ID3D11ShaderResourceView** GetTextureArray();
+
+	bool InitializeMesh(ID3D11Device*, AssetCacheClass*, const AssetDataType&);
+	void SwapMesh(ModelClass*);
 
 private:
 	bool InitializeBuffers(ID3D11Device*);
 	void ShutdownBuffers();
 	void RenderBuffers(ID3D11DeviceContext*);
 
-	bool LoadTextures(ID3D11Device*, WCHAR*, WCHAR*, WCHAR*, WCHAR*, WCHAR*);
-	void ReleaseTextures();
-
-	bool LoadModel(char*);
+	bool ImportModel(AssetCacheClass*, const AssetDataType&);
+	bool LoadModel(const AssetDataType&);
 	void ReleaseModel();
 
 	void CalculateModelVectors();
+	void CalculateFaceVectors(int, int);
+	static void CalculateFaceVectorsJob(void*, int, int);
 	void CalculateTangentBinormal(TempVertexType, TempVertexType, TempVertexType, VectorType&, VectorType&);
 	void CalculateNormal(VectorType, VectorType, VectorType&);
 
@@ -77,7 +92,6 @@ private:
 	ID3D11Buffer* m_vertexBuffer, *m_indexBuffer;
 	int m_vertexCount, m_indexCount;
 
-	TextureArrayClass* m_TextureArray;
 	ModelType* m_Model;
 };
 
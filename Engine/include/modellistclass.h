@@ -1,38 +1,103 @@
 #ifndef MODELLISTCLASS_H
 #define MODELLISTCLASS_H
 
-#include <stdlib.h>
-#include <time.h>
+#include <vector>
 #include <DirectXMath.h>
 using namespace DirectX;
 
+#include "scenegeneratorclass.h"
+#include "memoryclass.h"
+#include "entitystoreclass.h"
+#include "transformclass.h"
+#include "jobsystemclass.h"
+#include "profilerclass.h"
+
+//
+// globals
+const unsigned int MODEL_COMPONENTS =
+	(1u << COMPONENT_POSITION) | (1u << COMPONENT_RADIUS) | (1u << COMPONENT_COLOR) |
+	(1u << COMPONENT_MESH) | (1u << COMPONENT_FLAGS) | (1u << COMPONENT_MODEL);
+const int MODEL_PARALLEL_COUNT = 4096;		// fewer models are updated or extracted on the calling thread alone
+const int MODEL_EXTRACT_GRAIN = 1024;		// visible models an extraction job copies at least
+
+// what the renderer needs to draw a visible model, copied out of the entity store
+struct RenderItemType
+{
+	XMFLOAT4X4 world;
+	XMFLOAT4 color;
+	float positionX, positionY, positionZ;
+	float radius;
+	MeshHandleType mesh;
+};
+
+// the models of the scene, every one of them is an entity of the store. the index of a model
+//  stays the same for the lifetime of the scene, the entity keeps it in its model component.
+//  the transform node of a model has the id of its index
 class ModelListClass
 {
 private:
-	struct ModelInfoType
+	struct UpdateJobType
+	{
+		ModelListClass* modelList;
+		float time;
+	};
+
+	struct ExtractJobType
 	{
-		XMFLOAT4 color;
-		float positionX, positionY, positionZ;
+		ModelListClass* modelList;
+		const int* models;
+		RenderItemType* items;
 	};
 
 public:
 	ModelListClass();
-	ModelListClass(const ModelListClass&) = default;
+	ModelListClass(const ModelListClass&) = delete;
 	~ModelListClass() = default;
 	// rule of five
-	ModelListClass& operator=(const ModelListClass&) = default;
-	ModelListClass(ModelListClass&&) = default;
-	ModelListClass& operator=(ModelListClass&&) = default;
+	ModelListClass& operator=(const ModelListClass&) = delete;
+	ModelListClass(ModelListClass&&) = delete;
+	ModelListClass& operator=(ModelListClass&&) = delete;
 
 	bool Initialize(int);
+	bool Initialize(const SceneSettingsType&);
 	void Shutdown();
 
 	int GetModelCount();
-	void GetData(int, float&, float&, float&, XMFLOAT4&);
+	void GetData(int, float&, float&, float&, float&, XMFLOAT4&);
+
+	void SetPosition(int, float, float, float);
+	bool SetVelocity(int, float, float, float);
+	MeshHandleType GetMesh(int);
+	void SetMesh(int, MeshHandleType);
+	unsigned int GetFlags(int);
+	void SetFlags(int, unsigned int);
+	unsigned int GetVersion();
+	void TakeMovedModels(std::vector<int>&);
+
+	EntityStoreClass* GetEntities();
+	EntityType GetEntity(int);
+	TransformClass* GetTransforms();
+
+	// the systems over the entities of the models
+	void Update(float);
+	void Extract(const int*, int, RenderItemType*);
 
 private:
-	int m_modelCount;
-	ModelInfoType* m_ModelInfoList;
+	static void UpdateJob(void*, int, int);
+	static void ExtractJob(void*, int, int);
+
+private:
+	EntityStoreClass m_entities;
+	std::vector<EntityType> m_models;
+	TransformClass m_transforms;
+
+	// bumped on every change, the models that moved since the last take are listed
+	unsigned int m_version;
+	std::vector<int> m_movedModels;
+
+	// what the update system works on, kept so the frames do not allocate
+	std::vector<EntityChunkType> m_chunks;
+	std::vector<int> m_moves;
 };
 
 #endif	// MODELLISTCLASS_H
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef PACKFILECLASS_H
+#define PACKFILECLASS_H
+
+#include <string.h>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "compressionclass.h"
+
+//
+// globals
+const char* const PACK_ENGINE_FILENAME = "./data/engine.pak";
+const char* const PACK_ENGINE_FILES[] = {
+	"./data/sphere.txt",
+	"./data/stone01_conv.dds",
+	"./data/dirt01_conv.dds",
+	"./data/alpha01_conv.dds",
+	"./data/bump01_conv.dds",
+	"./data/spec02_conv.dds",
+	"./data/fontdata.txt",
+	"./data/font_conv.dds",
+	"./shader/bumpmap.vs.hlsl",
+	"./shader/specmap.ps.hlsl",
+	"./shader/font.vs.hlsl",
+	"./shader/font.ps.hlsl"
+};
+const int PACK_ENGINE_FILE_COUNT = sizeof(PACK_ENGINE_FILES) / sizeof(PACK_ENGINE_FILES[0]);
+const unsigned long long PACK_ALIGNMENT = 4096;
+const unsigned int PACK_ENTRY_COMPRESSED = 0x1;
+
+// bytes of an asset, either a span into the mapped pack or a loose file read into the buffer
+struct AssetDataType
+{
+	const unsigned char* data;
+	unsigned long long size;
+	std::vector<unsigned char> buffer;
+};
+
+// read only stream over a span of memory, used to parse text assets in place
+class MemoryStreamBuffer : public std::streambuf
+{
+public:
+	MemoryStreamBuffer(const unsigned char* data, unsigned long long size)
+	{
+		char* begin = (char*)data;
+		setg(begin, begin, begin + size);
+	}
+};
+
+class PackFileClass
+{
+private:
+	struct PackHeaderType
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int entryCount;
+		unsigned int nameBytes;
+		unsigned long long tocOffset;
+		unsigned long long dataOffset;
+	};
+
+	// table of contents entry, sorted by hash
+	struct PackEntryType
+	{
+		unsigned long long hash;
+		unsigned long long offset;
+		unsigned long long size;			// stored size
+		unsigned long long rawSize;			// size after decompression
+		unsigned int nameOffset;
+		unsigned int nameLength;
+		unsigned int flags;
+		unsigned int reserved;
+	};
+
+public:
+	PackFileClass();
+	PackFileClass(const PackFileClass&) = delete;
+	~PackFileClass();
+	// rule of five
+	PackFileClass& operator=(const PackFileClass&) = delete;
+	PackFileClass(PackFileClass&&) = delete;
+	PackFileClass& operator=(PackFileClass&&) = delete;
+
+	bool Open(const char*);
+	void Close();
+	bool IsOpen();
+
+	bool Find(const char*, const unsigned char*&, unsigned long long&);
+	bool Read(const char*, AssetDataType&);
+	int GetEntryCount();
+
+	static bool Build(const char*, const char* const*, int, bool);
+	static bool ReadLooseFile(const char*, AssetDataType&);
+	static unsigned long long HashPath(const char*);
+
+private:
+	const PackEntryType* FindEntry(const char*);
+	static std::string NormalizePath(const char*);
+
+private:
+	const unsigned char* m_data;
+	unsigned long long m_size;
+	const PackHeaderType* m_header;
+	const PackEntryType* m_entries;
+	const char* m_names;
+
+	// platform handles of the mapping
+	void* m_file;
+	void* m_mapping;
+};
+
+#endif	// PACKFILECLASS_H
\ No newline at end of file
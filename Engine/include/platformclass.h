@@ -0,0 +1,84 @@
+#ifndef PLATFORMCLASS_H
+#define PLATFORMCLASS_H
+
+#include <stddef.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//
+// globals
+const double SYNTHETIC_PLATFORM_TICK_MS = 0.01;		// the made up clock moves at least this much per sleep
+
+// the kinds of messages a platform hands to the frame loop
+enum PlatformMessageType
+{
+	PLATFORM_MESSAGE_QUIT,
+	PLATFORM_MESSAGE_KEY,
+	PLATFORM_MESSAGE_MOUSE,
+	PLATFORM_MESSAGE_OTHER			// handled by the platform itself, like a window being moved
+};
+
+struct PlatformEventType
+{
+	PlatformMessageType message;
+	double time;					// milliseconds on the clock of the platform when it was posted
+	int x, y;						// mouse movement
+	unsigned int key;
+	bool down;
+};
+
+// the window system and the clock the frame loop runs on, so the loop runs the same on
+//  every platform and with a made up source of events
+class PlatformClass
+{
+public:
+	PlatformClass() = default;
+	PlatformClass(const PlatformClass&) = default;
+	virtual ~PlatformClass() = default;
+	// rule of five
+	PlatformClass& operator=(const PlatformClass&) = default;
+	PlatformClass(PlatformClass&&) = default;
+	PlatformClass& operator=(PlatformClass&&) = default;
+
+	// takes the next pending event, false once there is none left
+	virtual bool PollEvent(PlatformEventType&) = 0;
+	// milliseconds since some point in the past
+	virtual double GetTime() = 0;
+	// gives up the thread for about the milliseconds, no time just yields it
+	virtual void SleepFor(double) = 0;
+};
+
+// a platform whose events are made up, they show up once the clock reached their time. the
+//  clock either only moves when it is told to or it is the real one
+class SyntheticPlatformClass : public PlatformClass
+{
+public:
+	SyntheticPlatformClass(bool = false);
+	SyntheticPlatformClass(const SyntheticPlatformClass&) = default;
+	~SyntheticPlatformClass() = default;
+	// rule of five
+	SyntheticPlatformClass& operator=(const SyntheticPlatformClass&) = default;
+	SyntheticPlatformClass(SyntheticPlatformClass&&) = default;
+	SyntheticPlatformClass& operator=(SyntheticPlatformClass&&) = default;
+
+	bool PollEvent(PlatformEventType&) override;
+	double GetTime() override;
+	void SleepFor(double) override;
+
+	// events have to be posted in the order of their time
+	void PostEvent(const PlatformEventType&);
+	void SetTime(double);
+	void Advance(double);
+	int GetPendingCount();
+
+private:
+	std::vector<PlatformEventType> m_events;
+	size_t m_nextEvent;
+	double m_time;
+	bool m_realClock;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+#endif	// PLATFORMCLASS_H
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include <DirectXMath.h>
 using namespace DirectX;
 
+#include "profilerclass.h"
+#include "inputqueueclass.h"
+
 class PositionClass
 {
 public:
@@ -15,9 +18,8 @@ public:
 
 	bool Frame();
 
-	void SetFrameTime(float);
 	void SetMousePosition(int, int);
-	void SetKeyboard(unsigned char*);
+	void SetKeyTimes(const float*);
 
 	XMFLOAT3 GetDirection();
 	XMFLOAT3 GetUp();
@@ -28,9 +30,8 @@ private:
 	void Calculate();
 
 private:
-	float m_frameTime;
 	int m_mouseX, m_mouseY;
-	unsigned char* m_key;
+	const float* m_keyTimes;		// milliseconds every key was down during the step
 	float m_angleH, m_angleV;
 
 	XMVECTOR m_position, m_direction, m_right, m_up;
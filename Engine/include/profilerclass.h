@@ -0,0 +1,77 @@
+#ifndef PROFILERCLASS_H
+#define PROFILERCLASS_H
+
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+//
+// globals
+const bool PROFILER_ENABLED = true;
+const int PROFILER_RING_SIZE = 16384;		// zones kept per thread, a power of two
+const int PROFILER_MAX_THREADS = 16;
+const char* const PROFILER_TRACE_FILENAME = "profile.json";
+
+// hierarchical cpu profiler, zones are written into a lock free ring per thread and
+//  can be exported to the chrome trace format (chrome://tracing or ui.perfetto.dev)
+class ProfilerClass
+{
+private:
+	struct ZoneType
+	{
+		const char* name;
+		unsigned long long begin, end;		// ticks
+	};
+
+	// written only by its own thread, read by the exporter
+	struct ThreadBufferType
+	{
+		ZoneType zones[PROFILER_RING_SIZE];
+		std::atomic<unsigned long long> head;
+		unsigned int threadId;
+	};
+
+public:
+	ProfilerClass() = delete;
+
+	static bool Initialize();
+	static void Shutdown();
+
+	static unsigned long long GetTicks();
+	static void Record(const char*, unsigned long long, unsigned long long);
+	static bool WriteTrace(const char*);
+
+	static double GetTicksPerMicrosecond();
+
+private:
+	static ThreadBufferType* GetThreadBuffer();
+
+private:
+	static ThreadBufferType s_buffers[PROFILER_MAX_THREADS];
+	static std::atomic<int> s_bufferCount;
+	static double s_ticksPerMicrosecond;
+	static unsigned long long s_startTicks;
+};
+
+// times the scope it lives in, the name has to be a string literal
+class ProfileZoneClass
+{
+public:
+	ProfileZoneClass(const char*);
+	ProfileZoneClass(const ProfileZoneClass&) = delete;
+	~ProfileZoneClass();
+	// rule of five
+	ProfileZoneClass& operator=(const ProfileZoneClass&) = delete;
+	ProfileZoneClass(ProfileZoneClass&&) = delete;
+	ProfileZoneClass& operator=(ProfileZoneClass&&) = delete;
+
+private:
+	const char* m_name;
+	unsigned long long m_begin;
+};
+
+#endif	// PROFILERCLASS_H
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef RANDOMCLASS_H
+#define RANDOMCLASS_H
+
+// pcg32 random number generator, the same seed gives the same numbers on every platform
+class RandomClass
+{
+public:
+	RandomClass();
+	RandomClass(unsigned long long, unsigned long long = 0);
+	RandomClass(const RandomClass&) = default;
+	~RandomClass() = default;
+	// rule of five
+	RandomClass& operator=(const RandomClass&) = default;
+	RandomClass(RandomClass&&) = default;
+	RandomClass& operator=(RandomClass&&) = default;
+
+	void Seed(unsigned long long, unsigned long long = 0);
+
+	unsigned int Next();
+	unsigned int NextInt(unsigned int);
+	float NextFloat();
+	float NextRange(float, float);
+	float NextGaussian();
+
+private:
+	unsigned long long m_state;
+	unsigned long long m_increment;
+};
+
+#endif	// RANDOMCLASS_H
\ No newline at end of file
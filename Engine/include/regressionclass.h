@@ -0,0 +1,99 @@
+#ifndef REGRESSIONCLASS_H
+#define REGRESSIONCLASS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <DirectXMath.h>
+using namespace DirectX;
+
+#include "frustumclass.h"
+#include "modellistclass.h"
+#include "scenegeneratorclass.h"
+#include "packfileclass.h"
+#ifdef _WIN32
+#include "modelclass.h"
+#include "textureclass.h"
+#include "fontclass.h"
+#endif
+
+// the frustum check a culling scenario runs
+enum RegressionCullingType
+{
+	REGRESSION_CULL_POINT,
+	REGRESSION_CULL_SPHERE,
+	REGRESSION_CULL_CUBE,
+	REGRESSION_CULL_COUNT
+};
+
+//
+// globals
+const char* const REGRESSION_OUTPUT_FILENAME = "regression.json";
+const char* const REGRESSION_BASELINE_FILENAME = "./regression_baseline.json";
+const char* const REGRESSION_CULLING_NAMES[REGRESSION_CULL_COUNT] = { "point", "sphere", "cube" };
+const int REGRESSION_OBJECT_COUNTS[] = { 500, 10000, 100000 };
+const int REGRESSION_OBJECT_COUNT_COUNT = sizeof(REGRESSION_OBJECT_COUNTS) / sizeof(REGRESSION_OBJECT_COUNTS[0]);
+const int REGRESSION_TEXT_LENGTHS[] = { 16, 64, 256 };
+const int REGRESSION_TEXT_LENGTH_COUNT = sizeof(REGRESSION_TEXT_LENGTHS) / sizeof(REGRESSION_TEXT_LENGTHS[0]);
+const int REGRESSION_WARMUP = 3;
+const int REGRESSION_TRIALS = 15;
+const double REGRESSION_MAD_FACTOR = 4.0;		// scaled MADs a median may rise before it counts as a regression
+const double REGRESSION_MIN_CHANGE = 0.10;		// and never less than this fraction of the baseline
+const char* const REGRESSION_MODEL_FILENAME = "./data/sphere.txt";
+const char* const REGRESSION_FONT_FILENAME = "./data/fontdata.txt";
+const char* const REGRESSION_TARGA_FILENAME = "regression.tga";
+const int REGRESSION_TARGA_SIZE = 512;
+
+// the statistics of one scenario, the line format of the results and the baseline
+struct RegressionResultType
+{
+	std::string scenario;
+	std::string unit;
+	int trials;
+	double median;
+	double mad;			// median absolute deviation from the median
+};
+
+// runs a fixed matrix of microbenchmarks and compares their medians with a checked in baseline
+class RegressionClass
+{
+private:
+	typedef void (*BodyType)(void*);
+
+public:
+	RegressionClass() = default;
+	RegressionClass(const RegressionClass&) = default;
+	~RegressionClass() = default;
+	// rule of five
+	RegressionClass& operator=(const RegressionClass&) = default;
+	RegressionClass(RegressionClass&&) = default;
+	RegressionClass& operator=(RegressionClass&&) = default;
+
+	bool Run(const char*, const char*, bool);
+
+private:
+	bool Frustum();
+	bool ModelList();
+	bool Model();
+	bool Targa();
+	bool Text();
+
+	void Measure(const std::string&, const char*, double, BodyType, void*);
+	bool Compare(const char*, const std::vector<RegressionResultType>&);
+
+	static bool WriteResults(const char*, const std::vector<RegressionResultType>&);
+	static bool ReadResults(const char*, std::vector<RegressionResultType>&);
+	static double Median(std::vector<double>);
+	static double GetTime();
+
+private:
+	std::vector<RegressionResultType> m_results;
+};
+
+#endif	// REGRESSIONCLASS_H
\ No newline at end of file
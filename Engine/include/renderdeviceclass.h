@@ -0,0 +1,134 @@
+#ifndef RENDERDEVICECLASS_H
+#define RENDERDEVICECLASS_H
+
+#include <string.h>
+#include <vector>
+
+#include "renderstatsclass.h"
+
+// the kinds of resources a render device creates
+enum RenderResourceType
+{
+	RENDER_RESOURCE_NONE,
+	RENDER_RESOURCE_VERTEX_BUFFER,
+	RENDER_RESOURCE_INDEX_BUFFER,
+	RENDER_RESOURCE_CONSTANT_BUFFER,
+	RENDER_RESOURCE_TEXTURE,
+	RENDER_RESOURCE_VERTEX_SHADER,
+	RENDER_RESOURCE_PIXEL_SHADER
+};
+
+// the operations a render device records in its command log
+enum RenderOperationType
+{
+	RENDER_OPERATION_UPDATE_BUFFER,
+	RENDER_OPERATION_SET_VERTEX_BUFFER,
+	RENDER_OPERATION_SET_INDEX_BUFFER,
+	RENDER_OPERATION_SET_CONSTANT_BUFFER,
+	RENDER_OPERATION_SET_TEXTURE,
+	RENDER_OPERATION_SET_SHADER,
+	RENDER_OPERATION_DRAW_INDEXED,
+	RENDER_OPERATION_CLEAR,
+	RENDER_OPERATION_PRESENT
+};
+
+struct RenderCommandType
+{
+	RenderOperationType operation;
+	int resource;			// handle the command works on, -1 if none
+	int slot;
+	unsigned long long size;	// bytes uploaded, stride or index count
+};
+
+// the device the renderer submits its work to, resources are referred to by handles
+class RenderDeviceClass
+{
+public:
+	RenderDeviceClass() = default;
+	RenderDeviceClass(const RenderDeviceClass&) = default;
+	virtual ~RenderDeviceClass() = default;
+	// rule of five
+	RenderDeviceClass& operator=(const RenderDeviceClass&) = default;
+	RenderDeviceClass(RenderDeviceClass&&) = default;
+	RenderDeviceClass& operator=(RenderDeviceClass&&) = default;
+
+	// vertex, index and constant buffers, the data may be null for a dynamic buffer
+	virtual int CreateBuffer(RenderResourceType, const void*, unsigned long long) = 0;
+	virtual int CreateTexture(int, int, const void*, unsigned long long) = 0;
+	// shaders are created from their byte code
+	virtual int CreateShader(RenderResourceType, const void*, unsigned long long) = 0;
+	virtual void Release(int) = 0;
+
+	// replace the whole content of a buffer like a map with discard
+	virtual bool UpdateBuffer(int, const void*, unsigned long long) = 0;
+
+	virtual void SetVertexBuffer(int, unsigned int) = 0;
+	virtual void SetIndexBuffer(int) = 0;
+	// the slot of the constant buffer in the stage of the given shader type
+	virtual void SetConstantBuffer(RenderResourceType, int, int) = 0;
+	virtual void SetTextures(int, const int*, int) = 0;
+	virtual void SetShader(int) = 0;
+
+	virtual void DrawIndexed(int) = 0;
+	virtual void Clear(float, float, float, float) = 0;
+	virtual void Present() = 0;
+};
+
+// a device without a gpu, uploads are copied into memory like a driver would and every
+//  command is logged, so the cpu side of the renderer can be run and measured anywhere
+class NullRenderDeviceClass : public RenderDeviceClass
+{
+private:
+	struct ResourceType
+	{
+		RenderResourceType type;
+		int width, height;
+		std::vector<unsigned char> data;
+	};
+
+public:
+	NullRenderDeviceClass();
+	NullRenderDeviceClass(const NullRenderDeviceClass&) = delete;
+	~NullRenderDeviceClass() = default;
+	// rule of five
+	NullRenderDeviceClass& operator=(const NullRenderDeviceClass&) = delete;
+	NullRenderDeviceClass(NullRenderDeviceClass&&) = delete;
+	NullRenderDeviceClass& operator=(NullRenderDeviceClass&&) = delete;
+
+	int CreateBuffer(RenderResourceType, const void*, unsigned long long) override;
+	int CreateTexture(int, int, const void*, unsigned long long) override;
+	int CreateShader(RenderResourceType, const void*, unsigned long long) override;
+	void Release(int) override;
+
+	bool UpdateBuffer(int, const void*, unsigned long long) override;
+
+	void SetVertexBuffer(int, unsigned int) override;
+	void SetIndexBuffer(int) override;
+	void SetConstantBuffer(RenderResourceType, int, int) override;
+	void SetTextures(int, const int*, int) override;
+	void SetShader(int) override;
+
+	void DrawIndexed(int) override;
+	void Clear(float, float, float, float) override;
+	void Present() override;
+
+	// the commands of the last presented frame
+	const std::vector<RenderCommandType>& GetCommandLog();
+	unsigned long long GetResourceBytes();
+	int GetResourceCount();
+
+private:
+	int CreateResource(RenderResourceType, int, int, const void*, unsigned long long);
+	bool IsValid(int, RenderResourceType);
+	void Log(RenderOperationType, int, int, unsigned long long);
+
+private:
+	std::vector<ResourceType> m_resources;
+	std::vector<int> m_freeResources;
+	std::vector<RenderCommandType> m_commands;
+	std::vector<RenderCommandType> m_lastCommands;
+	unsigned long long m_resourceBytes;
+	int m_resourceCount;
+};
+
+#endif	// RENDERDEVICECLASS_H
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef RENDERSTATSCLASS_H
+#define RENDERSTATSCLASS_H
+
+#include <string.h>
+#include <atomic>
+#include <fstream>
+#include <algorithm>
+
+//
+// globals
+const bool RENDER_STATS_ENABLED = true;
+const int RENDER_STATS_MAX_COUNTERS = 32;
+const int RENDER_STATS_MAX_THREADS = 16;
+const char* const RENDER_STATS_FILENAME = "render_stats.json";
+
+// the counters every renderer reports, more can be registered by name
+enum RenderCounterType
+{
+	RENDER_COUNTER_DRAWS,
+	RENDER_COUNTER_TRIANGLES,
+	RENDER_COUNTER_MAPS,
+	RENDER_COUNTER_UPLOAD_BYTES,
+	RENDER_COUNTER_SHADER_SWITCHES,
+	RENDER_COUNTER_TEXTURE_BINDS,
+	RENDER_COUNTER_BUFFER_BINDS,
+	RENDER_COUNTER_STATE_CHANGES,
+	RENDER_COUNTER_CLEARS,
+	RENDER_COUNTER_PRESENTS,
+	RENDER_COUNTER_BUILTIN_COUNT
+};
+
+// registry of render counters, every thread adds into its own accumulators without
+//  contention and the accumulators are folded into per frame values once a frame
+class RenderStatsClass
+{
+private:
+	// written only by its own thread, read when the frame ends
+	struct ThreadCountersType
+	{
+		std::atomic<unsigned long long> values[RENDER_STATS_MAX_COUNTERS];
+		const void* shader;		// last vertex shader the thread bound
+	};
+
+public:
+	RenderStatsClass() = delete;
+
+	static int Register(const char*);
+	static int Find(const char*);
+
+	static void Add(int, unsigned long long);
+	static void CountDraw(int);
+	static void CountMap(unsigned long long);
+	static void CountShader(const void*);
+
+	static void EndFrame();
+
+	static int GetCounterCount();
+	static const char* GetName(int);
+	static unsigned long long GetFrameValue(int);
+	static unsigned long long GetPeakValue(int);
+	static unsigned long long GetTotalValue(int);
+	static unsigned long long GetFrameCount();
+
+	static bool WriteJSON(const char*);
+
+private:
+	static ThreadCountersType* GetThreadCounters();
+
+private:
+	static ThreadCountersType s_threads[RENDER_STATS_MAX_THREADS];
+	static std::atomic<int> s_threadCount;
+
+	static const char* s_names[RENDER_STATS_MAX_COUNTERS];
+	static std::atomic<int> s_counterCount;
+
+	// folded values, only touched by the thread that ends the frames
+	static unsigned long long s_totals[RENDER_STATS_MAX_COUNTERS];
+	static unsigned long long s_frames[RENDER_STATS_MAX_COUNTERS];
+	static unsigned long long s_peaks[RENDER_STATS_MAX_COUNTERS];
+	static unsigned long long s_frameCount;
+};
+
+#endif	// RENDERSTATSCLASS_H
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef SCENEGENERATORCLASS_H
+#define SCENEGENERATORCLASS_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "randomclass.h"
+
+// the ways the objects of a generated scene can be laid out
+enum SceneDistributionType
+{
+	SCENE_UNIFORM,			// spread evenly through a cube
+	SCENE_CLUSTERED,		// gaussian clumps at random centers
+	SCENE_GRID,				// a regular cubic lattice
+	SCENE_CITY,				// towers of stacked objects on blocks separated by streets
+	SCENE_DISTRIBUTION_COUNT
+};
+
+//
+// globals
+const char* const SCENE_DISTRIBUTION_NAMES[SCENE_DISTRIBUTION_COUNT] = { "uniform", "clustered", "grid", "city" };
+const int SCENE_MAX_OBJECTS = 100000000;
+const int SCENE_DEFAULT_OBJECTS = 500;
+const unsigned long long SCENE_DEFAULT_SEED = 1;
+const float SCENE_EXTENT = 50.f;			// half the size of the cube the default scene fills
+const int SCENE_CLUSTER_SIZE = 1000;		// objects per cluster on average
+const int SCENE_CITY_BLOCK_LOTS = 8;		// lots along each side of a city block
+const int SCENE_CITY_MAX_FLOORS = 20;
+
+// one object of a scene, 20 bytes on disk and in memory
+struct SceneObjectType
+{
+	float positionX, positionY, positionZ;
+	float radius;
+	unsigned int color;		// rgba, 8 bits each
+};
+
+// names a scene, either generated from a distribution and a seed or loaded from a file
+struct SceneSettingsType
+{
+	SceneDistributionType distribution;
+	int objectCount;
+	unsigned long long seed;
+	std::string filename;		// loaded instead of generated if not empty
+};
+
+class SceneGeneratorClass
+{
+private:
+	struct SceneHeaderType
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int objectCount;
+		unsigned int reserved;
+	};
+
+public:
+	SceneGeneratorClass() = delete;
+
+	static void GetDefaultSettings(SceneSettingsType&);
+	static bool ParseSettings(const char*, SceneSettingsType&);
+	static std::string GetName(const SceneSettingsType&);
+
+	static bool Create(const SceneSettingsType&, std::vector<SceneObjectType>&);
+	static bool Generate(SceneDistributionType, int, unsigned long long, std::vector<SceneObjectType>&);
+
+	static bool Save(const char*, const std::vector<SceneObjectType>&);
+	static bool Load(const char*, std::vector<SceneObjectType>&);
+
+	static void GetColor(const SceneObjectType&, float&, float&, float&, float&);
+
+private:
+	static void GenerateUniform(RandomClass&, float, std::vector<SceneObjectType>&);
+	static void GenerateClustered(RandomClass&, float, std::vector<SceneObjectType>&);
+	static void GenerateGrid(RandomClass&, std::vector<SceneObjectType>&);
+	static void GenerateCity(RandomClass&, std::vector<SceneObjectType>&);
+	static unsigned int RandomColor(RandomClass&);
+};
+
+#endif	// SCENEGENERATORCLASS_H
\ No newline at end of file
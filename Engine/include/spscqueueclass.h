@@ -0,0 +1,69 @@
+#ifndef SPSCQUEUECLASS_H
+#define SPSCQUEUECLASS_H
+
+#include <atomic>
+
+// lock free ring for one producer and one consumer thread, the size has to be a power of two.
+//  each side only writes its own index, so neither ever waits on the other
+template <class T, unsigned int Size>
+class SpscQueueClass
+{
+public:
+	SpscQueueClass() : m_head(0), m_tail(0) {}
+	SpscQueueClass(const SpscQueueClass&) = delete;
+	~SpscQueueClass() = default;
+	// rule of five
+	SpscQueueClass& operator=(const SpscQueueClass&) = delete;
+	SpscQueueClass(SpscQueueClass&&) = delete;
+	SpscQueueClass& operator=(SpscQueueClass&&) = delete;
+
+	// called by the producer, false if the queue is full
+	bool Push(const T& item)
+	{
+		unsigned int tail;
+
+		tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) >= Size)
+		{
+			return false;
+		}
+
+		// the item has to be written before the consumer sees the new tail
+		m_items[tail & (Size - 1)] = item;
+		m_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// called by the consumer, false if the queue is empty
+	bool Pop(T& item)
+	{
+		unsigned int head;
+
+		head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		// the slot may only be reused once the item was read
+		item = m_items[head & (Size - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool IsEmpty()
+	{
+		return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+	}
+
+private:
+	static_assert((Size & (Size - 1)) == 0, "the size of the queue has to be a power of two");
+
+	alignas(64) std::atomic<unsigned int> m_head;		// next item to pop, written by the consumer
+	alignas(64) std::atomic<unsigned int> m_tail;		// next slot to push to, written by the producer
+	T m_items[Size];
+};
+
+#endif	// SPSCQUEUECLASS_H
\ No newline at end of file
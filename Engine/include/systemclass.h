@@ -4,13 +4,26 @@
 #define WIN32_LEAN_AND_MEAN
 
 #include <windows.h>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "inputclass.h"
 #include "graphicsclass.h"
+#include "modellistclass.h"
 #include "fpsclass.h"
 #include "cpuclass.h"
 #include "timerclass.h"
 #include "positionclass.h"
+#include "profilerclass.h"
+#include "jobsystemclass.h"
+#include "framestatsclass.h"
+#include "flythroughclass.h"
+#include "framepipelineclass.h"
+#include "win32platformclass.h"
+#include "frameloopclass.h"
+#include "framelimiterclass.h"
 
 class SystemClass
 {
@@ -19,7 +32,7 @@ public:
 	SystemClass(const SystemClass&);
 	~SystemClass();
 
-	bool Initialize();
+	bool Initialize(FlythroughModeType, const char*, bool);
 	void Shutdown();
 	void Run();
 
@@ -27,8 +40,14 @@ public:
 
 private:
 	bool Frame();
+	bool Simulate();
+	bool Render(FrameStateType*);
+	void SimulationMain();
+	bool ProcessInput(int, XMFLOAT3&, XMFLOAT3&, XMFLOAT3&);
+	void MoveModels(int, float, float, std::vector<ModelMoveType>&);
 	void InitializeWindows(int&, int&);
 	void ShutdownWindows();
+	void WriteFrameStats();
 
 private:
 	LPCWSTR m_applicationName;
@@ -42,6 +61,37 @@ private:
 	CpuClass* m_Cpu;
 	TimerClass* m_Timer;
 	PositionClass* m_Position;
+
+	// the messages are drained and the camera is moved in fixed steps
+	Win32PlatformClass* m_Platform;
+	FrameLoopClass* m_Loop;
+	XMFLOAT3 m_previousPosition, m_previousDirection, m_previousUp;	// the camera one step ago
+
+	// the models as the simulation moves them, the renderer only gets the positions of the moving ones
+	ModelListClass* m_Models;
+	std::vector<EntityChunkType> m_modelChunks;
+	std::vector<int> m_movedModels;
+
+	// the input thread stamps the events, every step takes the ones up to its end
+	InputQueueClass* m_InputQueue;
+
+	// paces the frames without vsync and measures how old the input is when a frame is submitted
+	FrameLimiterClass* m_Limiter;
+	int m_inputLatencyCounter;
+
+	FrameStatsClass* m_FrameStats;			// every frame of the run
+	FrameStatsClass* m_RecentFrameStats;	// the last second, shown on the hud
+	float m_recentTime;
+	int m_hudPage;
+
+	FlythroughClass* m_Flythrough;
+	FlythroughModeType m_flythroughMode;
+	std::string m_flythroughFilename;
+
+	// the simulation thread hands its frames to the render thread through the pipeline
+	FramePipelineClass* m_Pipeline;
+	std::thread m_simulationThread;
+	std::atomic<bool> m_quit, m_failed;
 };
 
 static LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);
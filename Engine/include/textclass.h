@@ -3,6 +3,23 @@
 
 #include "fontclass.h"
 #include "fontshaderclass.h"
+#include "framestatsclass.h"
+#include "renderstatsclass.h"
+#include "framearenaclass.h"
+#include "memoryclass.h"
+#include "memorypoolclass.h"
+
+//
+// globals
+const int TEXT_SENTENCE_COUNT = 5;
+
+// what the last line of the hud shows, F3 goes to the next page
+enum HudPageType
+{
+	HUD_PAGE_RENDER,
+	HUD_PAGE_MEMORY,
+	HUD_PAGE_COUNT
+};
 
 class TextClass
 {
@@ -29,7 +46,7 @@ public:
 	TextClass(TextClass&&) = default;
 	TextClass& operator=(TextClass&&) = default;
 
-	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, HWND, int, int, XMMATRIX);
+	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, PackFileClass*, AssetCacheClass*, HWND, int, int, XMMATRIX);
 	void Shutdown();
 	bool Render(ID3D11DeviceContext*, XMMATRIX, XMMATRIX);
 
@@ -40,6 +57,9 @@ public:
 
 	bool SetFps(int, ID3D11DeviceContext*);
 	bool SetCpu(int, ID3D11DeviceContext*);
+	bool SetFrameStats(float, float, float, float, float, unsigned long long, ID3D11DeviceContext*);
+	bool SetRenderStats(ID3D11DeviceContext*);
+	bool SetMemoryStats(ID3D11DeviceContext*);
 
 private:
 	bool InitializeSentence(SentenceType**, int, ID3D11Device*);
@@ -50,12 +70,15 @@ private:
 private:
 	FontClass* m_Font;
 	FontShaderClass* m_FontShader;
+	MemoryPoolClass* m_SentencePool;
 	int m_screenWidth, m_screenHeight;
 	XMMATRIX m_baseViewMatrix;
 
 	SentenceType* m_sentence1;
 	SentenceType* m_sentence2;
 	SentenceType* m_sentence3;
+	SentenceType* m_sentence4;
+	SentenceType* m_sentence5;
 };
 
 #endif	// TEXTCLASS_H_
\ No newline at end of file
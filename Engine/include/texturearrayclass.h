@@ -2,6 +2,18 @@
 #define TEXTUREARRAYCLASS_H
 
 #include <d3d11.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+
+#include "packfileclass.h"
+#include "texturestreamerclass.h"
+
+//
+// globals
+const int TEXTURE_ARRAY_SIZE = 5;
+const int TEXTURE_STREAMING_SIZE = 64;		// size of the mips that are loaded before streaming kicks in
+const int TEXTURE_DDS_HEADER_SIZE = 148;	// magic number, header and dx10 header
 
 class TextureArrayClass
 {
@@ -14,13 +26,26 @@ public:
 	TextureArrayClass(TextureArrayClass&&) = default;
 	TextureArrayClass& operator=(TextureArrayClass&&) = default;
 
-	bool Initialize(ID3D11Device*, WCHAR*, WCHAR*, WCHAR*, WCHAR*, WCHAR*);
+	bool Initialize(ID3D11Device*, PackFileClass*, WCHAR*, WCHAR*, WCHAR*, WCHAR*, WCHAR*);
 	void Shutdown();
 
+	ID3D11ShaderResourceView* SwapTexture(int, ID3D11ShaderResourceView*, bool);
+
 	ID3D11ShaderResourceView** GetTextureArray();
+	const char* GetFilename(int);
+	bool IsLoose(int);
+
+	static bool ReadTexture(PackFileClass*, const char*, bool, int, AssetDataType&);
+	static bool CreateTexture(ID3D11Device*, const AssetDataType&, int, ID3D11ShaderResourceView**);
+
+private:
+	bool LoadTexture(ID3D11Device*, int, int);
 
 private:
-	ID3D11ShaderResourceView* m_textures[5];
+	ID3D11ShaderResourceView* m_textures[TEXTURE_ARRAY_SIZE];
+	std::string m_filenames[TEXTURE_ARRAY_SIZE];
+	bool m_loose[TEXTURE_ARRAY_SIZE];		// reloaded from the loose file since the pack was built
+	PackFileClass* m_Pack;
 };
 
 #endif	// TEXTUREARRAYCLASS_H
\ No newline at end of file
@@ -4,8 +4,19 @@
 #include <d3d11.h>
 #include <stdio.h>
 
+#include "packfileclass.h"
+#include "assetcacheclass.h"
+#include "renderstatsclass.h"
+
+//
+// globals
+const unsigned int TARGA_IMPORTER_VERSION = 1;		// bump whenever the decoded targa data changes
+
 class TextureClass
 {
+	// the regression suite times the loaders without a device
+	friend class RegressionClass;
+
 private:
 	// targa file header structure
 	struct TargaHeader
@@ -26,14 +37,14 @@ public:
 	TextureClass(TextureClass&&) = default;
 	TextureClass& operator=(TextureClass&&) = default;
 
-	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, char*);
-	bool InitializeDDS(ID3D11Device*, ID3D11DeviceContext*, char*);
+	bool Initialize(ID3D11Device*, ID3D11DeviceContext*, PackFileClass*, AssetCacheClass*, char*);
+	bool InitializeDDS(ID3D11Device*, ID3D11DeviceContext*, PackFileClass*, char*);
 	void Shutdown();
 
 	ID3D11ShaderResourceView* GetTexture();
 
 private:
-	bool LoadTarga(char*, int&, int&);
+	bool LoadTarga(PackFileClass*, AssetCacheClass*, char*, int&, int&);
 
 private:
 	unsigned char* m_targaData;
@@ -0,0 +1,63 @@
+#ifndef TEXTURELOADERCLASS_H
+#define TEXTURELOADERCLASS_H
+
+#include <d3d11.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "packfileclass.h"
+
+// reads and creates the streamed mips of the textures on its own thread, the finished textures
+//  are taken by the render thread at a frame boundary
+class TextureLoaderClass
+{
+private:
+	struct SlotType
+	{
+		std::string filename;				// request that waits for the loader thread
+		bool loose;
+		int maxSize;
+		unsigned int generation;
+		bool requested;
+
+		bool finished;						// finished load that waits for the render thread
+		ID3D11ShaderResourceView* texture;	// nullptr if the load failed
+		int textureSize;
+		unsigned int textureGeneration;
+	};
+
+public:
+	TextureLoaderClass();
+	TextureLoaderClass(const TextureLoaderClass&) = delete;
+	~TextureLoaderClass();
+	// rule of five
+	TextureLoaderClass& operator=(const TextureLoaderClass&) = delete;
+	TextureLoaderClass(TextureLoaderClass&&) = delete;
+	TextureLoaderClass& operator=(TextureLoaderClass&&) = delete;
+
+	bool Initialize(ID3D11Device*, PackFileClass*, int);
+	void Shutdown();
+
+	bool Request(int, const char*, bool, int, unsigned int);
+	bool TakeFinished(int, ID3D11ShaderResourceView*&, int&, unsigned int&);
+
+	int GetFailCount();
+
+private:
+	void Run();
+
+private:
+	ID3D11Device* m_device;
+	PackFileClass* m_Pack;
+	std::vector<SlotType> m_slots;
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	bool m_quit;
+	int m_nextSlot, m_failCount;
+};
+
+#endif	// TEXTURELOADERCLASS_H
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef TEXTURESTREAMERCLASS_H
+#define TEXTURESTREAMERCLASS_H
+
+#include <math.h>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+
+//
+// globals
+const int STREAMER_MAX_MIPS = 16;
+const int STREAMER_UNKNOWN_BITS = 32;		// bits per pixel assumed for the budget of an unknown format
+
+class TextureStreamerClass
+{
+public:
+	// called to make 'topMip' the most detailed resident mip of a texture, both
+	//  when streaming detail in and when evicting it again
+	typedef bool (*LoadCallback)(void*, int, int);
+
+private:
+	struct TextureInfoType
+	{
+		int width, height, mipCount;
+		int bitsPerPixel, blockBytes;		// blockBytes is 0 for uncompressed formats
+		int residentMip, requestedMip;
+		float priority;						// screen coverage of the biggest request this frame
+		unsigned long lastNeeded[STREAMER_MAX_MIPS];
+	};
+
+public:
+	TextureStreamerClass();
+	TextureStreamerClass(const TextureStreamerClass&) = default;
+	~TextureStreamerClass() = default;
+	// rule of five
+	TextureStreamerClass& operator=(const TextureStreamerClass&) = default;
+	TextureStreamerClass(TextureStreamerClass&&) = default;
+	TextureStreamerClass& operator=(TextureStreamerClass&&) = default;
+
+	bool Initialize(unsigned long long, int, float, LoadCallback, void*);
+	void Shutdown();
+
+	int RegisterTexture(int, int, int, int, int, int);
+	int RegisterFile(const char*, int);
+	int RegisterDDS(const unsigned char*, unsigned long long, int);
+
+	void BeginFrame();
+	void RequestSphere(int, float, float);
+	void RequestMip(int, int);
+	int Update(int);
+	void FailLoad(int, int);
+
+	int GetRequiredMip(int, float, float);
+	int GetResidentMip(int);
+	int GetMipSize(int, int);
+	int GetTextureCount();
+	unsigned long long GetResidentBytes();
+	unsigned long long GetBudget();
+	int GetLoadCount();
+	int GetEvictCount();
+	int GetFailCount();
+
+	// bitsPerPixel and blockBytes are both 0 if the format is unknown
+	static bool ReadDDSInfo(const unsigned char*, unsigned long long, int&, int&, int&, int&, int&);
+	static unsigned long long GetMipBytes(int, int, int, int, int);
+	static int GetTopMip(int, int, int, int);
+
+private:
+	static int GetFormatBits(unsigned int);
+	unsigned long long CalculateMipBytes(const TextureInfoType&, int);
+	unsigned long long CalculateResidentBytes(const TextureInfoType&, int);
+	void Request(int, int, float);
+	bool EvictFor(unsigned long long, int);
+	bool SetResidentMip(int, int);
+
+private:
+	std::vector<TextureInfoType> m_textures;
+	std::vector<int> m_loadQueue;
+
+	LoadCallback m_loadCallback;
+	void* m_userData;
+
+	unsigned long long m_budget, m_residentBytes;
+	unsigned long m_frame;
+	float m_pixelScale;					// screen height / (2 * tan(fov / 2))
+	int m_loadCount, m_evictCount, m_failCount;
+};
+
+#endif	// TEXTURESTREAMERCLASS_H
\ No newline at end of file
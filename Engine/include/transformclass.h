@@ -0,0 +1,82 @@
+#ifndef TRANSFORMCLASS_H
+#define TRANSFORMCLASS_H
+
+#include <vector>
+#include <algorithm>
+#include <DirectXMath.h>
+using namespace DirectX;
+
+#include "jobsystemclass.h"
+#include "profilerclass.h"
+
+//
+// globals
+const int TRANSFORM_PARALLEL_NODES = 16384;		// fewer dirty nodes are updated on the calling thread alone
+const int TRANSFORM_RANGE_GRAIN = 16;			// dirty subtrees an update job takes at least
+
+// hierarchy of local translation, rotation and scale transforms and the world matrices they make
+//  up. the nodes are kept in depth first order, so every parent comes before its children and
+//  the subtree of a node is the range up to its subtree end. moving a node marks it dirty, the
+//  update recomputes the ranges of the dirty nodes and never looks at the clean subtrees. the
+//  ids of the nodes stay the same when the order is built again after a node was added
+class TransformClass
+{
+private:
+	struct RangeType
+	{
+		int begin, end;
+	};
+
+public:
+	TransformClass();
+	TransformClass(const TransformClass&) = delete;
+	~TransformClass() = default;
+	// rule of five
+	TransformClass& operator=(const TransformClass&) = delete;
+	TransformClass(TransformClass&&) = delete;
+	TransformClass& operator=(TransformClass&&) = delete;
+
+	bool Initialize(int);
+	void Shutdown();
+
+	// a node at the origin, -1 for no parent
+	int AddNode(int);
+
+	void SetLocal(int, XMFLOAT3, XMFLOAT4, XMFLOAT3);
+	void SetTranslation(int, XMFLOAT3);
+	int GetParent(int);
+
+	void Update();
+	void GetWorldMatrix(int, XMMATRIX&);
+
+	int GetNodeCount();
+	int GetUpdatedCount();
+
+private:
+	void MarkDirty(int);
+	void Sort();
+	void UpdateRange(int, int);
+
+	static void UpdateJob(void*, int, int);
+
+private:
+	// by node id
+	std::vector<int> m_orders;
+
+	// in depth first order
+	std::vector<int> m_ids;
+	std::vector<int> m_parents;
+	std::vector<int> m_subtreeEnds;
+	std::vector<XMFLOAT3> m_translations;
+	std::vector<XMFLOAT4> m_rotations;
+	std::vector<XMFLOAT3> m_scales;
+	std::vector<XMFLOAT4X4> m_worlds;
+	std::vector<unsigned char> m_dirty;
+
+	std::vector<int> m_dirtyNodes;
+	std::vector<RangeType> m_ranges;
+	int m_updatedCount;
+	bool m_sorted;
+};
+
+#endif	// TRANSFORMCLASS_H
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef VISIBILITYCLASS_H
+#define VISIBILITYCLASS_H
+
+#include <string.h>
+#include <atomic>
+#include <vector>
+#include <DirectXMath.h>
+using namespace DirectX;
+
+#include "frustumclass.h"
+#include "modellistclass.h"
+#include "profilerclass.h"
+#include "jobsystemclass.h"
+
+//
+// globals
+const int VISIBILITY_PARALLEL_MODELS = 4096;	// fewer models are culled on the calling thread alone
+const int VISIBILITY_MOVED_FRACTION = 16;		// more than one in this many models moved and all of them are culled again
+const unsigned int VISIBILITY_COMPONENTS =
+	(1u << COMPONENT_POSITION) | (1u << COMPONENT_RADIUS) | (1u << COMPONENT_FLAGS) | (1u << COMPONENT_MODEL);
+
+// keeps the models of the model list that the camera can see. the visible set of the last frame
+//  is kept as long as the camera and the scene do not change, models that moved are tested alone.
+//  a full cull goes over the entity chunks with a bounding sphere, a job for every chunk
+class VisibilityClass
+{
+public:
+	VisibilityClass();
+	VisibilityClass(const VisibilityClass&) = delete;
+	~VisibilityClass() = default;
+	// rule of five
+	VisibilityClass& operator=(const VisibilityClass&) = delete;
+	VisibilityClass(VisibilityClass&&) = delete;
+	VisibilityClass& operator=(VisibilityClass&&) = delete;
+
+	bool Initialize(ModelListClass*);
+	void Shutdown();
+
+	void Cull(float, XMMATRIX, XMMATRIX);
+
+	int GetVisibleCount();
+	int GetVisibleModel(int);
+	const int* GetVisibleModels();
+	unsigned long long GetPlaneTestCount();
+	bool IsReused();
+
+	void SetCoherent(bool);
+	void SetCaching(bool);
+
+private:
+	void CullAll();
+	void CullMoved();
+	bool CheckModel(FrustumClass&, int);
+	void CullChunk(FrustumClass&, const EntityChunkType&);
+
+	static void CullJob(void*, int, int);
+
+private:
+	ModelListClass* m_ModelList;
+	FrustumClass* m_Frustum;
+
+	std::vector<int> m_visibleModels;
+	std::vector<unsigned char> m_visible;			// per model, whether it is in the visible set
+	std::vector<FrustumCacheType> m_cullCache;		// per model, what culling found last frame
+	std::vector<int> m_movedModels;
+	std::vector<EntityChunkType> m_chunks;
+	std::atomic<unsigned long long> m_jobPlaneTests;	// plane tests of the culling jobs, they test on copies of the frustum
+
+	// what the visible set was culled with
+	XMFLOAT4X4 m_viewMatrix, m_projectionMatrix;
+	float m_screenDepth;
+	unsigned int m_sceneVersion;
+	bool m_valid, m_reused;
+
+	bool m_coherent, m_caching;
+};
+
+#endif	// VISIBILITYCLASS_H
\ No newline at end of file
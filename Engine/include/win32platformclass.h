@@ -0,0 +1,36 @@
+#ifndef WIN32PLATFORMCLASS_H
+#define WIN32PLATFORMCLASS_H
+
+#pragma comment(lib, "winmm.lib")
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <timeapi.h>
+
+#include "platformclass.h"
+
+// the windows message queue of the calling thread and the performance counter
+class Win32PlatformClass : public PlatformClass
+{
+public:
+	Win32PlatformClass();
+	Win32PlatformClass(const Win32PlatformClass&) = delete;
+	~Win32PlatformClass() = default;
+	// rule of five
+	Win32PlatformClass& operator=(const Win32PlatformClass&) = delete;
+	Win32PlatformClass(Win32PlatformClass&&) = delete;
+	Win32PlatformClass& operator=(Win32PlatformClass&&) = delete;
+
+	bool Initialize();
+	void Shutdown();
+
+	bool PollEvent(PlatformEventType&) override;
+	double GetTime() override;
+	void SleepFor(double) override;
+
+private:
+	double m_ticksPerMs;
+	bool m_timerPeriod;		// the scheduler ticks every millisecond while it is set
+};
+
+#endif	// WIN32PLATFORMCLASS_H
\ No newline at end of file
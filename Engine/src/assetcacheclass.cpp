@@ -0,0 +1,212 @@
+#include "assetcacheclass.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+// pre-processing directives
+#define BLOB_MAGIC 0x424F4C42		// "BLOB"
+#define BLOB_VERSION 1
+
+AssetCacheClass::AssetCacheClass()
+	: m_hitCount(0), m_missCount(0), m_storeCount(0)
+{
+}
+
+bool AssetCacheClass::Initialize(const char* directory)
+{
+	m_directory = directory;
+	if (!m_directory.empty() && m_directory.back() != '/' && m_directory.back() != '\\')
+	{
+		m_directory += '/';
+	}
+
+	m_hitCount = 0;
+	m_missCount = 0;
+	m_storeCount = 0;
+
+	// create the cache directory, it is fine if it exists already
+#ifdef _WIN32
+	if (!CreateDirectoryA(m_directory.c_str(), NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+	{
+		return false;
+	}
+#else
+	struct stat info;
+	if (mkdir(m_directory.c_str(), 0755) != 0 && (stat(m_directory.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)))
+	{
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+void AssetCacheClass::Shutdown()
+{
+	m_directory.clear();
+
+	return;
+}
+
+unsigned long long AssetCacheClass::MakeKey(const AssetDataType& source, const char* importer,
+	unsigned int importerVersion, const void* settings, int settingsSize)
+{
+	unsigned long long key;
+
+	// chain the hashes so a change in any of the parts gives a different key
+	key = Hash(importer, strlen(importer), 0);
+	key = Hash(&importerVersion, sizeof(importerVersion), key);
+	key = Hash(settings, settingsSize, key);
+	key = Hash(source.data, source.size, key);
+
+	return key;
+}
+
+bool AssetCacheClass::Load(unsigned long long key, std::vector<unsigned char>& blob)
+{
+	std::ifstream fin;
+	BlobHeaderType header;
+
+	// a missing, stale or broken blob is a miss and the asset has to be imported
+	fin.open(GetBlobFilename(key).c_str(), std::ios::in | std::ios::binary);
+	if (fin.fail())
+	{
+		m_missCount++;
+		return false;
+	}
+
+	fin.read((char*)&header, sizeof(header));
+	if (fin.gcount() != sizeof(header) || header.magic != BLOB_MAGIC || header.version != BLOB_VERSION || header.key != key)
+	{
+		m_missCount++;
+		return false;
+	}
+
+	blob.resize((size_t)header.size);
+	fin.read((char*)blob.data(), (std::streamsize)header.size);
+	if ((unsigned long long)fin.gcount() != header.size || Hash(blob.data(), blob.size(), key) != header.hash)
+	{
+		blob.clear();
+		m_missCount++;
+		return false;
+	}
+
+	m_hitCount++;
+
+	return true;
+}
+
+bool AssetCacheClass::Store(unsigned long long key, const void* data, unsigned long long size)
+{
+	std::ofstream fout;
+	std::string filename, temporary;
+	BlobHeaderType header;
+
+	filename = GetBlobFilename(key);
+	temporary = filename + ".tmp";
+
+	header.magic = BLOB_MAGIC;
+	header.version = BLOB_VERSION;
+	header.key = key;
+	header.size = size;
+	header.hash = Hash(data, size, key);
+
+	// write to a temporary file first so a crash never leaves a half written blob behind
+	fout.open(temporary.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	fout.write((const char*)&header, sizeof(header));
+	fout.write((const char*)data, (std::streamsize)size);
+	fout.close();
+	if (fout.fail())
+	{
+		remove(temporary.c_str());
+		return false;
+	}
+
+	// then move it into place
+#ifdef _WIN32
+	if (!MoveFileExA(temporary.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING))
+#else
+	if (rename(temporary.c_str(), filename.c_str()) != 0)
+#endif
+	{
+		remove(temporary.c_str());
+		return false;
+	}
+
+	m_storeCount++;
+
+	return true;
+}
+
+int AssetCacheClass::GetHitCount()
+{
+	return m_hitCount;
+}
+
+int AssetCacheClass::GetMissCount()
+{
+	return m_missCount;
+}
+
+int AssetCacheClass::GetStoreCount()
+{
+	return m_storeCount;
+}
+
+unsigned long long AssetCacheClass::Hash(const void* data, unsigned long long size, unsigned long long seed)
+{
+	const unsigned long long m = 0xC6A4A7935BD1E995ull;
+	const unsigned char* bytes;
+	unsigned long long hash, k;
+
+	// 64 bit murmur hash, eight bytes at a time
+	bytes = (const unsigned char*)data;
+	hash = seed ^ (size * m);
+
+	for (; size >= 8; size -= 8, bytes += 8)
+	{
+		memcpy(&k, bytes, sizeof(k));
+
+		k *= m;
+		k ^= k >> 47;
+		k *= m;
+
+		hash ^= k;
+		hash *= m;
+	}
+
+	// mix in the remaining bytes
+	if (size > 0)
+	{
+		for (int i = (int)size - 1; i >= 0; i--)
+		{
+			hash ^= (unsigned long long)bytes[i] << (8 * i);
+		}
+		hash *= m;
+	}
+
+	hash ^= hash >> 47;
+	hash *= m;
+	hash ^= hash >> 47;
+
+	return hash;
+}
+
+std::string AssetCacheClass::GetBlobFilename(unsigned long long key)
+{
+	char name[32];
+
+	// blobs are named by their key
+	snprintf(name, sizeof(name), "%016llx.bin", key);
+
+	return m_directory + name;
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "assetwatcherclass.h"
+
+AssetWatcherClass::AssetWatcherClass()
+	: m_FileSystem(nullptr), m_quit(false), m_reloadCount(0), m_failCount(0), m_pollTime(ASSET_WATCHER_POLL_TIME)
+{
+}
+
+AssetWatcherClass::~AssetWatcherClass()
+{
+	Shutdown();
+}
+
+bool AssetWatcherClass::Initialize(FileSystemClass* fileSystem, int pollTime)
+{
+	if (!fileSystem || pollTime <= 0)
+	{
+		return false;
+	}
+
+	m_FileSystem = fileSystem;
+	m_pollTime = pollTime;
+	m_quit = false;
+	m_reloadCount = 0;
+	m_failCount = 0;
+
+	return true;
+}
+
+void AssetWatcherClass::Shutdown()
+{
+	void* resource;
+
+	// stop the watcher thread
+	if (m_thread.joinable())
+	{
+		m_quit = true;
+		m_FileSystem->Wake();
+		m_thread.join();
+	}
+
+	// release the resources that never made it to a frame boundary
+	for (size_t i = 0; i < m_watches.size(); i++)
+	{
+		resource = m_watches[i]->pending.exchange(nullptr);
+		if (resource)
+		{
+			m_watches[i]->release(m_watches[i]->context, (int)i, resource);
+		}
+		delete m_watches[i];
+	}
+	m_watches.clear();
+
+	return;
+}
+
+int AssetWatcherClass::Register(const char* filename, ImportCallback import, SwapCallback swap, ReleaseCallback release, void* context)
+{
+	WatchType* watch;
+
+	// the list is fixed once the thread runs, so it can be read without a lock
+	if (m_thread.joinable() || !m_FileSystem || !import || !swap || !release)
+	{
+		return -1;
+	}
+
+	watch = new WatchType;
+	if (!watch)
+	{
+		return -1;
+	}
+
+	watch->filename = filename;
+	watch->stamp = 0;
+	watch->import = import;
+	watch->swap = swap;
+	watch->release = release;
+	watch->context = context;
+	watch->pending = nullptr;
+
+	// the version that is loaded right now is the one on disk
+	if (!m_FileSystem->GetStamp(filename, watch->stamp))
+	{
+		watch->stamp = 0;
+	}
+	watch->seenStamp = watch->stamp;
+
+	m_FileSystem->Watch(filename);
+	m_watches.push_back(watch);
+
+	return (int)m_watches.size() - 1;
+}
+
+bool AssetWatcherClass::Start()
+{
+	if (!m_FileSystem || m_thread.joinable())
+	{
+		return false;
+	}
+
+	m_quit = false;
+	m_thread = std::thread(&AssetWatcherClass::Run, this);
+
+	return true;
+}
+
+void AssetWatcherClass::ApplyChanges()
+{
+	void* resource;
+
+	// take every finished resource, a single exchange per file and no lock
+	for (size_t i = 0; i < m_watches.size(); i++)
+	{
+		resource = m_watches[i]->pending.exchange(nullptr, std::memory_order_acquire);
+		if (resource)
+		{
+			m_watches[i]->swap(m_watches[i]->context, (int)i, resource);
+		}
+	}
+
+	return;
+}
+
+int AssetWatcherClass::GetReloadCount()
+{
+	return m_reloadCount;
+}
+
+int AssetWatcherClass::GetFailCount()
+{
+	return m_failCount;
+}
+
+void AssetWatcherClass::Run()
+{
+	WatchType* watch;
+	AssetDataType asset;
+	unsigned long long stamp;
+	void* resource;
+	void* replaced;
+
+	while (!m_quit)
+	{
+		m_FileSystem->Wait(m_pollTime);
+
+		for (size_t i = 0; i < m_watches.size() && !m_quit; i++)
+		{
+			watch = m_watches[i];
+
+			// skip files that are missing or did not change
+			if (!m_FileSystem->GetStamp(watch->filename.c_str(), stamp) || stamp == watch->stamp)
+			{
+				continue;
+			}
+
+			// wait until the file stopped changing, editors often write in several steps
+			if (stamp != watch->seenStamp)
+			{
+				watch->seenStamp = stamp;
+				continue;
+			}
+			watch->stamp = stamp;
+
+			// import the new version, a broken file keeps the old resource in use
+			resource = nullptr;
+			if (m_FileSystem->Read(watch->filename.c_str(), asset))
+			{
+				resource = watch->import(watch->context, (int)i, asset);
+			}
+			if (!resource)
+			{
+				m_failCount++;
+				continue;
+			}
+
+			// publish the complete resource, it replaces one the render thread has not picked up yet
+			replaced = watch->pending.exchange(resource, std::memory_order_acq_rel);
+			if (replaced)
+			{
+				watch->release(watch->context, (int)i, replaced);
+			}
+			m_reloadCount++;
+		}
+	}
+
+	return;
+}
\ No newline at end of file
@@ -0,0 +1,2918 @@
+#include "benchmarkclass.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#else
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+BenchmarkClass::BenchmarkClass()
+{
+	SceneGeneratorClass::GetDefaultSettings(m_scene);
+	m_sceneName = SceneGeneratorClass::GetName(m_scene);
+}
+
+bool BenchmarkClass::Run(const char* name, const char* scene, const char* outputFilename)
+{
+	std::ofstream fout;
+	bool result;
+
+	// the scene the benchmark runs on, the default one if none is named
+	SceneGeneratorClass::GetDefaultSettings(m_scene);
+	if (!scene && strcmp(name, "jobs") == 0)
+	{
+		scene = BENCHMARK_JOBS_SCENE;
+	}
+	else if (!scene && strcmp(name, "pipeline") == 0)
+	{
+		scene = BENCHMARK_PIPELINE_SCENE;
+	}
+	if (scene && !SceneGeneratorClass::ParseSettings(scene, m_scene))
+	{
+		return false;
+	}
+	m_sceneName = SceneGeneratorClass::GetName(m_scene);
+
+	// open the file the results are written to
+	fout.open(outputFilename, std::ios::out | std::ios::app);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// the benchmarks run with the workers of the job system like the engine does
+	if (!JobSystemClass::Initialize(0))
+	{
+		return false;
+	}
+
+	// run the benchmark with the given name
+	if (strcmp(name, "coldstart") == 0)
+	{
+		result = ColdStart(fout);
+	}
+	else if (strcmp(name, "compression") == 0)
+	{
+		result = Compression(fout);
+	}
+	else if (strcmp(name, "hotreload") == 0)
+	{
+		result = HotReload(fout);
+	}
+	else if (strcmp(name, "profiler") == 0)
+	{
+		result = Profiler(fout);
+	}
+	else if (strcmp(name, "headless") == 0)
+	{
+		result = Headless(fout);
+	}
+	else if (strcmp(name, "flythrough") == 0)
+	{
+		result = Flythrough(fout);
+	}
+	else if (strcmp(name, "frustum") == 0)
+	{
+		result = Frustum(fout);
+	}
+	else if (strcmp(name, "idle") == 0)
+	{
+		result = Idle(fout);
+	}
+	else if (strcmp(name, "jobs") == 0)
+	{
+		result = Jobs(fout);
+	}
+	else if (strcmp(name, "pipeline") == 0)
+	{
+		result = Pipeline(fout);
+	}
+	else if (strcmp(name, "frameloop") == 0)
+	{
+		result = FrameLoop(fout);
+	}
+	else if (strcmp(name, "limiter") == 0)
+	{
+		result = Limiter(fout);
+	}
+	else if (strcmp(name, "input") == 0)
+	{
+		result = Input(fout);
+	}
+	else if (strcmp(name, "arena") == 0)
+	{
+		result = Arena(fout);
+	}
+	else if (strcmp(name, "memory") == 0)
+	{
+		result = Memory(fout);
+	}
+	else if (strcmp(name, "handles") == 0)
+	{
+		result = Handles(fout);
+	}
+	else if (strcmp(name, "entities") == 0)
+	{
+		result = Entities(fout);
+	}
+	else if (strcmp(name, "transforms") == 0)
+	{
+		result = Transforms(fout);
+	}
+	else if (strcmp(name, "streaming") == 0)
+	{
+		result = Streaming(fout);
+	}
+	else
+	{
+		result = false;
+	}
+
+	JobSystemClass::Shutdown();
+	fout.close();
+
+	return result;
+}
+
+bool BenchmarkClass::ColdStart(std::ofstream& fout)
+{
+	std::vector<double> looseTimes, packTimes;
+	AssetDataType asset;
+	PackFileClass pack;
+	unsigned int checksum;
+	double start;
+
+	// build the pack from the loose files if there is none yet
+	if (!pack.Open(PACK_ENGINE_FILENAME))
+	{
+		if (!PackFileClass::Build(PACK_ENGINE_FILENAME, PACK_ENGINE_FILES, PACK_ENGINE_FILE_COUNT, true))
+		{
+			return false;
+		}
+	}
+	pack.Close();
+
+	checksum = 0;
+	for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+	{
+		// time opening and reading every loose file on its own
+		for (int i = 0; i < PACK_ENGINE_FILE_COUNT; i++)
+		{
+			DropFileCache(PACK_ENGINE_FILES[i]);
+		}
+
+		start = GetTime();
+		for (int i = 0; i < PACK_ENGINE_FILE_COUNT; i++)
+		{
+			if (!PackFileClass::ReadLooseFile(PACK_ENGINE_FILES[i], asset))
+			{
+				return false;
+			}
+			checksum += asset.data[asset.size / 2];
+		}
+		looseTimes.push_back((GetTime() - start) * 1000.0);
+
+		// time mapping the pack and touching every asset in it
+		DropFileCache(PACK_ENGINE_FILENAME);
+
+		start = GetTime();
+		if (!pack.Open(PACK_ENGINE_FILENAME))
+		{
+			return false;
+		}
+		for (int i = 0; i < PACK_ENGINE_FILE_COUNT; i++)
+		{
+			if (!pack.Read(PACK_ENGINE_FILES[i], asset))
+			{
+				return false;
+			}
+
+			// touch every page so the mapping is actually read in
+			for (unsigned long long j = 0; j < asset.size; j += PACK_ALIGNMENT)
+			{
+				checksum += asset.data[j];
+			}
+		}
+		pack.Close();
+		packTimes.push_back((GetTime() - start) * 1000.0);
+	}
+
+	WriteResult(fout, "coldstart", "loose", "ms", looseTimes);
+	WriteResult(fout, "coldstart", "pack", "ms", packTimes);
+
+	// keep the reads from being optimized away
+	return checksum != 0xFFFFFFFF;
+}
+
+bool BenchmarkClass::Compression(std::ofstream& fout)
+{
+	std::vector<unsigned char> source, compressed, output;
+	std::vector<double> times[2];
+	std::vector<double> ratio, rawTimes, compressedTimes;
+	AssetDataType asset;
+	int threadCounts[2];
+	double start;
+	char variant[64];
+
+	// concatenate all the engine assets, that is the data a compressed pack holds
+	for (int i = 0; i < PACK_ENGINE_FILE_COUNT; i++)
+	{
+		if (!PackFileClass::ReadLooseFile(PACK_ENGINE_FILES[i], asset))
+		{
+			return false;
+		}
+		source.insert(source.end(), asset.data, asset.data + asset.size);
+	}
+
+	if (!CompressionClass::Compress(source.data(), source.size(), compressed))
+	{
+		return false;
+	}
+	output.resize(source.size());
+
+	// decompression throughput on a single thread and on all the worker threads
+	threadCounts[0] = 1;
+	threadCounts[1] = CompressionClass::GetThreadCount();
+	for (int i = 0; i < 2; i++)
+	{
+		for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+		{
+			start = GetTime();
+			if (!CompressionClass::Decompress(compressed.data(), compressed.size(), output.data(), output.size(), threadCounts[i]))
+			{
+				return false;
+			}
+			times[i].push_back(source.size() / (1024.0 * 1024.0) / (GetTime() - start));
+		}
+
+		snprintf(variant, sizeof(variant), "decompress_%d_threads", threadCounts[i]);
+		WriteResult(fout, "compression", variant, "MB/s", times[i]);
+	}
+
+	if (memcmp(source.data(), output.data(), source.size()) != 0)
+	{
+		return false;
+	}
+
+	// ratio of the compressed to the raw size
+	ratio.push_back((double)compressed.size() / (double)source.size());
+	WriteResult(fout, "compression", "ratio", "fraction", ratio);
+
+	// load time off a throttled disk, compressed assets read less but have to be decompressed afterwards
+	for (int i = 0; i < BENCHMARK_DISK_COUNT; i++)
+	{
+		rawTimes.clear();
+		compressedTimes.clear();
+		for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+		{
+			start = GetTime();
+			ReadThrottled(source.size(), BENCHMARK_DISK_BANDWIDTHS[i]);
+			rawTimes.push_back((GetTime() - start) * 1000.0);
+
+			start = GetTime();
+			ReadThrottled(compressed.size(), BENCHMARK_DISK_BANDWIDTHS[i]);
+			CompressionClass::Decompress(compressed.data(), compressed.size(), output.data(), output.size(), threadCounts[1]);
+			compressedTimes.push_back((GetTime() - start) * 1000.0);
+		}
+
+		snprintf(variant, sizeof(variant), "raw_%.0fMBs", BENCHMARK_DISK_BANDWIDTHS[i]);
+		WriteResult(fout, "compression", variant, "ms", rawTimes);
+		snprintf(variant, sizeof(variant), "compressed_%.0fMBs", BENCHMARK_DISK_BANDWIDTHS[i]);
+		WriteResult(fout, "compression", variant, "ms", compressedTimes);
+	}
+
+	// keep the decompression from being optimized away
+	return output[output.size() / 2] == source[source.size() / 2];
+}
+
+bool BenchmarkClass::HotReload(std::ofstream& fout)
+{
+	const char* filename = "./data/hotreload.bin";
+	const int fileSize = 256 * 1024;
+	const int applyCount = 100000;
+	MemoryFileSystemClass fileSystem;
+	AssetWatcherClass watcher;
+	std::vector<unsigned char> file, * live;
+	std::vector<double> latencies, applyTimes, tornCounts, backwardCounts;
+	std::thread writer;
+	double start;
+	unsigned char version, seen;
+	int torn, backward;
+	bool timedOut;
+
+	// a blob that was handed over before it was imported whole has bytes of two versions, or some
+	//  that were never written
+	auto isTorn = [&live]()
+	{
+		return (*live)[0] == BENCHMARK_RELOAD_UNFINISHED || std::count(live->begin(), live->end(), (*live)[0]) != (long)live->size();
+	};
+
+	// the watched file is filled with its version number, so a partial swap would show up as mixed bytes
+	file.assign(fileSize, 0);
+	fileSystem.Write(filename, file.data(), file.size());
+	live = new std::vector<unsigned char>(file);
+
+	if (!watcher.Initialize(&fileSystem, 10) || watcher.Register(filename, ImportBlob, SwapBlob, ReleaseBlob, &live) < 0 || !watcher.Start())
+	{
+		delete live;
+		return false;
+	}
+
+	// time from writing the file to the render thread using the new version, a reload that never
+	//  arrives fails the run
+	torn = 0;
+	timedOut = false;
+	for (int trial = 0; trial < BENCHMARK_TRIALS && !timedOut; trial++)
+	{
+		file.assign(fileSize, (unsigned char)(trial + 1));
+
+		start = GetTime();
+		fileSystem.Write(filename, file.data(), file.size());
+		while ((*live)[0] != (unsigned char)(trial + 1))
+		{
+			if (GetTime() - start > BENCHMARK_RELOAD_TIMEOUT)
+			{
+				timedOut = true;
+				break;
+			}
+
+			// one frame
+			watcher.ApplyChanges();
+			torn += isTorn() ? 1 : 0;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		if (!timedOut)
+		{
+			latencies.push_back((GetTime() - start) * 1000.0);
+		}
+	}
+	tornCounts.push_back((double)torn);
+
+	// write new versions while the earlier ones are still imported, every frame has to see a whole
+	//  version and never an older one than the frame before
+	backward = 0;
+	torn = 0;
+	version = (unsigned char)(BENCHMARK_TRIALS + BENCHMARK_RELOAD_RACE_WRITES);
+	if (!timedOut)
+	{
+		writer = std::thread([&fileSystem, filename, fileSize]()
+		{
+			std::vector<unsigned char> racing;
+			RandomClass random(1);
+
+			for (int i = 1; i <= BENCHMARK_RELOAD_RACE_WRITES; i++)
+			{
+				racing.assign(fileSize, (unsigned char)(BENCHMARK_TRIALS + i));
+				fileSystem.Write(filename, racing.data(), racing.size());
+				std::this_thread::sleep_for(std::chrono::milliseconds(1 + random.NextInt(BENCHMARK_RELOAD_RACE_MAX_MS)));
+			}
+		});
+
+		start = GetTime();
+		seen = (*live)[0];
+		while ((*live)[0] != version)
+		{
+			if (GetTime() - start > BENCHMARK_RELOAD_TIMEOUT + BENCHMARK_RELOAD_RACE_WRITES * BENCHMARK_RELOAD_RACE_MAX_MS / 1000.0)
+			{
+				timedOut = true;
+				break;
+			}
+
+			watcher.ApplyChanges();
+			torn += isTorn() ? 1 : 0;
+			backward += (*live)[0] < seen ? 1 : 0;
+			seen = (*live)[0];
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		writer.join();
+	}
+	tornCounts.push_back((double)torn);
+	backwardCounts.push_back((double)backward);
+
+	// cost of the frame boundary check when nothing changed
+	for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+	{
+		start = GetTime();
+		for (int i = 0; i < applyCount; i++)
+		{
+			watcher.ApplyChanges();
+		}
+		applyTimes.push_back((GetTime() - start) * 1e9 / applyCount);
+	}
+
+	watcher.Shutdown();
+	delete live;
+
+	WriteResult(fout, "hotreload", "latency", "ms", latencies);
+	WriteResult(fout, "hotreload", "apply_idle", "ns", applyTimes);
+	WriteResult(fout, "hotreload", "torn_frames", "count", tornCounts);
+	WriteResult(fout, "hotreload", "backward_frames", "count", backwardCounts);
+
+	if (timedOut)
+	{
+		fprintf(stderr, "hotreload: a reload did not arrive within %.0f seconds\n", BENCHMARK_RELOAD_TIMEOUT);
+	}
+
+	return !timedOut && *std::max_element(tornCounts.begin(), tornCounts.end()) == 0.0 && backward == 0 &&
+		watcher.GetFailCount() == 0;
+}
+
+bool BenchmarkClass::Profiler(std::ofstream& fout)
+{
+	const int zoneCount = 1000000;
+	const int maxThreads = 4;
+	std::vector<double> singleTimes, nestedTimes, threadTimes;
+	std::vector<std::thread> threads;
+	double threadResults[maxThreads];
+	double start;
+	int threadCount;
+
+	if (!ProfilerClass::Initialize())
+	{
+		return false;
+	}
+
+	// no more threads than cores, otherwise the time slices of the others are counted
+	threadCount = std::max(1, std::min(maxThreads, (int)std::thread::hardware_concurrency()));
+
+	for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+	{
+		// cost of a single zone, that is two timestamps and one record
+		start = GetTime();
+		for (int i = 0; i < zoneCount; i++)
+		{
+			ProfileZoneClass zone("single");
+		}
+		singleTimes.push_back((GetTime() - start) * 1e9 / zoneCount);
+
+		// cost per zone with a zone nested in another
+		start = GetTime();
+		for (int i = 0; i < zoneCount / 2; i++)
+		{
+			ProfileZoneClass outer("outer");
+			{
+				ProfileZoneClass inner("inner");
+			}
+		}
+		nestedTimes.push_back((GetTime() - start) * 1e9 / zoneCount);
+
+		// cost per zone while several threads record at the same time
+		threads.clear();
+		for (int t = 0; t < threadCount; t++)
+		{
+			threads.push_back(std::thread([&threadResults, t, zoneCount]()
+			{
+				double threadStart = GetTime();
+				for (int i = 0; i < zoneCount; i++)
+				{
+					ProfileZoneClass zone("thread");
+				}
+				threadResults[t] = (GetTime() - threadStart) * 1e9 / zoneCount;
+			}));
+		}
+		for (int t = 0; t < threadCount; t++)
+		{
+			threads[t].join();
+			threadTimes.push_back(threadResults[t]);
+		}
+	}
+
+	WriteResult(fout, "profiler", "zone", "ns", singleTimes);
+	WriteResult(fout, "profiler", "nested", "ns", nestedTimes);
+	WriteResult(fout, "profiler", "threads", "ns", threadTimes);
+
+	// the export has to work on what was recorded
+	if (!ProfilerClass::WriteTrace(PROFILER_TRACE_FILENAME))
+	{
+		return false;
+	}
+	ProfilerClass::Shutdown();
+
+	// fail if a zone costs more than the budget
+	return Median(singleTimes) < BENCHMARK_ZONE_BUDGET && Median(nestedTimes) < BENCHMARK_ZONE_BUDGET &&
+		Median(threadTimes) < BENCHMARK_ZONE_BUDGET;
+}
+
+bool BenchmarkClass::Headless(std::ofstream& fout)
+{
+	std::vector<double> frameTimes, commandCounts, drawCounts;
+	NullRenderDeviceClass device;
+	HeadlessGraphicsClass graphics;
+	PackFileClass pack;
+	XMFLOAT3 position, direction, up;
+	double start;
+	float angle;
+	bool result;
+
+	// render the scene of the graphics object without a gpu, assets come from the pack or the loose files
+	pack.Open(PACK_ENGINE_FILENAME);
+
+	result = graphics.Initialize(&device, &pack, HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT, m_scene);
+	if (!result)
+	{
+		graphics.Shutdown();
+		return false;
+	}
+
+	position = XMFLOAT3(0.f, 0.f, -3.f);
+	up = XMFLOAT3(0.f, 1.f, 0.f);
+
+	for (int trial = 0; trial < BENCHMARK_TRIALS && result; trial++)
+	{
+		// turn the camera around once over the frames so the visible set keeps changing
+		start = GetTime();
+		for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES && result; frame++)
+		{
+			angle = 6.2831853f * frame / BENCHMARK_HEADLESS_FRAMES;
+			direction = XMFLOAT3(sinf(angle), 0.f, cosf(angle));
+
+			result = graphics.Frame(position, direction, up);
+			if (result)
+			{
+				result = graphics.Render();
+			}
+		}
+		frameTimes.push_back((GetTime() - start) * 1e3 / BENCHMARK_HEADLESS_FRAMES);
+
+		// what the last frame submitted
+		commandCounts.push_back((double)device.GetCommandLog().size());
+		drawCounts.push_back((double)RenderStatsClass::GetFrameValue(RENDER_COUNTER_DRAWS));
+	}
+
+	graphics.Shutdown();
+
+	WriteResult(fout, "headless", "frame", "ms", frameTimes);
+	WriteResult(fout, "headless", "commands", "count", commandCounts);
+	WriteResult(fout, "headless", "draws", "count", drawCounts);
+
+	return result;
+}
+
+bool BenchmarkClass::Flythrough(std::ofstream& fout)
+{
+	std::vector<double> frameTimes, worstTimes, plainFrameTimes, planeTests, plainPlaneTests;
+	std::vector<int> visibleCounts;
+	NullRenderDeviceClass device;
+	HeadlessGraphicsClass graphics;
+	FlythroughClass flythrough;
+	PackFileClass pack;
+	XMFLOAT3 position, direction, up;
+	double start, frameStart, frameTime, worstTime;
+	float angle;
+	int frameCount, planeTestsCounter;
+	unsigned long long frameTests;
+	bool result, coherent;
+
+	// record a walk forward and a turn of the camera as the path if there is none yet
+	if (!flythrough.Load(FLYTHROUGH_FILENAME))
+	{
+		flythrough.BeginRecording();
+		for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES / 2; frame++)
+		{
+			flythrough.Record(FLYTHROUGH_STEP_MS, XMFLOAT3(0.f, 0.f, -3.f + 0.05f * frame), XMFLOAT3(0.f, 0.f, 1.f),
+				XMFLOAT3(0.f, 1.f, 0.f));
+		}
+		for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES / 2; frame++)
+		{
+			angle = 6.2831853f * frame / (BENCHMARK_HEADLESS_FRAMES / 2);
+			flythrough.Record(FLYTHROUGH_STEP_MS, XMFLOAT3(0.f, 0.f, -3.f + 0.05f * (BENCHMARK_HEADLESS_FRAMES / 2)),
+				XMFLOAT3(sinf(angle), 0.f, cosf(angle)), XMFLOAT3(0.f, 1.f, 0.f));
+		}
+
+		if (!flythrough.Save(FLYTHROUGH_FILENAME))
+		{
+			return false;
+		}
+	}
+
+	pack.Open(PACK_ENGINE_FILENAME);
+
+	result = graphics.Initialize(&device, &pack, HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT, m_scene);
+	if (!result)
+	{
+		graphics.Shutdown();
+		return false;
+	}
+
+	planeTestsCounter = RenderStatsClass::Find("plane_tests");
+
+	// every other run tests every model against the planes in order, the others keep what the last frame found
+	for (int run = 0; run < 2 * BENCHMARK_TRIALS && result; run++)
+	{
+		coherent = run % 2 == 1;
+		graphics.SetCoherentCulling(coherent);
+
+		// every run renders exactly the same views, the time of every frame goes to the log
+		flythrough.BeginPlayback();
+		frameCount = 0;
+		frameTests = 0;
+		worstTime = 0.0;
+
+		start = GetTime();
+		while (result && flythrough.Play(position, direction, up))
+		{
+			frameStart = GetTime();
+
+			result = graphics.Frame(position, direction, up);
+			if (result)
+			{
+				result = graphics.Render();
+			}
+
+			frameTime = (GetTime() - frameStart) * 1e3;
+			worstTime = std::max(worstTime, frameTime);
+			frameTests += RenderStatsClass::GetFrameValue(planeTestsCounter);
+
+			// both ways of culling have to keep the same models
+			if (!coherent)
+			{
+				flythrough.LogFrame((float)frameTime);
+				if (run == 0)
+				{
+					visibleCounts.push_back(graphics.GetVisibleCount());
+				}
+			}
+			else if (visibleCounts[frameCount] != graphics.GetVisibleCount())
+			{
+				result = false;
+			}
+			frameCount++;
+		}
+
+		frameTime = frameCount ? (GetTime() - start) * 1e3 / frameCount : 0.0;
+		if (coherent)
+		{
+			frameTimes.push_back(frameTime);
+			planeTests.push_back(frameCount ? (double)frameTests / frameCount : 0.0);
+		}
+		else
+		{
+			plainFrameTimes.push_back(frameTime);
+			worstTimes.push_back(worstTime);
+			plainPlaneTests.push_back(frameCount ? (double)frameTests / frameCount : 0.0);
+		}
+	}
+
+	graphics.Shutdown();
+
+	// the frames of the last trial can be compared with those of another build
+	if (!flythrough.WriteLog(FLYTHROUGH_LOG_FILENAME))
+	{
+		return false;
+	}
+
+	WriteResult(fout, "flythrough", "frame", "ms", plainFrameTimes);
+	WriteResult(fout, "flythrough", "worst_frame", "ms", worstTimes);
+	WriteResult(fout, "flythrough", "plane_tests", "count", plainPlaneTests);
+	WriteResult(fout, "flythrough", "coherent_frame", "ms", frameTimes);
+	WriteResult(fout, "flythrough", "coherent_plane_tests", "count", planeTests);
+
+	return result;
+}
+
+bool BenchmarkClass::Idle(std::ofstream& fout)
+{
+	std::vector<double> frameTimes[6], planeTests[6], skippedFrames;
+	std::vector<int> visibleCounts[3];
+	std::vector<XMFLOAT3> positions;
+	NullRenderDeviceClass device;
+	HeadlessGraphicsClass graphics;
+	ModelListClass* modelList;
+	PackFileClass pack;
+	RandomClass random;
+	XMFLOAT3 position, direction, up;
+	XMFLOAT4 color;
+	double start;
+	float radius;
+	int modelCount, movedCounts[3], index, planeTestsCounter, skippedCounter, mode, motion, frameSkips;
+	unsigned long long frameTests;
+	bool result, caching;
+	static const char* const names[6] = { "culled", "cached", "moving_culled", "moving_cached", "swarm_culled", "swarm_cached" };
+	char variant[64];
+
+	pack.Open(PACK_ENGINE_FILENAME);
+
+	result = graphics.Initialize(&device, &pack, HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT, m_scene);
+	if (!result)
+	{
+		graphics.Shutdown();
+		return false;
+	}
+
+	planeTestsCounter = RenderStatsClass::Find("plane_tests");
+	skippedCounter = RenderStatsClass::Find("culling_skipped");
+
+	// where the scene put the models, the moving runs place them around it
+	modelList = graphics.GetModelList();
+	modelCount = modelList->GetModelCount();
+	movedCounts[0] = 0;
+	movedCounts[1] = std::max(1, modelCount / BENCHMARK_IDLE_MOVED);
+	movedCounts[2] = std::max(1, modelCount / BENCHMARK_IDLE_SWARM_MOVED);
+	positions.resize(modelCount);
+	for (int i = 0; i < modelCount; i++)
+	{
+		modelList->GetData(i, positions[i].x, positions[i].y, positions[i].z, radius, color);
+	}
+
+	// the camera does not move at all
+	position = XMFLOAT3(0.f, 0.f, -3.f);
+	direction = XMFLOAT3(0.f, 0.f, 1.f);
+	up = XMFLOAT3(0.f, 1.f, 0.f);
+
+	// every trial culls every frame and keeps the visible set, with a still scene, with some models
+	//  moving and with so many of them moving that keeping the set falls back to culling them all
+	for (int run = 0; run < 6 * BENCHMARK_TRIALS && result; run++)
+	{
+		mode = run % 6;
+		caching = mode % 2 == 1;
+		motion = mode / 2;
+		graphics.SetCullCaching(caching);
+
+		// the moving runs of a trial move the same models to the same places
+		random.Seed(run / 2);
+		frameTests = 0;
+		frameSkips = 0;
+
+		start = GetTime();
+		for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES && result; frame++)
+		{
+			for (int i = 0; i < movedCounts[motion]; i++)
+			{
+				index = (int)random.NextInt((unsigned int)modelCount);
+				modelList->SetPosition(index,
+					positions[index].x + random.NextRange(-BENCHMARK_IDLE_DISTANCE, BENCHMARK_IDLE_DISTANCE),
+					positions[index].y + random.NextRange(-BENCHMARK_IDLE_DISTANCE, BENCHMARK_IDLE_DISTANCE),
+					positions[index].z + random.NextRange(-BENCHMARK_IDLE_DISTANCE, BENCHMARK_IDLE_DISTANCE));
+			}
+
+			result = graphics.Frame(position, direction, up);
+			if (result)
+			{
+				result = graphics.Render();
+			}
+
+			frameTests += RenderStatsClass::GetFrameValue(planeTestsCounter);
+			frameSkips += (int)RenderStatsClass::GetFrameValue(skippedCounter);
+
+			// keeping the visible set has to find the same models as culling every frame
+			if (!caching)
+			{
+				visibleCounts[motion].resize(BENCHMARK_HEADLESS_FRAMES);
+				visibleCounts[motion][frame] = graphics.GetVisibleCount();
+			}
+			else if (visibleCounts[motion][frame] != graphics.GetVisibleCount())
+			{
+				result = false;
+			}
+		}
+
+		frameTimes[mode].push_back((GetTime() - start) * 1e3 / BENCHMARK_HEADLESS_FRAMES);
+		planeTests[mode].push_back((double)frameTests / BENCHMARK_HEADLESS_FRAMES);
+		if (mode == 1)
+		{
+			skippedFrames.push_back((double)frameSkips);
+		}
+
+		// put the models back so every run starts from the same scene
+		if (motion > 0)
+		{
+			for (int i = 0; i < modelCount; i++)
+			{
+				modelList->SetPosition(i, positions[i].x, positions[i].y, positions[i].z);
+			}
+		}
+	}
+
+	graphics.Shutdown();
+
+	for (int i = 0; i < 6; i++)
+	{
+		snprintf(variant, sizeof(variant), "%s_frame", names[i]);
+		WriteResult(fout, "idle", variant, "ms", frameTimes[i]);
+		snprintf(variant, sizeof(variant), "%s_plane_tests", names[i]);
+		WriteResult(fout, "idle", variant, "count", planeTests[i]);
+	}
+	WriteResult(fout, "idle", "skipped_frames", "count", skippedFrames);
+
+	return result;
+}
+
+bool BenchmarkClass::Jobs(std::ofstream& fout)
+{
+	std::vector<double> cullTimes, cullSpeedups, decompressRates, decompressSpeedups, jobTimes;
+	std::vector<unsigned char> source, compressed, output;
+	std::vector<int> threadCounts, values;
+	ModelListClass modelList;
+	VisibilityClass visibility;
+	CameraClass camera;
+	RandomClass random(1);
+	JobCounterType counter, fillCounter, doubleCounter;
+	XMMATRIX projectionMatrix, viewMatrix;
+	double start, cullBase, decompressBase;
+	float angle;
+	int visibleCount, hardwareThreads;
+	bool result;
+	static const char* const words[8] = { "vertex ", "texture ", "normal ", "tangent ", "0.5 ", "-1.0 ", "0.25 ", "\n" };
+	char variant[64];
+
+	// thread counts in powers of two up to one per core
+	hardwareThreads = std::min((int)std::thread::hardware_concurrency(), JOB_MAX_THREADS);
+	for (int count = 1; count < hardwareThreads; count *= 2)
+	{
+		threadCounts.push_back(count);
+	}
+	threadCounts.push_back(std::max(1, hardwareThreads));
+
+	// text like data that compresses about as well as the model files
+	while (source.size() < (size_t)BENCHMARK_JOBS_DATA_SIZE)
+	{
+		const char* word = words[random.NextInt(8)];
+		source.insert(source.end(), word, word + strlen(word));
+	}
+	if (!CompressionClass::Compress(source.data(), source.size(), compressed))
+	{
+		return false;
+	}
+	output.resize(source.size());
+
+	result = modelList.Initialize(m_scene);
+	if (!result)
+	{
+		return false;
+	}
+
+	projectionMatrix = XMMatrixPerspectiveFovLH(3.14159265f / 4.f, (float)HEADLESS_SCREEN_WIDTH / (float)HEADLESS_SCREEN_HEIGHT,
+		HEADLESS_SCREEN_NEAR, HEADLESS_SCREEN_DEPTH);
+
+	// the job system of the benchmark is replaced by one with every thread count in turn
+	JobSystemClass::Shutdown();
+
+	visibleCount = -1;
+	cullBase = decompressBase = 0.0;
+	for (size_t i = 0; i < threadCounts.size() && result; i++)
+	{
+		result = JobSystemClass::Initialize(threadCounts[i]);
+		if (!result)
+		{
+			break;
+		}
+
+		result = visibility.Initialize(&modelList);
+		if (!result)
+		{
+			JobSystemClass::Shutdown();
+			break;
+		}
+		visibility.SetCaching(false);
+
+		cullTimes.clear();
+		decompressRates.clear();
+		jobTimes.clear();
+		for (int trial = 0; trial < BENCHMARK_TRIALS && result; trial++)
+		{
+			// cull the whole scene for a turn of the camera, every thread count has to keep the same models
+			start = GetTime();
+			for (int frame = 0; frame < BENCHMARK_JOBS_FRAMES; frame++)
+			{
+				angle = 6.2831853f * frame / BENCHMARK_JOBS_FRAMES;
+				camera.SetPosition(0.f, 0.f, -3.f);
+				camera.SetDirection(sinf(angle), 0.f, cosf(angle));
+				camera.SetUp(0.f, 1.f, 0.f);
+				camera.Render();
+				camera.GetViewMatrix(viewMatrix);
+				visibility.Cull(HEADLESS_SCREEN_DEPTH, projectionMatrix, viewMatrix);
+			}
+			cullTimes.push_back((GetTime() - start) * 1e3 / BENCHMARK_JOBS_FRAMES);
+
+			if (visibleCount < 0)
+			{
+				visibleCount = visibility.GetVisibleCount();
+			}
+			result = visibleCount == visibility.GetVisibleCount();
+
+			// decompress the blocks of the data as jobs
+			start = GetTime();
+			result = result && CompressionClass::Decompress(compressed.data(), compressed.size(), output.data(), output.size(),
+				threadCounts[i]);
+			decompressRates.push_back(source.size() / (1024.0 * 1024.0) / (GetTime() - start));
+
+			// the cost of a job that does nothing, from the submission to the end of the wait
+			start = GetTime();
+			for (int job = 0; job < BENCHMARK_JOBS_EMPTY; job++)
+			{
+				JobSystemClass::Run(EmptyJob, nullptr, 0, 1, &counter);
+			}
+			JobSystemClass::Wait(&counter);
+			jobTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_JOBS_EMPTY);
+		}
+
+		// a parallel for that depends on another one has to see all its writes, the values
+		//  are filled into the first half and doubled into the second
+		values.assign(source.size() / 2, 0);
+		JobSystemClass::ParallelFor(FillJob, &values, 0, (int)values.size() / 2, 4096, &fillCounter);
+		JobSystemClass::ParallelFor(DoubleJob, &values, 0, (int)values.size() / 2, 4096, &doubleCounter, &fillCounter);
+		JobSystemClass::Wait(&doubleCounter);
+		for (size_t j = 0; j < values.size() / 2 && result; j++)
+		{
+			result = values[j] == (int)j && values[values.size() / 2 + j] == 2 * (int)j;
+		}
+
+		visibility.Shutdown();
+		JobSystemClass::Shutdown();
+
+		result = result && memcmp(source.data(), output.data(), source.size()) == 0;
+
+		// the speedups are relative to the single thread
+		if (i == 0)
+		{
+			cullBase = Median(cullTimes);
+			decompressBase = Median(decompressRates);
+		}
+		cullSpeedups.clear();
+		decompressSpeedups.clear();
+		for (size_t j = 0; j < cullTimes.size(); j++)
+		{
+			cullSpeedups.push_back(cullBase / cullTimes[j]);
+			decompressSpeedups.push_back(decompressRates[j] / decompressBase);
+		}
+
+		snprintf(variant, sizeof(variant), "cull_%d_threads", threadCounts[i]);
+		WriteResult(fout, "jobs", variant, "ms", cullTimes);
+		snprintf(variant, sizeof(variant), "cull_speedup_%d_threads", threadCounts[i]);
+		WriteResult(fout, "jobs", variant, "x", cullSpeedups);
+		snprintf(variant, sizeof(variant), "decompress_%d_threads", threadCounts[i]);
+		WriteResult(fout, "jobs", variant, "MB/s", decompressRates);
+		snprintf(variant, sizeof(variant), "decompress_speedup_%d_threads", threadCounts[i]);
+		WriteResult(fout, "jobs", variant, "x", decompressSpeedups);
+		snprintf(variant, sizeof(variant), "empty_job_%d_threads", threadCounts[i]);
+		WriteResult(fout, "jobs", variant, "ns", jobTimes);
+	}
+
+	modelList.Shutdown();
+
+	// hand the run back a job system like the one it started with
+	return JobSystemClass::Initialize(0) && result;
+}
+
+bool BenchmarkClass::Pipeline(std::ofstream& fout)
+{
+	std::vector<double> frameTimes[2], latencies[2], simulateTimes, renderTimes;
+	std::vector<int> visibleCounts;
+	std::vector<XMFLOAT3> positions;
+	NullRenderDeviceClass device;
+	HeadlessGraphicsClass graphics;
+	FramePipelineClass pipeline;
+	PackFileClass pack;
+	ModelListClass* modelList;
+	FrameStateType* state;
+	std::thread simulation;
+	double start, phaseStart, simulateTime, renderTime, latency;
+	float radius;
+	XMFLOAT4 color;
+	int modelCount;
+	bool result, pipelined;
+
+	// the latency is measured with the profiler clock
+	if (!ProfilerClass::Initialize())
+	{
+		return false;
+	}
+
+	pack.Open(PACK_ENGINE_FILENAME);
+
+	result = graphics.Initialize(&device, &pack, HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT, m_scene);
+	if (!result)
+	{
+		graphics.Shutdown();
+		return false;
+	}
+
+	// where the scene put the models, the simulation moves them around it
+	modelList = graphics.GetModelList();
+	modelCount = modelList->GetModelCount();
+	positions.resize(modelCount);
+	for (int i = 0; i < modelCount; i++)
+	{
+		modelList->GetData(i, positions[i].x, positions[i].y, positions[i].z, radius, color);
+	}
+
+	// every other run simulates the next frame on its own thread while this one renders
+	for (int run = 0; run < 2 * BENCHMARK_TRIALS && result; run++)
+	{
+		pipelined = run % 2 == 1;
+		result = pipeline.Initialize(pipelined);
+		if (!result)
+		{
+			break;
+		}
+
+		simulateTime = renderTime = latency = 0.0;
+		start = GetTime();
+
+		if (pipelined)
+		{
+			simulation = std::thread([&pipeline, &positions]()
+			{
+				FrameStateType* simulated;
+
+				for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES; frame++)
+				{
+					simulated = pipeline.BeginSimulation();
+					if (!simulated)
+					{
+						break;
+					}
+					SimulateFrame(simulated, positions);
+					pipeline.EndSimulation();
+				}
+			});
+		}
+
+		for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES && result; frame++)
+		{
+			// without pipelining the frame is simulated right before it is rendered
+			if (!pipelined)
+			{
+				phaseStart = GetTime();
+				state = pipeline.BeginSimulation();
+				SimulateFrame(state, positions);
+				pipeline.EndSimulation();
+				simulateTime += GetTime() - phaseStart;
+			}
+
+			state = pipeline.BeginRender();
+			if (!state)
+			{
+				result = false;
+				break;
+			}
+
+			// move the models the simulation moved, then cull and submit the frame
+			phaseStart = GetTime();
+			for (size_t i = 0; i < state->moves.size(); i++)
+			{
+				modelList->SetPosition(state->moves[i].index, state->moves[i].position.x, state->moves[i].position.y,
+					state->moves[i].position.z);
+			}
+
+			result = graphics.Frame(state->position, state->direction, state->up);
+			if (result)
+			{
+				result = graphics.Render();
+			}
+			renderTime += GetTime() - phaseStart;
+
+			pipeline.EndRender();
+			latency += pipeline.GetLatency();
+
+			// both ways have to render the same frames
+			if (!pipelined)
+			{
+				visibleCounts.resize(BENCHMARK_HEADLESS_FRAMES);
+				visibleCounts[frame] = graphics.GetVisibleCount();
+			}
+			else if (visibleCounts[frame] != graphics.GetVisibleCount())
+			{
+				result = false;
+			}
+		}
+
+		frameTimes[pipelined ? 1 : 0].push_back((GetTime() - start) * 1e3 / BENCHMARK_HEADLESS_FRAMES);
+		latencies[pipelined ? 1 : 0].push_back(latency / BENCHMARK_HEADLESS_FRAMES);
+		if (!pipelined)
+		{
+			simulateTimes.push_back(simulateTime * 1e3 / BENCHMARK_HEADLESS_FRAMES);
+			renderTimes.push_back(renderTime * 1e3 / BENCHMARK_HEADLESS_FRAMES);
+		}
+
+		pipeline.Stop();
+		if (simulation.joinable())
+		{
+			simulation.join();
+		}
+		pipeline.Shutdown();
+
+		// put the models back so every run starts from the same scene
+		for (int i = 0; i < modelCount; i++)
+		{
+			modelList->SetPosition(i, positions[i].x, positions[i].y, positions[i].z);
+		}
+	}
+
+	graphics.Shutdown();
+
+	WriteResult(fout, "pipeline", "simulate", "ms", simulateTimes);
+	WriteResult(fout, "pipeline", "render", "ms", renderTimes);
+	WriteResult(fout, "pipeline", "latency_mode_frame", "ms", frameTimes[0]);
+	WriteResult(fout, "pipeline", "latency_mode_latency", "ms", latencies[0]);
+	WriteResult(fout, "pipeline", "pipelined_frame", "ms", frameTimes[1]);
+	WriteResult(fout, "pipeline", "pipelined_latency", "ms", latencies[1]);
+
+	return result;
+}
+
+bool BenchmarkClass::FrameLoop(std::ofstream& fout)
+{
+	std::vector<double> singleLatencies, singleBacklogs, drainedLatencies, drainedBacklogs;
+	std::vector<double> variableDrifts, fixedDrifts, snappedErrors, interpolatedErrors, stallSteps, droppedTimes;
+	SyntheticPlatformClass platform;
+	PlatformEventType event;
+	EventLatencyType latency;
+	FrameLoopClass loop;
+	RandomClass random(1);
+	double endPositions[2][2], positions[2], velocities[2], frameTime, total, time, speed;
+	double previous, current, shown, lastShown, lastSnapped, snappedError, interpolatedError;
+	int steps, frames;
+	bool result;
+
+	result = true;
+	for (int trial = 0; trial < BENCHMARK_TRIALS && result; trial++)
+	{
+		// a 1000 hz mouse floods the messages of a 60 hz loop, once taking one message per frame and
+		//  once draining all of them
+		for (int drain = 0; drain < 2; drain++)
+		{
+			platform = SyntheticPlatformClass();
+			for (double t = 0.0; t < BENCHMARK_LOOP_SECONDS * 1000.0; t += BENCHMARK_LOOP_MOUSE_MS)
+			{
+				event.message = PLATFORM_MESSAGE_MOUSE;
+				event.time = t + random.NextFloat() * BENCHMARK_LOOP_MOUSE_MS * 0.5;
+				event.x = 1;
+				event.y = 0;
+				event.key = 0;
+				event.down = false;
+				platform.PostEvent(event);
+			}
+
+			result = loop.Initialize(&platform);
+			if (!result)
+			{
+				break;
+			}
+
+			latency.platform = &platform;
+			latency.total = latency.worst = 0.0;
+			latency.count = 0;
+
+			for (frames = 0; platform.GetTime() < BENCHMARK_LOOP_SECONDS * 1000.0; frames++)
+			{
+				platform.Advance(BENCHMARK_LOOP_FRAME_MS);
+
+				if (drain)
+				{
+					loop.PumpEvents(RecordEvent, &latency);
+				}
+				else if (platform.PollEvent(event))
+				{
+					RecordEvent(&latency, event);
+				}
+
+				loop.Advance();
+			}
+
+			(drain ? drainedLatencies : singleLatencies).push_back(latency.count > 0 ? latency.total / latency.count : 0.0);
+			(drain ? drainedBacklogs : singleBacklogs).push_back(platform.GetPendingCount());
+		}
+
+		// a spring moved with the frame time as its time step ends up somewhere else on every run,
+		//  moved in fixed steps it ends up at the same place however the frames jitter
+		for (int run = 0; run < 2; run++)
+		{
+			platform = SyntheticPlatformClass();
+			result = loop.Initialize(&platform);
+			if (!result)
+			{
+				break;
+			}
+
+			// both runs stop halfway into the same step
+			total = floor(BENCHMARK_LOOP_SECONDS * 1000.0 / FRAME_LOOP_STEP_MS) * FRAME_LOOP_STEP_MS + FRAME_LOOP_STEP_MS * 0.5;
+
+			positions[0] = positions[1] = 1.0;
+			velocities[0] = velocities[1] = 0.0;
+			for (time = 0.0; time < total; time += frameTime)
+			{
+				frameTime = std::min((double)random.NextRange(BENCHMARK_LOOP_MIN_FRAME_MS, BENCHMARK_LOOP_MAX_FRAME_MS), total - time);
+				platform.Advance(frameTime);
+
+				StepSpring(positions[0], velocities[0], frameTime);
+
+				steps = loop.Advance();
+				for (int i = 0; i < steps; i++)
+				{
+					StepSpring(positions[1], velocities[1], loop.GetStepTime());
+				}
+			}
+
+			endPositions[run][0] = positions[0];
+			endPositions[run][1] = positions[1];
+		}
+		if (!result)
+		{
+			break;
+		}
+
+		variableDrifts.push_back(fabs(endPositions[0][0] - endPositions[1][0]));
+		fixedDrifts.push_back(fabs(endPositions[0][1] - endPositions[1][1]));
+
+		// something moving at a constant speed should move as far as the time of the frame, shown
+		//  at the last step it stutters, shown between the last two steps it does not
+		platform = SyntheticPlatformClass();
+		result = loop.Initialize(&platform);
+		if (!result)
+		{
+			break;
+		}
+
+		speed = 0.01;
+		previous = current = 0.0;
+		snappedError = interpolatedError = 0.0;
+		lastShown = lastSnapped = 0.0;
+		frames = 0;
+		for (time = 0.0; time < BENCHMARK_LOOP_SECONDS * 1000.0; time += frameTime)
+		{
+			frameTime = random.NextRange(BENCHMARK_LOOP_MIN_FRAME_MS, BENCHMARK_LOOP_MAX_FRAME_MS);
+			platform.Advance(frameTime);
+
+			steps = loop.Advance();
+			for (int i = 0; i < steps; i++)
+			{
+				previous = current;
+				current += speed * loop.GetStepTime();
+			}
+
+			// how far off the distance shown this frame is from the distance it should have moved
+			shown = previous + (current - previous) * loop.GetAlpha();
+			if (frames > 0)
+			{
+				snappedError += fabs((current - lastSnapped) - speed * frameTime) / (speed * frameTime);
+				interpolatedError += fabs((shown - lastShown) - speed * frameTime) / (speed * frameTime);
+			}
+			lastSnapped = current;
+			lastShown = shown;
+			frames++;
+		}
+
+		snappedErrors.push_back(snappedError / (frames - 1));
+		interpolatedErrors.push_back(interpolatedError / (frames - 1));
+
+		// a frame held up by the debugger is not caught up in a burst of steps
+		platform = SyntheticPlatformClass();
+		result = loop.Initialize(&platform);
+		if (!result)
+		{
+			break;
+		}
+
+		platform.Advance(BENCHMARK_LOOP_STALL_MS);
+		stallSteps.push_back(loop.Advance());
+		droppedTimes.push_back(loop.GetDroppedTime());
+	}
+
+	WriteResult(fout, "frameloop", "one_message_latency", "ms", singleLatencies);
+	WriteResult(fout, "frameloop", "one_message_backlog", "count", singleBacklogs);
+	WriteResult(fout, "frameloop", "drained_latency", "ms", drainedLatencies);
+	WriteResult(fout, "frameloop", "drained_backlog", "count", drainedBacklogs);
+	WriteResult(fout, "frameloop", "variable_step_drift", "distance", variableDrifts);
+	WriteResult(fout, "frameloop", "fixed_step_drift", "distance", fixedDrifts);
+	WriteResult(fout, "frameloop", "snapped_motion_error", "fraction", snappedErrors);
+	WriteResult(fout, "frameloop", "interpolated_motion_error", "fraction", interpolatedErrors);
+	WriteResult(fout, "frameloop", "stall_steps", "count", stallSteps);
+	WriteResult(fout, "frameloop", "stall_dropped", "ms", droppedTimes);
+
+	// the drained loop keeps up, the fixed steps do not depend on the frames
+	return result && Median(drainedBacklogs) == 0.0 && Median(fixedDrifts) == 0.0 &&
+		Median(stallSteps) == FRAME_LOOP_MAX_STEPS;
+}
+
+bool BenchmarkClass::Limiter(std::ofstream& fout)
+{
+	static const char* const modes[6] = { "spin", "vsync", "limited", "late", "pipelined_vsync", "pipelined_late" };
+	std::vector<double> submitLatencies[6], displayLatencies[6], cpuLoads[6], spinShares, missedFrames;
+	SyntheticPlatformClass platform(true);
+	FrameLimiterClass limiter;
+	FramePipelineClass pipeline;
+	std::thread simulation;
+	double interval, start, cpuStart, sampleTime, workStart, work, submitTime, displayTime, submitLatency, displayLatency;
+	int frames;
+	bool result, pipelined, vsync;
+	char variant[64];
+
+	// the pipeline measures its latency with the profiler clock
+	if (!ProfilerClass::Initialize())
+	{
+		return false;
+	}
+
+	// the display shows the last submitted frame at every refresh
+	interval = 1000.0 / BENCHMARK_LIMITER_FPS;
+
+	result = true;
+	for (int trial = 0; trial < BENCHMARK_LIMITER_TRIALS && result; trial++)
+	{
+		for (int mode = 0; mode < 6 && result; mode++)
+		{
+			// the limiter samples at the frame start, or as late as the work and a margin allow
+			pipelined = mode >= 4;
+			vsync = mode == 1 || mode == 4;
+			result = limiter.Initialize(&platform, (mode == 2 || mode == 3 || mode == 5) ? BENCHMARK_LIMITER_FPS : 0.0,
+				(mode == 3 || mode == 5) ? BENCHMARK_LIMITER_WORK_MS + BENCHMARK_LIMITER_MARGIN_MS : 0.0);
+			if (!result)
+			{
+				break;
+			}
+
+			// the refreshes start with the run, so the deadlines of the limiter are refreshes
+			submitLatency = displayLatency = 0.0;
+			start = platform.GetTime();
+			cpuStart = GetCpuTime();
+
+			// the pipelined modes simulate on their own thread like the engine, the limiter paces that
+			//  thread and this one renders whatever it hands over
+			work = BENCHMARK_LIMITER_WORK_MS;
+			if (pipelined)
+			{
+				result = pipeline.Initialize(true);
+				if (!result)
+				{
+					break;
+				}
+
+				work -= BENCHMARK_LIMITER_SIMULATE_MS;
+				simulation = std::thread([&pipeline, &limiter, &platform]()
+				{
+					double simulateStart;
+
+					while (true)
+					{
+						limiter.BeginFrame();
+						if (!pipeline.BeginSimulation())
+						{
+							break;
+						}
+
+						simulateStart = platform.GetTime();
+						while (platform.GetTime() - simulateStart < BENCHMARK_LIMITER_SIMULATE_MS)
+						{
+						}
+
+						pipeline.EndSimulation();
+						limiter.EndFrame();
+					}
+				});
+			}
+
+			for (frames = 0; platform.GetTime() - start < 1000.0; frames++)
+			{
+				if (pipelined)
+				{
+					if (!pipeline.BeginRender())
+					{
+						result = false;
+						break;
+					}
+				}
+				else
+				{
+					limiter.BeginFrame();
+				}
+				sampleTime = workStart = platform.GetTime();
+
+				// the cpu work of the frame
+				while (platform.GetTime() - workStart < work)
+				{
+				}
+				submitTime = platform.GetTime();
+
+				// with vsync the present blocks until the next refresh
+				displayTime = start + ceil((submitTime - start) / interval) * interval;
+				if (vsync)
+				{
+					platform.SleepFor(displayTime - submitTime);
+					submitTime = platform.GetTime();
+				}
+
+				// the input of a pipelined frame was sampled when its simulation began
+				if (pipelined)
+				{
+					pipeline.EndRender();
+					sampleTime = submitTime - pipeline.GetLatency();
+				}
+				else
+				{
+					limiter.EndFrame();
+				}
+
+				submitLatency += submitTime - sampleTime;
+				displayLatency += displayTime - sampleTime;
+			}
+
+			submitLatencies[mode].push_back(submitLatency / frames);
+			displayLatencies[mode].push_back(displayLatency / frames);
+			cpuLoads[mode].push_back(100.0 * (GetCpuTime() - cpuStart) / (platform.GetTime() - start));
+
+			if (pipelined)
+			{
+				pipeline.Stop();
+				simulation.join();
+				pipeline.Shutdown();
+			}
+
+			if (mode == 3)
+			{
+				spinShares.push_back(100.0 * limiter.GetSpinTime() / (platform.GetTime() - start));
+				missedFrames.push_back(limiter.GetMissedCount());
+			}
+		}
+	}
+
+	for (int mode = 0; mode < 6; mode++)
+	{
+		snprintf(variant, sizeof(variant), "%s_submit_latency", modes[mode]);
+		WriteResult(fout, "limiter", variant, "ms", submitLatencies[mode]);
+		snprintf(variant, sizeof(variant), "%s_display_latency", modes[mode]);
+		WriteResult(fout, "limiter", variant, "ms", displayLatencies[mode]);
+		snprintf(variant, sizeof(variant), "%s_cpu", modes[mode]);
+		WriteResult(fout, "limiter", variant, "percent", cpuLoads[mode]);
+	}
+	WriteResult(fout, "limiter", "late_spin", "percent", spinShares);
+	WriteResult(fout, "limiter", "late_missed_frames", "count", missedFrames);
+
+	return result;
+}
+
+bool BenchmarkClass::Input(std::ofstream& fout)
+{
+	std::vector<double> polledSeen, queuedSeen, polledHeld, queuedHeld, queuedMouse, latencies, dropped;
+	std::vector<double> tapStarts, tapEnds, frameTimes;
+	SyntheticPlatformClass platform(true);
+	InputQueueClass queue;
+	FrameLoopClass loop;
+	RandomClass random(1);
+	InputEventType event;
+	double start, time, end, heldTime, latency, frameStart, stepEnd;
+	int steps, eventCount, taps, mouseX, mouseY, mouseTotal, mouseSeen, polledTaps, latencyCount;
+	bool result, down;
+	size_t tap;
+
+	result = true;
+	for (int trial = 0; trial < BENCHMARK_INPUT_TRIALS && result; trial++)
+	{
+		SyntheticInputClass input;
+
+		// a fast mouse moving all the time and short taps of a key, starting a little from now
+		start = platform.GetTime() + 10.0;
+		end = start + BENCHMARK_INPUT_SECONDS * 1000.0;
+		tapStarts.clear();
+		tapEnds.clear();
+		for (time = start + BENCHMARK_INPUT_TAP_MS; time < end; time += BENCHMARK_INPUT_TAP_MS * (0.5 + random.NextFloat()))
+		{
+			tapStarts.push_back(time);
+			tapEnds.push_back(time + random.NextRange(BENCHMARK_INPUT_MIN_TAP, BENCHMARK_INPUT_MAX_TAP));
+		}
+
+		mouseTotal = 0;
+		tap = 0;
+		down = false;
+		memset(&event, 0, sizeof(event));
+		for (time = start; time < end; time += BENCHMARK_INPUT_MOUSE_MS)
+		{
+			// the key events that happened before this mouse event
+			while (tap < tapStarts.size() && (down ? tapEnds[tap] : tapStarts[tap]) <= time)
+			{
+				event.time = down ? tapEnds[tap] : tapStarts[tap];
+				event.device = INPUT_DEVICE_KEYBOARD;
+				event.key = INPUT_KEY_W;
+				event.down = !down;
+				event.x = event.y = 0;
+				input.PostEvent(event);
+
+				tap += down ? 1 : 0;
+				down = !down;
+			}
+
+			event.time = time;
+			event.device = INPUT_DEVICE_MOUSE;
+			event.key = 0;
+			event.down = false;
+			event.x = 1;
+			event.y = 0;
+			input.PostEvent(event);
+			mouseTotal++;
+		}
+
+		result = loop.Initialize(&platform);
+		if (!result)
+		{
+			break;
+		}
+		queue.Initialize(loop.GetSimulatedTime());
+
+		result = input.Start(&queue, &platform);
+		if (!result)
+		{
+			break;
+		}
+
+		// a 60 hz game taking the input at the end of every fixed step
+		taps = 0;
+		mouseSeen = 0;
+		heldTime = 0.0;
+		latency = 0.0;
+		latencyCount = 0;
+		frameTimes.clear();
+		frameStart = platform.GetTime();
+		while (platform.GetTime() < end + 2.0 * loop.GetStepTime())
+		{
+			frameTimes.push_back(platform.GetTime());
+
+			steps = loop.Advance();
+			for (int i = 0; i < steps; i++)
+			{
+				stepEnd = loop.GetSimulatedTime() - (steps - 1 - i) * loop.GetStepTime();
+				eventCount = queue.Consume(stepEnd);
+
+				// how long the events waited from happening until a step took them
+				latency += (queue.GetEventAge() + platform.GetTime() - stepEnd) * eventCount;
+				latencyCount += eventCount;
+
+				taps += queue.WasKeyPressed(INPUT_KEY_W) ? 1 : 0;
+				heldTime += queue.GetKeyTimes()[INPUT_KEY_W];
+				queue.GetMouseMovement(mouseX, mouseY);
+				mouseSeen += mouseX;
+			}
+
+			frameStart += BENCHMARK_LOOP_FRAME_MS;
+			platform.SleepFor(frameStart - platform.GetTime());
+		}
+
+		input.Stop();
+
+		// polling the device state at the frames only sees the taps a frame fell into, and moves
+		//  the camera for a whole frame for every one of them
+		polledTaps = 0;
+		for (size_t i = 0, frame = 0; i < tapStarts.size(); i++)
+		{
+			while (frame < frameTimes.size() && frameTimes[frame] < tapStarts[i])
+			{
+				frame++;
+			}
+			if (frame < frameTimes.size() && frameTimes[frame] <= tapEnds[i])
+			{
+				polledTaps++;
+			}
+		}
+
+		// the real hold time of all the taps
+		time = 0.0;
+		for (size_t i = 0; i < tapStarts.size(); i++)
+		{
+			time += tapEnds[i] - tapStarts[i];
+		}
+
+		polledSeen.push_back(100.0 * polledTaps / tapStarts.size());
+		queuedSeen.push_back(100.0 * taps / tapStarts.size());
+		polledHeld.push_back(100.0 * polledTaps * BENCHMARK_LOOP_FRAME_MS / time);
+		queuedHeld.push_back(100.0 * heldTime / time);
+		queuedMouse.push_back(100.0 * mouseSeen / mouseTotal);
+		latencies.push_back(latencyCount > 0 ? latency / latencyCount : 0.0);
+		dropped.push_back((double)queue.GetDroppedCount());
+	}
+
+	WriteResult(fout, "input", "polled_taps_seen", "percent", polledSeen);
+	WriteResult(fout, "input", "queued_taps_seen", "percent", queuedSeen);
+	WriteResult(fout, "input", "polled_hold_time", "percent", polledHeld);
+	WriteResult(fout, "input", "queued_hold_time", "percent", queuedHeld);
+	WriteResult(fout, "input", "queued_mouse_seen", "percent", queuedMouse);
+	WriteResult(fout, "input", "queued_latency", "ms", latencies);
+	WriteResult(fout, "input", "queued_dropped", "count", dropped);
+
+	// every tap and all the movement has to arrive
+	return result && Median(queuedSeen) == 100.0 && Median(queuedMouse) == 100.0 && Median(dropped) == 0.0;
+}
+
+bool BenchmarkClass::Arena(std::ofstream& fout)
+{
+	std::vector<double> renderCalls, heapTimes, heapCalls, arenaTimes, arenaCalls, arenaBytes;
+	std::vector<int> sizes;
+	NullRenderDeviceClass device;
+	HeadlessGraphicsClass graphics;
+	PackFileClass pack;
+	RandomClass random(1);
+	XMFLOAT3 position, direction, up;
+	unsigned long long calls;
+	unsigned char* memory;
+	unsigned char* temporaries[BENCHMARK_ARENA_TEMPORARIES];
+	double start, time;
+	float angle;
+	int frames;
+	bool result;
+
+	// the heap calls are counted for this thread, the one that renders
+	pack.Open(PACK_ENGINE_FILENAME);
+
+	result = graphics.Initialize(&device, &pack, HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT, m_scene);
+	if (!result)
+	{
+		graphics.Shutdown();
+		return false;
+	}
+
+	position = XMFLOAT3(0.f, 0.f, -3.f);
+	up = XMFLOAT3(0.f, 1.f, 0.f);
+
+	// the sizes of the temporaries are the same for every frame and both allocators
+	sizes.resize(BENCHMARK_ARENA_TEMPORARIES);
+	for (int i = 0; i < BENCHMARK_ARENA_TEMPORARIES; i++)
+	{
+		sizes[i] = BENCHMARK_ARENA_MIN_SIZE + (int)random.NextInt(BENCHMARK_ARENA_MAX_SIZE - BENCHMARK_ARENA_MIN_SIZE + 1);
+	}
+
+	for (int trial = 0; trial < BENCHMARK_TRIALS && result; trial++)
+	{
+		// the frames of the renderer with the camera turning, once it is warm no frame may touch the heap
+		calls = FrameArenaClass::GetHeapCallCount();
+		frames = 0;
+		for (int frame = 0; frame < BENCHMARK_ARENA_WARMUP + BENCHMARK_HEADLESS_FRAMES && result; frame++)
+		{
+			if (frame == BENCHMARK_ARENA_WARMUP)
+			{
+				calls = FrameArenaClass::GetHeapCallCount();
+			}
+
+			angle = 6.2831853f * frame / BENCHMARK_HEADLESS_FRAMES;
+			direction = XMFLOAT3(sinf(angle), 0.f, cosf(angle));
+
+			result = graphics.Frame(position, direction, up);
+			if (result)
+			{
+				result = graphics.Render();
+			}
+			frames += frame >= BENCHMARK_ARENA_WARMUP ? 1 : 0;
+		}
+		if (frames > 0)
+		{
+			renderCalls.push_back((double)(FrameArenaClass::GetHeapCallCount() - calls) / frames);
+		}
+
+		// temporaries from the heap, every one is allocated and freed on its own
+		calls = FrameArenaClass::GetHeapCallCount();
+		start = GetTime();
+		for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES; frame++)
+		{
+			for (int i = 0; i < BENCHMARK_ARENA_TEMPORARIES; i++)
+			{
+				temporaries[i] = new unsigned char[sizes[i]];
+				temporaries[i][0] = (unsigned char)i;
+			}
+			for (int i = 0; i < BENCHMARK_ARENA_TEMPORARIES; i++)
+			{
+				delete[] temporaries[i];
+			}
+		}
+		time = GetTime() - start;
+		heapTimes.push_back(time * 1e9 / ((double)BENCHMARK_HEADLESS_FRAMES * BENCHMARK_ARENA_TEMPORARIES));
+		heapCalls.push_back((double)(FrameArenaClass::GetHeapCallCount() - calls) / BENCHMARK_HEADLESS_FRAMES);
+
+		// the same temporaries from the frame arena, released all at once when the frame ends
+		FrameArenaClass::EndFrame();
+		calls = FrameArenaClass::GetHeapCallCount();
+		start = GetTime();
+		for (int frame = 0; frame < BENCHMARK_HEADLESS_FRAMES && result; frame++)
+		{
+			for (int i = 0; i < BENCHMARK_ARENA_TEMPORARIES && result; i++)
+			{
+				memory = (unsigned char*)FrameArenaClass::Allocate(sizes[i]);
+				result = memory != nullptr;
+				if (result)
+				{
+					memory[0] = (unsigned char)i;
+				}
+			}
+			FrameArenaClass::EndFrame();
+		}
+		time = GetTime() - start;
+		arenaTimes.push_back(time * 1e9 / ((double)BENCHMARK_HEADLESS_FRAMES * BENCHMARK_ARENA_TEMPORARIES));
+		arenaCalls.push_back((double)(FrameArenaClass::GetHeapCallCount() - calls) / BENCHMARK_HEADLESS_FRAMES);
+		arenaBytes.push_back((double)FrameArenaClass::GetCapacity() / 1024.0);
+	}
+
+	graphics.Shutdown();
+
+	WriteResult(fout, "arena", "render_heap_calls", "count", renderCalls);
+	WriteResult(fout, "arena", "heap_temporary", "ns", heapTimes);
+	WriteResult(fout, "arena", "heap_calls", "count", heapCalls);
+	WriteResult(fout, "arena", "arena_temporary", "ns", arenaTimes);
+	WriteResult(fout, "arena", "arena_calls", "count", arenaCalls);
+	WriteResult(fout, "arena", "arena_capacity", "KB", arenaBytes);
+
+	// a warm frame may not call into the heap at all
+	return result && Median(renderCalls) == 0.0;
+}
+
+bool BenchmarkClass::Memory(std::ofstream& fout)
+{
+	struct ObjectType
+	{
+		unsigned char bytes[BENCHMARK_MEMORY_OBJECT_SIZE];
+	};
+
+	std::vector<double> heapTimes, trackedTimes, poolTimes, sceneBytes, graphicsBytes, leaks;
+	std::vector<ObjectType*> objects;
+	NullRenderDeviceClass device;
+	PackFileClass pack;
+	MemoryPoolClass pool;
+	MemoryStatsType before, stats;
+	double start;
+	char report[1024];
+	bool result;
+
+	objects.resize(BENCHMARK_MEMORY_OBJECTS);
+	result = pool.Initialize(sizeof(ObjectType), MEMORY_TAG_GENERAL, BENCHMARK_MEMORY_OBJECTS);
+	pack.Open(PACK_ENGINE_FILENAME);
+
+	for (int trial = 0; trial < BENCHMARK_TRIALS && result; trial++)
+	{
+		// small objects from the heap without tracking
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_MEMORY_OBJECTS; i++)
+		{
+			objects[i] = new ObjectType;
+			objects[i]->bytes[0] = (unsigned char)i;
+		}
+		for (int i = 0; i < BENCHMARK_MEMORY_OBJECTS; i++)
+		{
+			delete objects[i];
+		}
+		heapTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_MEMORY_OBJECTS);
+
+		// the same objects tracked under a tag
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_MEMORY_OBJECTS; i++)
+		{
+			objects[i] = MemoryClass::New<ObjectType>(MEMORY_TAG_GENERAL);
+			objects[i]->bytes[0] = (unsigned char)i;
+		}
+		for (int i = 0; i < BENCHMARK_MEMORY_OBJECTS; i++)
+		{
+			MemoryClass::Delete(objects[i]);
+		}
+		trackedTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_MEMORY_OBJECTS);
+
+		// and from a pool, its pages are tracked
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_MEMORY_OBJECTS; i++)
+		{
+			objects[i] = pool.New<ObjectType>();
+			objects[i]->bytes[0] = (unsigned char)i;
+		}
+		for (int i = 0; i < BENCHMARK_MEMORY_OBJECTS; i++)
+		{
+			pool.Delete(objects[i]);
+		}
+		poolTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_MEMORY_OBJECTS);
+
+		// what a scene takes per tag, everything has to be given back once it is released
+		{
+			HeadlessGraphicsClass graphics;
+
+			MemoryClass::GetTotalStats(before);
+			result = graphics.Initialize(&device, &pack, HEADLESS_SCREEN_WIDTH, HEADLESS_SCREEN_HEIGHT, m_scene);
+			if (result)
+			{
+				MemoryClass::GetStats(MEMORY_TAG_SCENE, stats);
+				sceneBytes.push_back(stats.current / 1024.0);
+				MemoryClass::GetStats(MEMORY_TAG_GRAPHICS, stats);
+				graphicsBytes.push_back(stats.current / 1024.0);
+			}
+			graphics.Shutdown();
+		}
+
+		MemoryClass::GetTotalStats(stats);
+		leaks.push_back((double)((long long)stats.live - (long long)before.live));
+	}
+
+	pool.Shutdown();
+
+	// the pool and every scene are gone, the report has to be empty
+	if (MemoryClass::GetLeakReport(report, sizeof(report)) > 0)
+	{
+		fputs(report, stderr);
+		result = false;
+	}
+
+	WriteResult(fout, "memory", "heap_object", "ns", heapTimes);
+	WriteResult(fout, "memory", "tracked_object", "ns", trackedTimes);
+	WriteResult(fout, "memory", "pool_object", "ns", poolTimes);
+	WriteResult(fout, "memory", "scene", "KB", sceneBytes);
+	WriteResult(fout, "memory", "graphics", "KB", graphicsBytes);
+	WriteResult(fout, "memory", "leaks", "count", leaks);
+
+	return result;
+}
+
+bool BenchmarkClass::Handles(std::ofstream& fout)
+{
+	struct ObjectType
+	{
+		int id;
+		float values[15];
+	};
+
+	std::vector<double> pointerLookupTimes, handleLookupTimes, pointerIterateTimes, poolIterateTimes, churnTimes, stale, errors;
+	std::vector<ObjectType*> pointers;
+	std::vector<HandleType<ObjectType>> handles;
+	std::vector<int> order;
+	HandlePoolClass<ObjectType> pool;
+	RandomClass random(1);
+	ObjectType* object;
+	double start;
+	long long sum;
+	int destroyed, caught, wrong;
+
+	// the same objects once allocated one by one and once in the pool, visited in a random order
+	pointers.resize(BENCHMARK_HANDLE_OBJECTS);
+	handles.resize(BENCHMARK_HANDLE_OBJECTS);
+	order.resize(BENCHMARK_HANDLE_OBJECTS);
+	pool.Reserve(BENCHMARK_HANDLE_OBJECTS);
+	for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS; i++)
+	{
+		pointers[i] = new ObjectType;
+		pointers[i]->id = i;
+
+		handles[i] = pool.Create();
+		pool.Get(handles[i])->id = i;
+
+		order[i] = i;
+	}
+	for (int i = BENCHMARK_HANDLE_OBJECTS - 1; i > 0; i--)
+	{
+		std::swap(order[i], order[random.NextInt(i + 1)]);
+	}
+
+	sum = 0;
+	for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+	{
+		// a lookup through a raw pointer against one through the slot of a handle
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS; i++)
+		{
+			sum += pointers[order[i]]->id;
+		}
+		pointerLookupTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_HANDLE_OBJECTS);
+
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS; i++)
+		{
+			sum += pool.Get(handles[order[i]])->id;
+		}
+		handleLookupTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_HANDLE_OBJECTS);
+
+		// a pass over all the objects, scattered on the heap or packed in the pool
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS; i++)
+		{
+			sum += pointers[i]->id;
+		}
+		pointerIterateTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_HANDLE_OBJECTS);
+
+		start = GetTime();
+		object = pool.GetData();
+		for (int i = 0; i < pool.GetCount(); i++)
+		{
+			sum += object[i].id;
+		}
+		poolIterateTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_HANDLE_OBJECTS);
+
+		// destroy a random half and create the objects again, the slots are reused with a new
+		//  generation so every handle to a destroyed object has to be caught
+		destroyed = 0;
+		caught = 0;
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS / 2; i++)
+		{
+			destroyed += pool.Destroy(handles[order[i]]) ? 1 : 0;
+		}
+		for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS / 2; i++)
+		{
+			HandleType<ObjectType> handle = pool.Create();
+			pool.Get(handle)->id = -1;
+
+			caught += pool.Get(handles[order[i]]) ? 0 : 1;
+			handles[order[i]] = handle;
+		}
+		churnTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_HANDLE_OBJECTS);
+		stale.push_back(destroyed > 0 ? 100.0 * caught / destroyed : 0.0);
+
+		// the objects that were moved into the holes are still found through their handles
+		wrong = 0;
+		for (int i = BENCHMARK_HANDLE_OBJECTS / 2; i < BENCHMARK_HANDLE_OBJECTS; i++)
+		{
+			object = pool.Get(handles[order[i]]);
+			wrong += (!object || object->id != order[i]) ? 1 : 0;
+		}
+		errors.push_back(wrong);
+
+		// give the new objects the ids of the ones they replaced for the next trial
+		for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS / 2; i++)
+		{
+			pool.Get(handles[order[i]])->id = order[i];
+		}
+
+		// the next trial destroys another half
+		for (int i = BENCHMARK_HANDLE_OBJECTS - 1; i > 0; i--)
+		{
+			std::swap(order[i], order[random.NextInt(i + 1)]);
+		}
+	}
+
+	for (int i = 0; i < BENCHMARK_HANDLE_OBJECTS; i++)
+	{
+		delete pointers[i];
+	}
+	pool.Clear();
+
+	// keep the lookups from being optimized away
+	if (sum == 0)
+	{
+		return false;
+	}
+
+	WriteResult(fout, "handles", "pointer_lookup", "ns", pointerLookupTimes);
+	WriteResult(fout, "handles", "handle_lookup", "ns", handleLookupTimes);
+	WriteResult(fout, "handles", "pointer_iterate", "ns", pointerIterateTimes);
+	WriteResult(fout, "handles", "pool_iterate", "ns", poolIterateTimes);
+	WriteResult(fout, "handles", "churn", "ns", churnTimes);
+	WriteResult(fout, "handles", "stale_caught", "%", stale);
+	WriteResult(fout, "handles", "wrong_objects", "count", errors);
+
+	for (size_t i = 0; i < errors.size(); i++)
+	{
+		if (errors[i] > 0 || stale[i] < 100.0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool BenchmarkClass::Entities(std::ofstream& fout)
+{
+	// one record per object with everything in it, like the model list kept its models
+	struct ObjectType
+	{
+		XMFLOAT4 color;
+		float positionX, positionY, positionZ;
+		float radius;
+		MeshHandleType mesh;
+		float velocityX, velocityY, velocityZ;
+	};
+
+	struct MoveJobType
+	{
+		std::vector<EntityChunkType>* chunks;
+		float time;
+	};
+
+	const unsigned int mask = (1u << COMPONENT_POSITION) | (1u << COMPONENT_VELOCITY) | (1u << COMPONENT_RADIUS) | (1u << COMPONENT_FLAGS);
+	const unsigned int moveMask = (1u << COMPONENT_POSITION) | (1u << COMPONENT_VELOCITY);
+	std::vector<double> createTimes, columnTimes, parallelTimes, recordTimes, addTimes, removeTimes, errors;
+	std::vector<EntityChunkType> chunks;
+	std::vector<EntityType> entities;
+	std::vector<ObjectType> objects;
+	EntityStoreClass store;
+	RandomClass random(1);
+	ColorComponentType color;
+	MoveJobType job;
+	double start;
+	float sum;
+	int index, wrong, count;
+	bool result;
+
+	// the entities numbered by their flags, so a check finds out if a move mixed up their rows
+	result = store.Initialize(MEMORY_TAG_GENERAL) && store.Reserve(mask, BENCHMARK_ENTITY_COUNT);
+	entities.resize(BENCHMARK_ENTITY_COUNT);
+
+	start = GetTime();
+	for (int i = 0; i < BENCHMARK_ENTITY_COUNT && result; i++)
+	{
+		entities[i] = store.Create(mask);
+		result = !entities[i].IsNull();
+		if (result)
+		{
+			store.Get<VelocityComponentType>(entities[i])->x = 1.f;
+			store.Get<FlagsComponentType>(entities[i])->flags = (unsigned int)i;
+		}
+	}
+	createTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_ENTITY_COUNT);
+
+	objects.resize(BENCHMARK_ENTITY_COUNT);
+	for (int i = 0; i < BENCHMARK_ENTITY_COUNT; i++)
+	{
+		objects[i].velocityX = 1.f;
+	}
+
+	auto moveJob = [](void* data, int begin, int end)
+	{
+		MoveJobType* move = (MoveJobType*)data;
+
+		for (int chunk = begin; chunk < end; chunk++)
+		{
+			const EntityChunkType& rows = (*move->chunks)[chunk];
+			PositionComponentType* positions = rows.Get<PositionComponentType>();
+			VelocityComponentType* velocities = rows.Get<VelocityComponentType>();
+
+			for (int i = 0; i < rows.count; i++)
+			{
+				positions[i].x += velocities[i].x * move->time;
+				positions[i].y += velocities[i].y * move->time;
+				positions[i].z += velocities[i].z * move->time;
+			}
+		}
+	};
+
+	job.chunks = &chunks;
+	job.time = 0.001f;
+
+	for (int trial = 0; trial < BENCHMARK_TRIALS && result; trial++)
+	{
+		// move the entities along their velocity through the columns that hold them
+		start = GetTime();
+		store.Query(moveMask, chunks);
+		moveJob(&job, 0, (int)chunks.size());
+		columnTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_ENTITY_COUNT);
+
+		// the same as a job for every chunk
+		start = GetTime();
+		{
+			JobCounterType counter;
+
+			store.Query(moveMask, chunks);
+			JobSystemClass::ParallelFor(moveJob, &job, 0, (int)chunks.size(), 1, &counter);
+			JobSystemClass::Wait(&counter);
+		}
+		parallelTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_ENTITY_COUNT);
+
+		// and through records that carry every component along
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_ENTITY_COUNT; i++)
+		{
+			objects[i].positionX += objects[i].velocityX * job.time;
+			objects[i].positionY += objects[i].velocityY * job.time;
+			objects[i].positionZ += objects[i].velocityZ * job.time;
+		}
+		recordTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_ENTITY_COUNT);
+
+		// color random entities, they move to another archetype and the last rows fill the holes
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_ENTITY_CHANGES; i++)
+		{
+			color.red = (float)i;
+			store.Add(entities[random.NextInt(BENCHMARK_ENTITY_COUNT)], color);
+		}
+		addTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_ENTITY_CHANGES);
+
+		// and move all of them back, from the last row on so no row is moved before it is visited
+		store.Query(1u << COMPONENT_COLOR, chunks);
+		count = chunks.empty() ? 0 : chunks.back().first + chunks.back().count;
+		start = GetTime();
+		for (int chunk = (int)chunks.size() - 1; chunk >= 0; chunk--)
+		{
+			for (int i = chunks[chunk].count - 1; i >= 0; i--)
+			{
+				store.Remove<ColorComponentType>(chunks[chunk].entities[i]);
+			}
+		}
+		removeTimes.push_back((GetTime() - start) * 1e9 / std::max(count, 1));
+
+		// every entity still finds its own components
+		wrong = 0;
+		for (int i = 0; i < 1000; i++)
+		{
+			index = random.NextInt(BENCHMARK_ENTITY_COUNT);
+			if (store.GetMask(entities[index]) != mask || store.Get<FlagsComponentType>(entities[index])->flags != (unsigned int)index)
+			{
+				wrong++;
+			}
+		}
+		errors.push_back(wrong);
+	}
+
+	// keep the moves from being optimized away
+	sum = 0.f;
+	for (int i = 0; i < BENCHMARK_ENTITY_COUNT && result; i += 1000)
+	{
+		sum += store.Get<PositionComponentType>(entities[i])->x + objects[i].positionX;
+	}
+	if (sum <= 0.f)
+	{
+		result = false;
+	}
+
+	store.Shutdown();
+
+	WriteResult(fout, "entities", "create", "ns", createTimes);
+	WriteResult(fout, "entities", "iterate_columns", "ns", columnTimes);
+	WriteResult(fout, "entities", "iterate_jobs", "ns", parallelTimes);
+	WriteResult(fout, "entities", "iterate_records", "ns", recordTimes);
+	WriteResult(fout, "entities", "add_component", "ns", addTimes);
+	WriteResult(fout, "entities", "remove_component", "ns", removeTimes);
+	WriteResult(fout, "entities", "wrong_entities", "count", errors);
+
+	for (size_t i = 0; i < errors.size(); i++)
+	{
+		result = result && errors[i] == 0;
+	}
+
+	return result;
+}
+
+bool BenchmarkClass::Transforms(std::ofstream& fout)
+{
+	std::vector<double> buildTimes, fullTimes, dirtyTimes, updatedCounts, speedups, errors;
+	std::vector<XMFLOAT3> translations;
+	std::vector<XMFLOAT4X4> worlds;
+	std::vector<int> parents;
+	TransformClass transforms;
+	RandomClass random(1);
+	XMFLOAT4X4 full;
+	XMFLOAT4 rotation;
+	XMFLOAT3 scale;
+	XMMATRIX world;
+	double start, frameTime, fullTime;
+	int node, updated, wrong;
+	bool result;
+
+	// a forest of trees where every node hangs below any earlier node of its tree, so most of them
+	//  are not added after the subtree of their parent and the first update sorts them
+	parents.resize(BENCHMARK_TRANSFORM_NODES);
+	translations.resize(BENCHMARK_TRANSFORM_NODES);
+	for (int i = 0; i < BENCHMARK_TRANSFORM_NODES; i++)
+	{
+		node = i % BENCHMARK_TRANSFORM_TREE;
+		parents[i] = node == 0 ? -1 : i - node + random.NextInt(node);
+		translations[i] = XMFLOAT3(random.NextRange(-1.f, 1.f), random.NextRange(-1.f, 1.f), random.NextRange(-1.f, 1.f));
+	}
+
+	result = transforms.Initialize(BENCHMARK_TRANSFORM_NODES);
+
+	start = GetTime();
+	for (int i = 0; i < BENCHMARK_TRANSFORM_NODES && result; i++)
+	{
+		XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(random.NextRange(-0.1f, 0.1f), random.NextRange(-0.1f, 0.1f), random.NextRange(-0.1f, 0.1f)));
+		scale.x = scale.y = scale.z = random.NextRange(0.99f, 1.01f);
+
+		result = transforms.AddNode(parents[i]) == i;
+		transforms.SetLocal(i, translations[i], rotation, scale);
+	}
+	transforms.Update();
+	buildTimes.push_back((GetTime() - start) * 1000.0);
+
+	// the sort keeps the ids and the parents of the nodes
+	wrong = 0;
+	for (int i = 0; i < BENCHMARK_TRANSFORM_NODES && result; i++)
+	{
+		if (transforms.GetParent(i) != parents[i])
+		{
+			wrong++;
+		}
+	}
+	errors.push_back(wrong);
+
+	worlds.resize(BENCHMARK_TRANSFORM_NODES);
+	for (int trial = 0; trial < BENCHMARK_TRIALS && result; trial++)
+	{
+		// move one percent of the nodes every frame, only their subtrees are updated
+		frameTime = 0.0;
+		updated = 0;
+		for (int frame = 0; frame < BENCHMARK_TRANSFORM_FRAMES; frame++)
+		{
+			for (int i = 0; i < BENCHMARK_TRANSFORM_DIRTY; i++)
+			{
+				node = random.NextInt(BENCHMARK_TRANSFORM_NODES);
+				translations[node].x += random.NextRange(-0.1f, 0.1f);
+				transforms.SetTranslation(node, translations[node]);
+			}
+
+			start = GetTime();
+			transforms.Update();
+			frameTime += GetTime() - start;
+			updated += transforms.GetUpdatedCount();
+		}
+		dirtyTimes.push_back(frameTime * 1000.0 / BENCHMARK_TRANSFORM_FRAMES);
+		updatedCounts.push_back((double)updated / BENCHMARK_TRANSFORM_FRAMES);
+
+		for (int i = 0; i < BENCHMARK_TRANSFORM_NODES; i++)
+		{
+			transforms.GetWorldMatrix(i, world);
+			XMStoreFloat4x4(&worlds[i], world);
+		}
+
+		// every node marked dirty is a full recompute of the hierarchy, it has to come up with the
+		//  same matrices the updates of the dirty subtrees did
+		for (int i = 0; i < BENCHMARK_TRANSFORM_NODES; i++)
+		{
+			transforms.SetTranslation(i, translations[i]);
+		}
+
+		start = GetTime();
+		transforms.Update();
+		fullTime = GetTime() - start;
+		fullTimes.push_back(fullTime * 1e9 / BENCHMARK_TRANSFORM_NODES);
+		speedups.push_back(fullTime * BENCHMARK_TRANSFORM_FRAMES / std::max(frameTime, 1e-9));
+
+		wrong = 0;
+		for (int i = 0; i < BENCHMARK_TRANSFORM_NODES; i++)
+		{
+			transforms.GetWorldMatrix(i, world);
+			XMStoreFloat4x4(&full, world);
+			if (memcmp(&full, &worlds[i], sizeof(full)) != 0)
+			{
+				wrong++;
+			}
+		}
+		errors.push_back(wrong);
+	}
+
+	transforms.Shutdown();
+
+	WriteResult(fout, "transforms", "build_sort", "ms", buildTimes);
+	WriteResult(fout, "transforms", "full_update", "ns", fullTimes);
+	WriteResult(fout, "transforms", "dirty_update", "ms", dirtyTimes);
+	WriteResult(fout, "transforms", "dirty_nodes_updated", "count", updatedCounts);
+	WriteResult(fout, "transforms", "dirty_speedup", "x", speedups);
+	WriteResult(fout, "transforms", "wrong_nodes", "count", errors);
+
+	for (size_t i = 0; i < errors.size(); i++)
+	{
+		result = result && errors[i] == 0;
+	}
+
+	return result;
+}
+
+bool BenchmarkClass::Streaming(std::ofstream& fout)
+{
+	std::vector<double> frameTimes, loadCounts, evictCounts, peakBytes, overBudgetCounts, outOfOrderCounts, notLeastRecentCounts;
+	std::vector<double> failCounts, retryCounts;
+	std::vector<XMFLOAT3> centers;
+	std::vector<float> radii;
+	StreamingCheckType check;
+	TextureStreamerClass streamer;
+	RandomClass random(m_scene.seed);
+	XMFLOAT3 camera;
+	double start, time;
+	float pixelScale, distance, pixels, along;
+	int size, residentMip, mip, overBudget;
+	unsigned long long peak;
+	static const int blockBytes[4] = { 8, 16, 0, 0 };		// DXT1, DXT5, 32 and 64 bit
+	static const int bitsPerPixel[4] = { 0, 0, 32, 64 };
+
+	// textures of 256 to 2048 pixels in compressed and uncompressed formats on objects along the z axis
+	for (int i = 0; i < BENCHMARK_STREAMING_TEXTURES; i++)
+	{
+		size = 256 << random.NextInt(4);
+		mip = (int)random.NextInt(4);
+		check.width.push_back(size);
+		check.height.push_back(size);
+		check.mipCount.push_back((int)log2f((float)size) + 1);
+		check.blockBytes.push_back(blockBytes[mip]);
+		check.bitsPerPixel.push_back(bitsPerPixel[mip]);
+		centers.push_back(XMFLOAT3(random.NextRange(-30.f, 30.f), random.NextRange(-5.f, 5.f), random.NextRange(0.f, BENCHMARK_STREAMING_LENGTH)));
+		radii.push_back(random.NextRange(1.f, 4.f));
+	}
+
+	pixelScale = (float)BENCHMARK_STREAMING_SCREEN_HEIGHT / (2.f * tanf(BENCHMARK_STREAMING_FOV * 0.5f));
+
+	for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+	{
+		if (!streamer.Initialize(BENCHMARK_STREAMING_BUDGET, BENCHMARK_STREAMING_SCREEN_HEIGHT, BENCHMARK_STREAMING_FOV, StreamMips, &check))
+		{
+			return false;
+		}
+
+		// every texture starts with its mips up to 64 pixels like the renderer loads them
+		check.residentMips.clear();
+		check.lastNeeded.clear();
+		check.priorities.assign(BENCHMARK_STREAMING_TEXTURES, 0.f);
+		check.failedMips.assign(BENCHMARK_STREAMING_TEXTURES, -1);
+		check.failed.assign(BENCHMARK_STREAMING_TEXTURES, false);
+		check.frame = 0;
+		check.loads = 0;
+		check.outOfOrder = 0;
+		check.notLeastRecent = 0;
+		check.retried = 0;
+		for (int i = 0; i < BENCHMARK_STREAMING_TEXTURES; i++)
+		{
+			residentMip = 0;
+			while ((check.width[i] >> residentMip) > 64)
+			{
+				residentMip++;
+			}
+			check.residentMips.push_back(residentMip);
+			check.lastNeeded.push_back(std::vector<unsigned long>(check.mipCount[i], 0));
+			if (streamer.RegisterTexture(check.width[i], check.height[i], check.mipCount[i], check.bitsPerPixel[i],
+				check.blockBytes[i], residentMip) != i)
+			{
+				return false;
+			}
+		}
+
+		overBudget = 0;
+		peak = 0;
+		time = 0.0;
+		for (int frame = 0; frame < BENCHMARK_STREAMING_FRAMES; frame++)
+		{
+			// the camera flies down the z axis and back, swaying from side to side, and looks ahead
+			along = (float)(frame % (BENCHMARK_STREAMING_FRAMES / 2)) / (float)(BENCHMARK_STREAMING_FRAMES / 2);
+			camera.x = 20.f * sinf((float)frame * 0.01f);
+			camera.y = 0.f;
+			camera.z = (frame < BENCHMARK_STREAMING_FRAMES / 2 ? along : 1.f - along) * (BENCHMARK_STREAMING_LENGTH + 100.f) - 50.f;
+
+			start = GetTime();
+			streamer.BeginFrame();
+			check.frame++;
+			std::fill(check.priorities.begin(), check.priorities.end(), 0.f);
+			for (int i = 0; i < BENCHMARK_STREAMING_TEXTURES; i++)
+			{
+				distance = sqrtf((centers[i].x - camera.x) * (centers[i].x - camera.x) + (centers[i].y - camera.y) *
+					(centers[i].y - camera.y) + (centers[i].z - camera.z) * (centers[i].z - camera.z));
+				if (distance > BENCHMARK_STREAMING_VIEW || centers[i].z + radii[i] < camera.z)
+				{
+					continue;
+				}
+
+				streamer.RequestSphere(i, distance, radii[i]);
+
+				// what the request asks for, worked out apart from the streamer
+				pixels = distance > radii[i] ? 2.f * radii[i] * pixelScale / distance : 1.e9f;
+				check.priorities[i] = std::max(check.priorities[i], pixels);
+				for (mip = streamer.GetRequiredMip(i, distance, radii[i]); mip < check.mipCount[i]; mip++)
+				{
+					check.lastNeeded[i][mip] = check.frame;
+				}
+			}
+
+			check.lastPriority = FLT_MAX;
+			streamer.Update(BENCHMARK_STREAMING_LOADS);
+			time += GetTime() - start;
+
+			// the loads that failed on the loader thread are reported back like the renderer does
+			for (int i = 0; i < BENCHMARK_STREAMING_TEXTURES; i++)
+			{
+				if (check.failedMips[i] >= 0)
+				{
+					streamer.FailLoad(i, std::max(check.width[i], check.height[i]) >> check.failedMips[i]);
+					check.residentMips[i] = check.failedMips[i];
+					check.failedMips[i] = -1;
+				}
+			}
+
+			// the mips the owner holds never go over the budget, and the streamer counts the same bytes
+			if (GetStreamedBytes(check) > BENCHMARK_STREAMING_BUDGET || GetStreamedBytes(check) != streamer.GetResidentBytes())
+			{
+				overBudget++;
+			}
+			peak = std::max(peak, GetStreamedBytes(check));
+		}
+
+		frameTimes.push_back(time * 1e6 / BENCHMARK_STREAMING_FRAMES);
+		loadCounts.push_back((double)streamer.GetLoadCount());
+		evictCounts.push_back((double)streamer.GetEvictCount());
+		peakBytes.push_back((double)peak / (1024.0 * 1024.0));
+		overBudgetCounts.push_back((double)overBudget);
+		outOfOrderCounts.push_back((double)check.outOfOrder);
+		notLeastRecentCounts.push_back((double)check.notLeastRecent);
+		failCounts.push_back((double)streamer.GetFailCount());
+		retryCounts.push_back((double)check.retried);
+
+		streamer.Shutdown();
+	}
+
+	WriteResult(fout, "streaming", "frame", "us", frameTimes);
+	WriteResult(fout, "streaming", "loads", "count", loadCounts);
+	WriteResult(fout, "streaming", "evictions", "count", evictCounts);
+	WriteResult(fout, "streaming", "peak_resident", "MB", peakBytes);
+	WriteResult(fout, "streaming", "over_budget", "count", overBudgetCounts);
+	WriteResult(fout, "streaming", "out_of_order", "count", outOfOrderCounts);
+	WriteResult(fout, "streaming", "not_least_recent", "count", notLeastRecentCounts);
+	WriteResult(fout, "streaming", "failed_loads", "count", failCounts);
+	WriteResult(fout, "streaming", "retried_loads", "count", retryCounts);
+
+	// the path has to stream, evict and retry the failed loads, and without breaking any of the rules
+	return Median(loadCounts) > 0.0 && Median(evictCounts) > 0.0 && Median(retryCounts) > 0.0 && *std::max_element(overBudgetCounts.begin(), overBudgetCounts.end()) == 0.0 &&
+		*std::max_element(outOfOrderCounts.begin(), outOfOrderCounts.end()) == 0.0 &&
+		*std::max_element(notLeastRecentCounts.begin(), notLeastRecentCounts.end()) == 0.0;
+}
+
+bool BenchmarkClass::Frustum(std::ofstream& fout)
+{
+	std::vector<double> pointTimes, pointCornerTimes, cubeTimes, cubeCornerTimes, rectangleTimes, rectangleCornerTimes;
+	std::vector<double> cubeBatchTimes, rectangleBatchTimes, mismatchCounts;
+	std::vector<XMFLOAT3> centers, sizes;
+	std::vector<float> radii;
+	std::vector<FrustumResultType> results;
+	FrustumClass frustum;
+	RandomClass random(m_scene.seed);
+	FrustumResultType classified, batched;
+	XMFLOAT4 plane;
+	float distance, extent, nearest;
+	bool expected, inside;
+	volatile int visible;
+	int mismatches;
+	double start;
+
+	// check the one dot product paths against the eight corner tests on random boxes and frustums
+	mismatches = 0;
+	for (int i = 0; i < BENCHMARK_FRUSTUM_CASES; i++)
+	{
+		if (i % (BENCHMARK_FRUSTUM_CASES / BENCHMARK_FRUSTUM_CAMERAS) == 0)
+		{
+			ConstructRandomFrustum(random, frustum);
+		}
+
+		XMFLOAT3 center(random.NextRange(-60.f, 60.f), random.NextRange(-60.f, 60.f), random.NextRange(-60.f, 60.f));
+		XMFLOAT3 size(random.NextRange(0.f, 5.f), random.NextRange(0.f, 5.f), random.NextRange(0.f, 5.f));
+
+		// boxes, and the cubes of their x size, that touch a plane within the tolerance may go either way
+		nearest = FLT_MAX;
+		for (int j = 0; j < 6; j++)
+		{
+			plane = frustum.GetPlane(j);
+			distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			extent = fabsf(plane.x) * size.x + fabsf(plane.y) * size.y + fabsf(plane.z) * size.z;
+			nearest = std::min(nearest, std::min(fabsf(distance), std::min(fabsf(distance + extent), fabsf(distance - extent))));
+
+			extent = (fabsf(plane.x) + fabsf(plane.y) + fabsf(plane.z)) * size.x;
+			nearest = std::min(nearest, std::min(fabsf(distance + extent), fabsf(distance - extent)));
+		}
+		if (nearest < BENCHMARK_FRUSTUM_TOLERANCE)
+		{
+			continue;
+		}
+
+		if (frustum.CheckPoint(center.x, center.y, center.z) != CheckPointPlanes(frustum, center.x, center.y, center.z))
+		{
+			mismatches++;
+		}
+
+		if (frustum.CheckCube(center.x, center.y, center.z, size.x) !=
+			CheckRectangleCorners(frustum, center.x, center.y, center.z, size.x, size.x, size.x))
+		{
+			mismatches++;
+		}
+
+		expected = CheckRectangleCorners(frustum, center.x, center.y, center.z, size.x, size.y, size.z);
+		if (frustum.CheckRectangle(center.x, center.y, center.z, size.x, size.y, size.z) != expected)
+		{
+			mismatches++;
+		}
+
+		// the three state result has to agree with the test, and inside means all eight corners are inside
+		classified = frustum.ClassifyRectangle(center.x, center.y, center.z, size.x, size.y, size.z);
+		if ((classified != FRUSTUM_OUTSIDE) != expected)
+		{
+			mismatches++;
+		}
+
+		inside = true;
+		for (int corner = 0; corner < 8; corner++)
+		{
+			inside = inside && CheckPointPlanes(frustum, center.x + (corner & 1 ? size.x : -size.x),
+				center.y + (corner & 2 ? size.y : -size.y), center.z + (corner & 4 ? size.z : -size.z));
+		}
+		if ((classified == FRUSTUM_INSIDE) != inside)
+		{
+			mismatches++;
+		}
+
+		// the batched variants give the same result as one at a time
+		frustum.ClassifyRectangles(&center, &size, 1, &batched);
+		if (batched != classified)
+		{
+			mismatches++;
+		}
+
+		frustum.ClassifyCubes(&center, &size.x, 1, &batched);
+		if (batched != frustum.ClassifyCube(center.x, center.y, center.z, size.x))
+		{
+			mismatches++;
+		}
+	}
+	mismatchCounts.push_back((double)mismatches);
+
+	// time both paths on the same boxes
+	centers.resize(BENCHMARK_FRUSTUM_OBJECTS);
+	sizes.resize(BENCHMARK_FRUSTUM_OBJECTS);
+	radii.resize(BENCHMARK_FRUSTUM_OBJECTS);
+	results.resize(BENCHMARK_FRUSTUM_OBJECTS);
+	for (int i = 0; i < BENCHMARK_FRUSTUM_OBJECTS; i++)
+	{
+		centers[i] = XMFLOAT3(random.NextRange(-60.f, 60.f), random.NextRange(-60.f, 60.f), random.NextRange(-60.f, 60.f));
+		sizes[i] = XMFLOAT3(random.NextRange(0.f, 5.f), random.NextRange(0.f, 5.f), random.NextRange(0.f, 5.f));
+		radii[i] = sizes[i].x;
+	}
+	ConstructRandomFrustum(random, frustum);
+
+	// the visible count is kept so the loops are not optimized away
+	visible = 0;
+	auto measure = [&](std::vector<double>& times, auto body)
+	{
+		int count = 0;
+
+		start = GetTime();
+		for (int i = 0; i < BENCHMARK_FRUSTUM_OBJECTS; i++)
+		{
+			count += body(i);
+		}
+		times.push_back((GetTime() - start) * 1e9 / BENCHMARK_FRUSTUM_OBJECTS);
+
+		visible = visible + count;
+	};
+
+	for (int trial = 0; trial < BENCHMARK_TRIALS; trial++)
+	{
+		measure(pointCornerTimes, [&](int i) { return CheckPointPlanes(frustum, centers[i].x, centers[i].y, centers[i].z); });
+		measure(pointTimes, [&](int i) { return frustum.CheckPoint(centers[i].x, centers[i].y, centers[i].z); });
+		measure(cubeCornerTimes, [&](int i)
+		{
+			return CheckRectangleCorners(frustum, centers[i].x, centers[i].y, centers[i].z, radii[i], radii[i], radii[i]);
+		});
+		measure(cubeTimes, [&](int i) { return frustum.CheckCube(centers[i].x, centers[i].y, centers[i].z, radii[i]); });
+		measure(rectangleCornerTimes, [&](int i)
+		{
+			return CheckRectangleCorners(frustum, centers[i].x, centers[i].y, centers[i].z, sizes[i].x, sizes[i].y, sizes[i].z);
+		});
+		measure(rectangleTimes, [&](int i)
+		{
+			return frustum.CheckRectangle(centers[i].x, centers[i].y, centers[i].z, sizes[i].x, sizes[i].y, sizes[i].z);
+		});
+
+		start = GetTime();
+		frustum.ClassifyCubes(centers.data(), radii.data(), BENCHMARK_FRUSTUM_OBJECTS, results.data());
+		cubeBatchTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_FRUSTUM_OBJECTS);
+		visible = visible + results[trial];
+
+		start = GetTime();
+		frustum.ClassifyRectangles(centers.data(), sizes.data(), BENCHMARK_FRUSTUM_OBJECTS, results.data());
+		rectangleBatchTimes.push_back((GetTime() - start) * 1e9 / BENCHMARK_FRUSTUM_OBJECTS);
+		visible = visible + results[trial];
+	}
+
+	WriteResult(fout, "frustum", "mismatches", "count", mismatchCounts);
+	WriteResult(fout, "frustum", "point_planes", "ns", pointCornerTimes);
+	WriteResult(fout, "frustum", "point", "ns", pointTimes);
+	WriteResult(fout, "frustum", "cube_corners", "ns", cubeCornerTimes);
+	WriteResult(fout, "frustum", "cube", "ns", cubeTimes);
+	WriteResult(fout, "frustum", "cube_batch", "ns", cubeBatchTimes);
+	WriteResult(fout, "frustum", "rectangle_corners", "ns", rectangleCornerTimes);
+	WriteResult(fout, "frustum", "rectangle", "ns", rectangleTimes);
+	WriteResult(fout, "frustum", "rectangle_batch", "ns", rectangleBatchTimes);
+
+	return mismatches == 0;
+}
+
+void BenchmarkClass::ConstructRandomFrustum(RandomClass& random, FrustumClass& frustum)
+{
+	XMVECTOR position, direction, up;
+
+	// a camera somewhere in the middle of the boxes looking in any direction
+	position = XMVectorSet(random.NextRange(-10.f, 10.f), random.NextRange(-10.f, 10.f), random.NextRange(-10.f, 10.f), 1.f);
+	direction = XMVector3Normalize(XMVectorSet(random.NextGaussian(), random.NextGaussian(), random.NextGaussian(), 0.f));
+	up = fabsf(XMVectorGetY(direction)) > 0.9f ? XMVectorSet(1.f, 0.f, 0.f, 0.f) : XMVectorSet(0.f, 1.f, 0.f, 0.f);
+
+	frustum.ConstructFrustum(
+		HEADLESS_SCREEN_DEPTH,
+		XMMatrixPerspectiveFovLH(3.141592654f / 4.f, (float)HEADLESS_SCREEN_WIDTH / (float)HEADLESS_SCREEN_HEIGHT, HEADLESS_SCREEN_NEAR, HEADLESS_SCREEN_DEPTH),
+		XMMatrixLookAtLH(position, position + direction, up)
+	);
+
+	return;
+}
+
+void BenchmarkClass::EmptyJob(void* data, int begin, int end)
+{
+	return;
+}
+
+void BenchmarkClass::FillJob(void* data, int begin, int end)
+{
+	std::vector<int>& values = *(std::vector<int>*)data;
+
+	for (int i = begin; i < end; i++)
+	{
+		values[i] = i;
+	}
+
+	return;
+}
+
+void BenchmarkClass::DoubleJob(void* data, int begin, int end)
+{
+	std::vector<int>& values = *(std::vector<int>*)data;
+	size_t half = values.size() / 2;
+
+	for (int i = begin; i < end; i++)
+	{
+		values[half + i] = 2 * values[i];
+	}
+
+	return;
+}
+
+void BenchmarkClass::SimulateFrame(FrameStateType* state, const std::vector<XMFLOAT3>& positions)
+{
+	float angle, phase;
+	ModelMoveType move;
+
+	// turn the camera around once over the frames
+	angle = 6.2831853f * state->frame / BENCHMARK_HEADLESS_FRAMES;
+	state->position = XMFLOAT3(0.f, 0.f, -3.f);
+	state->direction = XMFLOAT3(sinf(angle), 0.f, cosf(angle));
+	state->up = XMFLOAT3(0.f, 1.f, 0.f);
+
+	// every model takes its turn to bob around where the scene put it
+	for (size_t i = state->frame % BENCHMARK_PIPELINE_MOVED; i < positions.size(); i += BENCHMARK_PIPELINE_MOVED)
+	{
+		phase = 0.1f * state->frame + (float)i;
+		move.index = (int)i;
+		move.position = XMFLOAT3(positions[i].x + 0.5f * sinf(phase), positions[i].y + 0.5f * cosf(phase),
+			positions[i].z + 0.25f * sinf(2.f * phase));
+		state->moves.push_back(move);
+	}
+
+	return;
+}
+
+void BenchmarkClass::RecordEvent(void* data, const PlatformEventType& event)
+{
+	EventLatencyType* latency = (EventLatencyType*)data;
+	double waited;
+
+	// how long the event was queued before the loop took it
+	waited = latency->platform->GetTime() - event.time;
+	latency->total += waited;
+	latency->worst = std::max(latency->worst, waited);
+	latency->count++;
+
+	return;
+}
+
+bool BenchmarkClass::StreamMips(void* data, int textureId, int topMip)
+{
+	StreamingCheckType* check = (StreamingCheckType*)data;
+	int resident;
+	unsigned long needed;
+
+	resident = check->residentMips[textureId];
+	if (topMip < resident)
+	{
+		// the loads of an update go from the biggest object on screen down
+		if (check->priorities[textureId] > check->lastPriority)
+		{
+			check->outOfOrder++;
+		}
+		check->lastPriority = check->priorities[textureId];
+
+		// a texture whose last load failed is loaded again
+		if (check->failed[textureId])
+		{
+			check->retried++;
+		}
+
+		// every few loads fail on the loader thread, the owner keeps the mips it had
+		check->loads++;
+		check->failed[textureId] = check->loads % BENCHMARK_STREAMING_FAIL == 0;
+		if (check->failed[textureId])
+		{
+			check->failedMips[textureId] = resident;
+		}
+	}
+	else if (topMip > resident)
+	{
+		// a mip that is needed this frame is never evicted, and of the others the one that was needed the longest
+		//  time ago goes first
+		needed = check->lastNeeded[textureId][resident];
+		if (needed == check->frame)
+		{
+			check->notLeastRecent++;
+		}
+		for (size_t i = 0; i < check->residentMips.size(); i++)
+		{
+			if (check->residentMips[i] < check->mipCount[i] - 1 && check->lastNeeded[i][check->residentMips[i]] != check->frame &&
+				check->lastNeeded[i][check->residentMips[i]] < needed)
+			{
+				check->notLeastRecent++;
+				break;
+			}
+		}
+	}
+
+	check->residentMips[textureId] = topMip;
+
+	return true;
+}
+
+unsigned long long BenchmarkClass::GetStreamedBytes(const StreamingCheckType& check)
+{
+	unsigned long long bytes = 0;
+
+	for (size_t i = 0; i < check.residentMips.size(); i++)
+	{
+		for (int mip = check.residentMips[i]; mip < check.mipCount[i]; mip++)
+		{
+			bytes += TextureStreamerClass::GetMipBytes(check.width[i], check.height[i], check.bitsPerPixel[i], check.blockBytes[i], mip);
+		}
+	}
+
+	return bytes;
+}
+
+void BenchmarkClass::StepSpring(double& position, double& velocity, double time)
+{
+	// a spring swinging once a second, semi implicit euler like a game would move it
+	const double stiffness = 4.0 * 3.14159265358979 * 3.14159265358979 / (1000.0 * 1000.0);
+
+	velocity -= stiffness * position * time;
+	position += velocity * time;
+
+	return;
+}
+
+bool BenchmarkClass::CheckRectangleCorners(FrustumClass& frustum, float xCenter, float yCenter, float zCenter,
+	float xSize, float ySize, float zSize)
+{
+	XMVECTOR plane;
+	XMFLOAT4 planeData;
+	XMFLOAT3 corner, distance;
+	bool front;
+
+	// the test the frustum object did before, each of the eight corners against every plane
+	for (int i = 0; i < 6; i++)
+	{
+		planeData = frustum.GetPlane(i);
+		plane = XMLoadFloat4(&planeData);
+
+		front = false;
+		for (int j = 0; j < 8 && !front; j++)
+		{
+			corner = XMFLOAT3(xCenter + (j & 1 ? xSize : -xSize), yCenter + (j & 2 ? ySize : -ySize), zCenter + (j & 4 ? zSize : -zSize));
+			XMStoreFloat3(&distance, XMVectorSum(XMPlaneDotCoord(plane, XMLoadFloat3(&corner))));
+			front = distance.x >= 0.f;
+		}
+
+		if (!front)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool BenchmarkClass::CheckPointPlanes(FrustumClass& frustum, float x, float y, float z)
+{
+	XMVECTOR plane;
+	XMFLOAT4 planeData;
+	XMFLOAT3 point, distance;
+
+	// the point test the frustum object did before
+	for (int i = 0; i < 6; i++)
+	{
+		planeData = frustum.GetPlane(i);
+		plane = XMLoadFloat4(&planeData);
+		point = XMFLOAT3(x, y, z);
+
+		XMStoreFloat3(&distance, XMVectorSum(XMPlaneDotCoord(plane, XMLoadFloat3(&point))));
+		if (distance.x < 0.f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+double BenchmarkClass::GetTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double BenchmarkClass::GetCpuTime()
+{
+	// milliseconds the process spent on any core
+#ifdef _WIN32
+	FILETIME creation, exit, kernel, user;
+	ULARGE_INTEGER kernelTime, userTime;
+
+	GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+	kernelTime.LowPart = kernel.dwLowDateTime;
+	kernelTime.HighPart = kernel.dwHighDateTime;
+	userTime.LowPart = user.dwLowDateTime;
+	userTime.HighPart = user.dwHighDateTime;
+
+	return (kernelTime.QuadPart + userTime.QuadPart) / 10000.0;
+#else
+	struct timespec time;
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+
+	return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif
+}
+
+double BenchmarkClass::Median(std::vector<double> samples)
+{
+	size_t middle;
+
+	if (samples.empty())
+	{
+		return 0.0;
+	}
+
+	middle = samples.size() / 2;
+	std::nth_element(samples.begin(), samples.begin() + middle, samples.end());
+
+	return samples[middle];
+}
+
+void BenchmarkClass::DropFileCache(const char* filename)
+{
+#ifndef _WIN32
+	int file;
+
+	// ask the kernel to forget the cached pages of the file so the next read is cold
+	file = open(filename, O_RDONLY);
+	if (file >= 0)
+	{
+		posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+		close(file);
+	}
+#endif
+
+	// on windows the file cache cannot be dropped per file, the numbers there are warm
+	return;
+}
+
+void BenchmarkClass::ReadThrottled(unsigned long long bytes, double bandwidth)
+{
+	// simulate a slow disk by waiting as long as reading the bytes at the given MB/s would take
+	std::this_thread::sleep_for(std::chrono::duration<double>(bytes / (bandwidth * 1024.0 * 1024.0)));
+
+	return;
+}
+
+void* BenchmarkClass::ImportBlob(void* context, int id, const AssetDataType& asset)
+{
+	std::vector<unsigned char>* blob;
+	size_t chunk;
+
+	// the import is a copy of the file built a piece at a time, the rest is marked as not imported yet
+	blob = new std::vector<unsigned char>((size_t)asset.size, BENCHMARK_RELOAD_UNFINISHED);
+	for (size_t offset = 0; offset < blob->size(); offset += BENCHMARK_RELOAD_CHUNK)
+	{
+		chunk = std::min((size_t)BENCHMARK_RELOAD_CHUNK, blob->size() - offset);
+		memcpy(blob->data() + offset, asset.data + offset, chunk);
+
+		// let the render thread run while the blob is half done
+		std::this_thread::yield();
+	}
+
+	return blob;
+}
+
+void BenchmarkClass::SwapBlob(void* context, int id, void* resource)
+{
+	std::vector<unsigned char>** live = (std::vector<unsigned char>**)context;
+
+	delete *live;
+	*live = (std::vector<unsigned char>*)resource;
+
+	return;
+}
+
+void BenchmarkClass::ReleaseBlob(void* context, int id, void* resource)
+{
+	delete (std::vector<unsigned char>*)resource;
+
+	return;
+}
+
+void BenchmarkClass::WriteResult(std::ofstream& fout, const char* benchmark, const char* variant,
+	const char* unit, std::vector<double>& samples)
+{
+	// one json object per line, the scene and its seed make the run reproducible
+	fout << "{\"benchmark\":\"" << benchmark << "\",\"variant\":\"" << variant << "\",\"unit\":\"" << unit << "\"";
+	fout << ",\"scene\":\"" << m_sceneName << "\"";
+	fout << ",\"trials\":" << samples.size();
+	fout << ",\"median\":" << Median(samples);
+	fout << ",\"min\":" << (samples.empty() ? 0.0 : *std::min_element(samples.begin(), samples.end()));
+	fout << ",\"max\":" << (samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end()));
+	fout << "}" << std::endl;
+
+	return;
+}
\ No newline at end of file
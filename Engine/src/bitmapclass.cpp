@@ -15,7 +15,8 @@ BitmapClass::~BitmapClass()
 {
 }
 
-bool BitmapClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext, int screenWidth, int screenHeight,
+bool BitmapClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext, PackFileClass* pack, AssetCacheClass* cache,
+	int screenWidth, int screenHeight,
 	char* textureFilename, int bitmapWidth, int bitmapHeight)
 {
 	bool result;
@@ -39,7 +40,7 @@ bool BitmapClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceCo
 	}
 
 	// load the texture for this model
-	result = LoadTexture(device, deviceContext, textureFilename);
+	result = LoadTexture(device, deviceContext, pack, cache, textureFilename);
 	if (!result)
 	{
 		return false;
@@ -226,8 +227,8 @@ bool BitmapClass::UpdateBuffers(ID3D11DeviceContext* deviceContext, int position
 	top = (float)(m_screenHeight / 2) - (float)positionY;
 	bottom = top - (float)m_bitmapHeight;
 
-	// create a temporary vertex array
-	vertices = new VertexType[m_vertexCount];
+	// take a temporary vertex array from the frame arena
+	vertices = FrameArenaClass::Allocate<VertexType>(m_vertexCount);
 	if (!vertices)
 	{
 		return false;
@@ -283,10 +284,7 @@ bool BitmapClass::UpdateBuffers(ID3D11DeviceContext* deviceContext, int position
 		m_vertexBuffer,
 		0
 		);
-
-	// release the vertex array 
-	delete[] vertices;
-	vertices = nullptr;
+	RenderStatsClass::CountMap(sizeof(VertexType) * m_vertexCount);
 
 	return true;
 }
@@ -315,6 +313,7 @@ void BitmapClass::RenderBuffers(ID3D11DeviceContext* deviceContext)
 		DXGI_FORMAT_R32_UINT,	// format
 		0						// offset
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_BUFFER_BINDS, 2);
 
 	// set the type of primitive that should be rendered from this vertex buffer
 	deviceContext->IASetPrimitiveTopology(
@@ -324,7 +323,7 @@ void BitmapClass::RenderBuffers(ID3D11DeviceContext* deviceContext)
 	return;
 }
 
-bool BitmapClass::LoadTexture(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* filename)
+bool BitmapClass::LoadTexture(ID3D11Device* device, ID3D11DeviceContext* deviceContext, PackFileClass* pack, AssetCacheClass* cache, char* filename)
 {
 	bool result;
 
@@ -336,7 +335,7 @@ bool BitmapClass::LoadTexture(ID3D11Device* device, ID3D11DeviceContext* deviceC
 	}
 
 	// initialize the texture object
-	result = m_Texture->Initialize(device, deviceContext, filename);
+	result = m_Texture->Initialize(device, deviceContext, pack, cache, filename);
 	if (!result)
 	{
 		return false;
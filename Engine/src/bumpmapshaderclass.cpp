@@ -19,7 +19,7 @@ BumpMapShaderClass::~BumpMapShaderClass()
 {
 }
 
-bool BumpMapShaderClass::Initialize(ID3D11Device* device, HWND hwnd)
+bool BumpMapShaderClass::Initialize(ID3D11Device* device, HWND hwnd, PackFileClass* pack)
 {
 	bool result;
 
@@ -27,6 +27,7 @@ bool BumpMapShaderClass::Initialize(ID3D11Device* device, HWND hwnd)
 	result = InitializeShader(
 		device, 
 		hwnd, 
+		pack,
 		L"./shader/bumpmap.vs.hlsl", 
 		L"./shader/specmap.ps.hlsl"
 	);
@@ -74,9 +75,12 @@ bool BumpMapShaderClass::Render(ID3D11DeviceContext* deviceContext, int indexCou
 }
 
 bool BumpMapShaderClass::InitializeShader(ID3D11Device* device, HWND hwnd,
-	WCHAR* vsFilename, WCHAR* psFilename)
+	PackFileClass* pack, WCHAR* vsFilename, WCHAR* psFilename)
 {
 	HRESULT result;
+	AssetDataType vertexShaderSource, pixelShaderSource;
+	char filename[128];
+	size_t length;
 	ID3D10Blob* errorMessage;
 	ID3D10Blob* vertexShaderBuffer;
 	ID3D10Blob* pixelShaderBuffer;
@@ -93,18 +97,27 @@ bool BumpMapShaderClass::InitializeShader(ID3D11Device* device, HWND hwnd,
 	vertexShaderBuffer = nullptr;
 	pixelShaderBuffer = nullptr;
 
+	// get the vertex shader source from the pack or the disk
+	wcstombs_s(&length, filename, sizeof(filename), vsFilename, _TRUNCATE);
+	result = pack->Read(filename, vertexShaderSource) ? S_OK : E_FAIL;
+
 	// compile the vertex shader code
-	result = D3DCompileFromFile(
-		vsFilename,							// filename
-		NULL,								// ptr to array of macros
-		NULL,								// ptr to an include interface
-		"BumpMapVertexShader",				// name of the shader function
-		"vs_5_0",							// version of the shader
-		D3D10_SHADER_ENABLE_STRICTNESS,		// compile flags
-		0,									// effect flags
-		&vertexShaderBuffer,				// compiled shader
-		&errorMessage						// lists of errors and warnings
-		);
+	if (SUCCEEDED(result))
+	{
+		result = D3DCompile(
+			vertexShaderSource.data,			// source code
+			(SIZE_T)vertexShaderSource.size,	// size of the source code
+			filename,							// name used in error messages
+			NULL,								// ptr to array of macros
+			NULL,								// ptr to an include interface
+			"BumpMapVertexShader",				// name of the shader function
+			"vs_5_0",							// version of the shader
+			D3D10_SHADER_ENABLE_STRICTNESS,		// compile flags
+			0,									// effect flags
+			&vertexShaderBuffer,				// compiled shader
+			&errorMessage						// lists of errors and warnings
+			);
+	}
 	if (FAILED(result))
 	{
 		// if the shader failed to compile it should have written somthing to error msg
@@ -121,18 +134,27 @@ bool BumpMapShaderClass::InitializeShader(ID3D11Device* device, HWND hwnd,
 		return false;
 	}
 
+	// get the pixel shader source from the pack or the disk
+	wcstombs_s(&length, filename, sizeof(filename), psFilename, _TRUNCATE);
+	result = pack->Read(filename, pixelShaderSource) ? S_OK : E_FAIL;
+
 	// compile the pixel shader code
-	result = D3DCompileFromFile(
-		psFilename,							// filename
-		NULL,								// ptr to array of macros
-		NULL,								// ptr to an include interface
-		"BumpMapPixelShader",				// name of the shader function
-		"ps_5_0",							// version of the shader
-		D3D10_SHADER_ENABLE_STRICTNESS,		// compile flags
-		0,									// effect flags
-		&pixelShaderBuffer,					// compiled shader
-		&errorMessage						// lists of errors and warnings
-		);
+	if (SUCCEEDED(result))
+	{
+		result = D3DCompile(
+			pixelShaderSource.data,				// source code
+			(SIZE_T)pixelShaderSource.size,		// size of the source code
+			filename,							// name used in error messages
+			NULL,								// ptr to array of macros
+			NULL,								// ptr to an include interface
+			"BumpMapPixelShader",				// name of the shader function
+			"ps_5_0",							// version of the shader
+			D3D10_SHADER_ENABLE_STRICTNESS,		// compile flags
+			0,									// effect flags
+			&pixelShaderBuffer,					// compiled shader
+			&errorMessage						// lists of errors and warnings
+			);
+	}
 	if (FAILED(result))
 	{
 		// if the shader failed to compile it should have written somthing to error msg
@@ -449,6 +471,7 @@ bool BumpMapShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		m_matrixBuffer,
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(MatrixBufferType));
 
 	// set the position of the constant buffer in the vertex shader
 	bufferNumber = 0;
@@ -466,6 +489,7 @@ bool BumpMapShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		5,				// number of textures in the array (two textures & one alpha map & one bumpmap) & one specmap
 		textureArray	// texture resource array [5]
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_TEXTURE_BINDS, 5);
 
 	// lock the camera constant buffer so it can be written to
 	result = deviceContext->Map(
@@ -492,6 +516,7 @@ bool BumpMapShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		m_cameraBuffer, 
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(CameraBufferType));
 
 	// set the position of the camera constant buffer in the vertex shader
 	bufferNumber = 1;
@@ -532,6 +557,7 @@ bool BumpMapShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		m_lightBuffer,
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(LightBufferType));
 
 	// set the position of the light constants buffer in the pixel shader
 	bufferNumber = 0;
@@ -554,6 +580,7 @@ void BumpMapShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int in
 	// set the vertex and pixel shaders
 	deviceContext->VSSetShader(m_vertexShader, NULL, 0);
 	deviceContext->PSSetShader(m_pixelShader, NULL, 0);
+	RenderStatsClass::CountShader(m_vertexShader);
 
 	// set the sampler state in the pixel shader
 	deviceContext->PSSetSamplers(
@@ -568,4 +595,5 @@ void BumpMapShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int in
 		0,
 		0
 		);
+	RenderStatsClass::CountDraw(indexCount);
 }
\ No newline at end of file
@@ -299,6 +299,7 @@ bool ColorShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		m_matrixBuffer, 
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(MatrixBufferType));
 
 	// set the position of the constant buffer in the vertex shader
 	bufferNumber = 0;
@@ -329,9 +330,11 @@ void ColorShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int inde
 		NULL, 					// only used if shader uses interfaces
 		0						// number of class-instances in the array
 		);
+	RenderStatsClass::CountShader(m_vertexShader);
 
 	// render the triangles
 	deviceContext->DrawIndexed(indexCount, 0, 0);
+	RenderStatsClass::CountDraw(indexCount);
 
 	return;
 }
\ No newline at end of file
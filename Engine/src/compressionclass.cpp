@@ -0,0 +1,386 @@
+#include "compressionclass.h"
+
+// pre-processing directives
+#define MIN_MATCH 4
+#define LAST_LITERALS 5			// the last bytes of a block are always literals
+#define MATCH_LIMIT 12			// no match may start closer to the end of the block
+#define MAX_OFFSET 65535
+#define HASH_BITS 14
+
+static unsigned int Read32(const unsigned char* ptr)
+{
+	unsigned int value;
+	memcpy(&value, ptr, sizeof(value));
+	return value;
+}
+
+static unsigned int Hash32(unsigned int value)
+{
+	return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static unsigned char* WriteLength(unsigned char* op, int length)
+{
+	// lengths of 15 and more continue in bytes of 255
+	while (length >= 255)
+	{
+		*op++ = 255;
+		length -= 255;
+	}
+	*op++ = (unsigned char)length;
+
+	return op;
+}
+
+bool CompressionClass::Compress(const unsigned char* source, unsigned long long sourceSize, std::vector<unsigned char>& output)
+{
+	unsigned int blockCount, blockSize;
+	std::vector<unsigned char> block;
+	size_t tableSize;
+	int rawSize, compressedSize;
+
+	// the stream starts with the block count and the stored size of every block
+	blockCount = (unsigned int)((sourceSize + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE);
+	tableSize = sizeof(unsigned int) * (1 + blockCount);
+
+	output.resize(tableSize);
+	memcpy(output.data(), &blockCount, sizeof(blockCount));
+
+	// worst case size of a block that does not compress at all
+	block.resize(COMPRESSION_BLOCK_SIZE + COMPRESSION_BLOCK_SIZE / 255 + 16);
+
+	for (unsigned int i = 0; i < blockCount; i++)
+	{
+		rawSize = (int)std::min<unsigned long long>(COMPRESSION_BLOCK_SIZE, sourceSize - (unsigned long long)i * COMPRESSION_BLOCK_SIZE);
+
+		// compress the block, keep it raw if that does not save anything
+		compressedSize = CompressBlock(source + (size_t)i * COMPRESSION_BLOCK_SIZE, rawSize, block.data(), (int)block.size());
+		if (compressedSize > 0 && compressedSize < rawSize)
+		{
+			output.insert(output.end(), block.data(), block.data() + compressedSize);
+			blockSize = (unsigned int)compressedSize;
+		}
+		else
+		{
+			output.insert(output.end(), source + (size_t)i * COMPRESSION_BLOCK_SIZE, source + (size_t)i * COMPRESSION_BLOCK_SIZE + rawSize);
+			blockSize = (unsigned int)rawSize | COMPRESSION_RAW_BLOCK;
+		}
+
+		memcpy(output.data() + sizeof(unsigned int) * (1 + i), &blockSize, sizeof(blockSize));
+	}
+
+	return true;
+}
+
+bool CompressionClass::Decompress(const unsigned char* source, unsigned long long sourceSize,
+	unsigned char* destination, unsigned long long destinationSize, int threadCount)
+{
+	unsigned int blockCount, blockSize;
+	std::vector<unsigned long long> offsets;
+	std::vector<std::thread> threads;
+	std::atomic<unsigned int> nextBlock;
+	DecompressJobType job;
+
+	// read the block table
+	if (sourceSize < sizeof(unsigned int))
+	{
+		return false;
+	}
+	memcpy(&blockCount, source, sizeof(blockCount));
+
+	if (blockCount != (destinationSize + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE ||
+		sourceSize < sizeof(unsigned int) * (1 + (unsigned long long)blockCount))
+	{
+		return false;
+	}
+
+	// find where every block starts so they can be decompressed independently
+	offsets.resize(blockCount + 1);
+	offsets[0] = sizeof(unsigned int) * (1 + (unsigned long long)blockCount);
+	for (unsigned int i = 0; i < blockCount; i++)
+	{
+		memcpy(&blockSize, source + sizeof(unsigned int) * (1 + i), sizeof(blockSize));
+		offsets[i + 1] = offsets[i] + (blockSize & ~COMPRESSION_RAW_BLOCK);
+	}
+
+	if (offsets[blockCount] > sourceSize)
+	{
+		return false;
+	}
+
+	job.source = source;
+	job.destination = destination;
+	job.destinationSize = destinationSize;
+	job.offsets = offsets.data();
+	job.failed = false;
+
+	// the blocks are jobs if the calling thread belongs to the job system
+	if (threadCount > 1 && JobSystemClass::GetThreadCount() > 1 && JobSystemClass::GetThreadIndex() >= 0)
+	{
+		JobCounterType counter;
+
+		JobSystemClass::ParallelFor(DecompressBlocks, &job, 0, (int)blockCount, 1, &counter);
+		JobSystemClass::Wait(&counter);
+
+		return !job.failed;
+	}
+
+	nextBlock = 0;
+
+	// otherwise every worker takes the next block until all of them are done
+	auto worker = [&]()
+	{
+		unsigned int index;
+
+		while ((index = nextBlock++) < blockCount && !job.failed)
+		{
+			DecompressBlocks(&job, (int)index, (int)index + 1);
+		}
+	};
+
+	// use no more threads than there are blocks, the calling thread is one of them
+	threadCount = std::max(1, std::min(threadCount, (int)blockCount));
+	for (int i = 1; i < threadCount; i++)
+	{
+		threads.push_back(std::thread(worker));
+	}
+
+	worker();
+
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+
+	return !job.failed;
+}
+
+int CompressionClass::CompressBlock(const unsigned char* source, int sourceSize, unsigned char* destination, int destinationCapacity)
+{
+	int hashTable[1 << HASH_BITS];
+	int ip, anchor, reference, literalLength, matchLength, matchEnd, matchStart;
+	unsigned int sequence, hash;
+	unsigned char* op;
+	unsigned char* opEnd;
+	unsigned char* token;
+
+	op = destination;
+	opEnd = destination + destinationCapacity;
+	anchor = 0;
+	ip = 0;
+
+	for (int i = 0; i < (1 << HASH_BITS); i++)
+	{
+		hashTable[i] = -1;
+	}
+
+	matchStart = sourceSize - MATCH_LIMIT;
+	matchEnd = sourceSize - LAST_LITERALS;
+
+	// find the matches with a single entry hash table of the last position of every 4 byte sequence
+	while (ip < matchStart)
+	{
+		sequence = Read32(source + ip);
+		hash = Hash32(sequence);
+		reference = hashTable[hash];
+		hashTable[hash] = ip;
+
+		if (reference < 0 || ip - reference > MAX_OFFSET || Read32(source + reference) != sequence)
+		{
+			ip++;
+			continue;
+		}
+
+		// extend the match as far as possible
+		matchLength = MIN_MATCH;
+		while (ip + matchLength < matchEnd && source[reference + matchLength] == source[ip + matchLength])
+		{
+			matchLength++;
+		}
+
+		literalLength = ip - anchor;
+
+		// make sure the sequence fits into the output
+		if (op + 1 + literalLength + literalLength / 255 + 2 + matchLength / 255 + 1 > opEnd)
+		{
+			return 0;
+		}
+
+		// write the token, the literals, the offset and the match length
+		token = op++;
+		*token = (unsigned char)(((literalLength >= 15 ? 15 : literalLength) << 4) |
+			(matchLength - MIN_MATCH >= 15 ? 15 : matchLength - MIN_MATCH));
+
+		if (literalLength >= 15)
+		{
+			op = WriteLength(op, literalLength - 15);
+		}
+		memcpy(op, source + anchor, literalLength);
+		op += literalLength;
+
+		*op++ = (unsigned char)((ip - reference) & 0xFF);
+		*op++ = (unsigned char)((ip - reference) >> 8);
+
+		if (matchLength - MIN_MATCH >= 15)
+		{
+			op = WriteLength(op, matchLength - MIN_MATCH - 15);
+		}
+
+		ip += matchLength;
+		anchor = ip;
+	}
+
+	// the rest of the block is written as the literals of the last sequence
+	literalLength = sourceSize - anchor;
+	if (op + 1 + literalLength + literalLength / 255 + 1 > opEnd)
+	{
+		return 0;
+	}
+
+	token = op++;
+	*token = (unsigned char)((literalLength >= 15 ? 15 : literalLength) << 4);
+	if (literalLength >= 15)
+	{
+		op = WriteLength(op, literalLength - 15);
+	}
+	memcpy(op, source + anchor, literalLength);
+	op += literalLength;
+
+	return (int)(op - destination);
+}
+
+bool CompressionClass::DecompressBlock(const unsigned char* source, int sourceSize, unsigned char* destination, int destinationSize)
+{
+	const unsigned char* ip;
+	const unsigned char* ipEnd;
+	unsigned char* op;
+	unsigned char* opEnd;
+	const unsigned char* match;
+	int literalLength, matchLength, offset;
+	unsigned char token, extra;
+
+	ip = source;
+	ipEnd = source + sourceSize;
+	op = destination;
+	opEnd = destination + destinationSize;
+
+	while (ip < ipEnd)
+	{
+		token = *ip++;
+
+		// copy the literals
+		literalLength = token >> 4;
+		if (literalLength == 15)
+		{
+			do
+			{
+				if (ip >= ipEnd)
+				{
+					return false;
+				}
+				extra = *ip++;
+				literalLength += extra;
+			} while (extra == 255);
+		}
+
+		if (literalLength > ipEnd - ip || literalLength > opEnd - op)
+		{
+			return false;
+		}
+		memcpy(op, ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		// the last sequence has no match
+		if (ip >= ipEnd)
+		{
+			break;
+		}
+
+		// copy the match from the already decompressed data
+		if (ipEnd - ip < 2)
+		{
+			return false;
+		}
+		offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > op - destination)
+		{
+			return false;
+		}
+		match = op - offset;
+
+		matchLength = (token & 15) + MIN_MATCH;
+		if ((token & 15) == 15)
+		{
+			do
+			{
+				if (ip >= ipEnd)
+				{
+					return false;
+				}
+				extra = *ip++;
+				matchLength += extra;
+			} while (extra == 255);
+		}
+
+		if (matchLength > opEnd - op)
+		{
+			return false;
+		}
+
+		// overlapping matches repeat the last bytes and have to be copied in order
+		if (offset >= matchLength)
+		{
+			memcpy(op, match, matchLength);
+			op += matchLength;
+		}
+		else
+		{
+			for (int i = 0; i < matchLength; i++)
+			{
+				*op++ = *match++;
+			}
+		}
+	}
+
+	return op == opEnd;
+}
+
+void CompressionClass::DecompressBlocks(void* data, int begin, int end)
+{
+	DecompressJobType* job;
+	unsigned int size;
+	int rawSize;
+
+	job = (DecompressJobType*)data;
+	for (int index = begin; index < end && !job->failed; index++)
+	{
+		memcpy(&size, job->source + sizeof(unsigned int) * (1 + index), sizeof(size));
+		rawSize = (int)std::min<unsigned long long>(COMPRESSION_BLOCK_SIZE, job->destinationSize - (unsigned long long)index * COMPRESSION_BLOCK_SIZE);
+
+		if (size & COMPRESSION_RAW_BLOCK)
+		{
+			// stored blocks are copied over
+			if ((int)(size & ~COMPRESSION_RAW_BLOCK) != rawSize)
+			{
+				job->failed = true;
+				break;
+			}
+			memcpy(job->destination + (size_t)index * COMPRESSION_BLOCK_SIZE, job->source + job->offsets[index], rawSize);
+		}
+		else if (!DecompressBlock(job->source + job->offsets[index], (int)size, job->destination + (size_t)index * COMPRESSION_BLOCK_SIZE, rawSize))
+		{
+			job->failed = true;
+			break;
+		}
+	}
+
+	return;
+}
+
+int CompressionClass::GetThreadCount()
+{
+	// leave one core for the render thread
+	return std::max(1, (int)std::thread::hardware_concurrency() - 1);
+}
\ No newline at end of file
@@ -610,12 +610,15 @@ void D3DClass::BeginScene(float red, float green, float blue, float alpha)
 		1.f, 
 		0
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_CLEARS, 2);
 
 	return;
 }
 
 void D3DClass::EndScene()
 {
+	ProfileZoneClass zone("EndScene");
+
 	// present the back buffer to the screen since rendering is complete
 	if (m_vsync_enabled)
 	{
@@ -633,6 +636,7 @@ void D3DClass::EndScene()
 			0		// Flags
 			);
 	}
+	RenderStatsClass::Add(RENDER_COUNTER_PRESENTS, 1);
 	
 	return;
 }
@@ -678,6 +682,7 @@ void D3DClass::TurnZBufferOn()
 		m_depthStencilState, 
 		1
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_STATE_CHANGES, 1);
 
 	return;
 }
@@ -688,6 +693,7 @@ void D3DClass::TurnZBufferOff()
 		m_depthDisabledStencilState,
 		1
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_STATE_CHANGES, 1);
 
 	return;
 }
@@ -708,6 +714,7 @@ void D3DClass::TurnOnAlphaBlending()
 		blendFactor,					// blend factor
 		0xFFFFFFFF						// sample mask
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_STATE_CHANGES, 1);
 
 	return;
 }
@@ -728,6 +735,7 @@ void D3DClass::TurnOffAlphaBlending()
 		blendFactor,					// blend factor
 		0xFFFFFFFF						// sample mask
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_STATE_CHANGES, 1);
 	
 	return;
 }
\ No newline at end of file
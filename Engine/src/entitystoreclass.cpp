@@ -0,0 +1,349 @@
+#include "entitystoreclass.h"
+
+// bytes of every component in its column
+static const size_t s_componentSizes[COMPONENT_COUNT] = {
+	sizeof(PositionComponentType),
+	sizeof(VelocityComponentType),
+	sizeof(RadiusComponentType),
+	sizeof(ColorComponentType),
+	sizeof(MeshComponentType),
+	sizeof(FlagsComponentType),
+	sizeof(ModelComponentType)
+};
+
+EntityStoreClass::EntityStoreClass()
+	: m_tag(MEMORY_TAG_GENERAL)
+{
+}
+
+EntityStoreClass::~EntityStoreClass()
+{
+	Shutdown();
+}
+
+bool EntityStoreClass::Initialize(MemoryTagType tag)
+{
+	// the columns are tracked under the tag of whoever owns the store
+	Shutdown();
+	m_tag = tag;
+
+	return true;
+}
+
+void EntityStoreClass::Shutdown()
+{
+	// release the columns of all the archetypes
+	for (size_t i = 0; i < m_archetypes.size(); i++)
+	{
+		for (int component = 0; component < COMPONENT_COUNT; component++)
+		{
+			MemoryClass::DeleteArray(m_archetypes[i].columns[component]);
+		}
+		MemoryClass::DeleteArray(m_archetypes[i].entities);
+	}
+
+	m_archetypes.clear();
+	m_records.Clear();
+
+	return;
+}
+
+EntityType EntityStoreClass::Create(unsigned int mask)
+{
+	EntityType entity;
+	EntityRecordType* record;
+	int archetype, row;
+
+	archetype = FindArchetype(mask);
+
+	// the record is where the handle finds the entity
+	entity = m_records.Create();
+	if (entity.IsNull())
+	{
+		return entity;
+	}
+
+	row = AddRow(archetype, entity);
+	if (row < 0)
+	{
+		m_records.Destroy(entity);
+		return EntityType();
+	}
+
+	record = m_records.Get(entity);
+	record->archetype = archetype;
+	record->row = row;
+
+	return entity;
+}
+
+bool EntityStoreClass::Destroy(EntityType entity)
+{
+	EntityRecordType* record;
+
+	record = m_records.Get(entity);
+	if (!record)
+	{
+		return false;
+	}
+
+	// the last entity of the archetype takes the row, the handle goes stale
+	RemoveRow(record->archetype, record->row);
+	m_records.Destroy(entity);
+
+	return true;
+}
+
+bool EntityStoreClass::Reserve(unsigned int mask, int count)
+{
+	int archetype;
+
+	// room for the entities so creating them does not copy the columns around
+	archetype = FindArchetype(mask);
+	m_records.Reserve(m_records.GetCount() + count);
+	if (m_archetypes[archetype].capacity < count)
+	{
+		return Grow(m_archetypes[archetype], count);
+	}
+
+	return true;
+}
+
+bool EntityStoreClass::IsValid(EntityType entity)
+{
+	return m_records.IsValid(entity);
+}
+
+unsigned int EntityStoreClass::GetMask(EntityType entity)
+{
+	EntityRecordType* record;
+
+	record = m_records.Get(entity);
+	if (!record)
+	{
+		return 0;
+	}
+
+	return m_archetypes[record->archetype].mask;
+}
+
+int EntityStoreClass::GetCount()
+{
+	return m_records.GetCount();
+}
+
+int EntityStoreClass::GetArchetypeCount()
+{
+	return (int)m_archetypes.size();
+}
+
+void EntityStoreClass::Query(unsigned int mask, std::vector<EntityChunkType>& chunks)
+{
+	EntityChunkType chunk;
+	int first;
+
+	chunks.clear();
+	first = 0;
+
+	// split every archetype that has all the components into chunks of rows
+	for (size_t i = 0; i < m_archetypes.size(); i++)
+	{
+		ArchetypeType& archetype = m_archetypes[i];
+
+		if ((archetype.mask & mask) != mask)
+		{
+			continue;
+		}
+
+		for (int begin = 0; begin < archetype.count; begin += ENTITY_CHUNK_ROWS)
+		{
+			for (int component = 0; component < COMPONENT_COUNT; component++)
+			{
+				chunk.columns[component] = archetype.columns[component] ?
+					archetype.columns[component] + begin * s_componentSizes[component] : nullptr;
+			}
+			chunk.entities = archetype.entities + begin;
+			chunk.count = std::min(ENTITY_CHUNK_ROWS, archetype.count - begin);
+			chunk.first = first;
+
+			chunks.push_back(chunk);
+			first += chunk.count;
+		}
+	}
+
+	return;
+}
+
+int EntityStoreClass::FindArchetype(unsigned int mask)
+{
+	ArchetypeType archetype;
+
+	// there are only a few archetypes, and the moves between them go through the edges
+	for (size_t i = 0; i < m_archetypes.size(); i++)
+	{
+		if (m_archetypes[i].mask == mask)
+		{
+			return (int)i;
+		}
+	}
+
+	archetype.mask = mask;
+	archetype.count = 0;
+	archetype.capacity = 0;
+	archetype.entities = nullptr;
+	for (int component = 0; component < COMPONENT_COUNT; component++)
+	{
+		archetype.columns[component] = nullptr;
+		archetype.addEdges[component] = -1;
+		archetype.removeEdges[component] = -1;
+	}
+	m_archetypes.push_back(archetype);
+
+	return (int)m_archetypes.size() - 1;
+}
+
+bool EntityStoreClass::Grow(ArchetypeType& archetype, int capacity)
+{
+	unsigned char* column;
+	EntityType* entities;
+
+	// copy every column into a bigger one
+	for (int component = 0; component < COMPONENT_COUNT; component++)
+	{
+		if (!(archetype.mask & (1u << component)))
+		{
+			continue;
+		}
+
+		column = MemoryClass::NewArray<unsigned char>((size_t)capacity * s_componentSizes[component], m_tag);
+		if (!column)
+		{
+			return false;
+		}
+
+		if (archetype.columns[component])
+		{
+			memcpy(column, archetype.columns[component], (size_t)archetype.count * s_componentSizes[component]);
+			MemoryClass::DeleteArray(archetype.columns[component]);
+		}
+		archetype.columns[component] = column;
+	}
+
+	entities = MemoryClass::NewArray<EntityType>(capacity, m_tag);
+	if (!entities)
+	{
+		return false;
+	}
+
+	if (archetype.entities)
+	{
+		memcpy(entities, archetype.entities, (size_t)archetype.count * sizeof(EntityType));
+		MemoryClass::DeleteArray(archetype.entities);
+	}
+	archetype.entities = entities;
+	archetype.capacity = capacity;
+
+	return true;
+}
+
+int EntityStoreClass::AddRow(int index, EntityType entity)
+{
+	ArchetypeType& archetype = m_archetypes[index];
+	int row;
+
+	// double the columns once they are full
+	if (archetype.count == archetype.capacity)
+	{
+		if (!Grow(archetype, std::max(ENTITY_MIN_CAPACITY, archetype.capacity * 2)))
+		{
+			return -1;
+		}
+	}
+
+	// the new row starts out zeroed
+	row = archetype.count++;
+	for (int component = 0; component < COMPONENT_COUNT; component++)
+	{
+		if (archetype.columns[component])
+		{
+			memset(archetype.columns[component] + row * s_componentSizes[component], 0, s_componentSizes[component]);
+		}
+	}
+	archetype.entities[row] = entity;
+
+	return row;
+}
+
+void EntityStoreClass::RemoveRow(int index, int row)
+{
+	ArchetypeType& archetype = m_archetypes[index];
+	int last;
+
+	// move the last row into the hole and tell its entity where it went
+	last = archetype.count - 1;
+	if (row != last)
+	{
+		for (int component = 0; component < COMPONENT_COUNT; component++)
+		{
+			if (archetype.columns[component])
+			{
+				memcpy(archetype.columns[component] + row * s_componentSizes[component],
+					archetype.columns[component] + last * s_componentSizes[component], s_componentSizes[component]);
+			}
+		}
+		archetype.entities[row] = archetype.entities[last];
+		m_records.Get(archetype.entities[row])->row = row;
+	}
+	archetype.count--;
+
+	return;
+}
+
+bool EntityStoreClass::Move(EntityType entity, unsigned int mask, int component, bool adding)
+{
+	EntityRecordType* record;
+	int source, target, sourceRow, targetRow;
+	unsigned int shared;
+
+	record = m_records.Get(entity);
+	source = record->archetype;
+	sourceRow = record->row;
+
+	// follow the edge to the next archetype, or find it and remember the edge
+	target = adding ? m_archetypes[source].addEdges[component] : m_archetypes[source].removeEdges[component];
+	if (target < 0)
+	{
+		target = FindArchetype(mask);
+		if (adding)
+		{
+			m_archetypes[source].addEdges[component] = target;
+		}
+		else
+		{
+			m_archetypes[source].removeEdges[component] = target;
+		}
+	}
+
+	targetRow = AddRow(target, entity);
+	if (targetRow < 0)
+	{
+		return false;
+	}
+
+	// copy the components both archetypes have, then close the hole in the old one
+	shared = m_archetypes[source].mask & m_archetypes[target].mask;
+	for (int i = 0; i < COMPONENT_COUNT; i++)
+	{
+		if (shared & (1u << i))
+		{
+			memcpy(m_archetypes[target].columns[i] + targetRow * s_componentSizes[i],
+				m_archetypes[source].columns[i] + sourceRow * s_componentSizes[i], s_componentSizes[i]);
+		}
+	}
+	RemoveRow(source, sourceRow);
+
+	record->archetype = target;
+	record->row = targetRow;
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "filesystemclass.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+DiskFileSystemClass::DiskFileSystemClass()
+	: m_notify(-1)
+{
+	m_wakePipe[0] = -1;
+	m_wakePipe[1] = -1;
+
+#ifdef __linux__
+	// without inotify the files are simply polled
+	m_notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_notify >= 0 && pipe(m_wakePipe) != 0)
+	{
+		close(m_notify);
+		m_notify = -1;
+	}
+#endif
+}
+
+DiskFileSystemClass::~DiskFileSystemClass()
+{
+#ifndef _WIN32
+	if (m_notify >= 0)
+	{
+		close(m_notify);
+		close(m_wakePipe[0]);
+		close(m_wakePipe[1]);
+	}
+#endif
+}
+
+bool DiskFileSystemClass::Watch(const char* filename)
+{
+#ifdef __linux__
+	std::string directory;
+	size_t slash;
+
+	// watch the directory, editors often replace a file instead of writing into it
+	if (m_notify >= 0)
+	{
+		directory = filename;
+		slash = directory.find_last_of("/\\");
+		directory = slash == std::string::npos ? std::string(".") : directory.substr(0, slash + 1);
+
+		if (inotify_add_watch(m_notify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0)
+		{
+			return false;
+		}
+	}
+#endif
+
+	return true;
+}
+
+bool DiskFileSystemClass::GetStamp(const char* filename, unsigned long long& stamp)
+{
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA info;
+
+	if (!GetFileAttributesExA(filename, GetFileExInfoStandard, &info))
+	{
+		return false;
+	}
+
+	// last write time in 100ns ticks mixed with the size
+	stamp = ((unsigned long long)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+	stamp ^= ((unsigned long long)info.nFileSizeHigh << 32 | info.nFileSizeLow) * 0x9E3779B97F4A7C15ull;
+#else
+	struct stat info;
+
+	if (stat(filename, &info) != 0)
+	{
+		return false;
+	}
+
+	// last write time in nanoseconds mixed with the size
+#ifdef __APPLE__
+	stamp = (unsigned long long)info.st_mtimespec.tv_sec * 1000000000ull + info.st_mtimespec.tv_nsec;
+#else
+	stamp = (unsigned long long)info.st_mtim.tv_sec * 1000000000ull + info.st_mtim.tv_nsec;
+#endif
+	stamp ^= (unsigned long long)info.st_size * 0x9E3779B97F4A7C15ull;
+#endif
+
+	return true;
+}
+
+bool DiskFileSystemClass::Read(const char* filename, AssetDataType& asset)
+{
+	return PackFileClass::ReadLooseFile(filename, asset);
+}
+
+void DiskFileSystemClass::Wait(int milliseconds)
+{
+#ifdef __linux__
+	struct pollfd fds[2];
+	char buffer[4096];
+
+	if (m_notify >= 0)
+	{
+		// sleep until something changes in a watched directory or the timeout passes
+		fds[0].fd = m_notify;
+		fds[0].events = POLLIN;
+		fds[1].fd = m_wakePipe[0];
+		fds[1].events = POLLIN;
+		if (poll(fds, 2, milliseconds) > 0)
+		{
+			// the events only wake us up, the stamps tell what changed
+			while (read(m_notify, buffer, sizeof(buffer)) > 0)
+			{
+			}
+			if (fds[1].revents & POLLIN)
+			{
+				read(m_wakePipe[0], buffer, 1);
+			}
+		}
+		return;
+	}
+#endif
+
+	// poll the files again after the timeout
+	std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+
+	return;
+}
+
+void DiskFileSystemClass::Wake()
+{
+#ifdef __linux__
+	char signal = 1;
+
+	if (m_notify >= 0)
+	{
+		write(m_wakePipe[1], &signal, 1);
+	}
+#endif
+
+	return;
+}
+
+MemoryFileSystemClass::MemoryFileSystemClass()
+	: m_stamp(0), m_signaled(false)
+{
+}
+
+bool MemoryFileSystemClass::Watch(const char* filename)
+{
+	return true;
+}
+
+bool MemoryFileSystemClass::GetStamp(const char* filename, unsigned long long& stamp)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::map<std::string, FileType>::iterator file;
+
+	file = m_files.find(filename);
+	if (file == m_files.end())
+	{
+		return false;
+	}
+
+	stamp = file->second.stamp;
+
+	return true;
+}
+
+bool MemoryFileSystemClass::Read(const char* filename, AssetDataType& asset)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::map<std::string, FileType>::iterator file;
+
+	file = m_files.find(filename);
+	if (file == m_files.end())
+	{
+		return false;
+	}
+
+	// hand out a copy, the file may be written again while it is imported
+	asset.buffer = file->second.data;
+	asset.data = asset.buffer.data();
+	asset.size = asset.buffer.size();
+
+	return true;
+}
+
+void MemoryFileSystemClass::Wait(int milliseconds)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_changed.wait_for(lock, std::chrono::milliseconds(milliseconds), [this]() { return m_signaled; });
+	m_signaled = false;
+
+	return;
+}
+
+void MemoryFileSystemClass::Wake()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_signaled = true;
+	m_changed.notify_all();
+
+	return;
+}
+
+void MemoryFileSystemClass::Write(const char* filename, const void* data, unsigned long long size)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	FileType& file = m_files[filename];
+
+	file.data.assign((const unsigned char*)data, (const unsigned char*)data + size);
+	file.stamp = ++m_stamp;
+
+	m_signaled = true;
+	m_changed.notify_all();
+
+	return;
+}
+
+void MemoryFileSystemClass::Remove(const char* filename)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_files.erase(filename);
+
+	m_signaled = true;
+	m_changed.notify_all();
+
+	return;
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "flythroughclass.h"
+
+// pre-processing directives
+#define FLYTHROUGH_MAGIC 0x594C4654		// "TFLY"
+#define FLYTHROUGH_VERSION 1
+
+FlythroughClass::FlythroughClass()
+	: m_recordTime(0.f), m_playbackFrame(0), m_segment(0), m_finished(false)
+{
+}
+
+void FlythroughClass::BeginRecording()
+{
+	m_frames.clear();
+	m_recordTime = 0.f;
+
+	return;
+}
+
+void FlythroughClass::Record(float frameTime, XMFLOAT3 position, XMFLOAT3 direction, XMFLOAT3 up)
+{
+	FlythroughFrameType frame;
+
+	// the first frame starts the path, every later one is stamped with the time that passed since
+	if (!m_frames.empty())
+	{
+		m_recordTime += frameTime;
+	}
+
+	frame.time = m_recordTime;
+	frame.position = position;
+	frame.direction = direction;
+	frame.up = up;
+	m_frames.push_back(frame);
+
+	return;
+}
+
+bool FlythroughClass::Save(const char* filename)
+{
+	FlythroughHeaderType header;
+	std::ofstream fout;
+
+	fout.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// a small header and then the frames as they are in memory
+	header.magic = FLYTHROUGH_MAGIC;
+	header.version = FLYTHROUGH_VERSION;
+	header.frameCount = (unsigned int)m_frames.size();
+	header.reserved = 0;
+
+	fout.write((const char*)&header, sizeof(header));
+	fout.write((const char*)m_frames.data(), (std::streamsize)(m_frames.size() * sizeof(FlythroughFrameType)));
+	fout.close();
+
+	return !fout.fail();
+}
+
+bool FlythroughClass::Load(const char* filename)
+{
+	FlythroughHeaderType header;
+	std::ifstream fin;
+
+	fin.open(filename, std::ios::in | std::ios::binary);
+	if (fin.fail())
+	{
+		return false;
+	}
+
+	fin.read((char*)&header, sizeof(header));
+	if (fin.gcount() != sizeof(header) || header.magic != FLYTHROUGH_MAGIC || header.version != FLYTHROUGH_VERSION ||
+		header.frameCount == 0)
+	{
+		return false;
+	}
+
+	m_frames.resize(header.frameCount);
+	fin.read((char*)m_frames.data(), (std::streamsize)(m_frames.size() * sizeof(FlythroughFrameType)));
+	if (fin.gcount() != (std::streamsize)(m_frames.size() * sizeof(FlythroughFrameType)))
+	{
+		m_frames.clear();
+		return false;
+	}
+
+	// the time stamps have to grow or the path cannot be sampled
+	for (size_t i = 1; i < m_frames.size(); i++)
+	{
+		if (!(m_frames[i].time >= m_frames[i - 1].time))
+		{
+			m_frames.clear();
+			return false;
+		}
+	}
+
+	fin.close();
+
+	return true;
+}
+
+void FlythroughClass::BeginPlayback()
+{
+	m_playbackFrame = 0;
+	m_segment = 0;
+	m_finished = m_frames.empty();
+	m_frameTimes.clear();
+
+	return;
+}
+
+bool FlythroughClass::Play(XMFLOAT3& position, XMFLOAT3& direction, XMFLOAT3& up)
+{
+	const FlythroughFrameType* first;
+	const FlythroughFrameType* second;
+	float time, span, amount;
+
+	// the simulated time only depends on the number of played frames, not on how long they took
+	time = m_playbackFrame * FLYTHROUGH_STEP_MS;
+	if (m_finished || time > GetDuration())
+	{
+		m_finished = true;
+		return false;
+	}
+
+	// find the recorded frames around that time, they only ever move forward
+	while (m_segment + 1 < m_frames.size() - 1 && m_frames[m_segment + 1].time <= time)
+	{
+		m_segment++;
+	}
+
+	first = &m_frames[m_segment];
+	second = &m_frames[m_segment + 1 < m_frames.size() ? m_segment + 1 : m_segment];
+
+	span = second->time - first->time;
+	amount = span > 0.f ? (time - first->time) / span : 0.f;
+	amount = amount < 0.f ? 0.f : (amount > 1.f ? 1.f : amount);
+
+	position = Interpolate(first->position, second->position, amount, false);
+	direction = Interpolate(first->direction, second->direction, amount, true);
+	up = Interpolate(first->up, second->up, amount, true);
+
+	m_playbackFrame++;
+
+	return true;
+}
+
+bool FlythroughClass::IsFinished()
+{
+	return m_finished;
+}
+
+int FlythroughClass::GetFrameCount()
+{
+	return (int)m_frames.size();
+}
+
+float FlythroughClass::GetDuration()
+{
+	return m_frames.empty() ? 0.f : m_frames.back().time;
+}
+
+void FlythroughClass::LogFrame(float frameTime)
+{
+	// the time is only known once the next frame starts, keep one entry per played frame
+	if (m_frameTimes.size() < (size_t)m_playbackFrame)
+	{
+		m_frameTimes.push_back(frameTime);
+	}
+
+	return;
+}
+
+bool FlythroughClass::WriteLog(const char* filename)
+{
+	std::ofstream fout;
+
+	fout.open(filename, std::ios::out | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// one line per played frame, so runs of different builds can be compared frame by frame
+	fout << "frame,time,frame_ms" << std::endl;
+	for (size_t i = 0; i < m_frameTimes.size(); i++)
+	{
+		fout << i << "," << i * FLYTHROUGH_STEP_MS << "," << m_frameTimes[i] << std::endl;
+	}
+	fout.close();
+
+	return !fout.fail();
+}
+
+XMFLOAT3 FlythroughClass::Interpolate(const XMFLOAT3& a, const XMFLOAT3& b, float amount, bool normalize)
+{
+	XMFLOAT3 result;
+	float length;
+
+	result.x = a.x + (b.x - a.x) * amount;
+	result.y = a.y + (b.y - a.y) * amount;
+	result.z = a.z + (b.z - a.z) * amount;
+
+	// directions stay unit length between the recorded frames
+	if (normalize)
+	{
+		length = sqrtf(result.x * result.x + result.y * result.y + result.z * result.z);
+		if (length > 0.f)
+		{
+			result.x /= length;
+			result.y /= length;
+			result.z /= length;
+		}
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -13,19 +13,20 @@ FontClass::~FontClass()
 {
 }
 
-bool FontClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* fontFilename, char* textureFilename)
+bool FontClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext, PackFileClass* pack, AssetCacheClass* cache,
+	char* fontFilename, char* textureFilename)
 {
 	bool result;
 
 	// load in the text file containing the font data
-	result = LoadFontData(fontFilename);
+	result = LoadFontData(pack, cache, fontFilename);
 	if (!result)
 	{
 		return false;
 	}
 
 	// load the texture that has the font characters on it
-	result = LoadTexture(device, deviceContext, textureFilename);
+	result = LoadTexture(device, deviceContext, pack, textureFilename);
 	if (!result)
 	{
 		return false;
@@ -45,27 +46,46 @@ void FontClass::Shutdown()
 	return;
 }
 
-bool FontClass::LoadFontData(char* filename)
+bool FontClass::LoadFontData(PackFileClass* pack, AssetCacheClass* cache, char* filename)
 {
-	std::ifstream fin;
+	AssetDataType asset;
+	std::vector<unsigned char> blob;
+	unsigned long long key;
+	int characterCount;
 	char temp;
 
 	// create the font spacing buffer
-	m_Font = new FontType[95];		// 95 characters in the texture
+	m_Font = MemoryClass::NewArray<FontType>(FONT_CHARACTER_COUNT, MEMORY_TAG_TEXT);
 	if (!m_Font)
 	{
 		return false;
 	}
 
 	// read in the font size and spacing between chars
-	fin.open(filename);
-	if (fin.fail())
+	if (!pack->Read(filename, asset))
 	{
 		return false;
 	}
 
+	// an unchanged font is taken from the cache as the array of characters
+	key = 0;
+	if (cache)
+	{
+		characterCount = FONT_CHARACTER_COUNT;
+		key = cache->MakeKey(asset, "font", FONT_IMPORTER_VERSION, &characterCount, sizeof(characterCount));
+		if (cache->Load(key, blob) && blob.size() == FONT_CHARACTER_COUNT * sizeof(FontType))
+		{
+			memcpy(m_Font, blob.data(), blob.size());
+			return true;
+		}
+	}
+
+	// parse the text in place
+	MemoryStreamBuffer buffer(asset.data, asset.size);
+	std::istream fin(&buffer);
+
 	// read in the 95 used ascii characters for text
-	for (int i = 0; i < 95; i++)
+	for (int i = 0; i < FONT_CHARACTER_COUNT; i++)
 	{
 		fin.get(temp);			// |
 		while (temp != ' ')		// |
@@ -83,8 +103,11 @@ bool FontClass::LoadFontData(char* filename)
 		fin >> m_Font[i].size;
 	}
 
-	// close the file
-	fin.close();
+	// store the parsed font for the next run
+	if (cache)
+	{
+		cache->Store(key, m_Font, FONT_CHARACTER_COUNT * sizeof(FontType));
+	}
 
 	return true;
 }
@@ -94,19 +117,19 @@ void FontClass::ReleaseFontData()
 	// release the font data array
 	if (m_Font)
 	{
-		delete[] m_Font;
+		MemoryClass::DeleteArray(m_Font);
 		m_Font = nullptr;
 	}
 
 	return;
 }
 
-bool FontClass::LoadTexture(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* filename)
+bool FontClass::LoadTexture(ID3D11Device* device, ID3D11DeviceContext* deviceContext, PackFileClass* pack, char* filename)
 {
 	bool result;
 
 	// create the texture object
-	m_Texture = new TextureClass;
+	m_Texture = MemoryClass::New<TextureClass>(MEMORY_TAG_TEXT);
 	if (!m_Texture)
 	{
 		return false;
@@ -116,6 +139,7 @@ bool FontClass::LoadTexture(ID3D11Device* device, ID3D11DeviceContext* deviceCon
 	result = m_Texture->InitializeDDS(
 		device,
 		deviceContext,
+		pack,
 		filename
 		);
 	if (!result)
@@ -132,7 +156,7 @@ void FontClass::ReleaseTexture()
 	if (m_Texture)
 	{
 		m_Texture->Shutdown();
-		delete m_Texture;
+		MemoryClass::Delete(m_Texture);
 		m_Texture = nullptr;
 	}
 
@@ -14,12 +14,12 @@ FontShaderClass::~FontShaderClass()
 {
 }
 
-bool FontShaderClass::Initialize(ID3D11Device* device, HWND hwnd)
+bool FontShaderClass::Initialize(ID3D11Device* device, HWND hwnd, PackFileClass* pack)
 {
 	bool result;
 
 	// initialize the vertex and pixel shaders
-	result = InitializeShader(device, hwnd, L"./shader/font.vs.hlsl", L"./shader/font.ps.hlsl");
+	result = InitializeShader(device, hwnd, pack, L"./shader/font.vs.hlsl", L"./shader/font.ps.hlsl");
 	if (!result)
 	{
 		return false;
@@ -63,9 +63,12 @@ bool FontShaderClass::Render(ID3D11DeviceContext* deviceContext, int indexCount,
 		);
 }
 
-bool FontShaderClass::InitializeShader(ID3D11Device* device, HWND hwnd, WCHAR* vsFilename, WCHAR* psFilename)
+bool FontShaderClass::InitializeShader(ID3D11Device* device, HWND hwnd, PackFileClass* pack, WCHAR* vsFilename, WCHAR* psFilename)
 {
 	HRESULT result;
+	AssetDataType vertexShaderSource, pixelShaderSource;
+	char filename[128];
+	size_t length;
 	ID3D10Blob* errorMessage;
 	ID3D10Blob* vertexShaderBuffer;
 	ID3D10Blob* pixelShaderBuffer;
@@ -80,18 +83,27 @@ bool FontShaderClass::InitializeShader(ID3D11Device* device, HWND hwnd, WCHAR* v
 	vertexShaderBuffer = nullptr;
 	pixelShaderBuffer = nullptr;
 
+	// get the vertex shader source from the pack or the disk
+	wcstombs_s(&length, filename, sizeof(filename), vsFilename, _TRUNCATE);
+	result = pack->Read(filename, vertexShaderSource) ? S_OK : E_FAIL;
+
 	// compile the vertex shader code
-	result = D3DCompileFromFile(
-		vsFilename,							// filename
-		NULL,								// ptr to array of macros
-		NULL,								// ptr to an include interface
-		"FontVertexShader",				// name of the shader function
-		"vs_5_0",							// version of the shader
-		D3D10_SHADER_ENABLE_STRICTNESS,		// compile flags
-		0,									// effect flags
-		&vertexShaderBuffer,				// compiled shader
-		&errorMessage						// lists of errors and warnings
-		);
+	if (SUCCEEDED(result))
+	{
+		result = D3DCompile(
+			vertexShaderSource.data,			// source code
+			(SIZE_T)vertexShaderSource.size,	// size of the source code
+			filename,							// name used in error messages
+			NULL,								// ptr to array of macros
+			NULL,								// ptr to an include interface
+			"FontVertexShader",				// name of the shader function
+			"vs_5_0",							// version of the shader
+			D3D10_SHADER_ENABLE_STRICTNESS,		// compile flags
+			0,									// effect flags
+			&vertexShaderBuffer,				// compiled shader
+			&errorMessage						// lists of errors and warnings
+			);
+	}
 	if (FAILED(result)) {
 		// if the shader failed to compile it has written something into the error message
 		if (errorMessage) {
@@ -104,18 +116,27 @@ bool FontShaderClass::InitializeShader(ID3D11Device* device, HWND hwnd, WCHAR* v
 		return false;
 	}
 
+	// get the pixel shader source from the pack or the disk
+	wcstombs_s(&length, filename, sizeof(filename), psFilename, _TRUNCATE);
+	result = pack->Read(filename, pixelShaderSource) ? S_OK : E_FAIL;
+
 	// compile the PIXEL SHADER code
-	result = D3DCompileFromFile(
-		psFilename,							// filename
-		NULL, 								// ptr to array of macros
-		NULL, 								// ptr to an include interface
-		"FontPixelShader", 				// name of the shader function
-		"ps_5_0",							// version of the shader
-		D3D10_SHADER_ENABLE_STRICTNESS, 	// compile flags
-		0, 									// effect flags
-		&pixelShaderBuffer, 				// compiled shader
-		&errorMessage						// lists of errors and warnings
-		);
+	if (SUCCEEDED(result))
+	{
+		result = D3DCompile(
+			pixelShaderSource.data,				// source code
+			(SIZE_T)pixelShaderSource.size,		// size of the source code
+			filename,							// name used in error messages
+			NULL, 								// ptr to array of macros
+			NULL, 								// ptr to an include interface
+			"FontPixelShader", 				// name of the shader function
+			"ps_5_0",							// version of the shader
+			D3D10_SHADER_ENABLE_STRICTNESS, 	// compile flags
+			0, 									// effect flags
+			&pixelShaderBuffer, 				// compiled shader
+			&errorMessage						// lists of errors and warnings
+			);
+	}
 	if (FAILED(result)) {
 		// if the shader failed to compile it has written something into error message
 		if (errorMessage) {
@@ -373,6 +394,7 @@ bool FontShaderClass::SetShaderParameters(
 		m_constantBuffer,
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(ConstantBufferType));
 
 	// set the position of the constant buffer in the vertex shader
 	bufferNumber = 0;
@@ -390,6 +412,7 @@ bool FontShaderClass::SetShaderParameters(
 		1,			// num views
 		&texture	// shader resource view
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_TEXTURE_BINDS, 1);
 
 	// lock the PIXEL constant buffer so it can be written to
 	result = deviceContext->Map(
@@ -415,6 +438,7 @@ bool FontShaderClass::SetShaderParameters(
 		m_pixelBuffer,
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(PixelBufferType));
 
 	// set the position of the pixel constant in the pixel shader
 	bufferNumber = 0;
@@ -445,6 +469,7 @@ void FontShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int index
 		NULL, 					// only used if shader uses interfaces
 		0						// number of class-instances in the array
 		);
+	RenderStatsClass::CountShader(m_vertexShader);
 
 	// set the sampler state in the pixel shader
 	deviceContext->PSSetSamplers(
@@ -455,6 +480,7 @@ void FontShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int index
 
 	// render the triangles
 	deviceContext->DrawIndexed(indexCount, 0, 0);
+	RenderStatsClass::CountDraw(indexCount);
 
 	return;
 }
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include "framearenaclass.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "renderstatsclass.h"
+
+std::atomic<unsigned long long> FrameArenaClass::s_frame(0);
+
+// memory of an arena, the bytes follow the header
+struct FrameArenaBlockType
+{
+	FrameArenaBlockType* next;
+	size_t capacity;
+	size_t used;
+};
+
+// the arena of one thread, a frame that does not fit into the first block chains more blocks
+//  and the next frame starts out with a single block that is large enough for all of them
+struct FrameArenaThreadType
+{
+	~FrameArenaThreadType();
+
+	FrameArenaBlockType* blocks;		// the block that is allocated from comes first
+	size_t used;
+	size_t peak;
+	unsigned long long frame;			// frame the arena was last released in
+	bool endsFrames;					// the thread releases its arena itself with EndFrame
+};
+
+static thread_local FrameArenaThreadType t_arena = { nullptr, 0, 0, 0, false };
+static thread_local unsigned long long t_heapCalls = 0;
+
+// render counters of the thread that ends the frames
+static int s_heapCallsCounter = -1;
+static int s_arenaBytesCounter = -1;
+static unsigned long long s_lastHeapCalls = 0;
+
+static FrameArenaBlockType* CreateBlock(size_t capacity, FrameArenaBlockType* next)
+{
+	unsigned char* memory;
+	FrameArenaBlockType* block;
+
+	memory = new unsigned char[sizeof(FrameArenaBlockType) + capacity];
+	if (!memory)
+	{
+		return nullptr;
+	}
+
+	block = (FrameArenaBlockType*)memory;
+	block->next = next;
+	block->capacity = capacity;
+	block->used = 0;
+
+	return block;
+}
+
+static void ReleaseBlocks(FrameArenaBlockType* block)
+{
+	FrameArenaBlockType* next;
+
+	while (block)
+	{
+		next = block->next;
+		delete[] (unsigned char*)block;
+		block = next;
+	}
+
+	return;
+}
+
+static void ReleaseArena(FrameArenaThreadType& arena)
+{
+	size_t capacity;
+
+	if (!arena.blocks)
+	{
+		return;
+	}
+
+	// a frame that overflowed gets one block for all of it, so the next frame allocates nothing
+	if (arena.blocks->next)
+	{
+		capacity = 0;
+		for (FrameArenaBlockType* block = arena.blocks; block; block = block->next)
+		{
+			capacity += block->capacity;
+		}
+
+		ReleaseBlocks(arena.blocks);
+		arena.blocks = CreateBlock(capacity, nullptr);
+	}
+	else if (FRAME_ARENA_POISON)
+	{
+		// overwrite what the frame left behind, reading it afterwards shows up as 0xCD
+		memset(arena.blocks + 1, FRAME_ARENA_POISON_BYTE, arena.blocks->used);
+	}
+
+	if (arena.blocks)
+	{
+		arena.blocks->used = 0;
+	}
+	arena.used = 0;
+
+	return;
+}
+
+FrameArenaThreadType::~FrameArenaThreadType()
+{
+	ReleaseBlocks(blocks);
+	blocks = nullptr;
+}
+
+void* FrameArenaClass::Allocate(size_t size, size_t alignment)
+{
+	FrameArenaThreadType& arena = t_arena;
+	FrameArenaBlockType* block;
+	uintptr_t begin, address;
+	unsigned long long frame;
+
+	// the threads that do not end frames release their arena once they allocate in a newer one
+	frame = s_frame.load(std::memory_order_relaxed);
+	if (!arena.endsFrames && arena.frame != frame)
+	{
+		ReleaseArena(arena);
+		arena.frame = frame;
+	}
+
+	// bump the offset in the current block
+	block = arena.blocks;
+	if (block)
+	{
+		begin = (uintptr_t)(block + 1);
+		address = (begin + block->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		if (address + size <= begin + block->capacity)
+		{
+			arena.used += address + size - (begin + block->used);
+			block->used = address + size - begin;
+			arena.peak = std::max(arena.peak, arena.used);
+			return (void*)address;
+		}
+	}
+
+	// otherwise chain a new block that fits the allocation
+	block = CreateBlock(std::max(FRAME_ARENA_BLOCK_SIZE, size + alignment), arena.blocks);
+	if (!block)
+	{
+		return nullptr;
+	}
+	arena.blocks = block;
+
+	begin = (uintptr_t)(block + 1);
+	address = (begin + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	block->used = address + size - begin;
+	arena.used += block->used;
+	arena.peak = std::max(arena.peak, arena.used);
+
+	return (void*)address;
+}
+
+void FrameArenaClass::EndFrame()
+{
+	FrameArenaThreadType& arena = t_arena;
+
+	// report the heap calls and the arena bytes of the frame that ends
+	if (s_heapCallsCounter < 0)
+	{
+		s_heapCallsCounter = RenderStatsClass::Register("heap_calls");
+		s_arenaBytesCounter = RenderStatsClass::Register("frame_arena_bytes");
+		s_lastHeapCalls = t_heapCalls;
+	}
+	RenderStatsClass::Add(s_heapCallsCounter, t_heapCalls - s_lastHeapCalls);
+	RenderStatsClass::Add(s_arenaBytesCounter, arena.used);
+
+	// release the arena of the calling thread now, the other threads do it on their own
+	arena.endsFrames = true;
+	ReleaseArena(arena);
+	arena.frame = s_frame.fetch_add(1) + 1;
+
+	// the release itself may have allocated, that belongs to the next frame
+	s_lastHeapCalls = t_heapCalls;
+
+	return;
+}
+
+size_t FrameArenaClass::GetUsed()
+{
+	return t_arena.used;
+}
+
+size_t FrameArenaClass::GetPeak()
+{
+	return t_arena.peak;
+}
+
+size_t FrameArenaClass::GetCapacity()
+{
+	size_t capacity = 0;
+
+	for (FrameArenaBlockType* block = t_arena.blocks; block; block = block->next)
+	{
+		capacity += block->capacity;
+	}
+
+	return capacity;
+}
+
+unsigned long long FrameArenaClass::GetFrame()
+{
+	return s_frame.load();
+}
+
+unsigned long long FrameArenaClass::GetHeapCallCount()
+{
+	return t_heapCalls;
+}
+
+// the global heap of the engine, the same as the default one except that every call is counted
+//  for the thread that made it
+void* operator new(size_t size)
+{
+	void* memory;
+	std::new_handler handler;
+
+	t_heapCalls++;
+
+	// a request of zero bytes still gets a unique pointer
+	while (!(memory = malloc(size ? size : 1)))
+	{
+		handler = std::get_new_handler();
+		if (!handler)
+		{
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	if (memory)
+	{
+		t_heapCalls++;
+		free(memory);
+	}
+
+	return;
+}
+
+void operator delete[](void* memory) noexcept
+{
+	operator delete(memory);
+
+	return;
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	operator delete(memory);
+
+	return;
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	operator delete(memory);
+
+	return;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "framelimiterclass.h"
+
+FrameLimiterClass::FrameLimiterClass()
+	: m_Platform(nullptr), m_interval(0.0), m_budget(0.0), m_deadline(0.0), m_sampleTime(0.0), m_latency(0.0),
+	  m_spinMargin(FRAME_LIMITER_MIN_SPIN_MS), m_sleepTime(0.0), m_spinTime(0.0), m_missedCount(0)
+{
+}
+
+bool FrameLimiterClass::Initialize(PlatformClass* platform, double fps, double budget)
+{
+	if (!platform || fps < 0.0 || budget < 0.0)
+	{
+		return false;
+	}
+
+	m_Platform = platform;
+	m_interval = fps > 0.0 ? 1000.0 / fps : 0.0;
+
+	// without a budget, or with one longer than the frame, the input is sampled at the frame start
+	m_budget = budget > 0.0 ? std::min(budget, m_interval) : m_interval;
+
+	// the first frame is due one interval from now
+	m_deadline = m_Platform->GetTime() + m_interval;
+	m_sampleTime = m_Platform->GetTime();
+	m_latency = 0.0;
+	m_spinMargin = FRAME_LIMITER_MIN_SPIN_MS;
+	m_sleepTime = m_spinTime = 0.0;
+	m_missedCount = 0;
+
+	return true;
+}
+
+void FrameLimiterClass::BeginFrame()
+{
+	ProfileZoneClass zone("FrameLimiterClass::BeginFrame");
+
+	// wait until the input has to be sampled for the frame to be submitted when it is due
+	if (m_interval > 0.0)
+	{
+		WaitUntil(m_deadline - m_budget);
+	}
+
+	m_sampleTime = m_Platform->GetTime();
+
+	return;
+}
+
+void FrameLimiterClass::EndFrame()
+{
+	double now;
+
+	now = m_Platform->GetTime();
+	m_latency = now - m_sampleTime;
+
+	if (m_interval > 0.0)
+	{
+		// a frame that ran past its deadline is shown at the next one, the frames stay in step with it
+		if (now > m_deadline)
+		{
+			m_missedCount++;
+			m_deadline += ceil((now - m_deadline) / m_interval) * m_interval;
+		}
+
+		m_deadline += m_interval;
+	}
+
+	return;
+}
+
+double FrameLimiterClass::GetLatency()
+{
+	return m_latency;
+}
+
+double FrameLimiterClass::GetDeadline()
+{
+	return m_deadline;
+}
+
+double FrameLimiterClass::GetSleepTime()
+{
+	return m_sleepTime;
+}
+
+double FrameLimiterClass::GetSpinTime()
+{
+	return m_spinTime;
+}
+
+int FrameLimiterClass::GetMissedCount()
+{
+	return m_missedCount;
+}
+
+void FrameLimiterClass::WaitUntil(double target)
+{
+	double now, requested, after, overshoot, spinStart;
+
+	// sleep while the target is further away than the sleeps overshoot
+	now = m_Platform->GetTime();
+	while (target - now > m_spinMargin)
+	{
+		requested = target - now - m_spinMargin;
+		m_Platform->SleepFor(requested);
+		after = m_Platform->GetTime();
+
+		// a late wake up widens the spin right away, it narrows again slowly
+		overshoot = after - now - requested;
+		m_spinMargin = std::max(FRAME_LIMITER_MIN_SPIN_MS, std::max(overshoot, m_spinMargin * FRAME_LIMITER_SPIN_DECAY));
+
+		m_sleepTime += after - now;
+		now = after;
+	}
+
+	// spin the rest, yielding to whatever else wants to run
+	spinStart = now;
+	while (now < target)
+	{
+		m_Platform->SleepFor(0.0);
+		now = m_Platform->GetTime();
+	}
+	m_spinTime += now - spinStart;
+
+	return;
+}
\ No newline at end of file
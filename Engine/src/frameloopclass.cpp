@@ -0,0 +1,135 @@
+#include "frameloopclass.h"
+
+FrameLoopClass::FrameLoopClass()
+	: m_Platform(nullptr), m_stepTime(FRAME_LOOP_STEP_MS), m_lastTime(0.0), m_simulatedTime(0.0), m_accumulator(0.0), m_droppedTime(0.0),
+	  m_alpha(0.f), m_stepCount(0), m_quit(false)
+{
+}
+
+bool FrameLoopClass::Initialize(PlatformClass* platform, double stepTime)
+{
+	if (!platform || stepTime <= 0.0)
+	{
+		return false;
+	}
+
+	m_Platform = platform;
+	m_stepTime = stepTime;
+
+	// the first frame starts now
+	m_lastTime = m_Platform->GetTime();
+	m_simulatedTime = m_lastTime;
+	m_accumulator = 0.0;
+	m_droppedTime = 0.0;
+	m_alpha = 0.f;
+	m_stepCount = 0;
+	m_quit = false;
+
+	return true;
+}
+
+int FrameLoopClass::PumpEvents(FrameEventFunction function, void* data)
+{
+	ProfileZoneClass zone("FrameLoopClass::PumpEvents");
+	PlatformEventType event;
+	int count;
+
+	// take every pending event before the frame, so a burst of input never waits for later frames
+	count = 0;
+	while (m_Platform->PollEvent(event))
+	{
+		if (event.message == PLATFORM_MESSAGE_QUIT)
+		{
+			m_quit = true;
+		}
+
+		if (function)
+		{
+			function(data, event);
+		}
+		count++;
+	}
+
+	return count;
+}
+
+int FrameLoopClass::Advance()
+{
+	double now, elapsed;
+	int steps;
+
+	now = m_Platform->GetTime();
+	elapsed = now - m_lastTime;
+	m_lastTime = now;
+
+	// a stall like a breakpoint or a dragged window is not caught up step by step
+	if (elapsed > m_stepTime * FRAME_LOOP_MAX_STEPS)
+	{
+		m_droppedTime += elapsed - m_stepTime * FRAME_LOOP_MAX_STEPS;
+		elapsed = m_stepTime * FRAME_LOOP_MAX_STEPS;
+	}
+	else if (elapsed < 0.0)
+	{
+		elapsed = 0.0;
+	}
+
+	// spend the accumulated time in whole steps
+	m_accumulator += elapsed;
+	steps = (int)(m_accumulator / m_stepTime);
+	m_accumulator -= steps * m_stepTime;
+	m_simulatedTime = now - m_accumulator;
+
+	m_alpha = (float)(m_accumulator / m_stepTime);
+	m_stepCount += steps;
+
+	return steps;
+}
+
+bool FrameLoopClass::IsQuit()
+{
+	return m_quit;
+}
+
+double FrameLoopClass::GetStepTime()
+{
+	return m_stepTime;
+}
+
+double FrameLoopClass::GetSimulatedTime()
+{
+	return m_simulatedTime;
+}
+
+float FrameLoopClass::GetAlpha()
+{
+	return m_alpha;
+}
+
+double FrameLoopClass::GetDroppedTime()
+{
+	return m_droppedTime;
+}
+
+unsigned long long FrameLoopClass::GetStepCount()
+{
+	return m_stepCount;
+}
+
+XMFLOAT3 FrameLoopClass::Interpolate(const XMFLOAT3& previous, const XMFLOAT3& current, float alpha)
+{
+	XMFLOAT3 result;
+
+	XMStoreFloat3(&result, XMVectorLerp(XMLoadFloat3(&previous), XMLoadFloat3(&current), alpha));
+
+	return result;
+}
+
+XMFLOAT3 FrameLoopClass::InterpolateDirection(const XMFLOAT3& previous, const XMFLOAT3& current, float alpha)
+{
+	XMFLOAT3 result;
+
+	// directions stay unit length
+	XMStoreFloat3(&result, XMVector3Normalize(XMVectorLerp(XMLoadFloat3(&previous), XMLoadFloat3(&current), alpha)));
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "framepipelineclass.h"
+
+FramePipelineClass::FramePipelineClass()
+	: m_simulationState(-1), m_renderState(-1), m_frame(0), m_stopped(false), m_pipelined(true), m_latency(0.f)
+{
+}
+
+bool FramePipelineClass::Initialize(bool pipelined)
+{
+	m_pipelined = pipelined;
+	m_stopped = false;
+	m_frame = 0;
+
+	// the simulation may run ahead by all the states, or by none without pipelining
+	for (int i = 0; i < (m_pipelined ? (int)PIPELINE_STATE_COUNT : 1); i++)
+	{
+		m_states[i].hasFrameStats = false;
+		m_states[i].hudPage = 0;
+		if (!m_freeStates.Push(i))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FramePipelineClass::Shutdown()
+{
+	int state;
+
+	// release whoever still waits and take back all the states
+	Stop();
+
+	while (m_readyStates.Pop(state))
+	{
+	}
+	while (m_freeStates.Pop(state))
+	{
+	}
+
+	m_simulationState = m_renderState = -1;
+
+	return;
+}
+
+FrameStateType* FramePipelineClass::BeginSimulation()
+{
+	ProfileZoneClass zone("FramePipelineClass::BeginSimulation");
+
+	// wait until the renderer is done with a state, the queue is checked again under the lock so
+	//  a state that is handed over right before the wait still wakes it up
+	if (!m_freeStates.Pop(m_simulationState))
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (!m_freeStates.Pop(m_simulationState))
+		{
+			if (m_stopped)
+			{
+				return nullptr;
+			}
+			m_stateFree.wait(lock);
+		}
+	}
+
+	m_states[m_simulationState].frame = m_frame++;
+	m_states[m_simulationState].startTicks = ProfilerClass::GetTicks();
+	m_states[m_simulationState].moves.clear();
+	m_states[m_simulationState].hasFrameStats = false;
+
+	return &m_states[m_simulationState];
+}
+
+void FramePipelineClass::EndSimulation()
+{
+	// there is room for every state, so the push cannot fail
+	m_readyStates.Push(m_simulationState);
+	m_simulationState = -1;
+	Signal(m_stateReady);
+
+	return;
+}
+
+FrameStateType* FramePipelineClass::BeginRender()
+{
+	ProfileZoneClass zone("FramePipelineClass::BeginRender");
+
+	// wait until the simulation finished a state
+	if (!m_readyStates.Pop(m_renderState))
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (!m_readyStates.Pop(m_renderState))
+		{
+			if (m_stopped)
+			{
+				return nullptr;
+			}
+			m_stateReady.wait(lock);
+		}
+	}
+
+	return &m_states[m_renderState];
+}
+
+void FramePipelineClass::EndRender()
+{
+	// how long ago the simulation began the frame that was just rendered
+	m_latency = (float)((ProfilerClass::GetTicks() - m_states[m_renderState].startTicks) /
+		(ProfilerClass::GetTicksPerMicrosecond() * 1000.0));
+
+	m_freeStates.Push(m_renderState);
+	m_renderState = -1;
+	Signal(m_stateFree);
+
+	return;
+}
+
+void FramePipelineClass::Stop()
+{
+	// wake up both threads, they see the stop under the lock
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopped = true;
+	}
+	m_stateReady.notify_all();
+	m_stateFree.notify_all();
+
+	return;
+}
+
+bool FramePipelineClass::IsStopped()
+{
+	return m_stopped;
+}
+
+bool FramePipelineClass::IsPipelined()
+{
+	return m_pipelined;
+}
+
+float FramePipelineClass::GetLatency()
+{
+	return m_latency;
+}
+
+void FramePipelineClass::Signal(std::condition_variable& condition)
+{
+	// taking the lock orders the push before the check of a thread that is about to wait
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+	}
+	condition.notify_one();
+
+	return;
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "framestatsclass.h"
+
+FrameStatsClass::FrameStatsClass()
+	: m_budget(FRAME_BUDGET_MS)
+{
+	Reset();
+}
+
+void FrameStatsClass::Initialize(float budget)
+{
+	m_budget = budget;
+	Reset();
+
+	return;
+}
+
+void FrameStatsClass::Reset()
+{
+	for (int i = 0; i < COUNT_SIZE; i++)
+	{
+		m_counts[i] = 0;
+	}
+
+	m_count = 0;
+	m_overBudgetCount = 0;
+	m_max = 0;
+	m_total = 0;
+
+	return;
+}
+
+void FrameStatsClass::Record(float frameTime)
+{
+	unsigned long long value;
+
+	// keep the frame time in whole microseconds
+	value = frameTime > 0.f ? (unsigned long long)(frameTime * 1000.f + 0.5f) : 0;
+
+	m_counts[GetIndex(value)]++;
+	m_count++;
+	m_total += value;
+	m_max = std::max(m_max, value);
+
+	if (frameTime > m_budget)
+	{
+		m_overBudgetCount++;
+	}
+
+	return;
+}
+
+void FrameStatsClass::Merge(const FrameStatsClass& other)
+{
+	for (int i = 0; i < COUNT_SIZE; i++)
+	{
+		m_counts[i] += other.m_counts[i];
+	}
+
+	m_count += other.m_count;
+	m_overBudgetCount += other.m_overBudgetCount;
+	m_total += other.m_total;
+	m_max = std::max(m_max, other.m_max);
+
+	return;
+}
+
+float FrameStatsClass::GetPercentile(double percentile)
+{
+	unsigned long long target, count;
+
+	if (m_count == 0)
+	{
+		return 0.f;
+	}
+
+	// the frame at the percentile, counted from the fastest
+	target = (unsigned long long)(percentile / 100.0 * m_count + 0.5);
+	target = std::max(1ull, std::min(target, m_count));
+
+	// walk the buckets until that many frames were seen
+	count = 0;
+	for (int i = 0; i < COUNT_SIZE; i++)
+	{
+		count += m_counts[i];
+		if (count >= target)
+		{
+			return std::min(GetHighestValue(i), m_max) / 1000.f;
+		}
+	}
+
+	return m_max / 1000.f;
+}
+
+float FrameStatsClass::GetMax()
+{
+	return m_max / 1000.f;
+}
+
+float FrameStatsClass::GetMean()
+{
+	return m_count ? (float)((double)m_total / m_count / 1000.0) : 0.f;
+}
+
+unsigned long long FrameStatsClass::GetCount()
+{
+	return m_count;
+}
+
+unsigned long long FrameStatsClass::GetOverBudgetCount()
+{
+	return m_overBudgetCount;
+}
+
+bool FrameStatsClass::WriteJSON(const char* filename)
+{
+	std::ofstream fout;
+	bool comma;
+
+	fout.open(filename, std::ios::out | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// the summary first, then every bucket that has frames in it as [highest ms, count]
+	fout << "{\"frames\":" << m_count << ",\"budget\":" << m_budget << ",\"overBudget\":" << m_overBudgetCount;
+	fout << ",\"mean\":" << GetMean() << ",\"p50\":" << GetPercentile(50.0) << ",\"p90\":" << GetPercentile(90.0);
+	fout << ",\"p99\":" << GetPercentile(99.0) << ",\"p999\":" << GetPercentile(99.9) << ",\"max\":" << GetMax();
+	fout << ",\"histogram\":[";
+
+	comma = false;
+	for (int i = 0; i < COUNT_SIZE; i++)
+	{
+		if (m_counts[i])
+		{
+			fout << (comma ? "," : "") << "[" << GetHighestValue(i) / 1000.f << "," << m_counts[i] << "]";
+			comma = true;
+		}
+	}
+
+	fout << "]}" << std::endl;
+	fout.close();
+
+	return !fout.fail();
+}
+
+bool FrameStatsClass::WriteCSV(const char* filename)
+{
+	std::ofstream fout;
+
+	fout.open(filename, std::ios::out | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// one header line and one line of values, times in milliseconds
+	fout << "frames,budget,over_budget,mean,p50,p90,p99,p999,max" << std::endl;
+	fout << m_count << "," << m_budget << "," << m_overBudgetCount << "," << GetMean() << ",";
+	fout << GetPercentile(50.0) << "," << GetPercentile(90.0) << "," << GetPercentile(99.0) << ",";
+	fout << GetPercentile(99.9) << "," << GetMax() << std::endl;
+	fout.close();
+
+	return !fout.fail();
+}
+
+int FrameStatsClass::GetIndex(unsigned long long value)
+{
+	int bucket;
+
+	// the bucket is the power of two above the sub bucket range, values below it are counted exactly
+	bucket = 0;
+	for (unsigned long long v = value >> FRAME_STATS_SUB_BUCKET_BITS; v; v >>= 1)
+	{
+		bucket++;
+	}
+
+	// clamp what is out of range into the last sub bucket
+	if (bucket >= FRAME_STATS_BUCKET_COUNT)
+	{
+		return COUNT_SIZE - 1;
+	}
+
+	// in bucket b the values are counted in steps of 2^b, and only the upper half of the sub buckets is used
+	return bucket * SUB_BUCKET_HALF + (int)(value >> bucket);
+}
+
+unsigned long long FrameStatsClass::GetHighestValue(int index)
+{
+	int bucket, subBucket;
+
+	// the reverse of GetIndex, the highest value that falls into the sub bucket
+	bucket = index < SUB_BUCKET_COUNT ? 0 : (index - SUB_BUCKET_HALF) / SUB_BUCKET_HALF;
+	subBucket = index - bucket * SUB_BUCKET_HALF;
+
+	return (((unsigned long long)subBucket + 1) << bucket) - 1;
+}
\ No newline at end of file
@@ -1,10 +1,22 @@
 #include "frustumclass.h"
 
+FrustumClass::FrustumClass()
+	: m_epoch(1), m_travel(0.f), m_planeTests(0)
+{
+	for (int i = 0; i < 6; i++)
+	{
+		m_planes[i] = XMVectorZero();
+		m_planeData[i] = XMFLOAT4(0.f, 0.f, 0.f, 0.f);
+	}
+}
+
 void FrustumClass::ConstructFrustum(float screenDepth, XMMATRIX projectionMatrix, XMMATRIX viewMatrix)
 {
-	float zMinimum, r;
+	float zMinimum, r, move;
 	XMMATRIX matrix;
 	XMFLOAT4X4 fmatrix, fprojMatrix;
+	XMFLOAT4 previous[6];
+	bool turned;
 
 	// store matrices in specific 4x4 floats
 	XMStoreFloat4x4(&fprojMatrix, projectionMatrix);
@@ -78,6 +90,34 @@ void FrustumClass::ConstructFrustum(float screenDepth, XMMATRIX projectionMatrix
 	));
 	m_planes[5] = XMPlaneNormalize(m_planes[5]);
 
+	// keep the planes as floats, the box tests only need one dot product per plane
+	for (int i = 0; i < 6; i++)
+	{
+		XMStoreFloat4(&previous[i], XMLoadFloat4(&m_planeData[i]));
+		XMStoreFloat4(&m_planeData[i], m_planes[i]);
+	}
+
+	// a camera that only moved shifts every plane along its normal, no point changes its distance to
+	//  a plane by more than that. once the normals change the remembered margins are no longer valid
+	turned = false;
+	move = 0.f;
+	for (int i = 0; i < 6; i++)
+	{
+		turned = turned || m_planeData[i].x != previous[i].x || m_planeData[i].y != previous[i].y ||
+			m_planeData[i].z != previous[i].z;
+		move = std::max(move, fabsf(m_planeData[i].w - previous[i].w));
+	}
+
+	if (turned)
+	{
+		m_epoch++;
+		m_travel = 0.f;
+	}
+	else
+	{
+		m_travel += move;
+	}
+
 	return;
 }
 
@@ -86,7 +126,9 @@ bool FrustumClass::CheckPoint(float x, float y, float z)
 	// check if the point is inside all six planes of the view frustum
 	for (int i = 0; i < 6; i++)
 	{
-		if (distanceToPlane(i, XMFLOAT3(x, y, z)) < 0.f)
+		const XMFLOAT4& plane = m_planeData[i];
+
+		if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.f)
 		{
 			return false;
 		}
@@ -97,61 +139,80 @@ bool FrustumClass::CheckPoint(float x, float y, float z)
 
 bool FrustumClass::CheckCube(float xCenter, float yCenter, float zCenter, float radius)
 {
-	// check if any one point of the cube is in the view frustum
+	// a cube is a rectangle with the same size along every axis
+	return CheckRectangle(xCenter, yCenter, zCenter, radius, radius, radius);
+}
+
+bool FrustumClass::CheckSphere(float xCenter, float yCenter, float zCenter, float radius)
+{
+	// check if the radius of the sphere is inside the view frustum
 	for (int i = 0; i < 6; i++)
 	{
-		if (distanceToPlane(i, XMFLOAT3(xCenter - radius, yCenter - radius, zCenter - radius)) >= 0.f)
-		{
-			continue;
-		}
+		const XMFLOAT4& plane = m_planeData[i];
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter + radius, yCenter - radius, zCenter - radius)) >= 0.f)
+		m_planeTests++;
+		if (plane.x * xCenter + plane.y * yCenter + plane.z * zCenter + plane.w < -radius)
 		{
-			continue;
+			return false;
 		}
+	}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter - radius, yCenter + radius, zCenter - radius)) >= 0.f)
-		{
-			continue;
-		}
-		
-		if (distanceToPlane(i, XMFLOAT3(xCenter + radius, yCenter + radius, zCenter - radius)) >= 0.f)
-		{
-			continue;
-		}
+	return true;
+}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter - radius, yCenter - radius, zCenter + radius)) >= 0.f)
-		{
-			continue;
-		}
+bool FrustumClass::CheckSphere(float xCenter, float yCenter, float zCenter, float radius, FrustumCacheType& cache)
+{
+	float distance, margin;
+	int plane;
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter + radius, yCenter - radius, zCenter + radius)) >= 0.f)
-		{
-			continue;
-		}
+	// the sphere is still inside if the planes moved less than its margin since it was measured
+	if (cache.epoch == m_epoch && m_travel < cache.expiry)
+	{
+		return true;
+	}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter - radius, yCenter + radius, zCenter + radius)) >= 0.f)
+	// the plane that rejected it last frame most likely rejects it again, the others follow in order
+	margin = FLT_MAX;
+	for (int i = -1; i < 6; i++)
+	{
+		plane = i < 0 ? cache.plane : i;
+		if (i == cache.plane)
 		{
 			continue;
 		}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter + radius, yCenter + radius, zCenter + radius)) >= 0.f)
+		const XMFLOAT4& data = m_planeData[plane];
+
+		m_planeTests++;
+		distance = data.x * xCenter + data.y * yCenter + data.z * zCenter + data.w;
+		if (distance < -radius)
 		{
-			continue;
+			cache.plane = plane;
+			cache.epoch = 0;
+			return false;
 		}
 
-		return false;
+		margin = std::min(margin, distance + radius);
 	}
 
+	// remember how far inside it is
+	cache.epoch = m_epoch;
+	cache.expiry = m_travel + margin;
+
 	return true;
 }
 
-bool FrustumClass::CheckSphere(float xCenter, float yCenter, float zCenter, float radius)
+bool FrustumClass::CheckRectangle(float xCenter, float yCenter, float zCenter, float xSize, float ySize, float zSize)
 {
-	// check if the radius of the sphere is inside the view frustum
+	// the rectangle is outside if even its corner furthest along the plane normal, the positive
+	//  vertex, is behind one of the planes. the distance of that corner is the distance of the
+	//  center plus the sizes projected onto the absolute normal
 	for (int i = 0; i < 6; i++)
 	{
-		if (distanceToPlane(i, XMFLOAT3(xCenter, yCenter, zCenter)) < -radius)
+		const XMFLOAT4& plane = m_planeData[i];
+
+		if (plane.x * xCenter + plane.y * yCenter + plane.z * zCenter + plane.w +
+			fabsf(plane.x) * xSize + fabsf(plane.y) * ySize + fabsf(plane.z) * zSize < 0.f)
 		{
 			return false;
 		}
@@ -160,69 +221,125 @@ bool FrustumClass::CheckSphere(float xCenter, float yCenter, float zCenter, floa
 	return true;
 }
 
-bool FrustumClass::CheckRectangle(float xCenter, float yCenter, float zCenter, float xSize, float ySize, float zSize)
+FrustumResultType FrustumClass::ClassifyCube(float xCenter, float yCenter, float zCenter, float radius)
 {
-	// check if any of the 6 planes of the rectangle are inside the view frustum
+	return ClassifyRectangle(xCenter, yCenter, zCenter, radius, radius, radius);
+}
+
+FrustumResultType FrustumClass::ClassifyRectangle(float xCenter, float yCenter, float zCenter, float xSize, float ySize, float zSize)
+{
+	FrustumResultType result;
+	float distance, extent;
+
+	// outside if the positive vertex is behind a plane, inside if the negative vertex is in front of all of them
+	result = FRUSTUM_INSIDE;
 	for (int i = 0; i < 6; i++)
 	{
-		if (distanceToPlane(i, XMFLOAT3(xCenter - xSize, yCenter - ySize, zCenter - zSize)) >= 0.f)
-		{
-			continue;
-		}
+		const XMFLOAT4& plane = m_planeData[i];
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter + xSize, yCenter - ySize, zCenter - zSize)) >= 0.f)
-		{
-			continue;
-		}
+		distance = plane.x * xCenter + plane.y * yCenter + plane.z * zCenter + plane.w;
+		extent = fabsf(plane.x) * xSize + fabsf(plane.y) * ySize + fabsf(plane.z) * zSize;
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter - xSize, yCenter + ySize, zCenter - zSize)) >= 0.f)
+		if (distance + extent < 0.f)
 		{
-			continue;
+			return FRUSTUM_OUTSIDE;
 		}
-
-		if (distanceToPlane(i, XMFLOAT3(xCenter + xSize, yCenter + ySize, zCenter - zSize)) >= 0.f)
+		if (distance - extent < 0.f)
 		{
-			continue;
+			result = FRUSTUM_INTERSECT;
 		}
+	}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter - xSize, yCenter - ySize, zCenter + zSize)) >= 0.f)
-		{
-			continue;
-		}
+	return result;
+}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter + xSize, yCenter - ySize, zCenter + zSize)) >= 0.f)
-		{
-			continue;
-		}
+void FrustumClass::ClassifyCubes(const XMFLOAT3* centers, const float* radii, int count, FrustumResultType* results)
+{
+	XMFLOAT4 planes[6];
+	float lengths[6];
+	float distance, extent;
+
+	// copy the planes and the l1 length of their normals, the projected size of a cube only needs that
+	for (int i = 0; i < 6; i++)
+	{
+		planes[i] = m_planeData[i];
+		lengths[i] = fabsf(planes[i].x) + fabsf(planes[i].y) + fabsf(planes[i].z);
+	}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter - xSize, yCenter + ySize, zCenter + zSize)) >= 0.f)
+	for (int j = 0; j < count; j++)
+	{
+		results[j] = FRUSTUM_INSIDE;
+		for (int i = 0; i < 6; i++)
 		{
-			continue;
+			distance = planes[i].x * centers[j].x + planes[i].y * centers[j].y + planes[i].z * centers[j].z + planes[i].w;
+			extent = lengths[i] * radii[j];
+
+			if (distance + extent < 0.f)
+			{
+				results[j] = FRUSTUM_OUTSIDE;
+				break;
+			}
+			if (distance - extent < 0.f)
+			{
+				results[j] = FRUSTUM_INTERSECT;
+			}
 		}
+	}
+
+	return;
+}
+
+void FrustumClass::ClassifyRectangles(const XMFLOAT3* centers, const XMFLOAT3* sizes, int count, FrustumResultType* results)
+{
+	XMFLOAT4 planes[6], normals[6];
+	float distance, extent;
+
+	// copy the planes and their absolute normals so the loop only reads locals
+	for (int i = 0; i < 6; i++)
+	{
+		planes[i] = m_planeData[i];
+		normals[i] = XMFLOAT4(fabsf(planes[i].x), fabsf(planes[i].y), fabsf(planes[i].z), 0.f);
+	}
 
-		if (distanceToPlane(i, XMFLOAT3(xCenter + xSize, yCenter + ySize, zCenter + zSize)) >= 0.f)
+	for (int j = 0; j < count; j++)
+	{
+		results[j] = FRUSTUM_INSIDE;
+		for (int i = 0; i < 6; i++)
 		{
-			continue;
+			distance = planes[i].x * centers[j].x + planes[i].y * centers[j].y + planes[i].z * centers[j].z + planes[i].w;
+			extent = normals[i].x * sizes[j].x + normals[i].y * sizes[j].y + normals[i].z * sizes[j].z;
+
+			if (distance + extent < 0.f)
+			{
+				results[j] = FRUSTUM_OUTSIDE;
+				break;
+			}
+			if (distance - extent < 0.f)
+			{
+				results[j] = FRUSTUM_INTERSECT;
+			}
 		}
-
-		return false;
 	}
 
-	return true;
+	return;
+}
+
+XMFLOAT4 FrustumClass::GetPlane(int plane)
+{
+	return m_planeData[plane];
+}
+
+void FrustumClass::ResetCache(FrustumCacheType& cache)
+{
+	// epoch 0 is never the one of a frustum, so the object is tested the next time
+	cache.epoch = 0;
+	cache.expiry = 0.f;
+	cache.plane = 0;
+
+	return;
 }
 
-//
-// helper function
-float FrustumClass::distanceToPlane(int plane, XMFLOAT3 pt)
+unsigned long long FrustumClass::GetPlaneTestCount()
 {
-	XMFLOAT3 dist;
-	// calculate distance between plane and point
-	XMVECTOR sum = XMVectorSum(
-		XMPlaneDotCoord(
-			m_planes[plane],
-			XMLoadFloat3(&pt)
-		)
-	);
-	XMStoreFloat3(&dist, sum);
-	return dist.x;
+	return m_planeTests;
 }
\ No newline at end of file
@@ -12,15 +12,32 @@ GraphicsClass::GraphicsClass()
 	//  posX(0.f), posY(0.f), posZ(0.f), 
 	//  angleH(0.f), angleV(0.f)
 {
+	m_Pack = nullptr;
+	m_AssetCache = nullptr;
 	m_Direct3D = nullptr;
 	m_Camera = nullptr;
-	m_Model = nullptr;
-	m_BumpMapShader = nullptr;
 	m_Light = nullptr;
 	//m_Bitmap = nullptr;
 	m_Text = nullptr;
 	m_ModelList = nullptr;
-	m_Frustum = nullptr;
+	m_Visibility = nullptr;
+	m_TextureStreamer = nullptr;
+	m_TextureLoader = nullptr;
+	m_FileSystem = nullptr;
+	m_AssetWatcher = nullptr;
+	m_visibleModelsCounter = -1;
+	m_planeTestsCounter = -1;
+	m_cullingSkippedCounter = -1;
+	m_hudPage = HUD_PAGE_RENDER;
+
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		m_textureIds[i] = -1;
+		m_textureSizes[i] = TEXTURE_STREAMING_SIZE;
+		m_textureLoadedSizes[i] = TEXTURE_STREAMING_SIZE;
+		m_textureGenerations[i] = 0;
+		m_textureWatchIds[i] = -1;
+	}
 }
 
 GraphicsClass::GraphicsClass(const GraphicsClass& other)
@@ -35,9 +52,44 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 {
 	bool result;
 	XMMATRIX baseViewMatrix;
+	WCHAR* textureFilenames[TEXTURE_ARRAY_SIZE] = {
+		L"./data/stone01_conv.dds",
+		L"./data/dirt01_conv.dds",
+		L"./data/alpha01_conv.dds",
+		L"./data/bump01_conv.dds",
+		L"./data/spec02_conv.dds"
+	};
+	char filename[128];
+	size_t length;
+	AssetDataType asset;
+	SceneSettingsType sceneSettings;
+
+	// create the pack object
+	m_Pack = MemoryClass::New<PackFileClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_Pack)
+	{
+		return false;
+	}
+
+	// map the asset pack, without it every asset is read from its loose file
+	m_Pack->Open(PACK_ENGINE_FILENAME);
+
+	// create the asset cache object
+	m_AssetCache = MemoryClass::New<AssetCacheClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_AssetCache)
+	{
+		return false;
+	}
+
+	// without a cache directory every asset is imported from its source
+	if (!m_AssetCache->Initialize(ASSET_CACHE_DIRECTORY))
+	{
+		MemoryClass::Delete(m_AssetCache);
+		m_AssetCache = nullptr;
+	}
 
 	// create the Direct3D object
-	m_Direct3D = new D3DClass;
+	m_Direct3D = MemoryClass::New<D3DClass>(MEMORY_TAG_GRAPHICS);
 	if (!m_Direct3D)
 	{
 		return false;
@@ -61,7 +113,7 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 	}
 
 	// create the camera object
-	m_Camera = new CameraClass;
+	m_Camera = MemoryClass::New<CameraClass>(MEMORY_TAG_GRAPHICS);
 	if (!m_Camera) 
 	{
 		return false;
@@ -75,39 +127,58 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 	// set the initial position of the camera
 	m_Camera->SetPosition(0.f, 0.f, -3.f);
 
-	// create the model object
-	m_Model = new ModelClass;
-	if (!m_Model) 
+	// create the mesh of the models in the mesh pool
+	m_mesh = m_meshes.Create();
+	if (m_mesh.IsNull())
 	{
 		return false;
 	}
 
-	// initialize the model object
-	result = m_Model->Initialize(
+	// initialize the mesh
+	result = m_meshes.Get(m_mesh)->Initialize(
 		m_Direct3D->GetDevice(), 
-		m_Direct3D->GetDeviceContext(),
-		"./data/sphere.txt",
-		L"./data/stone01_conv.dds",
-		L"./data/dirt01_conv.dds",
-		L"./data/alpha01_conv.dds",
-		L"./data/bump01_conv.dds",
-		L"./data/spec02_conv.dds"
+		m_Pack,
+		m_AssetCache,
+		"./data/sphere.txt"
 		);
 	if (!result) 
 	{
 		MessageBox(hwnd, L"Could not initialize the model object.", L"Error", MB_OK);
 		return false;
 	}
+
+	// create the textures of the models in the texture pool
+	m_textureArray = m_textures.Create();
+	if (m_textureArray.IsNull())
+	{
+		return false;
+	}
+
+	// initialize the texture array
+	result = m_textures.Get(m_textureArray)->Initialize(
+		m_Direct3D->GetDevice(),
+		m_Pack,
+		textureFilenames[0],
+		textureFilenames[1],
+		textureFilenames[2],
+		textureFilenames[3],
+		textureFilenames[4]
+		);
+	if (!result)
+	{
+		MessageBox(hwnd, L"Could not initialize the texture array object.", L"Error", MB_OK);
+		return false;
+	}
 	
-	// create the light shader object
-	m_BumpMapShader = new BumpMapShaderClass;
-	if (!m_BumpMapShader)
+	// create the light shader in the shader pool
+	m_bumpMapShader = m_shaders.Create();
+	if (m_bumpMapShader.IsNull())
 	{
 		return false;
 	}
 
-	// initialize the light shader object
-	result = m_BumpMapShader->Initialize(m_Direct3D->GetDevice(), hwnd);
+	// initialize the light shader
+	result = m_shaders.Get(m_bumpMapShader)->Initialize(m_Direct3D->GetDevice(), hwnd, m_Pack);
 	if (!result)
 	{
 		MessageBox(hwnd, L"Could not initialize the light shader object.", L"Error", MB_OK);
@@ -115,7 +186,7 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 	}
 
 	// create the light object
-	m_Light = new LightClass;
+	m_Light = MemoryClass::New<LightClass>(MEMORY_TAG_GRAPHICS);
 	if (!m_Light)
 	{
 		return false;
@@ -139,6 +210,8 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 	//result = m_Bitmap->Initialize(
 	//	m_Direct3D->GetDevice(),
 	//	m_Direct3D->GetDeviceContext(),
+	//	m_Pack,
+	//	m_AssetCache,
 	//	screenWidth, screenHeight,
 	//	"./data/stone01.tga", 
 	//	128, 128								// width, height
@@ -150,7 +223,7 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 	//}
 
 	// create the text object
-	m_Text = new TextClass;
+	m_Text = MemoryClass::New<TextClass>(MEMORY_TAG_TEXT);
 	if (!m_Text)
 	{
 		return false;
@@ -160,6 +233,8 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 	result = m_Text->Initialize(
 		m_Direct3D->GetDevice(),
 		m_Direct3D->GetDeviceContext(),
+		m_Pack,
+		m_AssetCache,
 		hwnd,
 		screenWidth, screenHeight,
 		baseViewMatrix
@@ -171,27 +246,121 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 	}
 
 	// create the model list object
-	m_ModelList = new ModelListClass;
+	m_ModelList = MemoryClass::New<ModelListClass>(MEMORY_TAG_SCENE);
 	if (!m_ModelList)
 	{
 		return false;
 	}
 
 	// initialize the model list object
-	result = m_ModelList->Initialize(500);	// num Models
+	SceneGeneratorClass::GetDefaultSettings(sceneSettings);
+	result = m_ModelList->Initialize(sceneSettings);
 	if (!result)
 	{
 		MessageBox(hwnd, L"Could not initialize the model list object.", L"Error", MB_OK);
 		return false;
 	}
 
-	// create the frustum object
-	m_Frustum = new FrustumClass;
-	if (!m_Frustum)
+	// every model is drawn with the sphere mesh
+	for (int i = 0; i < m_ModelList->GetModelCount(); i++)
+	{
+		m_ModelList->SetMesh(i, m_mesh);
+	}
+
+	// count the visible models, the frustum plane tests and the frames that reused the visible set
+	m_visibleModelsCounter = RenderStatsClass::Register("visible_models");
+	m_planeTestsCounter = RenderStatsClass::Register("plane_tests");
+	m_cullingSkippedCounter = RenderStatsClass::Register("culling_skipped");
+
+	// create the visibility object
+	m_Visibility = MemoryClass::New<VisibilityClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_Visibility)
+	{
+		return false;
+	}
+
+	// initialize the visibility object
+	result = m_Visibility->Initialize(m_ModelList);
+	if (!result)
+	{
+		MessageBox(hwnd, L"Could not initialize the visibility object.", L"Error", MB_OK);
+		return false;
+	}
+
+	// create the texture streamer object
+	m_TextureStreamer = MemoryClass::New<TextureStreamerClass>(MEMORY_TAG_TEXTURE);
+	if (!m_TextureStreamer)
+	{
+		return false;
+	}
+
+	// initialize the texture streamer with the same field of view as the projection matrix
+	result = m_TextureStreamer->Initialize(
+		TEXTURE_BUDGET,
+		screenHeight,
+		3.141592654f / 4.f,
+		StreamTexture,
+		this
+	);
+	if (!result)
 	{
+		MessageBox(hwnd, L"Could not initialize the texture streamer object.", L"Error", MB_OK);
 		return false;
 	}
 
+	// create the texture loader object, the streamed mips are read and created on its thread
+	m_TextureLoader = MemoryClass::New<TextureLoaderClass>(MEMORY_TAG_TEXTURE);
+	if (!m_TextureLoader)
+	{
+		return false;
+	}
+
+	result = m_TextureLoader->Initialize(m_Direct3D->GetDevice(), m_Pack, TEXTURE_ARRAY_SIZE);
+	if (!result)
+	{
+		MessageBox(hwnd, L"Could not initialize the texture loader object.", L"Error", MB_OK);
+		return false;
+	}
+
+	// register the texture array of the model, only its small mips are loaded so far
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		wcstombs_s(&length, filename, sizeof(filename), textureFilenames[i], _TRUNCATE);
+		if (m_Pack->Read(filename, asset))
+		{
+			m_textureIds[i] = m_TextureStreamer->RegisterDDS(asset.data, asset.size, TEXTURE_STREAMING_SIZE);
+		}
+		else
+		{
+			m_textureIds[i] = -1;
+		}
+		if (m_textureIds[i] < 0)
+		{
+			MessageBox(hwnd, L"Could not register a texture for streaming.", L"Error", MB_OK);
+			return false;
+		}
+	}
+
+	// watch the assets so they are reloaded when they change on disk
+	if (HOT_RELOAD_ENABLED)
+	{
+		result = InitializeHotReload("./data/sphere.txt", textureFilenames);
+		if (!result)
+		{
+			MessageBox(hwnd, L"Could not initialize the asset watcher object.", L"Error", MB_OK);
+			return false;
+		}
+	}
+
+	// report how many imports the asset cache saved this run
+	if (m_AssetCache)
+	{
+		char cacheInfo[128];
+		sprintf_s(cacheInfo, sizeof(cacheInfo), "asset cache: %d hits, %d misses, %d stored\n",
+			m_AssetCache->GetHitCount(), m_AssetCache->GetMissCount(), m_AssetCache->GetStoreCount());
+		OutputDebugStringA(cacheInfo);
+	}
+
 	if (VCARD_INFO)
 	{
 		char cardName[128];
@@ -200,13 +369,12 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 		int len;
 		int slength = 128;
 		len = MultiByteToWideChar(CP_ACP, 0, cardName, slength, 0, 0);
-		wchar_t* buf = new wchar_t[len];
+		wchar_t* buf = FrameArenaClass::Allocate<wchar_t>(len);
 		MultiByteToWideChar(CP_ACP, 0, cardName, slength, buf, len);
 		std::wstring wsCardName(buf);
 		wsCardName.append(L": ");
 		wsCardName.append(std::to_wstring(cardMem));
 		wsCardName.append(L"Mb");
-		delete[] buf;
 
 		int msgboxID = MessageBox(
 			NULL,
@@ -221,18 +389,50 @@ bool GraphicsClass::Initialize(int screenWidth, int screenHeight, HWND hwnd)
 
 void GraphicsClass::Shutdown()
 {
-	// release the frustum object
-	if (m_Frustum)
+	// stop the asset watcher first, its imports use the objects below
+	if (m_AssetWatcher)
+	{
+		m_AssetWatcher->Shutdown();
+		MemoryClass::Delete(m_AssetWatcher);
+		m_AssetWatcher = nullptr;
+	}
+
+	// release the file system object
+	if (m_FileSystem)
+	{
+		MemoryClass::Delete(m_FileSystem);
+		m_FileSystem = nullptr;
+	}
+
+	// release the texture loader object, a load in flight is finished before the device goes away
+	if (m_TextureLoader)
 	{
-		delete m_Frustum;
-		m_Frustum = nullptr;
+		m_TextureLoader->Shutdown();
+		MemoryClass::Delete(m_TextureLoader);
+		m_TextureLoader = nullptr;
+	}
+
+	// release the texture streamer object
+	if (m_TextureStreamer)
+	{
+		m_TextureStreamer->Shutdown();
+		MemoryClass::Delete(m_TextureStreamer);
+		m_TextureStreamer = nullptr;
+	}
+
+	// release the visibility object
+	if (m_Visibility)
+	{
+		m_Visibility->Shutdown();
+		MemoryClass::Delete(m_Visibility);
+		m_Visibility = nullptr;
 	}
 
 	// release the model list object
 	if (m_ModelList)
 	{
 		m_ModelList->Shutdown();
-		delete m_ModelList;
+		MemoryClass::Delete(m_ModelList);
 		m_ModelList = nullptr;
 	}
 
@@ -240,7 +440,7 @@ void GraphicsClass::Shutdown()
 	if (m_Text)
 	{
 		m_Text->Shutdown();
-		delete m_Text;
+		MemoryClass::Delete(m_Text);
 		m_Text = nullptr;
 	}
 
@@ -255,28 +455,32 @@ void GraphicsClass::Shutdown()
 	// release the light object
 	if (m_Light)
 	{
-		delete m_Light;
+		MemoryClass::Delete(m_Light);
 		m_Light = nullptr;
 	}
 
-	// release the light shader object
-	if (m_BumpMapShader)
+	// release the shaders, the textures and the meshes in the order they are stored
+	for (int i = 0; i < m_shaders.GetCount(); i++)
 	{
-		m_BumpMapShader->Shutdown();
-		delete m_BumpMapShader;
-		m_BumpMapShader = nullptr;
+		m_shaders.GetData()[i].Shutdown();
 	}
+	m_shaders.Clear();
 
-	// release the model object
-	if (m_Model) {
-		m_Model->Shutdown();
-		delete m_Model;
-		m_Model = nullptr;
+	for (int i = 0; i < m_textures.GetCount(); i++)
+	{
+		m_textures.GetData()[i].Shutdown();
 	}
+	m_textures.Clear();
+
+	for (int i = 0; i < m_meshes.GetCount(); i++)
+	{
+		m_meshes.GetData()[i].Shutdown();
+	}
+	m_meshes.Clear();
 
 	// release the camera object
 	if (m_Camera) {
-		delete m_Camera;
+		MemoryClass::Delete(m_Camera);
 		m_Camera = nullptr;
 	}
 
@@ -284,10 +488,55 @@ void GraphicsClass::Shutdown()
 	if (m_Direct3D)
 	{
 		m_Direct3D->Shutdown();
-		delete m_Direct3D;
+		MemoryClass::Delete(m_Direct3D);
 		m_Direct3D = nullptr;
 	}
 
+	// release the asset cache object
+	if (m_AssetCache)
+	{
+		m_AssetCache->Shutdown();
+		MemoryClass::Delete(m_AssetCache);
+		m_AssetCache = nullptr;
+	}
+
+	// release the pack object
+	if (m_Pack)
+	{
+		m_Pack->Close();
+		MemoryClass::Delete(m_Pack);
+		m_Pack = nullptr;
+	}
+
+	return;
+}
+
+bool GraphicsClass::SetFrameStats(FrameStatsClass* frameStats)
+{
+	// show the frame time percentiles in milliseconds
+	return m_Text->SetFrameStats(
+		frameStats->GetPercentile(50.0),
+		frameStats->GetPercentile(90.0),
+		frameStats->GetPercentile(99.0),
+		frameStats->GetPercentile(99.9),
+		frameStats->GetMax(),
+		frameStats->GetOverBudgetCount(),
+		m_Direct3D->GetDeviceContext()
+	);
+}
+
+void GraphicsClass::SetHudPage(int page)
+{
+	m_hudPage = page;
+
+	return;
+}
+
+void GraphicsClass::MoveModel(int index, XMFLOAT3 position)
+{
+	// the visibility object tests the model again on the next render
+	m_ModelList->SetPosition(index, position.x, position.y, position.z);
+
 	return;
 }
 
@@ -296,6 +545,7 @@ bool GraphicsClass::Frame(
 	XMFLOAT3 position, XMFLOAT3 direction, XMFLOAT3 up
 )
 {
+	ProfileZoneClass zone("GraphicsClass::Frame");
 	bool result;
 
 	// set the frame per second
@@ -333,11 +583,21 @@ bool GraphicsClass::Frame(
 
 bool GraphicsClass::Render()
 {
-	XMMATRIX worldMatrix, viewMatrix, projectionMatrix, orthoMatrix;
-	int modelCount, renderCount;
-	float positionX, positionY, positionZ, radius;
-	XMFLOAT4 color;
-	bool renderModel, result;
+	ProfileZoneClass zone("GraphicsClass::Render");
+	XMMATRIX worldMatrix, modelMatrix, viewMatrix, projectionMatrix, orthoMatrix;
+	RenderItemType* items;
+	int renderCount;
+	unsigned long long planeTests;
+	float distance;
+	XMFLOAT3 cameraPosition;
+	bool result;
+
+	// put the assets that were reloaded in the background into use before anything of this frame is drawn
+	if (m_AssetWatcher)
+	{
+		m_AssetWatcher->ApplyChanges();
+	}
+	ApplyStreamedTextures();
 
 	// clear the buffers to begin the scene
 	m_Direct3D->BeginScene(0.f, 0.f, 0.f, 1.f);
@@ -351,75 +611,117 @@ bool GraphicsClass::Render()
 	m_Direct3D->GetProjectionMatrix(projectionMatrix);
 	m_Direct3D->GetOrthoMatrix(orthoMatrix);
 
-	// construct the frustum
-	m_Frustum->ConstructFrustum(
-		SCREEN_DEPTH,
-		projectionMatrix,
-		viewMatrix
-	);
+	// start collecting the mip requests of this frame
+	m_TextureStreamer->BeginFrame();
+	cameraPosition = m_Camera->GetPosition();
 
-	// get the number of models that will be rendered
-	modelCount = m_ModelList->GetModelCount();
+	// find the models that can be seen by the camera, this is skipped if neither the camera nor the scene changed
+	planeTests = m_Visibility->GetPlaneTestCount();
+	m_Visibility->Cull(SCREEN_DEPTH, projectionMatrix, viewMatrix);
 
-	// initialize the count of models that have been rendered
-	renderCount = 0;
+	// the count of models that are rendered
+	renderCount = m_Visibility->GetVisibleCount();
 
-	// go through all the models and render them only if they can be seen by the camera
-	for (int index = 0; index < modelCount; index++)
+	// copy what is drawn of the visible models out of the entities
+	items = FrameArenaClass::Allocate<RenderItemType>(renderCount);
+	if (!items)
 	{
-		// get the position and color of the object model at this index
-		m_ModelList->GetData(
-			index,
-			positionX, positionY, positionZ,
-			color
-		);
-
-		// set the radius of the sphere to 1.0 since this is already known
-		radius = 1.f;
-
-		// check if the sphere model are in the view frustum
-		renderModel = m_Frustum->CheckSphere(
-			positionX, positionY, positionZ,
-			radius
-		);
+		return false;
+	}
+	m_ModelList->Extract(m_Visibility->GetVisibleModels(), renderCount, items);
 
-		// if it can be seen then render it, if not skip this model
-		if (renderModel)
+	// render the visible models
+	{
+		ProfileZoneClass submissionZone("submission");
+		BumpMapShaderClass* shader;
+		TextureArrayClass* textures;
+		ModelClass* mesh;
+		MeshHandleType boundMesh;
+
+		// the shader and the textures are the same for every model
+		shader = m_shaders.Get(m_bumpMapShader);
+		textures = m_textures.Get(m_textureArray);
+		if (!shader || !textures)
 		{
-			// move the model to the location it should be rendered at
-			worldMatrix = XMMatrixTranslation(positionX, positionY, positionZ);
+			return false;
+		}
 
-			// put the model vertex and index buffers on the graphics pipeline
-			m_Model->Render(m_Direct3D->GetDeviceContext());
+		for (int index = 0; index < renderCount; index++)
+		{
+			const RenderItemType& item = items[index];
+
+			// a model whose mesh was destroyed is skipped instead of drawing freed buffers
+			mesh = m_meshes.Get(item.mesh);
+			if (!mesh)
+			{
+				continue;
+			}
+
+			// request the texture detail this model needs at its distance from the camera
+			distance = sqrtf(
+				(item.positionX - cameraPosition.x) * (item.positionX - cameraPosition.x) +
+				(item.positionY - cameraPosition.y) * (item.positionY - cameraPosition.y) +
+				(item.positionZ - cameraPosition.z) * (item.positionZ - cameraPosition.z)
+			);
+			for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+			{
+				m_TextureStreamer->RequestSphere(m_textureIds[i], distance, item.radius);
+			}
+
+			// the world matrix of the model was made by its transform node, the one of the
+			//  scene stays as it is for the text
+			modelMatrix = XMLoadFloat4x4(&item.world);
+
+			// put the vertex and index buffers of the mesh on the graphics pipeline if the
+			//  last model used another one
+			if (item.mesh != boundMesh)
+			{
+				mesh->Render(m_Direct3D->GetDeviceContext());
+				boundMesh = item.mesh;
+			}
 
 			// render the model using the bumpmap shader
-			m_BumpMapShader->Render(
+			shader->Render(
 				m_Direct3D->GetDeviceContext(),
-				m_Model->GetIndexCount(),
-				worldMatrix, viewMatrix, projectionMatrix,
-				m_Model->GetTextureArray(),
+				mesh->GetIndexCount(),
+				modelMatrix, viewMatrix, projectionMatrix,
+				textures->GetTextureArray(),
 				m_Light->GetDirection(),
 				m_Light->GetAmbientColor(),
-				XMLoadFloat4(&color),			// customized color
+				XMLoadFloat4(&item.color),		// customized color
 				m_Camera->GetPosition(),
 				m_Light->GetSpecularColor(),
 				m_Light->GetSpecularPower()
 			);
-
-			// reset tot the original world matrix
-			m_Direct3D->GetWorldMatrix(worldMatrix);
-
-			// since this model was rendered, increase the count
-			renderCount++;
 		}
 	}
 
+	// stream in the most important missing mips, the new textures are used from the next frame on
+	m_TextureStreamer->Update(TEXTURE_LOADS_PER_FRAME);
+
 	// set the number of models that was actually rendered this frame
 	result = m_Text->SetValuei(renderCount, m_Direct3D->GetDeviceContext());
 	if (!result)
 	{
 		return false;
 	}
+	RenderStatsClass::Add(m_visibleModelsCounter, renderCount);
+	RenderStatsClass::Add(m_planeTestsCounter, m_Visibility->GetPlaneTestCount() - planeTests);
+	RenderStatsClass::Add(m_cullingSkippedCounter, m_Visibility->IsReused() ? 1 : 0);
+
+	// show the render counters of the last frame or the tracked memory
+	if (m_hudPage == HUD_PAGE_MEMORY)
+	{
+		result = m_Text->SetMemoryStats(m_Direct3D->GetDeviceContext());
+	}
+	else
+	{
+		result = m_Text->SetRenderStats(m_Direct3D->GetDeviceContext());
+	}
+	if (!result)
+	{
+		return false;
+	}
 
 
 	// TURN OFF the z buffer to begin all 2d rendering
@@ -467,5 +769,303 @@ bool GraphicsClass::Render()
 	// present the rendered scene to the screen
 	m_Direct3D->EndScene();
 
+	// release the temporaries of the frame and fold the render counters of all the threads
+	//  into the values of this frame
+	FrameArenaClass::EndFrame();
+	RenderStatsClass::EndFrame();
+
 	return true;
+}
+
+bool GraphicsClass::StreamTexture(void* userData, int textureId, int topMip)
+{
+	GraphicsClass* graphics = (GraphicsClass*)userData;
+
+	// find the layer of the texture array that was registered with this id
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		if (graphics->m_textureIds[i] == textureId)
+		{
+			// remember the size so a hot reload creates the texture with the same mips
+			graphics->m_textureSizes[i] = graphics->m_TextureStreamer->GetMipSize(textureId, topMip);
+
+			// read the mips up to the new top mip in the background, the texture is swapped in at a frame boundary
+			return graphics->m_TextureLoader->Request(
+				i,
+				graphics->m_textures.Get(graphics->m_textureArray)->GetFilename(i),
+				graphics->m_textures.Get(graphics->m_textureArray)->IsLoose(i),
+				graphics->m_textureSizes[i],
+				graphics->m_textureGenerations[i]
+			);
+		}
+	}
+
+	return false;
+}
+
+void GraphicsClass::ApplyStreamedTextures()
+{
+	TextureArrayClass* textures;
+	ID3D11ShaderResourceView* texture;
+	ID3D11ShaderResourceView* old;
+	unsigned int generation;
+	int maxSize;
+
+	textures = m_textures.Get(m_textureArray);
+
+	// put the textures the loader finished into use, a load of a file that was hot reloaded since is dropped
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		if (!m_TextureLoader->TakeFinished(i, texture, maxSize, generation))
+		{
+			continue;
+		}
+
+		if (generation != m_textureGenerations[i])
+		{
+			old = texture;
+		}
+		else if (texture)
+		{
+			old = textures->SwapTexture(i, texture, textures->IsLoose(i));
+			m_textureLoadedSizes[i] = maxSize;
+		}
+		else
+		{
+			// the latest load failed, the streamer goes back to the mips in the array and asks for them again
+			old = nullptr;
+			if (maxSize == m_textureSizes[i])
+			{
+				m_TextureStreamer->FailLoad(m_textureIds[i], m_textureLoadedSizes[i]);
+				m_textureSizes[i] = m_textureLoadedSizes[i];
+			}
+		}
+		if (old)
+		{
+			old->Release();
+		}
+	}
+
+	return;
+}
+
+bool GraphicsClass::InitializeHotReload(char* modelFilename, WCHAR** textureFilenames)
+{
+	char filename[128];
+	size_t length;
+
+	// create the file system object
+	m_FileSystem = MemoryClass::New<DiskFileSystemClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_FileSystem)
+	{
+		return false;
+	}
+
+	// create the asset watcher object
+	m_AssetWatcher = MemoryClass::New<AssetWatcherClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_AssetWatcher)
+	{
+		return false;
+	}
+
+	if (!m_AssetWatcher->Initialize(m_FileSystem, ASSET_WATCHER_POLL_TIME))
+	{
+		return false;
+	}
+
+	// register the textures, the mesh and the shaders of the model
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		wcstombs_s(&length, filename, sizeof(filename), textureFilenames[i], _TRUNCATE);
+		m_textureWatchIds[i] = m_AssetWatcher->Register(filename, ImportTexture, SwapTexture, ReleaseTexture, this);
+		if (m_textureWatchIds[i] < 0)
+		{
+			return false;
+		}
+	}
+
+	if (m_AssetWatcher->Register(modelFilename, ImportMesh, SwapMesh, ReleaseMesh, this) < 0 ||
+		m_AssetWatcher->Register("./shader/bumpmap.vs.hlsl", ImportShader, SwapShader, ReleaseShader, this) < 0 ||
+		m_AssetWatcher->Register("./shader/specmap.ps.hlsl", ImportShader, SwapShader, ReleaseShader, this) < 0)
+	{
+		return false;
+	}
+
+	// start watching
+	return m_AssetWatcher->Start();
+}
+
+void* GraphicsClass::ImportTexture(void* userData, int watchId, const AssetDataType& asset)
+{
+	GraphicsClass* graphics = (GraphicsClass*)userData;
+	TextureReloadType* reload;
+	int width, height, mipCount, bitsPerPixel, blockBytes;
+
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		if (graphics->m_textureWatchIds[i] == watchId)
+		{
+			if (!TextureStreamerClass::ReadDDSInfo(asset.data, asset.size, width, height, mipCount, bitsPerPixel, blockBytes))
+			{
+				return nullptr;
+			}
+
+			reload = MemoryClass::New<TextureReloadType>(MEMORY_TAG_TEXTURE);
+			if (!reload)
+			{
+				return nullptr;
+			}
+
+			// create the texture with all of its mips, the device is free threaded. the streamed sizes belong
+			//  to the render thread, the swap brings the texture to the size the streamer wants
+			reload->maxSize = std::max(width, height);
+			if (!TextureArrayClass::CreateTexture(graphics->m_Direct3D->GetDevice(), asset, 0, &reload->texture))
+			{
+				MemoryClass::Delete(reload);
+				return nullptr;
+			}
+
+			return reload;
+		}
+	}
+
+	return nullptr;
+}
+
+void GraphicsClass::SwapTexture(void* userData, int watchId, void* resource)
+{
+	GraphicsClass* graphics = (GraphicsClass*)userData;
+	TextureReloadType* reload = (TextureReloadType*)resource;
+	ID3D11ShaderResourceView* old;
+
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		if (graphics->m_textureWatchIds[i] == watchId)
+		{
+			// replace the texture in the array of the models, the streamed loads of the old file are out of date
+			old = graphics->m_textures.Get(graphics->m_textureArray)->SwapTexture(i, reload->texture, true);
+			reload->texture = old;
+			graphics->m_textureLoadedSizes[i] = reload->maxSize;
+			graphics->m_textureGenerations[i]++;
+
+			// stream the texture down to the mips the streamer wants
+			if (reload->maxSize != graphics->m_textureSizes[i])
+			{
+				graphics->m_TextureLoader->Request(
+					i,
+					graphics->m_textures.Get(graphics->m_textureArray)->GetFilename(i),
+					true,
+					graphics->m_textureSizes[i],
+					graphics->m_textureGenerations[i]
+				);
+			}
+			break;
+		}
+	}
+
+	// release the texture that was replaced
+	ReleaseTexture(userData, watchId, reload);
+
+	return;
+}
+
+void GraphicsClass::ReleaseTexture(void* userData, int watchId, void* resource)
+{
+	TextureReloadType* reload = (TextureReloadType*)resource;
+
+	if (reload->texture)
+	{
+		reload->texture->Release();
+	}
+	MemoryClass::Delete(reload);
+
+	return;
+}
+
+void* GraphicsClass::ImportMesh(void* userData, int watchId, const AssetDataType& asset)
+{
+	GraphicsClass* graphics = (GraphicsClass*)userData;
+	ModelClass* mesh;
+
+	// a model object that only holds the new vertex and index buffer
+	mesh = MemoryClass::New<ModelClass>(MEMORY_TAG_MESH);
+	if (!mesh)
+	{
+		return nullptr;
+	}
+
+	if (!mesh->InitializeMesh(graphics->m_Direct3D->GetDevice(), graphics->m_AssetCache, asset))
+	{
+		ReleaseMesh(userData, watchId, mesh);
+		return nullptr;
+	}
+
+	return mesh;
+}
+
+void GraphicsClass::SwapMesh(void* userData, int watchId, void* resource)
+{
+	GraphicsClass* graphics = (GraphicsClass*)userData;
+	ModelClass* mesh = (ModelClass*)resource;
+
+	// move the new buffers into the pooled mesh, the old ones go with the imported one. the
+	//  handle of the models stays the same
+	graphics->m_meshes.Get(graphics->m_mesh)->SwapMesh(mesh);
+	ReleaseMesh(userData, watchId, mesh);
+
+	return;
+}
+
+void GraphicsClass::ReleaseMesh(void* userData, int watchId, void* resource)
+{
+	ModelClass* mesh = (ModelClass*)resource;
+
+	mesh->Shutdown();
+	MemoryClass::Delete(mesh);
+
+	return;
+}
+
+void* GraphicsClass::ImportShader(void* userData, int watchId, const AssetDataType& asset)
+{
+	GraphicsClass* graphics = (GraphicsClass*)userData;
+	BumpMapShaderClass* shader;
+	PackFileClass loose;
+
+	// compile both shader files again, a pack that is not open reads the loose files
+	shader = MemoryClass::New<BumpMapShaderClass>(MEMORY_TAG_GRAPHICS);
+	if (!shader)
+	{
+		return nullptr;
+	}
+
+	if (!shader->Initialize(graphics->m_Direct3D->GetDevice(), NULL, &loose))
+	{
+		ReleaseShader(userData, watchId, shader);
+		return nullptr;
+	}
+
+	return shader;
+}
+
+void GraphicsClass::SwapShader(void* userData, int watchId, void* resource)
+{
+	GraphicsClass* graphics = (GraphicsClass*)userData;
+	BumpMapShaderClass* shader = (BumpMapShaderClass*)resource;
+
+	// exchange the new shader with the one behind the handle and release the old one
+	std::swap(*graphics->m_shaders.Get(graphics->m_bumpMapShader), *shader);
+	ReleaseShader(userData, watchId, shader);
+
+	return;
+}
+
+void GraphicsClass::ReleaseShader(void* userData, int watchId, void* resource)
+{
+	BumpMapShaderClass* shader = (BumpMapShaderClass*)resource;
+
+	shader->Shutdown();
+	MemoryClass::Delete(shader);
+
+	return;
 }
\ No newline at end of file
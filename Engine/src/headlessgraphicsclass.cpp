@@ -0,0 +1,404 @@
+#include "headlessgraphicsclass.h"
+
+HeadlessGraphicsClass::HeadlessGraphicsClass()
+	: m_Device(nullptr), m_Camera(nullptr), m_Light(nullptr), m_ModelList(nullptr), m_Visibility(nullptr),
+	  m_vertexBuffer(-1), m_indexBuffer(-1), m_indexCount(0),
+	  m_matrixBuffer(-1), m_lightBuffer(-1), m_cameraBuffer(-1),
+	  m_vertexShader(-1), m_pixelShader(-1), m_visibleModelsCounter(-1), m_planeTestsCounter(-1),
+	  m_cullingSkippedCounter(-1)
+{
+	for (int i = 0; i < HEADLESS_TEXTURE_COUNT; i++)
+	{
+		m_textures[i] = -1;
+	}
+}
+
+bool HeadlessGraphicsClass::Initialize(RenderDeviceClass* device, PackFileClass* pack, int screenWidth, int screenHeight, const SceneSettingsType& scene)
+{
+	bool result;
+
+	m_Device = device;
+
+	// the same matrices the d3d object sets up for the window
+	m_worldMatrix = XMMatrixIdentity();
+	m_projectionMatrix = XMMatrixPerspectiveFovLH(
+		3.141592654f / 4.f,
+		(float)screenWidth / (float)screenHeight,
+		HEADLESS_SCREEN_NEAR,
+		HEADLESS_SCREEN_DEPTH
+	);
+
+	// create the camera object and set its initial position
+	m_Camera = MemoryClass::New<CameraClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_Camera)
+	{
+		return false;
+	}
+	m_Camera->SetPosition(0.f, 0.f, -3.f);
+
+	// create the light object and initialize it like the graphics object does
+	m_Light = MemoryClass::New<LightClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_Light)
+	{
+		return false;
+	}
+	m_Light->SetAmbientColor(0.15f, 0.15f, 0.15f, 1.f);
+	m_Light->SetDiffuseColor(1.f, 1.f, 1.f, 1.f);
+	m_Light->SetDirection(0.f, 0.f, 1.f);
+	m_Light->SetSpecularColor(1.f, 1.f, 1.f, 1.f);
+	m_Light->SetSpecularPower(32.f);
+
+	// create the model list object
+	m_ModelList = MemoryClass::New<ModelListClass>(MEMORY_TAG_SCENE);
+	if (!m_ModelList)
+	{
+		return false;
+	}
+
+	result = m_ModelList->Initialize(scene);
+	if (!result)
+	{
+		return false;
+	}
+
+	m_visibleModelsCounter = RenderStatsClass::Register("visible_models");
+	m_planeTestsCounter = RenderStatsClass::Register("plane_tests");
+	m_cullingSkippedCounter = RenderStatsClass::Register("culling_skipped");
+
+	// create the visibility object
+	m_Visibility = MemoryClass::New<VisibilityClass>(MEMORY_TAG_GRAPHICS);
+	if (!m_Visibility)
+	{
+		return false;
+	}
+
+	result = m_Visibility->Initialize(m_ModelList);
+	if (!result)
+	{
+		return false;
+	}
+
+	// upload the sphere, its textures and the bumpmap shaders
+	result = LoadModel(pack);
+	if (!result)
+	{
+		return false;
+	}
+
+	result = LoadTextures(pack);
+	if (!result)
+	{
+		return false;
+	}
+
+	result = LoadShaders(pack);
+	if (!result)
+	{
+		return false;
+	}
+
+	// create the dynamic constant buffers
+	m_matrixBuffer = m_Device->CreateBuffer(RENDER_RESOURCE_CONSTANT_BUFFER, nullptr, sizeof(MatrixBufferType));
+	m_lightBuffer = m_Device->CreateBuffer(RENDER_RESOURCE_CONSTANT_BUFFER, nullptr, sizeof(LightBufferType));
+	m_cameraBuffer = m_Device->CreateBuffer(RENDER_RESOURCE_CONSTANT_BUFFER, nullptr, sizeof(CameraBufferType));
+	if (m_matrixBuffer < 0 || m_lightBuffer < 0 || m_cameraBuffer < 0)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void HeadlessGraphicsClass::Shutdown()
+{
+	// release the device resources
+	if (m_Device)
+	{
+		m_Device->Release(m_cameraBuffer);
+		m_Device->Release(m_lightBuffer);
+		m_Device->Release(m_matrixBuffer);
+		m_Device->Release(m_pixelShader);
+		m_Device->Release(m_vertexShader);
+		for (int i = 0; i < HEADLESS_TEXTURE_COUNT; i++)
+		{
+			m_Device->Release(m_textures[i]);
+			m_textures[i] = -1;
+		}
+		m_Device->Release(m_indexBuffer);
+		m_Device->Release(m_vertexBuffer);
+		m_Device = nullptr;
+	}
+
+	m_cameraBuffer = m_lightBuffer = m_matrixBuffer = -1;
+	m_pixelShader = m_vertexShader = -1;
+	m_indexBuffer = m_vertexBuffer = -1;
+
+	// release the visibility object
+	if (m_Visibility)
+	{
+		m_Visibility->Shutdown();
+		MemoryClass::Delete(m_Visibility);
+		m_Visibility = nullptr;
+	}
+
+	// release the model list object
+	if (m_ModelList)
+	{
+		m_ModelList->Shutdown();
+		MemoryClass::Delete(m_ModelList);
+		m_ModelList = nullptr;
+	}
+
+	// release the light object
+	if (m_Light)
+	{
+		MemoryClass::Delete(m_Light);
+		m_Light = nullptr;
+	}
+
+	// release the camera object
+	if (m_Camera)
+	{
+		MemoryClass::Delete(m_Camera);
+		m_Camera = nullptr;
+	}
+
+	return;
+}
+
+bool HeadlessGraphicsClass::Frame(XMFLOAT3 position, XMFLOAT3 direction, XMFLOAT3 up)
+{
+	// place the camera like the graphics object does
+	m_Camera->SetDirection(direction.x, direction.y, direction.z);
+	m_Camera->SetUp(up.x, up.y, up.z);
+	m_Camera->SetPosition(position.x, position.y, position.z);
+
+	return true;
+}
+
+bool HeadlessGraphicsClass::Render()
+{
+	ProfileZoneClass zone("HeadlessGraphicsClass::Render");
+	XMMATRIX viewMatrix;
+	MatrixBufferType matrixBuffer;
+	LightBufferType lightBuffer;
+	CameraBufferType cameraBuffer;
+	RenderItemType* items;
+	int renderCount;
+	unsigned long long planeTests;
+
+	// clear the buffers to begin the scene
+	m_Device->Clear(0.f, 0.f, 0.f, 1.f);
+
+	// generate the view matrix from the camera
+	m_Camera->Render();
+	m_Camera->GetViewMatrix(viewMatrix);
+
+	// find the models that can be seen by the camera, this is skipped if neither the camera nor the scene changed
+	planeTests = m_Visibility->GetPlaneTestCount();
+	m_Visibility->Cull(HEADLESS_SCREEN_DEPTH, m_projectionMatrix, viewMatrix);
+
+	renderCount = m_Visibility->GetVisibleCount();
+	RenderStatsClass::Add(m_visibleModelsCounter, renderCount);
+	RenderStatsClass::Add(m_planeTestsCounter, m_Visibility->GetPlaneTestCount() - planeTests);
+	RenderStatsClass::Add(m_cullingSkippedCounter, m_Visibility->IsReused() ? 1 : 0);
+
+	// copy what is drawn of the visible models out of the entities
+	items = FrameArenaClass::Allocate<RenderItemType>(renderCount);
+	if (!items)
+	{
+		return false;
+	}
+	m_ModelList->Extract(m_Visibility->GetVisibleModels(), renderCount, items);
+
+	// submit the visible models the way the model and the bumpmap shader objects do
+	{
+		ProfileZoneClass submissionZone("submission");
+
+		for (int index = 0; index < renderCount; index++)
+		{
+			const RenderItemType& item = items[index];
+
+			// put the model vertex and index buffers on the pipeline
+			m_Device->SetVertexBuffer(m_vertexBuffer, sizeof(VertexType));
+			m_Device->SetIndexBuffer(m_indexBuffer);
+
+			// pack the transposed matrices
+			matrixBuffer.world = XMMatrixTranspose(XMLoadFloat4x4(&item.world));
+			matrixBuffer.view = XMMatrixTranspose(viewMatrix);
+			matrixBuffer.projection = XMMatrixTranspose(m_projectionMatrix);
+			if (!m_Device->UpdateBuffer(m_matrixBuffer, &matrixBuffer, sizeof(matrixBuffer)))
+			{
+				return false;
+			}
+			m_Device->SetConstantBuffer(RENDER_RESOURCE_VERTEX_SHADER, 0, m_matrixBuffer);
+
+			m_Device->SetTextures(0, m_textures, HEADLESS_TEXTURE_COUNT);
+
+			// pack the camera position
+			cameraBuffer.cameraPosition = m_Camera->GetPosition();
+			cameraBuffer.padding = 0.f;
+			if (!m_Device->UpdateBuffer(m_cameraBuffer, &cameraBuffer, sizeof(cameraBuffer)))
+			{
+				return false;
+			}
+			m_Device->SetConstantBuffer(RENDER_RESOURCE_VERTEX_SHADER, 1, m_cameraBuffer);
+
+			// pack the light with the color of the model
+			lightBuffer.ambientColor = m_Light->GetAmbientColor();
+			lightBuffer.diffuseColor = XMLoadFloat4(&item.color);
+			lightBuffer.lightDirection = m_Light->GetDirection();
+			lightBuffer.specularColor = m_Light->GetSpecularColor();
+			lightBuffer.specularPower = m_Light->GetSpecularPower();
+			if (!m_Device->UpdateBuffer(m_lightBuffer, &lightBuffer, sizeof(lightBuffer)))
+			{
+				return false;
+			}
+			m_Device->SetConstantBuffer(RENDER_RESOURCE_PIXEL_SHADER, 0, m_lightBuffer);
+
+			// set the shaders and draw
+			m_Device->SetShader(m_vertexShader);
+			m_Device->SetShader(m_pixelShader);
+			m_Device->DrawIndexed(m_indexCount);
+		}
+	}
+
+	// present, release the temporaries of the frame and fold the render counters of this frame
+	m_Device->Present();
+	FrameArenaClass::EndFrame();
+	RenderStatsClass::EndFrame();
+
+	return true;
+}
+
+void HeadlessGraphicsClass::SetCoherentCulling(bool enabled)
+{
+	// without it every model is tested against the planes in order, as the graphics object did before
+	m_Visibility->SetCoherent(enabled);
+
+	return;
+}
+
+void HeadlessGraphicsClass::SetCullCaching(bool enabled)
+{
+	// without it the models are culled every frame, even if nothing changed
+	m_Visibility->SetCaching(enabled);
+
+	return;
+}
+
+int HeadlessGraphicsClass::GetVisibleCount()
+{
+	return m_Visibility->GetVisibleCount();
+}
+
+ModelListClass* HeadlessGraphicsClass::GetModelList()
+{
+	return m_ModelList;
+}
+
+bool HeadlessGraphicsClass::LoadModel(PackFileClass* pack)
+{
+	AssetDataType asset;
+	std::vector<VertexType> vertices;
+	std::vector<unsigned long> indices;
+	int vertexCount;
+	char input;
+
+	if (!pack->Read(HEADLESS_MODEL_FILENAME, asset))
+	{
+		return false;
+	}
+
+	// parse the text in place, in the format the model object reads
+	MemoryStreamBuffer buffer(asset.data, asset.size);
+	std::istream fin(&buffer);
+
+	// read up to the vertex count
+	do
+	{
+		fin.get(input);
+	} while (fin && input != ':');
+
+	fin >> vertexCount;
+	if (!fin || vertexCount <= 0)
+	{
+		return false;
+	}
+
+	// read up to the beginning of the data
+	do
+	{
+		fin.get(input);
+	} while (fin && input != ':');
+
+	// read in the vertex data, the tangent frame only matters to a real pixel shader
+	vertices.resize(vertexCount);
+	indices.resize(vertexCount);
+	for (int i = 0; i < vertexCount; i++)
+	{
+		fin >> vertices[i].position.x >> vertices[i].position.y >> vertices[i].position.z;
+		fin >> vertices[i].texture.x >> vertices[i].texture.y;
+		fin >> vertices[i].normal.x >> vertices[i].normal.y >> vertices[i].normal.z;
+		vertices[i].tangent = XMFLOAT3(0.f, 0.f, 0.f);
+		vertices[i].binormal = XMFLOAT3(0.f, 0.f, 0.f);
+		indices[i] = (unsigned long)i;
+	}
+	if (!fin)
+	{
+		return false;
+	}
+
+	// upload the static buffers
+	m_vertexBuffer = m_Device->CreateBuffer(RENDER_RESOURCE_VERTEX_BUFFER, vertices.data(), sizeof(VertexType) * vertices.size());
+	m_indexBuffer = m_Device->CreateBuffer(RENDER_RESOURCE_INDEX_BUFFER, indices.data(), sizeof(unsigned long) * indices.size());
+	m_indexCount = vertexCount;
+
+	return m_vertexBuffer >= 0 && m_indexBuffer >= 0;
+}
+
+bool HeadlessGraphicsClass::LoadTextures(PackFileClass* pack)
+{
+	AssetDataType asset;
+	unsigned int height, width;
+
+	for (int i = 0; i < HEADLESS_TEXTURE_COUNT; i++)
+	{
+		if (!pack->Read(HEADLESS_TEXTURE_FILENAMES[i], asset) || asset.size < 20)
+		{
+			return false;
+		}
+
+		// the size follows the magic, the size and the flags of the dds header
+		memcpy(&height, asset.data + 12, sizeof(height));
+		memcpy(&width, asset.data + 16, sizeof(width));
+
+		m_textures[i] = m_Device->CreateTexture((int)width, (int)height, asset.data, asset.size);
+		if (m_textures[i] < 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool HeadlessGraphicsClass::LoadShaders(PackFileClass* pack)
+{
+	AssetDataType asset;
+
+	// the source stands in for the byte code, the null device only keeps a copy
+	if (!pack->Read(HEADLESS_VERTEX_SHADER_FILENAME, asset))
+	{
+		return false;
+	}
+	m_vertexShader = m_Device->CreateShader(RENDER_RESOURCE_VERTEX_SHADER, asset.data, asset.size);
+
+	if (!pack->Read(HEADLESS_PIXEL_SHADER_FILENAME, asset))
+	{
+		return false;
+	}
+	m_pixelShader = m_Device->CreateShader(RENDER_RESOURCE_PIXEL_SHADER, asset.data, asset.size);
+
+	return m_vertexShader >= 0 && m_pixelShader >= 0;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include "inputbackendclass.h"
+
+SyntheticInputClass::SyntheticInputClass()
+	: m_Queue(nullptr), m_Platform(nullptr), m_running(false), m_finished(false)
+{
+}
+
+SyntheticInputClass::~SyntheticInputClass()
+{
+	Stop();
+}
+
+void SyntheticInputClass::PostEvent(const InputEventType& event)
+{
+	m_events.push_back(event);
+
+	return;
+}
+
+bool SyntheticInputClass::Start(InputQueueClass* queue, PlatformClass* platform)
+{
+	if (!queue || !platform || m_running)
+	{
+		return false;
+	}
+
+	m_Queue = queue;
+	m_Platform = platform;
+	m_finished = false;
+	m_running = true;
+	m_thread = std::thread(&SyntheticInputClass::ReadMain, this);
+
+	return true;
+}
+
+void SyntheticInputClass::Stop()
+{
+	m_running = false;
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
+
+	return;
+}
+
+bool SyntheticInputClass::IsFinished()
+{
+	return m_finished;
+}
+
+void SyntheticInputClass::ReadMain()
+{
+	double wait;
+
+	for (size_t i = 0; i < m_events.size() && m_running; i++)
+	{
+		// hand out every event once the clock reached it, like a device reporting at that moment
+		while ((wait = m_events[i].time - m_Platform->GetTime()) > 0.0 && m_running)
+		{
+			m_Platform->SleepFor(wait > 1.0 ? wait - 1.0 : 0.0);
+		}
+
+		m_Queue->Push(m_events[i]);
+	}
+
+	m_finished = true;
+
+	return;
+}
\ No newline at end of file
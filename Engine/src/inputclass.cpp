@@ -1,12 +1,10 @@
 #include "inputclass.h"
 
 InputClass::InputClass()
-	: m_directInput(nullptr), m_keyboard(nullptr), m_mouse(nullptr)
-{
-}
-
-InputClass::InputClass(const InputClass& other)
+	: m_directInput(nullptr), m_keyboard(nullptr), m_mouse(nullptr), m_screenWidth(0), m_screenHeight(0),
+	  m_Queue(nullptr), m_Platform(nullptr), m_running(false)
 {
+	m_events[0] = m_events[1] = m_events[2] = NULL;
 }
 
 InputClass::~InputClass()
@@ -16,14 +14,28 @@ InputClass::~InputClass()
 bool InputClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth, int screenHeight)
 {
 	HRESULT result;
+	DIPROPDWORD bufferSize;
 
 	// store the screen size which will be used for positioning the mosue cursor
 	m_screenWidth = screenWidth;
 	m_screenHeight = screenHeight;
 
-	// initialize the location of the mouse on the screen
-	m_mouseX = 0;
-	m_mouseY = 0;
+	// the devices signal these when they have new events, the last one wakes the thread to stop it
+	for (int i = 0; i < 3; i++)
+	{
+		m_events[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (!m_events[i])
+		{
+			return false;
+		}
+	}
+
+	// both devices keep their events in a buffer until they are read
+	bufferSize.diph.dwSize = sizeof(DIPROPDWORD);
+	bufferSize.diph.dwHeaderSize = sizeof(DIPROPHEADER);
+	bufferSize.diph.dwObj = 0;
+	bufferSize.diph.dwHow = DIPH_DEVICE;
+	bufferSize.dwData = INPUT_DEVICE_BUFFER_SIZE;
 
 	// initialize the main direct input interface
 	result = DirectInput8Create(
@@ -68,6 +80,19 @@ bool InputClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth, int
 		return false;
 	}
 
+	// buffer the key presses and signal when there are new ones
+	result = m_keyboard->SetProperty(DIPROP_BUFFERSIZE, &bufferSize.diph);
+	if (FAILED(result))
+	{
+		return false;
+	}
+
+	result = m_keyboard->SetEventNotification(m_events[0]);
+	if (FAILED(result))
+	{
+		return false;
+	}
+
 	// now ACQUIRE the keyboard
 	result = m_keyboard->Acquire();
 	if (FAILED(result))
@@ -105,6 +130,19 @@ bool InputClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth, int
 		return false;
 	}
 
+	// buffer the mouse movement and signal when there is new
+	result = m_mouse->SetProperty(DIPROP_BUFFERSIZE, &bufferSize.diph);
+	if (FAILED(result))
+	{
+		return false;
+	}
+
+	result = m_mouse->SetEventNotification(m_events[1]);
+	if (FAILED(result))
+	{
+		return false;
+	}
+
 	// ACQUIRE the mouse
 	result = m_mouse->Acquire();
 	if (FAILED(result))
@@ -117,6 +155,9 @@ bool InputClass::Initialize(HINSTANCE hinstance, HWND hwnd, int screenWidth, int
 
 void InputClass::Shutdown()
 {
+	// stop reading the devices
+	Stop();
+
 	// release the mouse
 	if (m_mouse)
 	{
@@ -139,116 +180,174 @@ void InputClass::Shutdown()
 		m_directInput->Release();
 		m_directInput = nullptr;
 	}
+
+	// close the events the devices signaled
+	for (int i = 0; i < 3; i++)
+	{
+		if (m_events[i])
+		{
+			CloseHandle(m_events[i]);
+			m_events[i] = NULL;
+		}
+	}
+
+	return;
 }
 
-bool InputClass::Frame()
+bool InputClass::Start(InputQueueClass* queue, PlatformClass* platform)
 {
-	bool result;
-
-	// read the current state of the keyboard
-	result = ReadKeyboard();
-	if (!result)
+	if (!queue || !platform || m_running)
 	{
 		return false;
 	}
 
-	// read the current state of the mouse
-	result = ReadMouse();
-	if (!result)
+	// read the devices on a thread of its own from now on
+	m_Queue = queue;
+	m_Platform = platform;
+	m_running = true;
+	m_thread = std::thread(&InputClass::ReadMain, this);
+
+	return true;
+}
+
+void InputClass::Stop()
+{
+	// wake the thread so it sees that it has to stop
+	m_running = false;
+	if (m_events[2])
 	{
-		return false;
+		SetEvent(m_events[2]);
 	}
 
-	// process the changes in the mouse and keyboard
-	ProcessInput();
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
 
-	return true;
+	return;
 }
 
-bool InputClass::ReadKeyboard()
+void InputClass::ReadMain()
 {
+	double time;
+	DWORD ticks;
+
+	while (m_running)
+	{
+		// sleep until a device has something new, a lost device is tried again now and then
+		WaitForMultipleObjects(3, m_events, FALSE, 100);
+		if (!m_running)
+		{
+			break;
+		}
+
+		// directinput stamps the events with the tick count, take both clocks together so the
+		//  stamps can be moved onto the clock of the platform
+		time = m_Platform->GetTime();
+		ticks = GetTickCount();
+		ReadKeyboard(time, ticks);
+		ReadMouse(time, ticks);
+	}
+
+	return;
+}
+
+bool InputClass::ReadKeyboard(double time, DWORD ticks)
+{
+	DIDEVICEOBJECTDATA data[INPUT_DEVICE_BUFFER_SIZE];
+	InputEventType event;
 	HRESULT result;
+	DWORD count;
 
-	// read the keyboard device
-	result = m_keyboard->GetDeviceState(
-		sizeof(m_keyboardState),		// size of the buffer of the data, in bytes
-		(LPVOID)&m_keyboardState		// data ; addr of struct that receives the state
-		);
+	// take all the key presses the keyboard buffered
+	count = INPUT_DEVICE_BUFFER_SIZE;
+	result = m_keyboard->GetDeviceData(sizeof(DIDEVICEOBJECTDATA), data, &count, 0);
 	if (FAILED(result))
 	{
 		// if the keyboard lost focus or was not acquired then try to get control back
 		if ((result == DIERR_INPUTLOST) || (result == DIERR_NOTACQUIRED))
 		{
 			m_keyboard->Acquire();
+			return true;
 		}
-		else
-		{
-			return false;
-		}
+
+		return false;
+	}
+
+	event.device = INPUT_DEVICE_KEYBOARD;
+	event.x = event.y = 0;
+	for (DWORD i = 0; i < count; i++)
+	{
+		// the offset is the scan code of the key
+		event.time = GetEventTime(time, ticks, data[i].dwTimeStamp);
+		event.key = (int)data[i].dwOfs;
+		event.down = (data[i].dwData & 0x80) != 0;
+		m_Queue->Push(event);
 	}
 
 	return true;
 }
 
-bool InputClass::ReadMouse()
+bool InputClass::ReadMouse(double time, DWORD ticks)
 {
+	DIDEVICEOBJECTDATA data[INPUT_DEVICE_BUFFER_SIZE];
+	InputEventType event;
 	HRESULT result;
+	DWORD count;
 
-	// read the mouse device
-	result = m_mouse->GetDeviceState(
-		sizeof(m_mouseState),			// size of the buffer of the data ; in bytes
-		(LPVOID)&m_mouseState			// data ; addr of struct that receives the state
-		);
+	// take all the movement the mouse buffered
+	count = INPUT_DEVICE_BUFFER_SIZE;
+	result = m_mouse->GetDeviceData(sizeof(DIDEVICEOBJECTDATA), data, &count, 0);
 	if (FAILED(result))
 	{
 		// if the mouse lost focus or was not acquired then try to get control back
 		if ((result == DIERR_INPUTLOST) || (result == DIERR_NOTACQUIRED))
 		{
 			m_mouse->Acquire();
+			return true;
+		}
+
+		return false;
+	}
+
+	event.device = INPUT_DEVICE_MOUSE;
+	event.key = 0;
+	event.down = false;
+	for (DWORD i = 0; i < count; i++)
+	{
+		// every axis is an event of its own, the buttons are not used
+		if (data[i].dwOfs == DIMOFS_X)
+		{
+			event.x = (int)data[i].dwData;
+			event.y = 0;
+		}
+		else if (data[i].dwOfs == DIMOFS_Y)
+		{
+			event.x = 0;
+			event.y = (int)data[i].dwData;
 		}
 		else
 		{
-			return false;
+			continue;
 		}
+		event.time = GetEventTime(time, ticks, data[i].dwTimeStamp);
+		m_Queue->Push(event);
 	}
 
 	return true;
 }
 
-void InputClass::ProcessInput()
+double InputClass::GetEventTime(double time, DWORD ticks, DWORD timeStamp)
 {
-	// update the location of the mouse cursor based on the change during the frame
-	m_mouseX = m_mouseState.lX;
-	m_mouseY = m_mouseState.lY;
-
-	// update the key pressed on the keyboard during the frame
-	memcpy_s(m_key, sizeof(m_key), m_keyboardState, sizeof(m_keyboardState));
-
-	return;
-}
+	DWORD age;
 
-bool InputClass::IsEscapePressed()
-{
-	// do a bitwise AND on the keyboard state to check if the escape key is pressed
-	if (m_keyboardState[DIK_ESCAPE] & 0x80)
+	// the tick count wraps after 49 days, the unsigned difference is right across it. a stamp
+	//  taken after the tick count was read comes out huge and happened just now
+	age = ticks - timeStamp;
+	if (age > INPUT_MAX_EVENT_AGE)
 	{
-		return true;
+		age = 0;
 	}
 
-	return false;
-}
-
-void InputClass::GetMouseLocation(int& mouseX, int& mouseY)
-{
-	mouseX = m_mouseX;
-	mouseY = m_mouseY;
-
-	return;
-}
-
-void InputClass::GetKeyPressed(unsigned char** key)
-{
-	*key = m_key;
-
-	return;
+	return time - (double)age;
 }
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "inputqueueclass.h"
+
+InputQueueClass::InputQueueClass()
+	: m_droppedCount(0), m_hasNextEvent(false), m_consumedTime(0.0), m_mouseX(0), m_mouseY(0), m_eventAge(0.0)
+{
+	memset(&m_nextEvent, 0, sizeof(m_nextEvent));
+	memset(m_keys, 0, sizeof(m_keys));
+	memset(m_keyDownTimes, 0, sizeof(m_keyDownTimes));
+	memset(m_pressedKeys, 0, sizeof(m_pressedKeys));
+	memset(m_keyTimes, 0, sizeof(m_keyTimes));
+}
+
+void InputQueueClass::Initialize(double time)
+{
+	// nothing is held down when the simulation starts
+	m_consumedTime = time;
+	m_hasNextEvent = false;
+	memset(m_keys, 0, sizeof(m_keys));
+	memset(m_pressedKeys, 0, sizeof(m_pressedKeys));
+	memset(m_keyTimes, 0, sizeof(m_keyTimes));
+	m_mouseX = m_mouseY = 0;
+	m_eventAge = 0.0;
+
+	return;
+}
+
+bool InputQueueClass::Push(const InputEventType& event)
+{
+	// the simulation fell far behind, losing the event beats blocking the device thread
+	if (!m_events.Push(event))
+	{
+		m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	return true;
+}
+
+int InputQueueClass::Consume(double time)
+{
+	ProfileZoneClass zone("InputQueueClass::Consume");
+	InputEventType& event = m_nextEvent;
+	double from, at, age;
+	int count;
+
+	from = m_consumedTime;
+	memset(m_pressedKeys, 0, sizeof(m_pressedKeys));
+	memset(m_keyTimes, 0, sizeof(m_keyTimes));
+	m_mouseX = m_mouseY = 0;
+
+	// apply the events in order up to the end of the step, the first later one waits
+	count = 0;
+	age = 0.0;
+	while (m_hasNextEvent || m_events.Pop(m_nextEvent))
+	{
+		if (event.time > time)
+		{
+			m_hasNextEvent = true;
+			break;
+		}
+		m_hasNextEvent = false;
+
+		// an event that came in late counts from the start of the step
+		at = std::max(event.time, from);
+		age += time - event.time;
+		count++;
+
+		if (event.device == INPUT_DEVICE_MOUSE)
+		{
+			m_mouseX += event.x;
+			m_mouseY += event.y;
+		}
+		else if (event.key >= 0 && event.key < INPUT_KEY_COUNT)
+		{
+			if (event.down && !m_keys[event.key])
+			{
+				m_keys[event.key] = true;
+				m_keyDownTimes[event.key] = at;
+				m_pressedKeys[event.key] = true;
+			}
+			else if (!event.down && m_keys[event.key])
+			{
+				m_keys[event.key] = false;
+				m_keyTimes[event.key] += (float)(at - std::max(m_keyDownTimes[event.key], from));
+			}
+		}
+	}
+
+	// the keys still down were held until the end of the step
+	for (int i = 0; i < INPUT_KEY_COUNT; i++)
+	{
+		if (m_keys[i])
+		{
+			m_keyTimes[i] += (float)(time - std::max(m_keyDownTimes[i], from));
+		}
+	}
+
+	m_consumedTime = time;
+	m_eventAge = count > 0 ? age / count : 0.0;
+
+	return count;
+}
+
+bool InputQueueClass::IsKeyDown(int key)
+{
+	return key >= 0 && key < INPUT_KEY_COUNT && m_keys[key];
+}
+
+bool InputQueueClass::WasKeyPressed(int key)
+{
+	return key >= 0 && key < INPUT_KEY_COUNT && m_pressedKeys[key];
+}
+
+const float* InputQueueClass::GetKeyTimes()
+{
+	return m_keyTimes;
+}
+
+void InputQueueClass::GetMouseMovement(int& mouseX, int& mouseY)
+{
+	mouseX = m_mouseX;
+	mouseY = m_mouseY;
+
+	return;
+}
+
+double InputQueueClass::GetEventAge()
+{
+	return m_eventAge;
+}
+
+unsigned long long InputQueueClass::GetDroppedCount()
+{
+	return m_droppedCount.load(std::memory_order_relaxed);
+}
\ No newline at end of file
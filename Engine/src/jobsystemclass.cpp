@@ -0,0 +1,410 @@
+#include "jobsystemclass.h"
+
+JobSystemClass::JobDequeType* JobSystemClass::s_deques = nullptr;
+std::vector<std::thread> JobSystemClass::s_workers;
+int JobSystemClass::s_threadCount = 1;
+std::atomic<bool> JobSystemClass::s_quit(false);
+std::atomic<int> JobSystemClass::s_queued(0);
+std::atomic<int> JobSystemClass::s_sleeping(0);
+std::mutex JobSystemClass::s_sleepLock;
+std::condition_variable JobSystemClass::s_wake;
+
+// the deque of the calling thread, threads outside of the system run their jobs right away
+static thread_local int t_threadIndex = -1;
+
+bool JobSystemClass::Initialize(int threadCount)
+{
+	// one thread per core by default, the calling thread is one of them
+	if (threadCount <= 0)
+	{
+		threadCount = (int)std::thread::hardware_concurrency();
+	}
+	s_threadCount = std::max(1, std::min(threadCount, JOB_MAX_THREADS));
+
+	s_deques = new JobDequeType[s_threadCount];
+	if (!s_deques)
+	{
+		s_threadCount = 1;
+		return false;
+	}
+
+	for (int i = 0; i < s_threadCount; i++)
+	{
+		s_deques[i].top.store(0, std::memory_order_relaxed);
+		s_deques[i].bottom.store(0, std::memory_order_relaxed);
+	}
+
+	s_quit = false;
+	s_queued = 0;
+	s_sleeping = 0;
+	t_threadIndex = 0;
+
+	// start the workers
+	for (int i = 1; i < s_threadCount; i++)
+	{
+		s_workers.push_back(std::thread(WorkerMain, i));
+	}
+
+	return true;
+}
+
+void JobSystemClass::Shutdown()
+{
+	// wake up the workers and wait for them to quit
+	s_quit = true;
+	s_wake.notify_all();
+
+	for (size_t i = 0; i < s_workers.size(); i++)
+	{
+		s_workers[i].join();
+	}
+	s_workers.clear();
+
+	// release the deques
+	if (s_deques)
+	{
+		delete[] s_deques;
+		s_deques = nullptr;
+	}
+
+	s_threadCount = 1;
+	t_threadIndex = -1;
+
+	return;
+}
+
+void JobSystemClass::Run(JobFunction function, void* data, int begin, int end, JobCounterType* counter, JobCounterType* dependency)
+{
+	JobType job;
+
+	// a single job over the whole range
+	job.function = function;
+	job.data = data;
+	job.begin = begin;
+	job.end = end;
+	job.grain = 0;
+	job.counter = counter;
+
+	Submit(job, dependency);
+
+	return;
+}
+
+void JobSystemClass::ParallelFor(JobFunction function, void* data, int begin, int end, int grain,
+	JobCounterType* counter, JobCounterType* dependency)
+{
+	JobType job;
+
+	if (end <= begin)
+	{
+		return;
+	}
+
+	// the range is split only when other threads are hungry, the grain is the smallest piece
+	job.function = function;
+	job.data = data;
+	job.begin = begin;
+	job.end = end;
+	job.grain = std::max(1, grain);
+	job.counter = counter;
+
+	Submit(job, dependency);
+
+	return;
+}
+
+void JobSystemClass::Wait(JobCounterType* counter)
+{
+	JobType job;
+
+	// run other jobs until the counted ones are done, this thread may end up running them itself
+	while (counter->value.load(std::memory_order_acquire) > 0)
+	{
+		if (t_threadIndex >= 0 && FindJob(t_threadIndex, job))
+		{
+			Execute(t_threadIndex, job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// the last job counts down under the lock, once it is free the counter is not touched anymore
+	std::lock_guard<std::mutex> lock(counter->lock);
+
+	return;
+}
+
+int JobSystemClass::GetThreadCount()
+{
+	return s_threadCount;
+}
+
+int JobSystemClass::GetThreadIndex()
+{
+	return t_threadIndex;
+}
+
+void JobSystemClass::Submit(const JobType& job, JobCounterType* dependency)
+{
+	if (job.counter)
+	{
+		job.counter->value.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// a job that depends on unfinished ones is queued by the last of them
+	if (dependency)
+	{
+		std::lock_guard<std::mutex> lock(dependency->lock);
+		if (dependency->value.load(std::memory_order_acquire) > 0)
+		{
+			dependency->waiting.push_back(job);
+			return;
+		}
+	}
+
+	Push(job);
+
+	return;
+}
+
+void JobSystemClass::Push(const JobType& job)
+{
+	JobDequeType* deque;
+	JobType inlineJob;
+	long long top, bottom;
+
+	// threads outside of the system have no deque and run the job right away
+	if (t_threadIndex < 0 || !s_deques)
+	{
+		inlineJob = job;
+		Execute(-1, inlineJob);
+		return;
+	}
+
+	deque = &s_deques[t_threadIndex];
+	bottom = deque->bottom.load(std::memory_order_relaxed);
+	top = deque->top.load(std::memory_order_acquire);
+
+	// a full deque runs the job right away as well
+	if (bottom - top >= JOB_DEQUE_SIZE)
+	{
+		inlineJob = job;
+		Execute(t_threadIndex, inlineJob);
+		return;
+	}
+
+	// the job has to be written before the thieves can see the new bottom
+	deque->jobs[bottom & (JOB_DEQUE_SIZE - 1)] = job;
+	deque->bottom.store(bottom + 1, std::memory_order_release);
+
+	s_queued.fetch_add(1, std::memory_order_relaxed);
+	if (s_sleeping.load(std::memory_order_relaxed) > 0)
+	{
+		s_wake.notify_one();
+	}
+
+	return;
+}
+
+bool JobSystemClass::Pop(JobDequeType& deque, JobType& job)
+{
+	long long top, bottom;
+	bool result;
+
+	// take the job at the bottom, the thieves may race for the last one
+	bottom = deque.bottom.load(std::memory_order_relaxed) - 1;
+	deque.bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	top = deque.top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		// the deque is empty
+		deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	job = deque.jobs[bottom & (JOB_DEQUE_SIZE - 1)];
+	result = true;
+	if (top == bottom)
+	{
+		// the last job goes to whoever moves the top first
+		result = deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	if (result)
+	{
+		s_queued.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	return result;
+}
+
+bool JobSystemClass::Steal(JobDequeType& deque, JobType& job)
+{
+	long long top, bottom;
+
+	// take the job at the top of another thread's deque
+	top = deque.top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	bottom = deque.bottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+	{
+		return false;
+	}
+
+	// the owner may be writing the slot again if the job was taken meanwhile, the compare
+	//  exchange fails then and the copy is thrown away
+	job = deque.jobs[top & (JOB_DEQUE_SIZE - 1)];
+	if (!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	s_queued.fetch_sub(1, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool JobSystemClass::FindJob(int index, JobType& job)
+{
+	// the own deque first, the newest job is the one most likely still in the cache
+	if (Pop(s_deques[index], job))
+	{
+		return true;
+	}
+
+	// then the oldest job of the other threads, those are the biggest pieces of work
+	for (int i = 1; i < s_threadCount; i++)
+	{
+		if (Steal(s_deques[(index + i) % s_threadCount], job))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JobSystemClass::Execute(int index, JobType& job)
+{
+	JobDequeType* deque;
+	JobType split;
+	int middle;
+
+	// work through the range a grain at a time, the upper half is handed to the thieves
+	//  whenever this thread has nothing queued that they could take
+	if (job.grain > 0 && index >= 0 && s_threadCount > 1)
+	{
+		deque = &s_deques[index];
+		while (job.end - job.begin > job.grain)
+		{
+			if (deque->bottom.load(std::memory_order_relaxed) <= deque->top.load(std::memory_order_relaxed))
+			{
+				middle = job.begin + (job.end - job.begin) / 2;
+
+				split = job;
+				split.begin = middle;
+				job.end = middle;
+				if (split.counter)
+				{
+					split.counter->value.fetch_add(1, std::memory_order_relaxed);
+				}
+				Push(split);
+			}
+			else
+			{
+				job.function(job.data, job.begin, job.begin + job.grain);
+				job.begin += job.grain;
+			}
+		}
+	}
+
+	job.function(job.data, job.begin, job.end);
+	Finish(job.counter);
+
+	return;
+}
+
+void JobSystemClass::Finish(JobCounterType* counter)
+{
+	std::vector<JobType> waiting;
+	int value;
+
+	if (!counter)
+	{
+		return;
+	}
+
+	// count down without the lock as long as other jobs are left
+	value = counter->value.load(std::memory_order_relaxed);
+	while (value > 1)
+	{
+		if (counter->value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	// this may be the last job, the jobs that depend on the counter are taken before anyone sees it at zero
+	{
+		std::lock_guard<std::mutex> lock(counter->lock);
+		if (counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			waiting.swap(counter->waiting);
+		}
+	}
+
+	for (size_t i = 0; i < waiting.size(); i++)
+	{
+		Push(waiting[i]);
+	}
+
+	return;
+}
+
+void JobSystemClass::WorkerMain(int index)
+{
+	JobType job;
+	int spins;
+
+	t_threadIndex = index;
+
+	spins = 0;
+	while (!s_quit.load(std::memory_order_relaxed))
+	{
+		if (FindJob(index, job))
+		{
+			Execute(index, job);
+			spins = 0;
+			continue;
+		}
+
+		// look a few more times before going to sleep
+		if (++spins < JOB_SPIN_COUNT)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		// sleep until a job is pushed, a wake up that was missed only costs the sleep time
+		{
+			std::unique_lock<std::mutex> lock(s_sleepLock);
+			s_sleeping.fetch_add(1);
+			s_wake.wait_for(lock, std::chrono::milliseconds(JOB_SLEEP_TIME), []()
+			{
+				return s_queued.load(std::memory_order_relaxed) > 0 || s_quit.load(std::memory_order_relaxed);
+			});
+			s_sleeping.fetch_sub(1);
+		}
+		spins = 0;
+	}
+
+	t_threadIndex = -1;
+
+	return;
+}
\ No newline at end of file
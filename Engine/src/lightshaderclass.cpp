@@ -433,6 +433,7 @@ bool LightShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		m_matrixBuffer,
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(MatrixBufferType));
 
 	// set the position of the constant buffer in the vertex shader
 	bufferNumber = 0;
@@ -450,6 +451,7 @@ bool LightShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		3,				// number of textures in the array (two textures & one alpha map)
 		textureArray	// texture resource array [2]
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_TEXTURE_BINDS, 3);
 
 	// lock the camera constant buffer so it can be written to
 	result = deviceContext->Map(
@@ -476,6 +478,7 @@ bool LightShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		m_cameraBuffer, 
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(CameraBufferType));
 
 	// set the position of the camera constant buffer in the vertex shader
 	bufferNumber = 1;
@@ -516,6 +519,7 @@ bool LightShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceContext,
 		m_lightBuffer,
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(LightBufferType));
 
 	// set the position of the light constants buffer in the pixel shader
 	bufferNumber = 0;
@@ -538,6 +542,7 @@ void LightShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int inde
 	// set the vertex and pixel shaders
 	deviceContext->VSSetShader(m_vertexShader, NULL, 0);
 	deviceContext->PSSetShader(m_pixelShader, NULL, 0);
+	RenderStatsClass::CountShader(m_vertexShader);
 
 	// set the sampler state in the pixel shader
 	deviceContext->PSSetSamplers(
@@ -552,4 +557,5 @@ void LightShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int inde
 		0,
 		0
 		);
+	RenderStatsClass::CountDraw(indexCount);
 }
\ No newline at end of file
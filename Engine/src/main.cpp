@@ -1,9 +1,111 @@
+#ifdef _WIN32
 #include "systemclass.h"
+#endif
+#include "packfileclass.h"
+#include "benchmarkclass.h"
+#include "scenegeneratorclass.h"
+#include "regressionclass.h"
 
+static bool SaveScene(const char* scene, const char* filename)
+{
+	SceneSettingsType settings;
+	std::vector<SceneObjectType> objects;
+
+	// generate the named scene and write it out so it can be loaded by name
+	if (!SceneGeneratorClass::ParseSettings(scene, settings) || !SceneGeneratorClass::Create(settings, objects))
+	{
+		return false;
+	}
+
+	return SceneGeneratorClass::Save(filename, objects);
+}
+
+#ifdef _WIN32
 int WINAPI WinMain(HINSTANCE hInstane, HINSTANCE hPrevInstance, PSTR pScmdline, int iCmdshow)
 {
 	SystemClass* System;
-	bool result;
+	BenchmarkClass Benchmark;
+	RegressionClass Regression;
+	std::string argument, flythroughFilename;
+	size_t separator;
+	FlythroughModeType flythroughMode;
+	bool pipelined, result;
+
+	// build the asset pack from the loose files and quit, "-pack raw" leaves the entries uncompressed
+	if (strncmp(pScmdline, "-pack", 5) == 0)
+	{
+		result = PackFileClass::Build(PACK_ENGINE_FILENAME, PACK_ENGINE_FILES, PACK_ENGINE_FILE_COUNT,
+			strcmp(pScmdline, "-pack raw") != 0);
+		return result ? 0 : 1;
+	}
+
+	// generate a scene and save it, "-scene city:100k:7 city.scene"
+	if (strncmp(pScmdline, "-scene ", 7) == 0)
+	{
+		argument = pScmdline + 7;
+		separator = argument.find(' ');
+		if (separator == std::string::npos)
+		{
+			return 1;
+		}
+		result = SaveScene(argument.substr(0, separator).c_str(), argument.substr(separator + 1).c_str());
+		return result ? 0 : 1;
+	}
+
+	// run the regression suite against the baseline and quit, "-regress update" replaces the baseline
+	if (strncmp(pScmdline, "-regress", 8) == 0)
+	{
+		result = Regression.Run(REGRESSION_OUTPUT_FILENAME, REGRESSION_BASELINE_FILENAME,
+			strcmp(pScmdline, "-regress update") == 0);
+		return result ? 0 : 1;
+	}
+
+	// run the named benchmark and quit, a scene may follow the name
+	if (strncmp(pScmdline, "-bench ", 7) == 0)
+	{
+		argument = pScmdline + 7;
+		separator = argument.find(' ');
+		if (separator == std::string::npos)
+		{
+			result = Benchmark.Run(argument.c_str(), nullptr, BENCHMARK_OUTPUT_FILENAME);
+		}
+		else
+		{
+			result = Benchmark.Run(argument.substr(0, separator).c_str(), argument.substr(separator + 1).c_str(),
+				BENCHMARK_OUTPUT_FILENAME);
+		}
+		return result ? 0 : 1;
+	}
+
+	// the latency mode renders every frame before the next one is simulated, "-latency -play"
+	pipelined = true;
+	if (strncmp(pScmdline, "-latency", 8) == 0)
+	{
+		pipelined = false;
+		pScmdline += 8;
+		while (*pScmdline == ' ')
+		{
+			pScmdline++;
+		}
+	}
+
+	// record the camera path of the run or play a recorded one back, a file name may follow
+	flythroughMode = FLYTHROUGH_OFF;
+	flythroughFilename = FLYTHROUGH_FILENAME;
+	if (strncmp(pScmdline, "-record", 7) == 0)
+	{
+		flythroughMode = FLYTHROUGH_RECORD;
+		argument = pScmdline + 7;
+	}
+	else if (strncmp(pScmdline, "-play", 5) == 0)
+	{
+		flythroughMode = FLYTHROUGH_PLAYBACK;
+		argument = pScmdline + 5;
+	}
+	if (argument.size() > 1 && argument[0] == ' ')
+	{
+		flythroughFilename = argument.substr(1);
+	}
 
 	// Create the system object
 	System = new SystemClass;
@@ -13,7 +115,7 @@ int WINAPI WinMain(HINSTANCE hInstane, HINSTANCE hPrevInstance, PSTR pScmdline,
 	}
 
 	// initialze and run the system oject
-	result = System->Initialize();
+	result = System->Initialize(flythroughMode, flythroughFilename.c_str(), pipelined);
 	if (result)
 	{
 		System->Run();
@@ -25,4 +127,47 @@ int WINAPI WinMain(HINSTANCE hInstane, HINSTANCE hPrevInstance, PSTR pScmdline,
 	System = nullptr;
 
 	return 0;
-}
\ No newline at end of file
+}
+#else
+int main(int argc, char* argv[])
+{
+	BenchmarkClass Benchmark;
+	RegressionClass Regression;
+	bool result;
+
+	// there is no window without windows, the pack can be built and the benchmarks run headless
+	if (argc > 1 && strcmp(argv[1], "-pack") == 0)
+	{
+		result = PackFileClass::Build(PACK_ENGINE_FILENAME, PACK_ENGINE_FILES, PACK_ENGINE_FILE_COUNT,
+			!(argc > 2 && strcmp(argv[2], "raw") == 0));
+		return result ? 0 : 1;
+	}
+
+	// generate a scene and save it
+	if (argc > 3 && strcmp(argv[1], "-scene") == 0)
+	{
+		result = SaveScene(argv[2], argv[3]);
+		return result ? 0 : 1;
+	}
+
+	// run the regression suite, it fails if a scenario got slower than its baseline
+	if (argc > 1 && strcmp(argv[1], "-regress") == 0)
+	{
+		result = Regression.Run(REGRESSION_OUTPUT_FILENAME, REGRESSION_BASELINE_FILENAME,
+			argc > 2 && strcmp(argv[2], "update") == 0);
+		return result ? 0 : 1;
+	}
+
+	// run the named benchmark on the named scene, the frames of the default headless scene by default
+	if (argc > 2 && strcmp(argv[1], "-bench") == 0)
+	{
+		result = Benchmark.Run(argv[2], argc > 3 ? argv[3] : nullptr, BENCHMARK_OUTPUT_FILENAME);
+	}
+	else
+	{
+		result = Benchmark.Run("headless", nullptr, BENCHMARK_OUTPUT_FILENAME);
+	}
+
+	return result ? 0 : 1;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "memoryclass.h"
+
+MemoryClass::MemoryBytesType MemoryClass::s_bytes[MEMORY_TAG_COUNT];
+MemoryClass::MemoryThreadCountsType MemoryClass::s_threads[MEMORY_MAX_THREADS + 1];
+std::atomic<int> MemoryClass::s_threadCount(0);
+
+static const char* const s_tagNames[MEMORY_TAG_COUNT] = {
+	"general",
+	"graphics",
+	"mesh",
+	"texture",
+	"text",
+	"scene"
+};
+
+// the slot the calling thread counts into, taken on its first allocation
+static thread_local int t_threadSlot = -1;
+
+void* MemoryClass::Allocate(size_t size, MemoryTagType tag)
+{
+	MemoryHeaderType* header;
+	unsigned char* block;
+	unsigned char* memory;
+	unsigned long long current, peak;
+
+	// the memory comes from the global heap, a failed allocation returns null like the callers expect.
+	//  the heap only aligns to 8 bytes on 32 bit builds, so the block has room to move the memory
+	//  after the header up to the alignment
+	block = (unsigned char*)::operator new(sizeof(MemoryHeaderType) + MEMORY_ALIGNMENT - 1 + size, std::nothrow);
+	if (!block)
+	{
+		return nullptr;
+	}
+
+	memory = block + sizeof(MemoryHeaderType);
+	memory += (MEMORY_ALIGNMENT - (size_t)memory % MEMORY_ALIGNMENT) % MEMORY_ALIGNMENT;
+
+	header = GetHeader(memory);
+	header->block = block;
+	header->size = size;
+	header->tag = (unsigned int)tag;
+	header->count = 1;
+
+	if (!MEMORY_TRACKING_ENABLED)
+	{
+		return memory;
+	}
+
+	// add the bytes to the tag, the peak only moves up
+	current = s_bytes[tag].current.fetch_add(size, std::memory_order_relaxed) + size;
+	peak = s_bytes[tag].peak.load(std::memory_order_relaxed);
+	while (current > peak && !s_bytes[tag].peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+	{
+	}
+
+	Increment(GetThreadCounts()->allocations[tag]);
+
+	return memory;
+}
+
+void MemoryClass::Free(void* memory)
+{
+	MemoryHeaderType* header;
+
+	if (!memory)
+	{
+		return;
+	}
+
+	header = GetHeader(memory);
+	if (MEMORY_TRACKING_ENABLED)
+	{
+		s_bytes[header->tag].current.fetch_sub(header->size, std::memory_order_relaxed);
+		Increment(GetThreadCounts()->frees[header->tag]);
+	}
+
+	::operator delete(header->block);
+
+	return;
+}
+
+void MemoryClass::GetStats(MemoryTagType tag, MemoryStatsType& stats)
+{
+	unsigned long long frees;
+	int threadCount;
+
+	stats.current = s_bytes[tag].current.load(std::memory_order_relaxed);
+	stats.peak = s_bytes[tag].peak.load(std::memory_order_relaxed);
+
+	// sum up the counts of all the threads, the shared slot comes last
+	stats.allocations = 0;
+	frees = 0;
+	threadCount = std::min(s_threadCount.load(), MEMORY_MAX_THREADS);
+	for (int i = 0; i < threadCount; i++)
+	{
+		stats.allocations += s_threads[i].allocations[tag].load(std::memory_order_relaxed);
+		frees += s_threads[i].frees[tag].load(std::memory_order_relaxed);
+	}
+	stats.allocations += s_threads[MEMORY_MAX_THREADS].allocations[tag].load(std::memory_order_relaxed);
+	frees += s_threads[MEMORY_MAX_THREADS].frees[tag].load(std::memory_order_relaxed);
+
+	stats.live = stats.allocations - frees;
+
+	return;
+}
+
+void MemoryClass::GetTotalStats(MemoryStatsType& stats)
+{
+	MemoryStatsType tagStats;
+
+	// the peaks of the tags may not have been at the same time, their sum is an upper bound
+	stats.current = 0;
+	stats.peak = 0;
+	stats.allocations = 0;
+	stats.live = 0;
+	for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+	{
+		GetStats((MemoryTagType)i, tagStats);
+		stats.current += tagStats.current;
+		stats.peak += tagStats.peak;
+		stats.allocations += tagStats.allocations;
+		stats.live += tagStats.live;
+	}
+
+	return;
+}
+
+const char* MemoryClass::GetTagName(MemoryTagType tag)
+{
+	return tag >= 0 && tag < MEMORY_TAG_COUNT ? s_tagNames[tag] : "unknown";
+}
+
+int MemoryClass::GetLeakReport(char* buffer, size_t bufferSize)
+{
+	MemoryStatsType stats;
+	size_t length;
+	int leaks;
+
+	// one line for every tag that still has memory, nothing if everything was freed
+	leaks = 0;
+	length = 0;
+	if (bufferSize > 0)
+	{
+		buffer[0] = '\0';
+	}
+
+	for (int i = 0; i < MEMORY_TAG_COUNT; i++)
+	{
+		GetStats((MemoryTagType)i, stats);
+		if (stats.live == 0)
+		{
+			continue;
+		}
+
+		leaks += (int)stats.live;
+		if (length < bufferSize)
+		{
+			snprintf(buffer + length, bufferSize - length, "memory leak: %s has %llu allocations with %llu bytes left, %llu bytes at the peak\n",
+				s_tagNames[i], stats.live, stats.current, stats.peak);
+			length += strlen(buffer + length);
+		}
+	}
+
+	return leaks;
+}
+
+MemoryClass::MemoryHeaderType* MemoryClass::GetHeader(void* memory)
+{
+	return (MemoryHeaderType*)memory - 1;
+}
+
+MemoryClass::MemoryThreadCountsType* MemoryClass::GetThreadCounts()
+{
+	// take the next free slot, threads beyond the maximum share the last one
+	if (t_threadSlot < 0)
+	{
+		t_threadSlot = std::min(s_threadCount.fetch_add(1), MEMORY_MAX_THREADS);
+	}
+
+	return &s_threads[t_threadSlot];
+}
+
+void MemoryClass::Increment(std::atomic<unsigned long long>& count)
+{
+	// only this thread writes its own slot, so a plain load and store is enough
+	if (t_threadSlot < MEMORY_MAX_THREADS)
+	{
+		count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+	else
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return;
+}
\ No newline at end of file
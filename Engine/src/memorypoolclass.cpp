@@ -0,0 +1,124 @@
+#include "memorypoolclass.h"
+
+MemoryPoolClass::MemoryPoolClass()
+	: m_elementSize(0), m_pageElements(0), m_tag(MEMORY_TAG_GENERAL), m_pages(nullptr), m_free(nullptr),
+	  m_usedCount(0), m_capacity(0)
+{
+}
+
+MemoryPoolClass::~MemoryPoolClass()
+{
+	Shutdown();
+}
+
+bool MemoryPoolClass::Initialize(size_t elementSize, MemoryTagType tag, int pageElements)
+{
+	if (pageElements <= 0)
+	{
+		return false;
+	}
+
+	// a free element has to hold the link to the next one and every element stays aligned
+	elementSize = std::max(elementSize, sizeof(FreeElementType));
+	m_elementSize = (elementSize + MEMORY_ALIGNMENT - 1) & ~(MEMORY_ALIGNMENT - 1);
+	m_pageElements = pageElements;
+	m_tag = tag;
+
+	return true;
+}
+
+void MemoryPoolClass::Shutdown()
+{
+	PageType* next;
+
+	// the pages go back all at once, objects still in the pool are not destroyed
+	while (m_pages)
+	{
+		next = m_pages->next;
+		MemoryClass::Free(m_pages);
+		m_pages = next;
+	}
+
+	m_free = nullptr;
+	m_usedCount = 0;
+	m_capacity = 0;
+
+	return;
+}
+
+void* MemoryPoolClass::Allocate()
+{
+	FreeElementType* element;
+
+	// take a new page once every element is in use
+	if (!m_free && !AddPage())
+	{
+		return nullptr;
+	}
+
+	element = m_free;
+	m_free = element->next;
+	m_usedCount++;
+
+	return element;
+}
+
+void MemoryPoolClass::Free(void* memory)
+{
+	FreeElementType* element;
+
+	if (!memory)
+	{
+		return;
+	}
+
+	// the element is used again by the next allocation
+	element = (FreeElementType*)memory;
+	element->next = m_free;
+	m_free = element;
+	m_usedCount--;
+
+	return;
+}
+
+int MemoryPoolClass::GetUsedCount()
+{
+	return m_usedCount;
+}
+
+int MemoryPoolClass::GetCapacity()
+{
+	return m_capacity;
+}
+
+bool MemoryPoolClass::AddPage()
+{
+	PageType* page;
+	unsigned char* elements;
+
+	if (m_elementSize == 0)
+	{
+		return false;
+	}
+
+	// the page is tracked under the tag of the pool
+	page = (PageType*)MemoryClass::Allocate(sizeof(PageType) + m_elementSize * m_pageElements, m_tag);
+	if (!page)
+	{
+		return false;
+	}
+
+	page->next = m_pages;
+	m_pages = page;
+
+	// link the elements of the page into the free list in order
+	elements = (unsigned char*)(page + 1);
+	for (int i = m_pageElements - 1; i >= 0; i--)
+	{
+		((FreeElementType*)(elements + m_elementSize * i))->next = m_free;
+		m_free = (FreeElementType*)(elements + m_elementSize * i);
+	}
+	m_capacity += m_pageElements;
+
+	return true;
+}
\ No newline at end of file
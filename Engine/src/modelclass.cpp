@@ -4,7 +4,6 @@ ModelClass::ModelClass()
 {
 	m_vertexBuffer = nullptr;
 	m_indexBuffer = nullptr;
-	m_TextureArray = nullptr;
 	m_Model = nullptr;
 }
 
@@ -16,38 +15,20 @@ ModelClass::~ModelClass()
 {
 }
 
-bool ModelClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext, 
-	char* modelFilename, WCHAR* textureFilename1, WCHAR* textureFilename2, 
-	WCHAR* textureFilename3, WCHAR* textureFilename4, WCHAR* textureFilename5)
+bool ModelClass::Initialize(ID3D11Device* device, PackFileClass* pack, AssetCacheClass* cache, char* modelFilename)
 {
 	bool result;
+	AssetDataType asset;
 
-	// load in the model data
-	result = LoadModel(modelFilename);
+	// get the model file from the pack or the disk
+	result = pack->Read(modelFilename, asset);
 	if (!result)
 	{
 		return false;
 	}
 
-	// calculate the normal, tangent and binormal for the model
-	CalculateModelVectors();
-
-	// initialize the vertex and index buffer
-	result = InitializeBuffers(device);
-	if (!result) 
-	{
-		return false;
-	}
-
-	// load the texture for this model
-	result = LoadTextures(
-		device, 
-		textureFilename1, 
-		textureFilename2, 
-		textureFilename3, 
-		textureFilename4,
-		textureFilename5
-	);
+	// import the model and create its vertex and index buffer
+	result = InitializeMesh(device, cache, asset);
 	if (!result)
 	{
 		return false;
@@ -58,9 +39,6 @@ bool ModelClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceCon
 
 void ModelClass::Shutdown()
 {
-	// release the model texture
-	ReleaseTextures();
-
 	// shutdown the vertex and index buffers
 	ShutdownBuffers();
 
@@ -83,9 +61,37 @@ int ModelClass::GetIndexCount()
 	return m_indexCount;
 }
 
-ID3D11ShaderResourceView** ModelClass::GetTextureArray()
+bool ModelClass::InitializeMesh(ID3D11Device* device, AssetCacheClass* cache, const AssetDataType& asset)
+{
+	bool result;
+
+	// load in the model data with its normal, tangent and binormal from the cache or import it
+	result = ImportModel(cache, asset);
+	if (!result)
+	{
+		return false;
+	}
+
+	// initialize the vertex and index buffer
+	result = InitializeBuffers(device);
+	if (!result) 
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void ModelClass::SwapMesh(ModelClass* other)
 {
-	return m_TextureArray->GetTextureArray();
+	// exchange the model data and buffers
+	std::swap(m_vertexBuffer, other->m_vertexBuffer);
+	std::swap(m_indexBuffer, other->m_indexBuffer);
+	std::swap(m_vertexCount, other->m_vertexCount);
+	std::swap(m_indexCount, other->m_indexCount);
+	std::swap(m_Model, other->m_Model);
+
+	return;
 }
 
 bool ModelClass::InitializeBuffers(ID3D11Device* device)
@@ -218,6 +224,7 @@ void ModelClass::RenderBuffers(ID3D11DeviceContext* deviceContext)
 		DXGI_FORMAT_R32_UINT, 
 		0
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_BUFFER_BINDS, 2);
 
 	// set the type of primitive that should be rendered from this vertex buffer, in this case triangles
 	deviceContext->IASetPrimitiveTopology(
@@ -229,92 +236,108 @@ void ModelClass::RenderBuffers(ID3D11DeviceContext* deviceContext)
 	return;
 }
 
-bool ModelClass::LoadTextures(ID3D11Device* device, WCHAR* filename1, WCHAR* filename2, 
-	WCHAR* filename3, WCHAR* filename4, WCHAR* filename5)
+bool ModelClass::ImportModel(AssetCacheClass* cache, const AssetDataType& asset)
 {
-	bool result;
+	std::vector<unsigned char> blob;
+	unsigned long long key;
+	int vertexCount;
 
-	// create the texture array object
-	m_TextureArray = new TextureArrayClass;
-	if (!m_TextureArray)
+	// an unchanged model is taken from the cache as it is, the blob is the vertex count followed by the vertices
+	key = 0;
+	if (cache)
 	{
-		return false;
+		key = cache->MakeKey(asset, "model", MODEL_IMPORTER_VERSION, nullptr, 0);
+		if (cache->Load(key, blob) && blob.size() >= sizeof(int))
+		{
+			memcpy(&vertexCount, blob.data(), sizeof(int));
+			if (vertexCount > 0 && blob.size() == sizeof(int) + vertexCount * sizeof(ModelType))
+			{
+				m_vertexCount = vertexCount;
+				m_indexCount = vertexCount;
+
+				m_Model = MemoryClass::NewArray<ModelType>(m_vertexCount, MEMORY_TAG_MESH);
+				if (!m_Model)
+				{
+					return false;
+				}
+				memcpy(m_Model, blob.data() + sizeof(int), m_vertexCount * sizeof(ModelType));
+
+				return true;
+			}
+		}
 	}
 
-	// initialize the texture array object
-	result = m_TextureArray->Initialize(device, filename1, filename2, filename3, filename4, filename5);
-	if (!result)
+	// otherwise parse the model and calculate the normal, tangent and binormal
+	if (!LoadModel(asset))
 	{
 		return false;
 	}
 
-	return true;
-}
+	CalculateModelVectors();
 
-void ModelClass::ReleaseTextures()
-{
-	// release the texture object
-	if (m_TextureArray)
+	// and store the result for the next run
+	if (cache)
 	{
-		m_TextureArray->Shutdown();
-		delete m_TextureArray;
-		m_TextureArray = nullptr;
+		blob.resize(sizeof(int) + m_vertexCount * sizeof(ModelType));
+		memcpy(blob.data(), &m_vertexCount, sizeof(int));
+		memcpy(blob.data() + sizeof(int), m_Model, m_vertexCount * sizeof(ModelType));
+		cache->Store(key, blob.data(), blob.size());
 	}
-	
-	return;
+
+	return true;
 }
 
-bool ModelClass::LoadModel(char* filename)
+bool ModelClass::LoadModel(const AssetDataType& asset)
 {
-	std::ifstream fin;
 	char input;
 
-	// open the model file
-	fin.open(filename);
-	if (fin.fail())
-	{
-		return false;
-	}
+	// parse the text in place
+	MemoryStreamBuffer buffer(asset.data, asset.size);
+	std::istream fin(&buffer);
 
-	// read up the value of vertex coutn
-	fin.get(input);
-	while (input != ':')
+	// read up the value of vertex coutn, a file that is cut short ends the stream
+	do
 	{
 		fin.get(input);
-	}
+	} while (fin && input != ':');
 
-	// read in the vertex count
+	// read in the vertex count, it can not be more than the text has room for
 	fin >> m_vertexCount;
+	if (!fin || m_vertexCount <= 0 || (unsigned long long)m_vertexCount > asset.size / MODEL_MIN_VERTEX_BYTES)
+	{
+		return false;
+	}
 
 	// set the number of indics to be the same as the vertex count
 	m_indexCount = m_vertexCount;
 
 	// create the model using the vertex count that was read in
-	m_Model = new ModelType[m_vertexCount];
+	m_Model = MemoryClass::NewArray<ModelType>(m_vertexCount, MEMORY_TAG_MESH);
 	if (!m_Model)
 	{
 		return false;
 	}
 
 	// read up to the beginning of the data
-	fin.get(input);
-	while (input != ':')
+	do
 	{
 		fin.get(input);
-	}
-	fin.get(input);		// first newline
-	fin.get(input);		// second newline
+	} while (fin && input != ':');
 
 	// read in the vertex data
-	for (int i = 0; i < m_vertexCount; i++)
+	for (int i = 0; i < m_vertexCount && fin; i++)
 	{
 		fin >> m_Model[i].x >> m_Model[i].y >> m_Model[i].z;
 		fin >> m_Model[i].tu >> m_Model[i].tv;
 		fin >> m_Model[i].nx >> m_Model[i].ny >> m_Model[i].nz;
 	}
 
-	// close the model file
-	fin.close();
+	// a half saved file keeps the model that was there before
+	if (!fin)
+	{
+		ReleaseModel();
+		return false;
+	}
 
 	return true;
 }
@@ -323,7 +346,7 @@ void ModelClass::ReleaseModel()
 {
 	if (m_Model)
 	{
-		delete[] m_Model;
+		MemoryClass::DeleteArray(m_Model);
 		m_Model = nullptr;
 	}
 
@@ -332,18 +355,25 @@ void ModelClass::ReleaseModel()
 
 void ModelClass::CalculateModelVectors()
 {
-	int faceCount;
+	JobCounterType counter;
+
+	// the faces do not share vertices, so they are calculated on all the threads
+	JobSystemClass::ParallelFor(CalculateFaceVectorsJob, this, 0, m_vertexCount / 3, MODEL_FACE_GRAIN, &counter);
+	JobSystemClass::Wait(&counter);
+
+	return;
+}
+
+void ModelClass::CalculateFaceVectors(int begin, int end)
+{
 	TempVertexType vertex1, vertex2, vertex3;
 	VectorType tangent, binormal, normal;
 
-	// calculate the number of faces in the model
-	faceCount = m_vertexCount / 3;
-
 	// initialize the index to the model data
-	int idx = 0;
+	int idx = begin * 3;
 
-	// go through all the faces and calculate the tangent, binormal and normal vectors
-	for (int i = 0; i < faceCount; i++)
+	// go through the faces and calculate the tangent, binormal and normal vectors
+	for (int i = begin; i < end; i++)
 	{
 		// get the three vertices for this face from the model
 		vertex1.x = m_Model[idx].x;
@@ -417,6 +447,13 @@ void ModelClass::CalculateModelVectors()
 	return;
 }
 
+void ModelClass::CalculateFaceVectorsJob(void* data, int begin, int end)
+{
+	((ModelClass*)data)->CalculateFaceVectors(begin, end);
+
+	return;
+}
+
 void ModelClass::CalculateTangentBinormal(TempVertexType vertex1, TempVertexType vertex2,
 	TempVertexType vertex3, VectorType& tangent, VectorType& binormal)
 {
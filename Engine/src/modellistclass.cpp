@@ -1,41 +1,75 @@
 #include "modellistclass.h"
 
 ModelListClass::ModelListClass()
-	: m_ModelInfoList(nullptr)
+	: m_version(0)
 {
 }
 
 bool ModelListClass::Initialize(int numModels)
 {
-	float red, green, blue;
-	
-	// store the number of models
-	m_modelCount = numModels;
+	SceneSettingsType settings;
 
-	// create a list array of the model information
-	m_ModelInfoList = new ModelInfoType[m_modelCount];
-	if (!m_ModelInfoList)
+	// the default uniform scene with the given number of models
+	SceneGeneratorClass::GetDefaultSettings(settings);
+	settings.objectCount = numModels;
+
+	return Initialize(settings);
+}
+
+bool ModelListClass::Initialize(const SceneSettingsType& settings)
+{
+	std::vector<SceneObjectType> objects;
+	ColorComponentType* color;
+	PositionComponentType* position;
+	EntityType entity;
+	int modelCount;
+
+	// generate the scene from its seed or load it from its file
+	if (!SceneGeneratorClass::Create(settings, objects))
 	{
 		return false;
 	}
 
-	// seed the random generatr with the current time
-	srand((unsigned int)time(nullptr));
+	// a new scene is a new version
+	modelCount = (int)objects.size();
+	m_version++;
+	m_movedModels.clear();
 
-	// go through all the models and randomly generate the model color and position
-	for (int i = 0; i < m_modelCount; i++)
+	// the components of the models are tracked as part of the scene
+	if (!m_entities.Initialize(MEMORY_TAG_SCENE) || !m_entities.Reserve(MODEL_COMPONENTS, modelCount) ||
+		!m_transforms.Initialize(modelCount))
 	{
-		// generate a random color for the model
-		red = (float)rand() / RAND_MAX;
-		green = (float)rand() / RAND_MAX;
-		blue = (float)rand() / RAND_MAX;
+		return false;
+	}
+	m_models.resize(modelCount);
 
-		m_ModelInfoList[i].color = XMFLOAT4(red, green, blue, 1.f);
+	// create an entity with the color, position and size of every object of the scene
+	for (int i = 0; i < modelCount; i++)
+	{
+		entity = m_entities.Create(MODEL_COMPONENTS);
+		if (entity.IsNull())
+		{
+			return false;
+		}
+		m_models[i] = entity;
 
-		// generate random position in front of the view for the node
-		m_ModelInfoList[i].positionX = (((float)rand() - (float)rand()) / RAND_MAX) * 50.f;
-		m_ModelInfoList[i].positionY = (((float)rand() - (float)rand()) / RAND_MAX) * 50.f;
-		m_ModelInfoList[i].positionZ = ((((float)rand() - (float)rand()) / RAND_MAX) * 50.f) + 5.0f;
+		color = m_entities.Get<ColorComponentType>(entity);
+		SceneGeneratorClass::GetColor(objects[i], color->red, color->green, color->blue, color->alpha);
+
+		position = m_entities.Get<PositionComponentType>(entity);
+		position->x = objects[i].positionX;
+		position->y = objects[i].positionY;
+		position->z = objects[i].positionZ;
+
+		m_entities.Get<RadiusComponentType>(entity)->radius = objects[i].radius;
+		m_entities.Get<ModelComponentType>(entity)->index = i;
+
+		// the unit sphere scaled to the size of the model and moved to its position
+		m_transforms.AddNode(-1);
+		m_transforms.SetLocal(i,
+			XMFLOAT3(objects[i].positionX, objects[i].positionY, objects[i].positionZ),
+			XMFLOAT4(0.f, 0.f, 0.f, 1.f),
+			XMFLOAT3(objects[i].radius, objects[i].radius, objects[i].radius));
 	}
 
 	return true;
@@ -43,28 +77,271 @@ bool ModelListClass::Initialize(int numModels)
 
 void ModelListClass::Shutdown()
 {
-	// release the model information list
-	if (m_ModelInfoList)
+	// release the entities and the transforms of the models
+	m_entities.Shutdown();
+	m_transforms.Shutdown();
+	m_models.clear();
+
+	return;
+}
+
+int ModelListClass::GetModelCount()
+{
+	return (int)m_models.size();
+}
+
+void ModelListClass::GetData(int index, float& positionX, float& positionY, float& positionZ, float& radius, XMFLOAT4& color)
+{
+	PositionComponentType* position;
+	ColorComponentType* modelColor;
+
+	position = m_entities.Get<PositionComponentType>(m_models[index]);
+	positionX = position->x;
+	positionY = position->y;
+	positionZ = position->z;
+	radius = m_entities.Get<RadiusComponentType>(m_models[index])->radius;
+
+	modelColor = m_entities.Get<ColorComponentType>(m_models[index]);
+	color = XMFLOAT4(modelColor->red, modelColor->green, modelColor->blue, modelColor->alpha);
+
+	return;
+}
+
+void ModelListClass::SetPosition(int index, float positionX, float positionY, float positionZ)
+{
+	PositionComponentType* position;
+
+	position = m_entities.Get<PositionComponentType>(m_models[index]);
+	position->x = positionX;
+	position->y = positionY;
+	position->z = positionZ;
+	m_transforms.SetTranslation(index, XMFLOAT3(positionX, positionY, positionZ));
+
+	// whoever keeps results about the model has to look at it again
+	m_version++;
+	m_movedModels.push_back(index);
+
+	return;
+}
+
+bool ModelListClass::SetVelocity(int index, float velocityX, float velocityY, float velocityZ)
+{
+	VelocityComponentType velocity;
+
+	// a model without a velocity stands still, it is only moved to the moving archetype once needed
+	if (velocityX == 0.f && velocityY == 0.f && velocityZ == 0.f)
 	{
-		delete[] m_ModelInfoList;
-		m_ModelInfoList = nullptr;
+		if (m_entities.Get<VelocityComponentType>(m_models[index]))
+		{
+			return m_entities.Remove<VelocityComponentType>(m_models[index]);
+		}
+		return true;
 	}
 
+	velocity.x = velocityX;
+	velocity.y = velocityY;
+	velocity.z = velocityZ;
+
+	return m_entities.Add(m_models[index], velocity);
+}
+
+MeshHandleType ModelListClass::GetMesh(int index)
+{
+	return m_entities.Get<MeshComponentType>(m_models[index])->mesh;
+}
+
+void ModelListClass::SetMesh(int index, MeshHandleType mesh)
+{
+	// the mesh does not change what can be seen, the version stays
+	m_entities.Get<MeshComponentType>(m_models[index])->mesh = mesh;
+
 	return;
 }
 
-int ModelListClass::GetModelCount()
+unsigned int ModelListClass::GetFlags(int index)
+{
+	return m_entities.Get<FlagsComponentType>(m_models[index])->flags;
+}
+
+void ModelListClass::SetFlags(int index, unsigned int flags)
+{
+	m_entities.Get<FlagsComponentType>(m_models[index])->flags = flags;
+
+	// hiding a model changes what can be seen like moving it does
+	m_version++;
+	m_movedModels.push_back(index);
+
+	return;
+}
+
+unsigned int ModelListClass::GetVersion()
+{
+	return m_version;
+}
+
+void ModelListClass::TakeMovedModels(std::vector<int>& movedModels)
+{
+	// hand out the list and start a new one, the capacity goes back and forth between the two
+	movedModels.clear();
+	movedModels.swap(m_movedModels);
+
+	return;
+}
+
+EntityStoreClass* ModelListClass::GetEntities()
+{
+	return &m_entities;
+}
+
+EntityType ModelListClass::GetEntity(int index)
+{
+	return m_models[index];
+}
+
+TransformClass* ModelListClass::GetTransforms()
 {
-	return m_modelCount;
+	return &m_transforms;
+}
+
+void ModelListClass::Update(float time)
+{
+	ProfileZoneClass zone("transform update");
+	UpdateJobType job;
+	PositionComponentType* position;
+	int rowCount;
+
+	// only the models with a velocity move
+	m_entities.Query((1u << COMPONENT_POSITION) | (1u << COMPONENT_VELOCITY) | (1u << COMPONENT_MODEL), m_chunks);
+	if (m_chunks.empty())
+	{
+		return;
+	}
+
+	// every chunk lists the models it moved in its own part of the moves
+	rowCount = m_chunks.back().first + m_chunks.back().count;
+	m_moves.resize(rowCount);
+
+	job.modelList = this;
+	job.time = time;
+
+	if (rowCount >= MODEL_PARALLEL_COUNT && JobSystemClass::GetThreadCount() > 1)
+	{
+		JobCounterType counter;
+
+		JobSystemClass::ParallelFor(UpdateJob, &job, 0, (int)m_chunks.size(), 1, &counter);
+		JobSystemClass::Wait(&counter);
+	}
+	else
+	{
+		UpdateJob(&job, 0, (int)m_chunks.size());
+	}
+
+	// the visibility tests the moved models again, a model without a velocity has none
+	m_movedModels.insert(m_movedModels.end(), m_moves.begin(), m_moves.end());
+	m_version += (unsigned int)rowCount;
+
+	// and their world matrices are made again
+	for (int i = 0; i < rowCount; i++)
+	{
+		position = m_entities.Get<PositionComponentType>(m_models[m_moves[i]]);
+		m_transforms.SetTranslation(m_moves[i], XMFLOAT3(position->x, position->y, position->z));
+	}
+
+	return;
 }
 
-void ModelListClass::GetData(int index, float& positionX, float& positionY, float& positionZ, XMFLOAT4& color)
+void ModelListClass::Extract(const int* models, int count, RenderItemType* items)
 {
-	positionX = m_ModelInfoList[index].positionX;
-	positionY = m_ModelInfoList[index].positionY;
-	positionZ = m_ModelInfoList[index].positionZ;
+	ProfileZoneClass zone("render extraction");
+	ExtractJobType job;
+
+	// the world matrices of the models that moved are made first
+	m_transforms.Update();
+
+	job.modelList = this;
+	job.models = models;
+	job.items = items;
 
-	color = m_ModelInfoList[index].color;
+	// copy what the renderer needs of the visible models into one packed array
+	if (count >= MODEL_PARALLEL_COUNT && JobSystemClass::GetThreadCount() > 1)
+	{
+		JobCounterType counter;
+
+		JobSystemClass::ParallelFor(ExtractJob, &job, 0, count, MODEL_EXTRACT_GRAIN, &counter);
+		JobSystemClass::Wait(&counter);
+	}
+	else
+	{
+		ExtractJob(&job, 0, count);
+	}
+
+	return;
+}
+
+void ModelListClass::UpdateJob(void* data, int begin, int end)
+{
+	UpdateJobType* job;
+	PositionComponentType* positions;
+	VelocityComponentType* velocities;
+	ModelComponentType* models;
+	int* moves;
+
+	job = (UpdateJobType*)data;
+	for (int chunk = begin; chunk < end; chunk++)
+	{
+		const EntityChunkType& rows = job->modelList->m_chunks[chunk];
+
+		positions = rows.Get<PositionComponentType>();
+		velocities = rows.Get<VelocityComponentType>();
+		models = rows.Get<ModelComponentType>();
+		moves = job->modelList->m_moves.data() + rows.first;
+
+		// move every model along its velocity
+		for (int i = 0; i < rows.count; i++)
+		{
+			positions[i].x += velocities[i].x * job->time;
+			positions[i].y += velocities[i].y * job->time;
+			positions[i].z += velocities[i].z * job->time;
+
+			moves[i] = models[i].index;
+		}
+	}
+
+	return;
+}
+
+void ModelListClass::ExtractJob(void* data, int begin, int end)
+{
+	ExtractJobType* job;
+	EntityStoreClass* entities;
+	PositionComponentType* position;
+	ColorComponentType* color;
+	RenderItemType* item;
+	EntityType entity;
+	XMMATRIX world;
+
+	job = (ExtractJobType*)data;
+	entities = &job->modelList->m_entities;
+
+	for (int i = begin; i < end; i++)
+	{
+		entity = job->modelList->m_models[job->models[i]];
+		item = &job->items[i];
+
+		position = entities->Get<PositionComponentType>(entity);
+		item->positionX = position->x;
+		item->positionY = position->y;
+		item->positionZ = position->z;
+		item->radius = entities->Get<RadiusComponentType>(entity)->radius;
+
+		color = entities->Get<ColorComponentType>(entity);
+		item->color = XMFLOAT4(color->red, color->green, color->blue, color->alpha);
+
+		item->mesh = entities->Get<MeshComponentType>(entity)->mesh;
+
+		job->modelList->m_transforms.GetWorldMatrix(job->models[i], world);
+		XMStoreFloat4x4(&item->world, world);
+	}
 
 	return;
 }
\ No newline at end of file
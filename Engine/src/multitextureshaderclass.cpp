@@ -356,6 +356,7 @@ bool MultiTextureShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceCon
 		m_matrixBuffer,		// resource
 		0					// sub-resource
 	);
+	RenderStatsClass::CountMap(sizeof(MatrixBufferType));
 
 	// set the POSITION OF THE MATRIX CONSTANT BUFFER in the vertex shader
 	bufferNumber = 0;
@@ -373,6 +374,7 @@ bool MultiTextureShaderClass::SetShaderParameters(ID3D11DeviceContext* deviceCon
 		2,				// number of textures in the array
 		textureArray	// texture resource array [2]
 	);
+	RenderStatsClass::Add(RENDER_COUNTER_TEXTURE_BINDS, 2);
 
 	return true;
 }
@@ -385,12 +387,14 @@ void MultiTextureShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, i
 	// set the vertex and pixel shaders that will be used to render this triangle
 	deviceContext->VSSetShader(m_vertexShader, NULL, 0);
 	deviceContext->PSSetShader(m_pixelShader, NULL, 0);
+	RenderStatsClass::CountShader(m_vertexShader);
 
 	// set the sampler state in the pixel shader
 	deviceContext->PSSetSamplers(0, 1, &m_samplerState);
 
 	// render the triangles
 	deviceContext->DrawIndexed(indexCount, 0, 0);
+	RenderStatsClass::CountDraw(indexCount);
 
 	return;
 }
\ No newline at end of file
@@ -0,0 +1,438 @@
+#include "packfileclass.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// pre-processing directives
+#define PACK_MAGIC 0x4B415054		// "TPAK"
+#define PACK_VERSION 2
+
+PackFileClass::PackFileClass()
+	: m_data(nullptr), m_size(0), m_header(nullptr), m_entries(nullptr), m_names(nullptr),
+	  m_file(nullptr), m_mapping(nullptr)
+{
+}
+
+PackFileClass::~PackFileClass()
+{
+	Close();
+}
+
+bool PackFileClass::Open(const char* filename)
+{
+	// close a pack that was opened before
+	Close();
+
+#ifdef _WIN32
+	HANDLE file, mapping;
+	LARGE_INTEGER size;
+
+	// open the pack file, this is the only file that is opened for all the assets
+	file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(PackHeaderType))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// map the whole file read only into the address space
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	m_data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_data)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_file = file;
+	m_mapping = mapping;
+	m_size = (unsigned long long)size.QuadPart;
+#else
+	int file;
+	struct stat info;
+	void* data;
+
+	// open the pack file, this is the only file that is opened for all the assets
+	file = open(filename, O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	if (fstat(file, &info) != 0 || info.st_size < (off_t)sizeof(PackHeaderType))
+	{
+		::close(file);
+		return false;
+	}
+
+	// map the whole file read only into the address space, the descriptor is not needed afterwards
+	data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	::close(file);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	m_data = (const unsigned char*)data;
+	m_size = (unsigned long long)info.st_size;
+#endif
+
+	// check the header and the bounds of the table of contents
+	m_header = (const PackHeaderType*)m_data;
+	if (m_header->magic != PACK_MAGIC || m_header->version != PACK_VERSION ||
+		m_header->tocOffset + (unsigned long long)m_header->entryCount * sizeof(PackEntryType) + m_header->nameBytes > m_size)
+	{
+		Close();
+		return false;
+	}
+
+	m_entries = (const PackEntryType*)(m_data + m_header->tocOffset);
+	m_names = (const char*)(m_entries + m_header->entryCount);
+
+	// check that every entry lies within the file
+	for (unsigned int i = 0; i < m_header->entryCount; i++)
+	{
+		if (m_entries[i].offset + m_entries[i].size > m_size ||
+			(!(m_entries[i].flags & PACK_ENTRY_COMPRESSED) && m_entries[i].size != m_entries[i].rawSize) ||
+			(unsigned long long)m_entries[i].nameOffset + m_entries[i].nameLength > m_header->nameBytes)
+		{
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void PackFileClass::Close()
+{
+	// unmap the pack file
+	if (m_data)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+#else
+		munmap((void*)m_data, (size_t)m_size);
+#endif
+		m_data = nullptr;
+	}
+
+#ifdef _WIN32
+	// release the mapping and file handles
+	if (m_mapping)
+	{
+		CloseHandle((HANDLE)m_mapping);
+		m_mapping = nullptr;
+	}
+
+	if (m_file)
+	{
+		CloseHandle((HANDLE)m_file);
+		m_file = nullptr;
+	}
+#endif
+
+	m_size = 0;
+	m_header = nullptr;
+	m_entries = nullptr;
+	m_names = nullptr;
+
+	return;
+}
+
+bool PackFileClass::IsOpen()
+{
+	return m_data != nullptr;
+}
+
+bool PackFileClass::Find(const char* filename, const unsigned char*& data, unsigned long long& size)
+{
+	const PackEntryType* entry;
+
+	// only uncompressed entries can be handed out as a span
+	entry = FindEntry(filename);
+	if (!entry || (entry->flags & PACK_ENTRY_COMPRESSED))
+	{
+		return false;
+	}
+
+	data = m_data + entry->offset;
+	size = entry->size;
+
+	return true;
+}
+
+bool PackFileClass::Read(const char* filename, AssetDataType& asset)
+{
+	const PackEntryType* entry;
+
+	entry = FindEntry(filename);
+	if (entry)
+	{
+		// hand out a span into the mapped pack if the asset is stored uncompressed
+		if (!(entry->flags & PACK_ENTRY_COMPRESSED))
+		{
+			asset.buffer.clear();
+			asset.data = m_data + entry->offset;
+			asset.size = entry->size;
+			return true;
+		}
+
+		// otherwise decompress its blocks in parallel straight into the asset buffer
+		asset.buffer.resize((size_t)entry->rawSize);
+		if (!CompressionClass::Decompress(m_data + entry->offset, entry->size,
+			asset.buffer.data(), entry->rawSize, CompressionClass::GetThreadCount()))
+		{
+			return false;
+		}
+
+		asset.data = asset.buffer.data();
+		asset.size = entry->rawSize;
+		return true;
+	}
+
+	// fall back to the loose file
+	return ReadLooseFile(filename, asset);
+}
+
+int PackFileClass::GetEntryCount()
+{
+	return m_header ? (int)m_header->entryCount : 0;
+}
+
+const PackFileClass::PackEntryType* PackFileClass::FindEntry(const char* filename)
+{
+	std::string path;
+	unsigned long long hash;
+	const PackEntryType* entry;
+	const PackEntryType* end;
+
+	if (!m_data)
+	{
+		return nullptr;
+	}
+
+	// look up the hash of the normalized path in the sorted table of contents
+	path = NormalizePath(filename);
+	hash = HashPath(path.c_str());
+
+	end = m_entries + m_header->entryCount;
+	entry = std::lower_bound(m_entries, end, hash, [](const PackEntryType& a, unsigned long long b)
+	{
+		return a.hash < b;
+	});
+
+	// compare the names of all the entries with that hash in case of a collision
+	for (; entry != end && entry->hash == hash; entry++)
+	{
+		if (entry->nameLength == path.size() && memcmp(m_names + entry->nameOffset, path.c_str(), path.size()) == 0)
+		{
+			return entry;
+		}
+	}
+
+	return nullptr;
+}
+
+bool PackFileClass::Build(const char* packFilename, const char* const* filenames, int count, bool compress)
+{
+	struct BuildEntryType
+	{
+		std::string path;
+		AssetDataType asset;
+		std::vector<unsigned char> compressed;
+		unsigned long long hash;
+	};
+
+	std::vector<BuildEntryType> files;
+	std::vector<PackEntryType> entries;
+	std::string names;
+	PackHeaderType header;
+	unsigned long long offset;
+	std::ofstream fout;
+	static const char padding[PACK_ALIGNMENT] = { 0 };
+
+	// read in all the loose files
+	files.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		if (!ReadLooseFile(filenames[i], files[i].asset))
+		{
+			return false;
+		}
+
+		files[i].path = NormalizePath(filenames[i]);
+		files[i].hash = HashPath(files[i].path.c_str());
+
+		// compress the file, but only keep it if that saves at least an eighth
+		if (compress && CompressionClass::Compress(files[i].asset.data, files[i].asset.size, files[i].compressed))
+		{
+			if (files[i].compressed.size() > files[i].asset.size - files[i].asset.size / 8)
+			{
+				files[i].compressed.clear();
+			}
+		}
+	}
+
+	// sort the files by the hash of their path so they can be found with a binary search
+	std::sort(files.begin(), files.end(), [](const BuildEntryType& a, const BuildEntryType& b)
+	{
+		return a.hash < b.hash;
+	});
+
+	// build the name table
+	for (int i = 0; i < count; i++)
+	{
+		names += files[i].path;
+	}
+
+	// setup the header, the table of contents follows directly
+	header.magic = PACK_MAGIC;
+	header.version = PACK_VERSION;
+	header.entryCount = (unsigned int)count;
+	header.nameBytes = (unsigned int)names.size();
+	header.tocOffset = sizeof(PackHeaderType);
+	header.dataOffset = header.tocOffset + count * sizeof(PackEntryType) + names.size();
+	header.dataOffset = (header.dataOffset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+
+	// place every file at a page aligned offset so it can be mapped on its own
+	entries.resize(count);
+	offset = header.dataOffset;
+	for (int i = 0, nameOffset = 0; i < count; i++)
+	{
+		entries[i].hash = files[i].hash;
+		entries[i].offset = offset;
+		entries[i].rawSize = files[i].asset.size;
+		entries[i].size = files[i].compressed.empty() ? files[i].asset.size : files[i].compressed.size();
+		entries[i].nameOffset = (unsigned int)nameOffset;
+		entries[i].nameLength = (unsigned int)files[i].path.size();
+		entries[i].flags = files[i].compressed.empty() ? 0 : PACK_ENTRY_COMPRESSED;
+		entries[i].reserved = 0;
+
+		nameOffset += (int)files[i].path.size();
+		offset = (offset + entries[i].size + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+	}
+
+	// write out the header, the table of contents and the names
+	fout.open(packFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	fout.write((const char*)&header, sizeof(header));
+	fout.write((const char*)entries.data(), count * sizeof(PackEntryType));
+	fout.write(names.data(), names.size());
+
+	// write out the file data, padded up to the next alignment
+	offset = header.tocOffset + count * sizeof(PackEntryType) + names.size();
+	for (int i = 0; i < count; i++)
+	{
+		fout.write(padding, (std::streamsize)(entries[i].offset - offset));
+		if (entries[i].flags & PACK_ENTRY_COMPRESSED)
+		{
+			fout.write((const char*)files[i].compressed.data(), (std::streamsize)entries[i].size);
+		}
+		else
+		{
+			fout.write((const char*)files[i].asset.data, (std::streamsize)entries[i].size);
+		}
+		offset = entries[i].offset + entries[i].size;
+	}
+
+	fout.close();
+
+	return !fout.fail();
+}
+
+bool PackFileClass::ReadLooseFile(const char* filename, AssetDataType& asset)
+{
+	std::ifstream fin;
+	std::streamoff size;
+
+	// open the file for reading in binary
+	fin.open(filename, std::ios::in | std::ios::binary | std::ios::ate);
+	if (fin.fail())
+	{
+		return false;
+	}
+
+	// read in the whole file
+	size = fin.tellg();
+	fin.seekg(0, std::ios::beg);
+
+	asset.buffer.resize((size_t)size);
+	fin.read((char*)asset.buffer.data(), size);
+	if (fin.gcount() != size)
+	{
+		return false;
+	}
+
+	fin.close();
+
+	asset.data = asset.buffer.data();
+	asset.size = (unsigned long long)size;
+
+	return true;
+}
+
+unsigned long long PackFileClass::HashPath(const char* path)
+{
+	unsigned long long hash = 14695981039346656037ull;
+
+	// 64 bit fnv-1a
+	for (; *path; path++)
+	{
+		hash ^= (unsigned char)*path;
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+std::string PackFileClass::NormalizePath(const char* filename)
+{
+	std::string path;
+
+	// skip a leading "./"
+	if (filename[0] == '.' && (filename[1] == '/' || filename[1] == '\\'))
+	{
+		filename += 2;
+	}
+
+	// use forward slashes and lower case so the lookup does not depend on the platform
+	for (; *filename; filename++)
+	{
+		char c = *filename;
+		if (c == '\\')
+		{
+			c = '/';
+		}
+		else if (c >= 'A' && c <= 'Z')
+		{
+			c = c - 'A' + 'a';
+		}
+		path += c;
+	}
+
+	return path;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "platformclass.h"
+
+SyntheticPlatformClass::SyntheticPlatformClass(bool realClock)
+	: m_nextEvent(0), m_time(0.0), m_realClock(realClock), m_start(std::chrono::steady_clock::now())
+{
+}
+
+bool SyntheticPlatformClass::PollEvent(PlatformEventType& event)
+{
+	// only what was posted up to now is pending
+	if (m_nextEvent >= m_events.size() || m_events[m_nextEvent].time > GetTime())
+	{
+		return false;
+	}
+
+	event = m_events[m_nextEvent++];
+
+	// forget the handled events once all of them are
+	if (m_nextEvent == m_events.size())
+	{
+		m_events.clear();
+		m_nextEvent = 0;
+	}
+
+	return true;
+}
+
+double SyntheticPlatformClass::GetTime()
+{
+	if (m_realClock)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count() + m_time;
+	}
+
+	return m_time;
+}
+
+void SyntheticPlatformClass::SleepFor(double time)
+{
+	if (!m_realClock)
+	{
+		m_time += std::max(time, SYNTHETIC_PLATFORM_TICK_MS);
+		return;
+	}
+
+	if (time <= 0.0)
+	{
+		std::this_thread::yield();
+	}
+	else
+	{
+		std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(time));
+	}
+
+	return;
+}
+
+void SyntheticPlatformClass::PostEvent(const PlatformEventType& event)
+{
+	m_events.push_back(event);
+
+	return;
+}
+
+void SyntheticPlatformClass::SetTime(double time)
+{
+	m_time = time;
+
+	return;
+}
+
+void SyntheticPlatformClass::Advance(double time)
+{
+	m_time += time;
+
+	return;
+}
+
+int SyntheticPlatformClass::GetPendingCount()
+{
+	int count = 0;
+
+	double time = GetTime();
+
+	for (size_t i = m_nextEvent; i < m_events.size() && m_events[i].time <= time; i++)
+	{
+		count++;
+	}
+
+	return count;
+}
\ No newline at end of file
@@ -1,11 +1,7 @@
 #include "positionclass.h"
 
-// pre-processing directives
-#define DIRECTINPUT_VERSION 0x0800
-#include <dinput.h>
-
 PositionClass::PositionClass()
-	: m_frameTime(0), m_mouseX(0), m_mouseY(0), m_key(nullptr), m_angleH(0.f), m_angleV(0.f)
+	: m_mouseX(0), m_mouseY(0), m_keyTimes(nullptr), m_angleH(0.f), m_angleV(0.f)
 {
 	m_position = XMVectorZero();
 	m_direction = XMVectorZero();
@@ -15,18 +11,14 @@ PositionClass::PositionClass()
 
 bool PositionClass::Frame()
 {
+	ProfileZoneClass zone("PositionClass::Frame");
+
 	Update();
 	Calculate();
 
 	return true;
 }
 
-void PositionClass::SetFrameTime(float time)
-{
-	m_frameTime = time;
-	return;
-}
-
 void PositionClass::SetMousePosition(int mouseX, int mouseY)
 {
 	m_mouseX = mouseX;
@@ -35,9 +27,9 @@ void PositionClass::SetMousePosition(int mouseX, int mouseY)
 	return;
 }
 
-void PositionClass::SetKeyboard(unsigned char* key)
+void PositionClass::SetKeyTimes(const float* keyTimes)
 {
-	m_key = key;
+	m_keyTimes = keyTimes;
 	return;
 }
 
@@ -88,32 +80,19 @@ void PositionClass::Update()
 		m_angleV += 360.f; 
 	}
 
-	// update position
-	if (m_key[DIK_A] & 0x80)		// left
-	{
-		m_position += m_right * m_frameTime * speed;
-	}
-	if (m_key[DIK_S] & 0x80)		// back
+	// update position, every key moves the camera for as long as it was down
+	if (!m_keyTimes)
 	{
-		m_position -= m_direction * m_frameTime * speed;
-	}
-	if (m_key[DIK_D] & 0x80)		// right
-	{
-		m_position -= m_right * m_frameTime * speed;
-	}
-	if (m_key[DIK_Q] & 0x80)		// down
-	{
-		m_position -= m_up * m_frameTime * speed;
-	}
-	if (m_key[DIK_W] & 0x80)		// forward
-	{
-		m_position += m_direction * m_frameTime * speed;
-	}
-	if (m_key[DIK_E] & 0x80)		// up
-	{
-		m_position += m_up * m_frameTime * speed;
+		return;
 	}
 
+	m_position += m_right * m_keyTimes[INPUT_KEY_A] * speed;		// left
+	m_position -= m_direction * m_keyTimes[INPUT_KEY_S] * speed;	// back
+	m_position -= m_right * m_keyTimes[INPUT_KEY_D] * speed;		// right
+	m_position -= m_up * m_keyTimes[INPUT_KEY_Q] * speed;			// down
+	m_position += m_direction * m_keyTimes[INPUT_KEY_W] * speed;	// forward
+	m_position += m_up * m_keyTimes[INPUT_KEY_E] * speed;			// up
+
 }
 
 void PositionClass::Calculate()
@@ -0,0 +1,189 @@
+#include "profilerclass.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PROFILER_USE_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_USE_TSC
+#endif
+
+ProfilerClass::ThreadBufferType ProfilerClass::s_buffers[PROFILER_MAX_THREADS];
+std::atomic<int> ProfilerClass::s_bufferCount(0);
+double ProfilerClass::s_ticksPerMicrosecond = 1000.0;
+unsigned long long ProfilerClass::s_startTicks = 0;
+
+// the buffer of the calling thread, taken on its first zone
+static thread_local void* t_buffer = nullptr;
+static thread_local bool t_bufferTaken = false;
+
+bool ProfilerClass::Initialize()
+{
+#ifdef PROFILER_USE_TSC
+	std::chrono::steady_clock::time_point start;
+	unsigned long long startTicks;
+	double elapsed;
+
+	// measure the rate of the time stamp counter against the steady clock
+	start = std::chrono::steady_clock::now();
+	startTicks = GetTicks();
+	do
+	{
+		elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	} while (elapsed < 10000.0);
+
+	s_ticksPerMicrosecond = (GetTicks() - startTicks) / elapsed;
+#else
+	// the ticks are steady clock nanoseconds
+	s_ticksPerMicrosecond = 1000.0;
+#endif
+
+	s_startTicks = GetTicks();
+
+	return s_ticksPerMicrosecond > 0.0;
+}
+
+void ProfilerClass::Shutdown()
+{
+	// forget the recorded zones, the buffers stay taken by their threads
+	for (int i = 0; i < PROFILER_MAX_THREADS; i++)
+	{
+		s_buffers[i].head.store(0, std::memory_order_relaxed);
+	}
+
+	return;
+}
+
+unsigned long long ProfilerClass::GetTicks()
+{
+#ifdef PROFILER_USE_TSC
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void ProfilerClass::Record(const char* name, unsigned long long begin, unsigned long long end)
+{
+	ThreadBufferType* buffer;
+	unsigned long long head;
+	ZoneType* zone;
+
+	buffer = GetThreadBuffer();
+	if (!buffer)
+	{
+		return;
+	}
+
+	// only this thread writes the buffer, the exporter sees the zone once the head moved past it
+	head = buffer->head.load(std::memory_order_relaxed);
+	zone = &buffer->zones[head & (PROFILER_RING_SIZE - 1)];
+	zone->name = name;
+	zone->begin = begin;
+	zone->end = end;
+	buffer->head.store(head + 1, std::memory_order_release);
+
+	return;
+}
+
+bool ProfilerClass::WriteTrace(const char* filename)
+{
+	std::ofstream fout;
+	std::vector<ZoneType> zones;
+	unsigned long long head, first, after;
+	int bufferCount;
+	bool comma;
+
+	fout.open(filename, std::ios::out | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// complete events with the timestamps and durations in microseconds
+	fout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+	fout.setf(std::ios::fixed);
+	fout.precision(3);
+
+	comma = false;
+	bufferCount = std::min(s_bufferCount.load(), PROFILER_MAX_THREADS);
+	for (int i = 0; i < bufferCount; i++)
+	{
+		ThreadBufferType& buffer = s_buffers[i];
+
+		// copy the zones still in the ring
+		head = buffer.head.load(std::memory_order_acquire);
+		first = head > PROFILER_RING_SIZE ? head - PROFILER_RING_SIZE : 0;
+		zones.clear();
+		for (unsigned long long j = first; j < head; j++)
+		{
+			zones.push_back(buffer.zones[j & (PROFILER_RING_SIZE - 1)]);
+		}
+
+		// drop the ones the thread overwrote while they were copied
+		after = buffer.head.load(std::memory_order_acquire);
+		if (after > PROFILER_RING_SIZE && after - PROFILER_RING_SIZE > first)
+		{
+			zones.erase(zones.begin(), zones.begin() + (size_t)std::min<unsigned long long>(after - PROFILER_RING_SIZE - first, zones.size()));
+		}
+
+		for (size_t j = 0; j < zones.size(); j++)
+		{
+			if (zones[j].begin < s_startTicks)
+			{
+				continue;
+			}
+
+			fout << (comma ? ",\n" : "") << "{\"name\":\"" << zones[j].name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.threadId;
+			fout << ",\"ts\":" << (zones[j].begin - s_startTicks) / s_ticksPerMicrosecond;
+			fout << ",\"dur\":" << (zones[j].end - zones[j].begin) / s_ticksPerMicrosecond << "}";
+			comma = true;
+		}
+	}
+
+	fout << std::endl << "]}" << std::endl;
+	fout.close();
+
+	return !fout.fail();
+}
+
+double ProfilerClass::GetTicksPerMicrosecond()
+{
+	return s_ticksPerMicrosecond;
+}
+
+ProfilerClass::ThreadBufferType* ProfilerClass::GetThreadBuffer()
+{
+	int index;
+
+	if (!t_bufferTaken)
+	{
+		// take the next free buffer, threads beyond the maximum are not profiled
+		t_bufferTaken = true;
+		index = s_bufferCount.fetch_add(1);
+		if (index < PROFILER_MAX_THREADS)
+		{
+			s_buffers[index].threadId = (unsigned int)index + 1;
+			t_buffer = &s_buffers[index];
+		}
+	}
+
+	return (ThreadBufferType*)t_buffer;
+}
+
+ProfileZoneClass::ProfileZoneClass(const char* name)
+	: m_name(name), m_begin(0)
+{
+	if (PROFILER_ENABLED)
+	{
+		m_begin = ProfilerClass::GetTicks();
+	}
+}
+
+ProfileZoneClass::~ProfileZoneClass()
+{
+	if (PROFILER_ENABLED)
+	{
+		ProfilerClass::Record(m_name, m_begin, ProfilerClass::GetTicks());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "randomclass.h"
+
+#include <math.h>
+
+RandomClass::RandomClass()
+{
+	Seed(0);
+}
+
+RandomClass::RandomClass(unsigned long long seed, unsigned long long stream)
+{
+	Seed(seed, stream);
+}
+
+void RandomClass::Seed(unsigned long long seed, unsigned long long stream)
+{
+	// every stream is a different sequence for the same seed, the increment has to be odd
+	m_state = 0;
+	m_increment = (stream << 1) | 1;
+	Next();
+	m_state += seed;
+	Next();
+
+	return;
+}
+
+unsigned int RandomClass::Next()
+{
+	unsigned long long state;
+	unsigned int xorShifted, rotation;
+
+	// advance the 64 bit lcg and permute the old state into 32 bits of output
+	state = m_state;
+	m_state = state * 6364136223846793005ull + m_increment;
+
+	xorShifted = (unsigned int)(((state >> 18) ^ state) >> 27);
+	rotation = (unsigned int)(state >> 59);
+
+	return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+unsigned int RandomClass::NextInt(unsigned int bound)
+{
+	unsigned long long product;
+	unsigned int threshold;
+
+	// a number below the bound without modulo bias, by multiplying and rejecting the short range
+	product = (unsigned long long)Next() * bound;
+	if ((unsigned int)product < bound)
+	{
+		threshold = (0u - bound) % bound;
+		while ((unsigned int)product < threshold)
+		{
+			product = (unsigned long long)Next() * bound;
+		}
+	}
+
+	return (unsigned int)(product >> 32);
+}
+
+float RandomClass::NextFloat()
+{
+	// the upper 24 bits fill the mantissa, so the result is below 1
+	return (Next() >> 8) * (1.f / 16777216.f);
+}
+
+float RandomClass::NextRange(float minimum, float maximum)
+{
+	return minimum + (maximum - minimum) * NextFloat();
+}
+
+float RandomClass::NextGaussian()
+{
+	float u, v;
+
+	// box-muller, the second value is thrown away to keep the generator free of state
+	u = 1.f - NextFloat();
+	v = NextFloat();
+
+	return sqrtf(-2.f * logf(u)) * cosf(6.2831853f * v);
+}
\ No newline at end of file
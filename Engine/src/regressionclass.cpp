@@ -0,0 +1,502 @@
+#include "regressionclass.h"
+
+// pre-processing directives
+#define MAD_SCALE 1.4826			// makes the MAD comparable to a standard deviation
+
+bool RegressionClass::Run(const char* outputFilename, const char* baselineFilename, bool updateBaseline)
+{
+	std::vector<RegressionResultType> baseline;
+	bool result;
+
+	// run every scenario of the matrix
+	m_results.clear();
+
+	result = Frustum();
+	result = ModelList() && result;
+	result = Model() && result;
+	result = Targa() && result;
+	result = Text() && result;
+	if (!result)
+	{
+		return false;
+	}
+
+	// the baseline is replaced on request, otherwise every scenario is compared with it
+	if (updateBaseline)
+	{
+		return WriteResults(baselineFilename, m_results) && WriteResults(outputFilename, m_results);
+	}
+
+	// without a baseline every scenario would pass as new, so the gate fails until one is made
+	if (!ReadResults(baselineFilename, baseline))
+	{
+		fprintf(stderr, "regression: no baseline could be read from %s, run \"-regress update\" to make one\n", baselineFilename);
+		WriteResults(outputFilename, m_results);
+		return false;
+	}
+
+	return Compare(outputFilename, baseline);
+}
+
+bool RegressionClass::Frustum()
+{
+	struct ContextType
+	{
+		FrustumClass* frustum;
+		const std::vector<SceneObjectType>* objects;
+		RegressionCullingType culling;
+		int visible;
+	};
+
+	std::vector<SceneObjectType> objects;
+	FrustumClass frustum;
+	XMMATRIX projectionMatrix, viewMatrix;
+	ContextType context;
+
+	// the camera of the graphics object, in the middle of the scene looking down z
+	projectionMatrix = XMMatrixPerspectiveFovLH(3.141592654f / 4.f, 4.f / 3.f, 0.1f, 1000.f);
+	viewMatrix = XMMatrixLookAtLH(XMVectorSet(0.f, 0.f, -3.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f), XMVectorSet(0.f, 1.f, 0.f, 0.f));
+	frustum.ConstructFrustum(1000.f, projectionMatrix, viewMatrix);
+
+	context.frustum = &frustum;
+	context.objects = &objects;
+	context.visible = 0;
+
+	for (int i = 0; i < REGRESSION_OBJECT_COUNT_COUNT; i++)
+	{
+		if (!SceneGeneratorClass::Generate(SCENE_UNIFORM, REGRESSION_OBJECT_COUNTS[i], SCENE_DEFAULT_SEED, objects))
+		{
+			return false;
+		}
+
+		for (int culling = 0; culling < REGRESSION_CULL_COUNT; culling++)
+		{
+			context.culling = (RegressionCullingType)culling;
+
+			// count the objects the check keeps, the count is kept so the checks are not optimized away
+			Measure(std::string("frustum/") + REGRESSION_CULLING_NAMES[culling] + "/" + std::to_string(REGRESSION_OBJECT_COUNTS[i]),
+				"ns/object", (double)objects.size(), [](void* data)
+			{
+				ContextType* context = (ContextType*)data;
+				const SceneObjectType* object = context->objects->data();
+				int count = (int)context->objects->size();
+				int visible = 0;
+
+				for (int j = 0; j < count; j++, object++)
+				{
+					switch (context->culling)
+					{
+					case REGRESSION_CULL_POINT:
+						visible += context->frustum->CheckPoint(object->positionX, object->positionY, object->positionZ);
+						break;
+					case REGRESSION_CULL_SPHERE:
+						visible += context->frustum->CheckSphere(object->positionX, object->positionY, object->positionZ, object->radius);
+						break;
+					default:
+						visible += context->frustum->CheckCube(object->positionX, object->positionY, object->positionZ, object->radius);
+						break;
+					}
+				}
+
+				context->visible += visible;
+			}, &context);
+		}
+	}
+
+	return true;
+}
+
+bool RegressionClass::ModelList()
+{
+	struct ContextType
+	{
+		ModelListClass* modelList;
+		float sum;
+	};
+
+	ContextType context;
+
+	for (int i = 0; i < REGRESSION_OBJECT_COUNT_COUNT; i++)
+	{
+		ModelListClass modelList;
+
+		if (!modelList.Initialize(REGRESSION_OBJECT_COUNTS[i]))
+		{
+			return false;
+		}
+
+		context.modelList = &modelList;
+		context.sum = 0.f;
+
+		// walk the list the way the graphics object does every frame
+		Measure("modellist/getdata/" + std::to_string(REGRESSION_OBJECT_COUNTS[i]), "ns/object",
+			(double)modelList.GetModelCount(), [](void* data)
+		{
+			ContextType* context = (ContextType*)data;
+			float positionX, positionY, positionZ, radius;
+			XMFLOAT4 color;
+
+			for (int j = 0; j < context->modelList->GetModelCount(); j++)
+			{
+				context->modelList->GetData(j, positionX, positionY, positionZ, radius, color);
+				context->sum += positionX + positionY + positionZ + radius + color.x;
+			}
+		}, &context);
+
+		modelList.Shutdown();
+	}
+
+	return true;
+}
+
+bool RegressionClass::Model()
+{
+#ifdef _WIN32
+	struct ContextType
+	{
+		ModelClass* model;
+		const AssetDataType* asset;
+	};
+
+	ModelClass model;
+	PackFileClass pack;
+	AssetDataType asset;
+	ContextType context;
+
+	// the model comes from the pack if there is one, otherwise from its loose file
+	pack.Open(PACK_ENGINE_FILENAME);
+	if (!pack.Read(REGRESSION_MODEL_FILENAME, asset) || !model.LoadModel(asset))
+	{
+		return false;
+	}
+
+	context.model = &model;
+	context.asset = &asset;
+
+	// parse the text of the model
+	Measure("asset/loadmodel/sphere", "us", 1e3, [](void* data)
+	{
+		ContextType* context = (ContextType*)data;
+
+		context->model->ReleaseModel();
+		context->model->LoadModel(*context->asset);
+	}, &context);
+
+	// the tangent space of all its faces
+	Measure("asset/modelvectors/sphere", "us", 1e3, [](void* data)
+	{
+		((ContextType*)data)->model->CalculateModelVectors();
+	}, &context);
+
+	model.ReleaseModel();
+#endif
+
+	// the model object needs a d3d device, there is nothing to measure without windows
+	return true;
+}
+
+bool RegressionClass::Targa()
+{
+#ifdef _WIN32
+	struct ContextType
+	{
+		TextureClass* texture;
+		PackFileClass* pack;
+	};
+
+	TextureClass texture;
+	PackFileClass pack;
+	ContextType context;
+	std::vector<unsigned char> image;
+	std::ofstream fout;
+
+	// write a 32 bit targa with a gradient, the engine does not ship one
+	image.resize(18 + REGRESSION_TARGA_SIZE * REGRESSION_TARGA_SIZE * 4);
+	image[2] = 2;
+	image[12] = REGRESSION_TARGA_SIZE & 0xFF;
+	image[13] = REGRESSION_TARGA_SIZE >> 8;
+	image[14] = REGRESSION_TARGA_SIZE & 0xFF;
+	image[15] = REGRESSION_TARGA_SIZE >> 8;
+	image[16] = 32;
+	for (size_t i = 18; i < image.size(); i++)
+	{
+		image[i] = (unsigned char)(i * 7);
+	}
+
+	fout.open(REGRESSION_TARGA_FILENAME, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+	fout.write((const char*)image.data(), (std::streamsize)image.size());
+	fout.close();
+
+	context.texture = &texture;
+	context.pack = &pack;
+
+	// read and flip the image without the asset cache
+	Measure("asset/loadtarga/" + std::to_string(REGRESSION_TARGA_SIZE), "us", 1e3, [](void* data)
+	{
+		ContextType* context = (ContextType*)data;
+		int height, width;
+
+		if (context->texture->LoadTarga(context->pack, nullptr, (char*)REGRESSION_TARGA_FILENAME, height, width))
+		{
+			delete[] context->texture->m_targaData;
+			context->texture->m_targaData = nullptr;
+		}
+	}, &context);
+
+	remove(REGRESSION_TARGA_FILENAME);
+#endif
+
+	return true;
+}
+
+bool RegressionClass::Text()
+{
+#ifdef _WIN32
+	struct ContextType
+	{
+		FontClass* font;
+		std::vector<FontClass::VertexType>* vertices;
+		std::string* sentence;
+	};
+
+	FontClass font;
+	PackFileClass pack;
+	std::vector<FontClass::VertexType> vertices;
+	std::string sentence;
+	ContextType context;
+
+	pack.Open(PACK_ENGINE_FILENAME);
+	if (!font.LoadFontData(&pack, nullptr, (char*)REGRESSION_FONT_FILENAME))
+	{
+		return false;
+	}
+
+	context.font = &font;
+	context.vertices = &vertices;
+	context.sentence = &sentence;
+
+	for (int i = 0; i < REGRESSION_TEXT_LENGTH_COUNT; i++)
+	{
+		// a sentence of printable characters with some spaces in between
+		sentence.clear();
+		for (int j = 0; j < REGRESSION_TEXT_LENGTHS[i]; j++)
+		{
+			sentence += (j % 8 == 7) ? ' ' : (char)('!' + j % (FONT_CHARACTER_COUNT - 1));
+		}
+		vertices.resize(sentence.size() * 6);
+
+		Measure("text/buildvertexarray/" + std::to_string(REGRESSION_TEXT_LENGTHS[i]), "ns/char", (double)sentence.size(),
+			[](void* data)
+		{
+			ContextType* context = (ContextType*)data;
+
+			context->font->BuildVertexArray(context->vertices->data(), (char*)context->sentence->c_str(), -320.f, 240.f);
+		}, &context);
+	}
+
+	font.ReleaseFontData();
+#endif
+
+	return true;
+}
+
+void RegressionClass::Measure(const std::string& scenario, const char* unit, double operations, BodyType body, void* context)
+{
+	RegressionResultType result;
+	std::vector<double> times, deviations;
+	double start;
+
+	// let the caches and the branch predictors settle first
+	for (int i = 0; i < REGRESSION_WARMUP; i++)
+	{
+		body(context);
+	}
+
+	// every trial is one call, in nanoseconds divided by the operations it did
+	for (int i = 0; i < REGRESSION_TRIALS; i++)
+	{
+		start = GetTime();
+		body(context);
+		times.push_back((GetTime() - start) * 1e9 / operations);
+	}
+
+	result.scenario = scenario;
+	result.unit = unit;
+	result.trials = REGRESSION_TRIALS;
+	result.median = Median(times);
+
+	for (size_t i = 0; i < times.size(); i++)
+	{
+		deviations.push_back(fabs(times[i] - result.median));
+	}
+	result.mad = Median(deviations);
+
+	m_results.push_back(result);
+
+	return;
+}
+
+bool RegressionClass::Compare(const char* outputFilename, const std::vector<RegressionResultType>& baseline)
+{
+	std::ofstream fout;
+	const RegressionResultType* reference;
+	const char* status;
+	double threshold;
+	bool regressed;
+
+	fout.open(outputFilename, std::ios::out | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	regressed = false;
+	for (size_t i = 0; i < m_results.size(); i++)
+	{
+		const RegressionResultType& result = m_results[i];
+
+		reference = nullptr;
+		for (size_t j = 0; j < baseline.size() && !reference; j++)
+		{
+			if (baseline[j].scenario == result.scenario && baseline[j].unit == result.unit)
+			{
+				reference = &baseline[j];
+			}
+		}
+
+		// a change counts if it is larger than the noise of both runs and than the minimum change
+		status = "new";
+		if (reference)
+		{
+			threshold = std::max(REGRESSION_MAD_FACTOR * MAD_SCALE * std::max(reference->mad, result.mad),
+				REGRESSION_MIN_CHANGE * reference->median);
+
+			if (result.median > reference->median + threshold)
+			{
+				status = "regressed";
+				regressed = true;
+			}
+			else if (result.median < reference->median - threshold)
+			{
+				status = "improved";
+			}
+			else
+			{
+				status = "unchanged";
+			}
+		}
+
+		// one json object per line
+		fout << "{\"scenario\":\"" << result.scenario << "\",\"unit\":\"" << result.unit << "\"";
+		fout << ",\"trials\":" << result.trials << ",\"median\":" << result.median << ",\"mad\":" << result.mad;
+		if (reference)
+		{
+			fout << ",\"baseline\":" << reference->median << ",\"baseline_mad\":" << reference->mad;
+		}
+		fout << ",\"status\":\"" << status << "\"}" << std::endl;
+	}
+
+	fout.close();
+
+	return !fout.fail() && !regressed;
+}
+
+bool RegressionClass::WriteResults(const char* filename, const std::vector<RegressionResultType>& results)
+{
+	std::ofstream fout;
+
+	fout.open(filename, std::ios::out | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// one json object per line
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		fout << "{\"scenario\":\"" << results[i].scenario << "\",\"unit\":\"" << results[i].unit << "\"";
+		fout << ",\"trials\":" << results[i].trials << ",\"median\":" << results[i].median;
+		fout << ",\"mad\":" << results[i].mad << "}" << std::endl;
+	}
+
+	fout.close();
+
+	return !fout.fail();
+}
+
+bool RegressionClass::ReadResults(const char* filename, std::vector<RegressionResultType>& results)
+{
+	std::ifstream fin;
+	std::string line;
+	RegressionResultType result;
+	size_t start, end;
+
+	fin.open(filename);
+	if (fin.fail())
+	{
+		return false;
+	}
+
+	// only the lines written by WriteResults are understood, the fields are found by their names
+	results.clear();
+	while (std::getline(fin, line))
+	{
+		start = line.find("\"scenario\":\"");
+		end = start == std::string::npos ? start : line.find('"', start + 12);
+		if (end == std::string::npos)
+		{
+			continue;
+		}
+		result.scenario = line.substr(start + 12, end - start - 12);
+
+		start = line.find("\"unit\":\"");
+		end = start == std::string::npos ? start : line.find('"', start + 8);
+		if (end == std::string::npos)
+		{
+			continue;
+		}
+		result.unit = line.substr(start + 8, end - start - 8);
+
+		start = line.find("\"trials\":");
+		result.trials = start == std::string::npos ? 0 : atoi(line.c_str() + start + 9);
+
+		start = line.find("\"median\":");
+		if (start == std::string::npos)
+		{
+			continue;
+		}
+		result.median = atof(line.c_str() + start + 9);
+
+		start = line.find("\"mad\":");
+		result.mad = start == std::string::npos ? 0.0 : atof(line.c_str() + start + 6);
+
+		results.push_back(result);
+	}
+
+	// a file without a single result is not a baseline
+	return !results.empty();
+}
+
+double RegressionClass::Median(std::vector<double> samples)
+{
+	size_t middle;
+
+	if (samples.empty())
+	{
+		return 0.0;
+	}
+
+	middle = samples.size() / 2;
+	std::nth_element(samples.begin(), samples.begin() + middle, samples.end());
+
+	return samples[middle];
+}
+
+double RegressionClass::GetTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
\ No newline at end of file
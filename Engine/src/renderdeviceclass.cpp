@@ -0,0 +1,227 @@
+#include "renderdeviceclass.h"
+
+NullRenderDeviceClass::NullRenderDeviceClass()
+	: m_resourceBytes(0), m_resourceCount(0)
+{
+}
+
+int NullRenderDeviceClass::CreateBuffer(RenderResourceType type, const void* data, unsigned long long size)
+{
+	if (type != RENDER_RESOURCE_VERTEX_BUFFER && type != RENDER_RESOURCE_INDEX_BUFFER && type != RENDER_RESOURCE_CONSTANT_BUFFER)
+	{
+		return -1;
+	}
+
+	return CreateResource(type, 0, 0, data, size);
+}
+
+int NullRenderDeviceClass::CreateTexture(int width, int height, const void* data, unsigned long long size)
+{
+	if (width <= 0 || height <= 0 || !data)
+	{
+		return -1;
+	}
+
+	return CreateResource(RENDER_RESOURCE_TEXTURE, width, height, data, size);
+}
+
+int NullRenderDeviceClass::CreateShader(RenderResourceType type, const void* byteCode, unsigned long long size)
+{
+	if ((type != RENDER_RESOURCE_VERTEX_SHADER && type != RENDER_RESOURCE_PIXEL_SHADER) || !byteCode)
+	{
+		return -1;
+	}
+
+	return CreateResource(type, 0, 0, byteCode, size);
+}
+
+void NullRenderDeviceClass::Release(int resource)
+{
+	if (resource < 0 || resource >= (int)m_resources.size() || m_resources[resource].type == RENDER_RESOURCE_NONE)
+	{
+		return;
+	}
+
+	// give the memory back and keep the handle for the next resource
+	m_resourceBytes -= m_resources[resource].data.size();
+	m_resourceCount--;
+
+	m_resources[resource].type = RENDER_RESOURCE_NONE;
+	std::vector<unsigned char>().swap(m_resources[resource].data);
+	m_freeResources.push_back(resource);
+
+	return;
+}
+
+bool NullRenderDeviceClass::UpdateBuffer(int buffer, const void* data, unsigned long long size)
+{
+	ResourceType* resource;
+
+	if (buffer < 0 || buffer >= (int)m_resources.size())
+	{
+		return false;
+	}
+
+	// the whole buffer is written, a larger update does not fit
+	resource = &m_resources[buffer];
+	if (resource->type == RENDER_RESOURCE_NONE || resource->type == RENDER_RESOURCE_TEXTURE ||
+		resource->type == RENDER_RESOURCE_VERTEX_SHADER || resource->type == RENDER_RESOURCE_PIXEL_SHADER ||
+		size > resource->data.size())
+	{
+		return false;
+	}
+
+	memcpy(resource->data.data(), data, (size_t)size);
+
+	Log(RENDER_OPERATION_UPDATE_BUFFER, buffer, 0, size);
+	RenderStatsClass::CountMap(size);
+
+	return true;
+}
+
+void NullRenderDeviceClass::SetVertexBuffer(int buffer, unsigned int stride)
+{
+	Log(RENDER_OPERATION_SET_VERTEX_BUFFER, buffer, 0, stride);
+	RenderStatsClass::Add(RENDER_COUNTER_BUFFER_BINDS, 1);
+
+	return;
+}
+
+void NullRenderDeviceClass::SetIndexBuffer(int buffer)
+{
+	Log(RENDER_OPERATION_SET_INDEX_BUFFER, buffer, 0, 0);
+	RenderStatsClass::Add(RENDER_COUNTER_BUFFER_BINDS, 1);
+
+	return;
+}
+
+void NullRenderDeviceClass::SetConstantBuffer(RenderResourceType stage, int slot, int buffer)
+{
+	Log(RENDER_OPERATION_SET_CONSTANT_BUFFER, buffer, slot, stage);
+
+	return;
+}
+
+void NullRenderDeviceClass::SetTextures(int slot, const int* textures, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		Log(RENDER_OPERATION_SET_TEXTURE, textures[i], slot + i, 0);
+	}
+	RenderStatsClass::Add(RENDER_COUNTER_TEXTURE_BINDS, count);
+
+	return;
+}
+
+void NullRenderDeviceClass::SetShader(int shader)
+{
+	Log(RENDER_OPERATION_SET_SHADER, shader, 0, 0);
+
+	// the shader switches are counted by the vertex shader like the d3d shader classes do
+	if (IsValid(shader, RENDER_RESOURCE_VERTEX_SHADER))
+	{
+		RenderStatsClass::CountShader(&m_resources[shader]);
+	}
+
+	return;
+}
+
+void NullRenderDeviceClass::DrawIndexed(int indexCount)
+{
+	Log(RENDER_OPERATION_DRAW_INDEXED, -1, 0, indexCount);
+	RenderStatsClass::CountDraw(indexCount);
+
+	return;
+}
+
+void NullRenderDeviceClass::Clear(float red, float green, float blue, float alpha)
+{
+	Log(RENDER_OPERATION_CLEAR, -1, 0, 0);
+	RenderStatsClass::Add(RENDER_COUNTER_CLEARS, 2);
+
+	return;
+}
+
+void NullRenderDeviceClass::Present()
+{
+	Log(RENDER_OPERATION_PRESENT, -1, 0, 0);
+	RenderStatsClass::Add(RENDER_COUNTER_PRESENTS, 1);
+
+	// keep the commands of this frame and reuse the memory of the one before
+	m_lastCommands.swap(m_commands);
+	m_commands.clear();
+
+	return;
+}
+
+const std::vector<RenderCommandType>& NullRenderDeviceClass::GetCommandLog()
+{
+	return m_lastCommands;
+}
+
+unsigned long long NullRenderDeviceClass::GetResourceBytes()
+{
+	return m_resourceBytes;
+}
+
+int NullRenderDeviceClass::GetResourceCount()
+{
+	return m_resourceCount;
+}
+
+int NullRenderDeviceClass::CreateResource(RenderResourceType type, int width, int height, const void* data, unsigned long long size)
+{
+	int resource;
+
+	// reuse a released handle before growing the list
+	if (!m_freeResources.empty())
+	{
+		resource = m_freeResources.back();
+		m_freeResources.pop_back();
+	}
+	else
+	{
+		resource = (int)m_resources.size();
+		m_resources.push_back(ResourceType());
+	}
+
+	// keep a copy of the initial data, a dynamic buffer starts out zeroed
+	m_resources[resource].type = type;
+	m_resources[resource].width = width;
+	m_resources[resource].height = height;
+	if (data)
+	{
+		m_resources[resource].data.assign((const unsigned char*)data, (const unsigned char*)data + size);
+	}
+	else
+	{
+		m_resources[resource].data.assign((size_t)size, 0);
+	}
+
+	m_resourceBytes += size;
+	m_resourceCount++;
+	if (type != RENDER_RESOURCE_VERTEX_SHADER && type != RENDER_RESOURCE_PIXEL_SHADER)
+	{
+		RenderStatsClass::Add(RENDER_COUNTER_UPLOAD_BYTES, size);
+	}
+
+	return resource;
+}
+
+bool NullRenderDeviceClass::IsValid(int resource, RenderResourceType type)
+{
+	return resource >= 0 && resource < (int)m_resources.size() && m_resources[resource].type == type;
+}
+
+void NullRenderDeviceClass::Log(RenderOperationType operation, int resource, int slot, unsigned long long size)
+{
+	RenderCommandType command;
+
+	command.operation = operation;
+	command.resource = resource;
+	command.slot = slot;
+	command.size = size;
+	m_commands.push_back(command);
+
+	return;
+}
\ No newline at end of file
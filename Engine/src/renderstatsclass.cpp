@@ -0,0 +1,251 @@
+#include "renderstatsclass.h"
+
+RenderStatsClass::ThreadCountersType RenderStatsClass::s_threads[RENDER_STATS_MAX_THREADS];
+std::atomic<int> RenderStatsClass::s_threadCount(0);
+
+const char* RenderStatsClass::s_names[RENDER_STATS_MAX_COUNTERS] = {
+	"draws",
+	"triangles",
+	"maps",
+	"upload_bytes",
+	"shader_switches",
+	"texture_binds",
+	"buffer_binds",
+	"state_changes",
+	"clears",
+	"presents"
+};
+std::atomic<int> RenderStatsClass::s_counterCount(RENDER_COUNTER_BUILTIN_COUNT);
+
+unsigned long long RenderStatsClass::s_totals[RENDER_STATS_MAX_COUNTERS];
+unsigned long long RenderStatsClass::s_frames[RENDER_STATS_MAX_COUNTERS];
+unsigned long long RenderStatsClass::s_peaks[RENDER_STATS_MAX_COUNTERS];
+unsigned long long RenderStatsClass::s_frameCount = 0;
+
+// the counters of the calling thread, taken on its first count
+static thread_local void* t_counters = nullptr;
+static thread_local bool t_countersTaken = false;
+
+int RenderStatsClass::Register(const char* name)
+{
+	int index;
+
+	// registering a name twice hands out the same counter
+	index = Find(name);
+	if (index >= 0)
+	{
+		return index;
+	}
+
+	// counters are registered while the engine initializes, the name has to be a string literal
+	index = s_counterCount.load();
+	if (index >= RENDER_STATS_MAX_COUNTERS)
+	{
+		return -1;
+	}
+
+	s_names[index] = name;
+	s_counterCount.store(index + 1);
+
+	return index;
+}
+
+int RenderStatsClass::Find(const char* name)
+{
+	int counterCount;
+
+	counterCount = s_counterCount.load();
+	for (int i = 0; i < counterCount; i++)
+	{
+		if (strcmp(s_names[i], name) == 0)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+void RenderStatsClass::Add(int counter, unsigned long long amount)
+{
+	ThreadCountersType* counters;
+
+	if (!RENDER_STATS_ENABLED || counter < 0 || counter >= RENDER_STATS_MAX_COUNTERS)
+	{
+		return;
+	}
+
+	counters = GetThreadCounters();
+	if (!counters)
+	{
+		return;
+	}
+
+	// only this thread writes its counters, so a plain load and store is enough
+	counters->values[counter].store(counters->values[counter].load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+
+	return;
+}
+
+void RenderStatsClass::CountDraw(int indexCount)
+{
+	// every draw is an indexed triangle list
+	Add(RENDER_COUNTER_DRAWS, 1);
+	Add(RENDER_COUNTER_TRIANGLES, (unsigned long long)(indexCount / 3));
+
+	return;
+}
+
+void RenderStatsClass::CountMap(unsigned long long bytes)
+{
+	Add(RENDER_COUNTER_MAPS, 1);
+	Add(RENDER_COUNTER_UPLOAD_BYTES, bytes);
+
+	return;
+}
+
+void RenderStatsClass::CountShader(const void* shader)
+{
+	ThreadCountersType* counters;
+
+	if (!RENDER_STATS_ENABLED)
+	{
+		return;
+	}
+
+	// binding the shader that is already bound is not a switch
+	counters = GetThreadCounters();
+	if (!counters || counters->shader == shader)
+	{
+		return;
+	}
+
+	counters->shader = shader;
+	Add(RENDER_COUNTER_SHADER_SWITCHES, 1);
+
+	return;
+}
+
+void RenderStatsClass::EndFrame()
+{
+	unsigned long long sum;
+	int threadCount, counterCount;
+
+	// fold the accumulators of all the threads, the frame value is what was added since the last frame
+	threadCount = std::min(s_threadCount.load(), RENDER_STATS_MAX_THREADS);
+	counterCount = s_counterCount.load();
+	for (int i = 0; i < counterCount; i++)
+	{
+		sum = 0;
+		for (int j = 0; j < threadCount; j++)
+		{
+			sum += s_threads[j].values[i].load(std::memory_order_relaxed);
+		}
+
+		s_frames[i] = sum - s_totals[i];
+		s_peaks[i] = std::max(s_peaks[i], s_frames[i]);
+		s_totals[i] = sum;
+	}
+
+	s_frameCount++;
+
+	return;
+}
+
+int RenderStatsClass::GetCounterCount()
+{
+	return s_counterCount.load();
+}
+
+const char* RenderStatsClass::GetName(int counter)
+{
+	if (counter < 0 || counter >= s_counterCount.load())
+	{
+		return "";
+	}
+
+	return s_names[counter];
+}
+
+unsigned long long RenderStatsClass::GetFrameValue(int counter)
+{
+	if (counter < 0 || counter >= RENDER_STATS_MAX_COUNTERS)
+	{
+		return 0;
+	}
+
+	return s_frames[counter];
+}
+
+unsigned long long RenderStatsClass::GetPeakValue(int counter)
+{
+	if (counter < 0 || counter >= RENDER_STATS_MAX_COUNTERS)
+	{
+		return 0;
+	}
+
+	return s_peaks[counter];
+}
+
+unsigned long long RenderStatsClass::GetTotalValue(int counter)
+{
+	if (counter < 0 || counter >= RENDER_STATS_MAX_COUNTERS)
+	{
+		return 0;
+	}
+
+	return s_totals[counter];
+}
+
+unsigned long long RenderStatsClass::GetFrameCount()
+{
+	return s_frameCount;
+}
+
+bool RenderStatsClass::WriteJSON(const char* filename)
+{
+	std::ofstream fout;
+	int counterCount;
+
+	fout.open(filename, std::ios::out | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// the last frame, the worst frame, the whole run and the average of every counter
+	fout << "{\"frames\":" << s_frameCount << ",\"counters\":[" << std::endl;
+	fout.setf(std::ios::fixed);
+	fout.precision(2);
+
+	counterCount = s_counterCount.load();
+	for (int i = 0; i < counterCount; i++)
+	{
+		fout << (i > 0 ? ",\n" : "") << "{\"name\":\"" << s_names[i] << "\"";
+		fout << ",\"last\":" << s_frames[i] << ",\"peak\":" << s_peaks[i] << ",\"total\":" << s_totals[i];
+		fout << ",\"mean\":" << (s_frameCount ? (double)s_totals[i] / s_frameCount : 0.0) << "}";
+	}
+
+	fout << std::endl << "]}" << std::endl;
+	fout.close();
+
+	return !fout.fail();
+}
+
+RenderStatsClass::ThreadCountersType* RenderStatsClass::GetThreadCounters()
+{
+	int index;
+
+	if (!t_countersTaken)
+	{
+		// take the next free accumulators, threads beyond the maximum are not counted
+		t_countersTaken = true;
+		index = s_threadCount.fetch_add(1);
+		if (index < RENDER_STATS_MAX_THREADS)
+		{
+			t_counters = &s_threads[index];
+		}
+	}
+
+	return (ThreadCountersType*)t_counters;
+}
\ No newline at end of file
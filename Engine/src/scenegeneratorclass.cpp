@@ -0,0 +1,321 @@
+#include "scenegeneratorclass.h"
+
+// pre-processing directives
+#define SCENE_MAGIC 0x4E435354		// "TSCN"
+#define SCENE_VERSION 1
+
+void SceneGeneratorClass::GetDefaultSettings(SceneSettingsType& settings)
+{
+	// the scene the engine always showed, now with a fixed seed
+	settings.distribution = SCENE_UNIFORM;
+	settings.objectCount = SCENE_DEFAULT_OBJECTS;
+	settings.seed = SCENE_DEFAULT_SEED;
+	settings.filename.clear();
+
+	return;
+}
+
+bool SceneGeneratorClass::ParseSettings(const char* text, SceneSettingsType& settings)
+{
+	const char* separator;
+	char* end;
+	std::string name;
+	long long count;
+
+	GetDefaultSettings(settings);
+
+	// "distribution[:count[:seed]]", the count may end in k or m, anything else is a scene file
+	separator = strchr(text, ':');
+	name = separator ? std::string(text, separator - text) : std::string(text);
+
+	for (int i = 0; i < SCENE_DISTRIBUTION_COUNT; i++)
+	{
+		if (name == SCENE_DISTRIBUTION_NAMES[i])
+		{
+			settings.distribution = (SceneDistributionType)i;
+
+			if (separator)
+			{
+				count = strtoll(separator + 1, &end, 10);
+				if (*end == 'k' || *end == 'K')
+				{
+					count *= 1000;
+					end++;
+				}
+				else if (*end == 'm' || *end == 'M')
+				{
+					count *= 1000000;
+					end++;
+				}
+
+				if (end == separator + 1 || count < 1 || count > SCENE_MAX_OBJECTS || (*end != '\0' && *end != ':'))
+				{
+					return false;
+				}
+				settings.objectCount = (int)count;
+
+				if (*end == ':')
+				{
+					settings.seed = strtoull(end + 1, &end, 10);
+					if (*end != '\0')
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+	}
+
+	if (text[0] == '\0')
+	{
+		return false;
+	}
+
+	settings.filename = text;
+
+	return true;
+}
+
+std::string SceneGeneratorClass::GetName(const SceneSettingsType& settings)
+{
+	if (!settings.filename.empty())
+	{
+		return settings.filename;
+	}
+
+	return std::string(SCENE_DISTRIBUTION_NAMES[settings.distribution]) + ":" +
+		std::to_string(settings.objectCount) + ":" + std::to_string(settings.seed);
+}
+
+bool SceneGeneratorClass::Create(const SceneSettingsType& settings, std::vector<SceneObjectType>& objects)
+{
+	if (!settings.filename.empty())
+	{
+		return Load(settings.filename.c_str(), objects);
+	}
+
+	return Generate(settings.distribution, settings.objectCount, settings.seed, objects);
+}
+
+bool SceneGeneratorClass::Generate(SceneDistributionType distribution, int objectCount, unsigned long long seed,
+	std::vector<SceneObjectType>& objects)
+{
+	float extent;
+
+	if (objectCount < 1 || objectCount > SCENE_MAX_OBJECTS)
+	{
+		return false;
+	}
+
+	// every distribution draws from its own stream, so they differ for the same seed
+	RandomClass random(seed, (unsigned long long)distribution);
+
+	// bigger scenes grow the volume so the density stays that of the default scene
+	extent = SCENE_EXTENT * std::max(1.f, cbrtf((float)objectCount / SCENE_DEFAULT_OBJECTS));
+
+	objects.resize(objectCount);
+
+	switch (distribution)
+	{
+	case SCENE_UNIFORM:
+		GenerateUniform(random, extent, objects);
+		break;
+	case SCENE_CLUSTERED:
+		GenerateClustered(random, extent, objects);
+		break;
+	case SCENE_GRID:
+		GenerateGrid(random, objects);
+		break;
+	case SCENE_CITY:
+		GenerateCity(random, objects);
+		break;
+	default:
+		objects.clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool SceneGeneratorClass::Save(const char* filename, const std::vector<SceneObjectType>& objects)
+{
+	SceneHeaderType header;
+	std::ofstream fout;
+
+	fout.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (fout.fail())
+	{
+		return false;
+	}
+
+	// the header is followed by the objects as they are in memory
+	header.magic = SCENE_MAGIC;
+	header.version = SCENE_VERSION;
+	header.objectCount = (unsigned int)objects.size();
+	header.reserved = 0;
+
+	fout.write((const char*)&header, sizeof(header));
+	fout.write((const char*)objects.data(), (std::streamsize)(objects.size() * sizeof(SceneObjectType)));
+	fout.close();
+
+	return !fout.fail();
+}
+
+bool SceneGeneratorClass::Load(const char* filename, std::vector<SceneObjectType>& objects)
+{
+	SceneHeaderType header;
+	std::ifstream fin;
+
+	fin.open(filename, std::ios::in | std::ios::binary);
+	if (fin.fail())
+	{
+		return false;
+	}
+
+	fin.read((char*)&header, sizeof(header));
+	if (fin.gcount() != sizeof(header) || header.magic != SCENE_MAGIC || header.version != SCENE_VERSION ||
+		header.objectCount < 1 || header.objectCount > (unsigned int)SCENE_MAX_OBJECTS)
+	{
+		return false;
+	}
+
+	objects.resize(header.objectCount);
+	fin.read((char*)objects.data(), (std::streamsize)(objects.size() * sizeof(SceneObjectType)));
+	if (fin.gcount() != (std::streamsize)(objects.size() * sizeof(SceneObjectType)))
+	{
+		objects.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void SceneGeneratorClass::GetColor(const SceneObjectType& object, float& red, float& green, float& blue, float& alpha)
+{
+	red = (object.color & 0xFF) / 255.f;
+	green = ((object.color >> 8) & 0xFF) / 255.f;
+	blue = ((object.color >> 16) & 0xFF) / 255.f;
+	alpha = (object.color >> 24) / 255.f;
+
+	return;
+}
+
+void SceneGeneratorClass::GenerateUniform(RandomClass& random, float extent, std::vector<SceneObjectType>& objects)
+{
+	// in front of the camera like the scene the model list always generated
+	for (size_t i = 0; i < objects.size(); i++)
+	{
+		objects[i].positionX = random.NextRange(-extent, extent);
+		objects[i].positionY = random.NextRange(-extent, extent);
+		objects[i].positionZ = random.NextRange(-extent, extent) + 5.f;
+		objects[i].radius = random.NextRange(0.5f, 1.5f);
+		objects[i].color = RandomColor(random);
+	}
+
+	return;
+}
+
+void SceneGeneratorClass::GenerateClustered(RandomClass& random, float extent, std::vector<SceneObjectType>& objects)
+{
+	std::vector<float> centers;
+	int clusterCount, cluster;
+	float spread;
+
+	// place the cluster centers evenly, each cluster spreads over a small part of the volume
+	clusterCount = std::max(1, (int)(objects.size() / SCENE_CLUSTER_SIZE));
+	spread = extent / cbrtf((float)clusterCount) * 0.25f;
+
+	centers.resize(clusterCount * 3);
+	for (int i = 0; i < clusterCount * 3; i++)
+	{
+		centers[i] = random.NextRange(-extent, extent);
+	}
+
+	for (size_t i = 0; i < objects.size(); i++)
+	{
+		cluster = (int)random.NextInt((unsigned int)clusterCount);
+
+		objects[i].positionX = centers[cluster * 3 + 0] + random.NextGaussian() * spread;
+		objects[i].positionY = centers[cluster * 3 + 1] + random.NextGaussian() * spread;
+		objects[i].positionZ = centers[cluster * 3 + 2] + random.NextGaussian() * spread + 5.f;
+		objects[i].radius = random.NextRange(0.5f, 1.5f);
+		objects[i].color = RandomColor(random);
+	}
+
+	return;
+}
+
+void SceneGeneratorClass::GenerateGrid(RandomClass& random, std::vector<SceneObjectType>& objects)
+{
+	const float spacing = 4.f;
+	int side, x, y, z;
+	float offset;
+
+	// fill the smallest cube that holds all the objects, layer by layer
+	side = (int)ceilf(cbrtf((float)objects.size()));
+	while ((long long)side * side * side < (long long)objects.size())
+	{
+		side++;
+	}
+	offset = (side - 1) * spacing * 0.5f;
+
+	for (size_t i = 0; i < objects.size(); i++)
+	{
+		x = (int)(i % side);
+		y = (int)((i / side) % side);
+		z = (int)(i / ((size_t)side * side));
+
+		objects[i].positionX = x * spacing - offset;
+		objects[i].positionY = y * spacing - offset;
+		objects[i].positionZ = z * spacing + 5.f;
+		objects[i].radius = 1.f;
+		objects[i].color = RandomColor(random);
+	}
+
+	return;
+}
+
+void SceneGeneratorClass::GenerateCity(RandomClass& random, std::vector<SceneObjectType>& objects)
+{
+	const float lotSize = 4.f, streetWidth = 8.f, floorHeight = 2.f, ground = -5.f;
+	int lotsPerSide, lot, lotX, lotZ, floors;
+	float originX, originZ, blockSize;
+	unsigned int color;
+	size_t index;
+
+	// enough lots in a square for the towers of average height to hold all the objects
+	lotsPerSide = (int)ceilf(sqrtf(objects.size() / (SCENE_CITY_MAX_FLOORS * 0.5f)));
+	lotsPerSide = std::max(1, lotsPerSide);
+	blockSize = SCENE_CITY_BLOCK_LOTS * lotSize + streetWidth;
+	originX = -(lotsPerSide / SCENE_CITY_BLOCK_LOTS + 1) * blockSize * 0.5f;
+	originZ = 5.f;
+
+	// raise a tower of random height on every lot until the objects run out
+	index = 0;
+	for (lot = 0; index < objects.size(); lot++)
+	{
+		lotX = lot % lotsPerSide;
+		lotZ = lot / lotsPerSide;
+		floors = 1 + (int)random.NextInt(SCENE_CITY_MAX_FLOORS);
+		color = RandomColor(random);
+
+		for (int floor = 0; floor < floors && index < objects.size(); floor++, index++)
+		{
+			objects[index].positionX = originX + (lotX / SCENE_CITY_BLOCK_LOTS) * blockSize + (lotX % SCENE_CITY_BLOCK_LOTS) * lotSize;
+			objects[index].positionY = ground + floor * floorHeight;
+			objects[index].positionZ = originZ + (lotZ / SCENE_CITY_BLOCK_LOTS) * blockSize + (lotZ % SCENE_CITY_BLOCK_LOTS) * lotSize;
+			objects[index].radius = 1.f;
+			objects[index].color = color;
+		}
+	}
+
+	return;
+}
+
+unsigned int SceneGeneratorClass::RandomColor(RandomClass& random)
+{
+	// opaque with random red, green and blue
+	return (random.Next() & 0x00FFFFFF) | 0xFF000000;
+}
\ No newline at end of file
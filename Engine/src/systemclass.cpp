@@ -3,7 +3,11 @@
 SystemClass::SystemClass()
 	: m_Input(nullptr), m_Graphics(nullptr), 
 	  m_Fps(nullptr), m_Cpu(nullptr), 
-	  m_Timer(nullptr), m_Position(nullptr)
+	  m_Timer(nullptr), m_Position(nullptr), m_Platform(nullptr), m_Loop(nullptr), m_Models(nullptr), m_InputQueue(nullptr),
+	  m_Limiter(nullptr), m_inputLatencyCounter(-1),
+	  m_FrameStats(nullptr), m_RecentFrameStats(nullptr), m_recentTime(0.f), m_hudPage(HUD_PAGE_RENDER),
+	  m_Flythrough(nullptr), m_flythroughMode(FLYTHROUGH_OFF),
+	  m_Pipeline(nullptr), m_quit(false), m_failed(false)
 {
 }
 
@@ -15,11 +19,22 @@ SystemClass::~SystemClass()
 {
 }
 
-bool SystemClass::Initialize()
+bool SystemClass::Initialize(FlythroughModeType flythroughMode, const char* flythroughFilename, bool pipelined)
 {
+	SceneSettingsType sceneSettings;
 	int screenWidth, screenHeight;
 	bool result;
 
+	// calibrate the profiler clock before the first zone
+	ProfilerClass::Initialize();
+
+	// start the workers of the job system, one thread per core
+	result = JobSystemClass::Initialize(0);
+	if (!result)
+	{
+		return false;
+	}
+
 	// initialize the width and height of the screen to zero before sending the variables into the function
 	screenWidth = 0;
 	screenHeight = 0;
@@ -27,19 +42,44 @@ bool SystemClass::Initialize()
 	// initialize the windows api
 	InitializeWindows(screenWidth, screenHeight);
 
-	//create the input object. This obj will be used to handle reading the keyboard input from the user
-	m_Input = new InputClass();
-	if (!m_Input)
+	// create the flythrough object, a played back path replaces the input object
+	m_flythroughMode = flythroughMode;
+	m_flythroughFilename = flythroughFilename ? flythroughFilename : FLYTHROUGH_FILENAME;
+
+	m_Flythrough = new FlythroughClass;
+	if (!m_Flythrough)
 	{
 		return false;
 	}
 
-	// Initialize the input object
-	result = m_Input->Initialize(m_hinstance, m_hwnd, screenWidth, screenHeight);
-	if (FAILED(result))
+	if (m_flythroughMode == FLYTHROUGH_PLAYBACK)
 	{
-		MessageBox(m_hwnd, L"Could not initialize the input object.", L"Error", MB_OK);
-		return false;
+		result = m_Flythrough->Load(m_flythroughFilename.c_str());
+		if (!result)
+		{
+			MessageBox(m_hwnd, L"Could not load the flythrough.", L"Error", MB_OK);
+			return false;
+		}
+		m_Flythrough->BeginPlayback();
+	}
+	else
+	{
+		m_Flythrough->BeginRecording();
+
+		//create the input object. This obj will be used to handle reading the keyboard input from the user
+		m_Input = new InputClass();
+		if (!m_Input)
+		{
+			return false;
+		}
+
+		// Initialize the input object
+		result = m_Input->Initialize(m_hinstance, m_hwnd, screenWidth, screenHeight);
+		if (FAILED(result))
+		{
+			MessageBox(m_hwnd, L"Could not initialize the input object.", L"Error", MB_OK);
+			return false;
+		}
 	}
 
 	// create the graphics object. this obj will handle rendering al the graphics for this application
@@ -56,6 +96,21 @@ bool SystemClass::Initialize()
 		return false;
 	}
 
+	// create the models the simulation moves, the same scene the graphics object shows
+	m_Models = MemoryClass::New<ModelListClass>(MEMORY_TAG_SCENE);
+	if (!m_Models)
+	{
+		return false;
+	}
+
+	SceneGeneratorClass::GetDefaultSettings(sceneSettings);
+	result = m_Models->Initialize(sceneSettings);
+	if (!result)
+	{
+		MessageBox(m_hwnd, L"Could not initialize the models of the simulation.", L"Error", MB_OK);
+		return false;
+	}
+
 	//create the fps object
 	m_Fps = new FpsClass;
 	if (!m_Fps)
@@ -95,11 +150,143 @@ bool SystemClass::Initialize()
 		return false;
 	}
 
+	// place the camera where it starts, so the first frames have two steps to interpolate between
+	m_Position->Frame();
+	m_previousPosition = m_Position->GetPosition();
+	m_previousDirection = m_Position->GetDirection();
+	m_previousUp = m_Position->GetUp();
+
+	// create the platform object, it hands the windows messages and the clock to the frame loop
+	m_Platform = new Win32PlatformClass;
+	if (!m_Platform)
+	{
+		return false;
+	}
+
+	result = m_Platform->Initialize();
+	if (!result)
+	{
+		MessageBox(m_hwnd, L"Could not initialize the Platform object.", L"Error", MB_OK);
+		return false;
+	}
+
+	// create the frame loop object, the camera moves at its fixed rate
+	m_Loop = new FrameLoopClass;
+	if (!m_Loop)
+	{
+		return false;
+	}
+
+	result = m_Loop->Initialize(m_Platform);
+	if (!result)
+	{
+		return false;
+	}
+
+	// create the input queue, the input object fills it once the run starts
+	m_InputQueue = new InputQueueClass;
+	if (!m_InputQueue)
+	{
+		return false;
+	}
+
+	// create the frame limiter, vsync paces the frames if it is on. it runs on the thread that
+	//  samples the input, which is the simulation thread unless the pipeline is in the latency mode
+	m_Limiter = new FrameLimiterClass;
+	if (!m_Limiter)
+	{
+		return false;
+	}
+
+	result = m_Limiter->Initialize(m_Platform, VSYNC_ENABLED ? 0.0 : FRAME_LIMITER_FPS, FRAME_LIMITER_LATENCY_MS);
+	if (!result)
+	{
+		return false;
+	}
+	m_inputLatencyCounter = RenderStatsClass::Register("input_latency_us");
+
+	// create the frame statistics, one for the whole run and one for the hud
+	m_FrameStats = new FrameStatsClass;
+	if (!m_FrameStats)
+	{
+		return false;
+	}
+	m_FrameStats->Initialize(FRAME_BUDGET_MS);
+
+	m_RecentFrameStats = new FrameStatsClass;
+	if (!m_RecentFrameStats)
+	{
+		return false;
+	}
+	m_RecentFrameStats->Initialize(FRAME_BUDGET_MS);
+
+	// create the frame pipeline, in the latency mode every frame is rendered before the next is simulated
+	m_Pipeline = new FramePipelineClass;
+	if (!m_Pipeline)
+	{
+		return false;
+	}
+
+	result = m_Pipeline->Initialize(pipelined);
+	if (!result)
+	{
+		return false;
+	}
+
 	return true;
 }
 
 void SystemClass::Shutdown()
 {
+	// stop the simulation thread if it still runs
+	m_quit = true;
+	if (m_Pipeline)
+	{
+		m_Pipeline->Stop();
+	}
+	if (m_simulationThread.joinable())
+	{
+		m_simulationThread.join();
+	}
+
+	// release the frame pipeline
+	if (m_Pipeline)
+	{
+		m_Pipeline->Shutdown();
+		delete m_Pipeline;
+		m_Pipeline = nullptr;
+	}
+
+	// write out the frame statistics of the whole run
+	if (m_FrameStats)
+	{
+		WriteFrameStats();
+		delete m_FrameStats;
+		m_FrameStats = nullptr;
+	}
+
+	if (m_RecentFrameStats)
+	{
+		delete m_RecentFrameStats;
+		m_RecentFrameStats = nullptr;
+	}
+
+	// write out the recorded path or the frame times of the played one
+	if (m_Flythrough)
+	{
+		if (m_flythroughMode == FLYTHROUGH_RECORD)
+		{
+			m_Flythrough->Save(m_flythroughFilename.c_str());
+		}
+		else if (m_flythroughMode == FLYTHROUGH_PLAYBACK)
+		{
+			m_Flythrough->WriteLog(FLYTHROUGH_LOG_FILENAME);
+		}
+
+		delete m_Flythrough;
+		m_Flythrough = nullptr;
+	}
+
 	// release the position object
 	if (m_Position)
 	{
@@ -107,6 +294,33 @@ void SystemClass::Shutdown()
 		m_Position = nullptr;
 	}
 
+	// release the input queue, the input object stopped filling it
+	if (m_InputQueue)
+	{
+		delete m_InputQueue;
+		m_InputQueue = nullptr;
+	}
+
+	// release the frame limiter, the frame loop and the platform object
+	if (m_Limiter)
+	{
+		delete m_Limiter;
+		m_Limiter = nullptr;
+	}
+
+	if (m_Loop)
+	{
+		delete m_Loop;
+		m_Loop = nullptr;
+	}
+
+	if (m_Platform)
+	{
+		m_Platform->Shutdown();
+		delete m_Platform;
+		m_Platform = nullptr;
+	}
+
 	// release the timer object
 	if (m_Timer)
 	{
@@ -128,6 +342,14 @@ void SystemClass::Shutdown()
 		m_Fps = nullptr;
 	}
 
+	// release the models of the simulation
+	if (m_Models)
+	{
+		m_Models->Shutdown();
+		MemoryClass::Delete(m_Models);
+		m_Models = nullptr;
+	}
+
 	// Release the graphics object
 	if (m_Graphics)
 	{
@@ -147,30 +369,71 @@ void SystemClass::Shutdown()
 	// shutdown the window
 	ShutdownWindows();
 
+	// stop the workers of the job system
+	JobSystemClass::Shutdown();
+
+	// everything that was tracked has to be released by now
+	{
+		char leakReport[1024];
+
+		if (MemoryClass::GetLeakReport(leakReport, sizeof(leakReport)) > 0)
+		{
+			OutputDebugStringA(leakReport);
+		}
+	}
+
+	// write out the render counters of the whole run
+	if (RENDER_STATS_ENABLED)
+	{
+		RenderStatsClass::WriteJSON(RENDER_STATS_FILENAME);
+	}
+
+	// export the last frames the profiler recorded
+	if (PROFILER_ENABLED)
+	{
+		ProfilerClass::WriteTrace(PROFILER_TRACE_FILENAME);
+		ProfilerClass::Shutdown();
+	}
+
 	return;
 }
 
 void SystemClass::Run()
 {
-	MSG msg;
 	bool done, result;
 
-	// initialize the msg structure
-	ZeroMemory(&msg, sizeof(MSG));
+	// read the devices on their own thread, the first step takes what they reported since now
+	m_InputQueue->Initialize(m_Loop->GetSimulatedTime());
+	if (m_Input && !m_Input->Start(m_InputQueue, m_Platform))
+	{
+		MessageBox(m_hwnd, L"Could not start reading the input.", L"Error", MB_OK);
+		return;
+	}
+
+	// the simulation runs a frame ahead on its own thread, in the latency mode it runs on this one
+	m_quit = false;
+	m_failed = false;
+	if (m_Pipeline->IsPipelined())
+	{
+		m_simulationThread = std::thread(&SystemClass::SimulationMain, this);
+	}
 
 	// Loop until there is a quit message from the window or the user
 	done = false;
 	while (!done)
 	{
-		// Handle the windows messages
-		if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+		// wait for the latest moment the input can be sampled and the frame still be on time, the
+		//  simulation thread does so itself when it runs ahead
+		if (!m_Pipeline->IsPipelined())
 		{
-			TranslateMessage(&msg);		// translating like keyboard's virtual key to char
-			DispatchMessage(&msg);		// sends message to our procedure WndProcd
+			m_Limiter->BeginFrame();
 		}
 
+		// handle all the windows messages that queued up, not just one of them
+		m_Loop->PumpEvents(nullptr, nullptr);
+
 		// if windows signals to end the application then exit out
-		if (msg.message == WM_QUIT)
+		if (m_Loop->IsQuit())
 		{
 			done = true;
 		}
@@ -180,69 +443,197 @@ void SystemClass::Run()
 			result = Frame();
 			if (!result)
 			{
-				MessageBox(m_hwnd, L"Frame Processing Failed", L"Error", MB_OK);
-				done = true;
+				m_failed = true;
+			}
+
+			// the frame is submitted, count how old the input it shows is
+			if (!m_Pipeline->IsPipelined())
+			{
+				m_Limiter->EndFrame();
+				RenderStatsClass::Add(m_inputLatencyCounter, (unsigned long long)(m_Limiter->GetLatency() * 1000.0));
+			}
+			else
+			{
+				RenderStatsClass::Add(m_inputLatencyCounter, (unsigned long long)(m_Pipeline->GetLatency() * 1000.0));
 			}
 		}
 
-		// check if the user pressed escape and wants to quit
-		if (m_Input->IsEscapePressed() == true)
+		// the simulation ends the run on escape, at the end of a played back path or if it failed
+		if (m_quit || m_failed)
 		{
 			done = true;
 		}
 	}
 
+	// stop the simulation thread and then the input thread that feeds it
+	m_quit = true;
+	m_Pipeline->Stop();
+	if (m_simulationThread.joinable())
+	{
+		m_simulationThread.join();
+	}
+
+	if (m_Input)
+	{
+		m_Input->Stop();
+	}
+
+	if (m_failed)
+	{
+		MessageBox(m_hwnd, L"Frame Processing Failed", L"Error", MB_OK);
+	}
+
 	return;
 }
 
 bool SystemClass::Frame()
 {
+	ProfileZoneClass zone("SystemClass::Frame");
+	FrameStateType* state;
+	bool result;
+
+	// without pipelining the frame is simulated right before it is rendered
+	if (!m_Pipeline->IsPipelined())
+	{
+		result = Simulate();
+		if (!result)
+		{
+			return false;
+		}
+	}
+
+	// render the oldest frame the simulation finished, there is none once the pipeline stopped
+	state = m_Pipeline->BeginRender();
+	if (!state)
+	{
+		return true;
+	}
+
+	result = Render(state);
+	m_Pipeline->EndRender();
+
+	return result;
+}
+
+bool SystemClass::Simulate()
+{
+	ProfileZoneClass zone("SystemClass::Simulate");
+	FrameStateType* state;
+	float stepTime, alpha;
+	int steps;
 	bool result;
-	int mouseX, mouseY;
-	unsigned char* key = nullptr;
+
+	// write into a state the renderer is done with
+	state = m_Pipeline->BeginSimulation();
+	if (!state)
+	{
+		return true;
+	}
 
 	// update the system stats
 	m_Timer->Frame();
 	m_Fps->Frame();
 	m_Cpu->Frame();
 
-	// do the input frame processing
-	result = m_Input->Frame();
-	if (!result)
+	// record the frame time in the histograms
+	m_FrameStats->Record(m_Timer->GetTime());
+	m_RecentFrameStats->Record(m_Timer->GetTime());
+
+	// the played back path sets the camera at fixed time steps, the input object is not there
+	if (m_flythroughMode == FLYTHROUGH_PLAYBACK)
 	{
-		return false;
+		m_Flythrough->LogFrame(m_Timer->GetTime());
+		if (!m_Flythrough->Play(state->position, state->direction, state->up))
+		{
+			// a played back path ends the run at its end
+			m_quit = true;
+			m_Pipeline->Stop();
+			return true;
+		}
+
+		// every played frame is one step of the path
+		steps = 1;
+		stepTime = FLYTHROUGH_STEP_MS;
+		alpha = 1.f;
+	}
+	else
+	{
+		// the camera and the models move in as many fixed steps as the time since the last frame holds
+		steps = m_Loop->Advance();
+		stepTime = (float)m_Loop->GetStepTime();
+		alpha = m_Loop->GetAlpha();
+
+		result = ProcessInput(steps, state->position, state->direction, state->up);
+		if (!result)
+		{
+			return false;
+		}
+
+		// check if the user pressed escape and wants to quit
+		if (m_InputQueue->IsKeyDown(INPUT_KEY_ESCAPE))
+		{
+			m_quit = true;
+			m_Pipeline->Stop();
+			return true;
+		}
 	}
 
-	// get the location of the mouse from the input object
-	m_Input->GetMouseLocation(mouseX, mouseY);
+	// move the models that have a velocity in the same steps, the renderer gets them in between
+	MoveModels(steps, stepTime, alpha, state->moves);
+
+	// show the percentiles of the last second and start over
+	m_recentTime += m_Timer->GetTime();
+	if (m_recentTime >= 1000.f)
+	{
+		state->frameStats = *m_RecentFrameStats;
+		state->hasFrameStats = true;
+
+		m_RecentFrameStats->Reset();
+		m_recentTime = 0.f;
+	}
 
-	// get the key pressed from the input object
-	m_Input->GetKeyPressed(&key);
+	state->fps = m_Fps->GetFps();
+	state->cpu = m_Cpu->GetCpuPercentage();
+	state->frameTime = m_Timer->GetTime();
+	state->hudPage = m_hudPage;
 
-	// set the frame time for calculating the updated position
-	m_Position->SetFrameTime(m_Timer->GetTime());
+	// hand the frame to the renderer
+	m_Pipeline->EndSimulation();
 
-	// update viewing angle by passing the mouse position
-	m_Position->SetMousePosition(mouseX, mouseY);
+	return true;
+}
 
-	// update position by passing the keyboard input
-	m_Position->SetKeyboard(key);
+bool SystemClass::Render(FrameStateType* state)
+{
+	ProfileZoneClass zone("SystemClass::Render");
+	bool result;
 
-	// do the position update
-	result = m_Position->Frame();
-	if (!result)
+	if (state->hasFrameStats)
 	{
-		return false;
+		result = m_Graphics->SetFrameStats(&state->frameStats);
+		if (!result)
+		{
+			return false;
+		}
+	}
+
+	// show the hud page the simulation picked
+	m_Graphics->SetHudPage(state->hudPage);
+
+	// move the models the simulation moved before they are culled
+	for (size_t i = 0; i < state->moves.size(); i++)
+	{
+		m_Graphics->MoveModel(state->moves[i].index, state->moves[i].position);
 	}
 
 	// do the frame processing for the graphics obj
 	result = m_Graphics->Frame(
-		m_Fps->GetFps(),
-		m_Cpu->GetCpuPercentage(),
-		m_Timer->GetTime(),
-		m_Position->GetPosition(), 
-		m_Position->GetDirection(), 
-		m_Position->GetUp()
+		state->fps,
+		state->cpu,
+		state->frameTime,
+		state->position,
+		state->direction,
+		state->up
 	);
 	if (!result)
 	{
@@ -259,6 +650,138 @@ bool SystemClass::Frame()
 	return true;
 }
 
+void SystemClass::SimulationMain()
+{
+	// simulate frames until the run ends, the renderer takes them as they are done. the limiter
+	//  holds every frame back until the latest moment its input can be sampled, so the thread
+	//  sleeps instead of simulating frames the display never shows
+	while (!m_quit)
+	{
+		m_Limiter->BeginFrame();
+
+		if (!Simulate())
+		{
+			m_failed = true;
+			m_quit = true;
+		}
+
+		m_Limiter->EndFrame();
+	}
+
+	// release the renderer if it waits for a frame
+	m_Pipeline->Stop();
+
+	return;
+}
+
+bool SystemClass::ProcessInput(int steps, XMFLOAT3& position, XMFLOAT3& direction, XMFLOAT3& up)
+{
+	bool result;
+	int mouseX, mouseY;
+	float alpha;
+
+	// move the camera in the fixed steps of the frame
+	for (int i = 0; i < steps; i++)
+	{
+		m_previousPosition = m_Position->GetPosition();
+		m_previousDirection = m_Position->GetDirection();
+		m_previousUp = m_Position->GetUp();
+
+		// take the input that happened up to the end of the step
+		m_InputQueue->Consume(m_Loop->GetSimulatedTime() - (steps - 1 - i) * m_Loop->GetStepTime());
+
+		// write out the frame statistics when F2 goes down
+		if (m_InputQueue->WasKeyPressed(INPUT_KEY_F2))
+		{
+			WriteFrameStats();
+		}
+
+		// show the next page on the hud when F3 goes down
+		if (m_InputQueue->WasKeyPressed(INPUT_KEY_F3))
+		{
+			m_hudPage = (m_hudPage + 1) % HUD_PAGE_COUNT;
+		}
+
+		// turn the camera by the mouse movement and move it for as long as the keys were down
+		m_InputQueue->GetMouseMovement(mouseX, mouseY);
+		m_Position->SetMousePosition(mouseX, mouseY);
+		m_Position->SetKeyTimes(m_InputQueue->GetKeyTimes());
+
+		result = m_Position->Frame();
+		if (!result)
+		{
+			return false;
+		}
+	}
+
+	// render the camera between the last two steps
+	alpha = m_Loop->GetAlpha();
+	position = FrameLoopClass::Interpolate(m_previousPosition, m_Position->GetPosition(), alpha);
+	direction = FrameLoopClass::InterpolateDirection(m_previousDirection, m_Position->GetDirection(), alpha);
+	up = FrameLoopClass::InterpolateDirection(m_previousUp, m_Position->GetUp(), alpha);
+
+	// stamp the camera of this frame onto the recorded path
+	if (m_flythroughMode == FLYTHROUGH_RECORD)
+	{
+		m_Flythrough->Record(m_Timer->GetTime(), position, direction, up);
+	}
+
+	return true;
+}
+
+void SystemClass::MoveModels(int steps, float stepTime, float alpha, std::vector<ModelMoveType>& moves)
+{
+	const unsigned int mask = (1u << COMPONENT_POSITION) | (1u << COMPONENT_VELOCITY) | (1u << COMPONENT_MODEL);
+	PositionComponentType* positions;
+	VelocityComponentType* velocities;
+	ModelComponentType* models;
+	ModelMoveType move;
+	XMFLOAT3 previous, current;
+	float seconds;
+
+	// the step time is in milliseconds
+	seconds = stepTime / 1000.f;
+	for (int i = 0; i < steps; i++)
+	{
+		m_Models->Update(seconds);
+	}
+
+	// the renderer gets every moving model below, not just the ones of the steps
+	m_Models->TakeMovedModels(m_movedModels);
+
+	// render the models between their last two steps like the camera, a model moved by its
+	//  velocity in the last one. without a step this frame they still move on with the alpha
+	m_Models->GetEntities()->Query(mask, m_modelChunks);
+	for (size_t chunk = 0; chunk < m_modelChunks.size(); chunk++)
+	{
+		positions = m_modelChunks[chunk].Get<PositionComponentType>();
+		velocities = m_modelChunks[chunk].Get<VelocityComponentType>();
+		models = m_modelChunks[chunk].Get<ModelComponentType>();
+
+		for (int i = 0; i < m_modelChunks[chunk].count; i++)
+		{
+			current = XMFLOAT3(positions[i].x, positions[i].y, positions[i].z);
+			previous = XMFLOAT3(current.x - velocities[i].x * seconds, current.y - velocities[i].y * seconds,
+				current.z - velocities[i].z * seconds);
+
+			move.index = models[i].index;
+			move.position = FrameLoopClass::Interpolate(previous, current, alpha);
+			moves.push_back(move);
+		}
+	}
+
+	return;
+}
+
+void SystemClass::WriteFrameStats()
+{
+	// the summary and the histogram go to json, the summary alone to csv
+	m_FrameStats->WriteJSON(FRAME_STATS_JSON_FILENAME);
+	m_FrameStats->WriteCSV(FRAME_STATS_CSV_FILENAME);
+
+	return;
+}
+
 LRESULT CALLBACK SystemClass::MessageHandler(HWND hwnd, UINT umsg, WPARAM wparam, LPARAM lparam)
 {
 	return DefWindowProc(hwnd, umsg, wparam, lparam);
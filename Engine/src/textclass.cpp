@@ -5,13 +5,14 @@
 #include <dinput.h>
 
 TextClass::TextClass()
-	: m_Font(nullptr), m_FontShader(nullptr),
-	  m_sentence1(nullptr), m_sentence2(nullptr), m_sentence3(nullptr)
+	: m_Font(nullptr), m_FontShader(nullptr), m_SentencePool(nullptr),
+	  m_sentence1(nullptr), m_sentence2(nullptr), m_sentence3(nullptr), m_sentence4(nullptr),
+	  m_sentence5(nullptr)
 {
 }
 
 bool TextClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext,
-	HWND hwnd, int screenWidth, int screenHeight, XMMATRIX baseViewMatrix)
+	PackFileClass* pack, AssetCacheClass* cache, HWND hwnd, int screenWidth, int screenHeight, XMMATRIX baseViewMatrix)
 {
 	bool result;
 
@@ -23,14 +24,14 @@ bool TextClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceCont
 	m_baseViewMatrix = baseViewMatrix;
 
 	// create the font object
-	m_Font = new FontClass;
+	m_Font = MemoryClass::New<FontClass>(MEMORY_TAG_TEXT);
 	if (!m_Font)
 	{
 		return false;
 	}
 
 	// initialize the font object
-	result = m_Font->Initialize(device, deviceContext, "./data/fontdata.txt", "./data/font_conv.dds");
+	result = m_Font->Initialize(device, deviceContext, pack, cache, "./data/fontdata.txt", "./data/font_conv.dds");
 	if (!result)
 	{
 		MessageBox(hwnd, L"Could not initialize the font object.", L"Error", MB_OK);
@@ -38,20 +39,33 @@ bool TextClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceCont
 	}
 
 	// create the font shader object
-	m_FontShader = new FontShaderClass;
+	m_FontShader = MemoryClass::New<FontShaderClass>(MEMORY_TAG_TEXT);
 	if (!m_FontShader)
 	{
 		return false;
 	}
 
 	// initialize the font shader object
-	result = m_FontShader->Initialize(device, hwnd);
+	result = m_FontShader->Initialize(device, hwnd, pack);
 	if (!result)
 	{
 		MessageBox(hwnd, L"Could not initialize the font shader object.", L"Error", MB_OK);
 		return false;
 	}
 
+	// create the pool the sentences come from
+	m_SentencePool = MemoryClass::New<MemoryPoolClass>(MEMORY_TAG_TEXT);
+	if (!m_SentencePool)
+	{
+		return false;
+	}
+
+	result = m_SentencePool->Initialize(sizeof(SentenceType), MEMORY_TAG_TEXT, TEXT_SENTENCE_COUNT);
+	if (!result)
+	{
+		return false;
+	}
+
 	// initialize the first sentence
 	result = InitializeSentence(&m_sentence1, 16, device);
 	if (!result)
@@ -94,6 +108,32 @@ bool TextClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceCont
 		return false;
 	}
 
+	// initialize the fourth sentence, long enough for the frame time percentiles
+	result = InitializeSentence(&m_sentence4, 64, device);
+	if (!result)
+	{
+		return false;
+	}
+
+	result = UpdateSentence(m_sentence4, "", 20, 80, 1.f, 1.f, 1.f, deviceContext);
+	if (!result)
+	{
+		return false;
+	}
+
+	// initialize the fifth sentence for the render counters
+	result = InitializeSentence(&m_sentence5, 64, device);
+	if (!result)
+	{
+		return false;
+	}
+
+	result = UpdateSentence(m_sentence5, "", 20, 100, 1.f, 1.f, 1.f, deviceContext);
+	if (!result)
+	{
+		return false;
+	}
+
 	return true;
 }
 
@@ -103,12 +143,22 @@ void TextClass::Shutdown()
 	ReleaseSentence(&m_sentence1);
 	ReleaseSentence(&m_sentence2);
 	ReleaseSentence(&m_sentence3);
+	ReleaseSentence(&m_sentence4);
+	ReleaseSentence(&m_sentence5);
+
+	// release the sentence pool
+	if (m_SentencePool)
+	{
+		m_SentencePool->Shutdown();
+		MemoryClass::Delete(m_SentencePool);
+		m_SentencePool = nullptr;
+	}
 
 	// release the font shader object
 	if (m_FontShader)
 	{
 		m_FontShader->Shutdown();
-		delete m_FontShader;
+		MemoryClass::Delete(m_FontShader);
 		m_FontShader = nullptr;
 	}
 
@@ -116,7 +166,7 @@ void TextClass::Shutdown()
 	if (m_Font)
 	{
 		m_Font->Shutdown();
-		delete m_Font;
+		MemoryClass::Delete(m_Font);
 		m_Font = nullptr;
 	}
 
@@ -148,6 +198,20 @@ bool TextClass::Render(ID3D11DeviceContext* deviceContext, XMMATRIX worldMatrix,
 		return false;
 	}
 
+	// draw the fourth sentence
+	result = RenderSentence(deviceContext, m_sentence4, worldMatrix, orthoMatrix);
+	if (!result)
+	{
+		return false;
+	}
+
+	// draw the fifth sentence
+	result = RenderSentence(deviceContext, m_sentence5, worldMatrix, orthoMatrix);
+	if (!result)
+	{
+		return false;
+	}
+
 	return true;
 }
 
@@ -160,7 +224,7 @@ bool TextClass::InitializeSentence(SentenceType** sentence, int maxLength, ID3D1
 	HRESULT result;
 
 	// create a new sentence object
-	*sentence = new SentenceType;
+	*sentence = m_SentencePool->New<SentenceType>();
 	if (!*sentence)
 	{
 		return false;
@@ -286,16 +350,13 @@ bool TextClass::UpdateSentence(SentenceType* sentence, char* text,
 		return false;
 	}
 
-	// create the vertex array
-	vertices = new VertexType[sentence->vertexCount];
+	// take the vertex array from the frame arena, it starts out as zeros
+	vertices = FrameArenaClass::Allocate<VertexType>(sentence->vertexCount);
 	if (!vertices)
 	{
 		return false;
 	}
 
-	// initialize vertex array to zeros at first
-	memset(vertices, 0, (sizeof(VertexType) * sentence->vertexCount));
-
 	// calculate the X and Y pixel position on the screen to start drawing to
 	drawX = (float)(((m_screenWidth / 2) * -1) + positionX);
 	drawY = (float)((m_screenHeight / 2) - positionY);
@@ -327,10 +388,7 @@ bool TextClass::UpdateSentence(SentenceType* sentence, char* text,
 		sentence->vertexBuffer, 
 		0
 		);
-
-	// release the vertex array
-	delete[] vertices;
-	vertices = nullptr;
+	RenderStatsClass::CountMap(sizeof(VertexType) * sentence->vertexCount);
 
 	return true;
 }
@@ -354,7 +412,7 @@ void TextClass::ReleaseSentence(SentenceType** sentence)
 		}
 
 		// release the sentence
-		delete *sentence;
+		m_SentencePool->Delete(*sentence);
 		*sentence = nullptr;
 	}
 
@@ -386,6 +444,7 @@ bool TextClass::RenderSentence(ID3D11DeviceContext* deviceContext, SentenceType*
 		DXGI_FORMAT_R32_UINT,
 		0
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_BUFFER_BINDS, 2);
 
 	// set the type of primitive that should be rendered
 	deviceContext->IASetPrimitiveTopology(
@@ -654,5 +713,89 @@ bool TextClass::SetCpu(int cpu, ID3D11DeviceContext* deviceContext)
 		return false;
 	}
 
+	return true;
+}
+
+bool TextClass::SetFrameStats(float p50, float p90, float p99, float p999, float max, unsigned long long overBudget,
+	ID3D11DeviceContext* deviceContext)
+{
+	char statsString[64];
+	float red, green, blue;
+	bool result;
+
+	// setup the frame time string in milliseconds
+	sprintf_s(statsString, "p50 %.1f p90 %.1f p99 %.1f p99.9 %.1f max %.1f", p50, p90, p99, p999, max);
+
+	// white if every frame was within the budget, yellow if only the tail missed it, red otherwise
+	red = 1.f;
+	green = 1.f;
+	blue = 1.f;
+	if (overBudget > 0)
+	{
+		blue = 0.f;
+	}
+	if (p90 > FRAME_BUDGET_MS)
+	{
+		green = 0.f;
+	}
+
+	// update the sentence vertex buffer with the new string information
+	result = UpdateSentence(m_sentence4, statsString, 20, 80, red, green, blue, deviceContext);
+	if (!result)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool TextClass::SetRenderStats(ID3D11DeviceContext* deviceContext)
+{
+	char statsString[64];
+	bool result;
+
+	// setup the render counter string from the values of the last frame
+	sprintf_s(statsString, "draws %llu tris %llu maps %llu up %lluk sw %llu tex %llu",
+		RenderStatsClass::GetFrameValue(RENDER_COUNTER_DRAWS),
+		RenderStatsClass::GetFrameValue(RENDER_COUNTER_TRIANGLES),
+		RenderStatsClass::GetFrameValue(RENDER_COUNTER_MAPS),
+		RenderStatsClass::GetFrameValue(RENDER_COUNTER_UPLOAD_BYTES) / 1024,
+		RenderStatsClass::GetFrameValue(RENDER_COUNTER_SHADER_SWITCHES),
+		RenderStatsClass::GetFrameValue(RENDER_COUNTER_TEXTURE_BINDS));
+
+	// update the sentence vertex buffer with the new string information
+	result = UpdateSentence(m_sentence5, statsString, 20, 100, 1.f, 1.f, 1.f, deviceContext);
+	if (!result)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool TextClass::SetMemoryStats(ID3D11DeviceContext* deviceContext)
+{
+	char statsString[64];
+	MemoryStatsType total, mesh, texture, text, scene;
+	bool result;
+
+	MemoryClass::GetTotalStats(total);
+	MemoryClass::GetStats(MEMORY_TAG_MESH, mesh);
+	MemoryClass::GetStats(MEMORY_TAG_TEXTURE, texture);
+	MemoryClass::GetStats(MEMORY_TAG_TEXT, text);
+	MemoryClass::GetStats(MEMORY_TAG_SCENE, scene);
+
+	// setup the memory string from the tracked bytes right now, too long a string is cut off
+	snprintf(statsString, sizeof(statsString), "mem %.1fM pk %.1fM mesh %lluk tex %lluk txt %lluk scn %lluk",
+		total.current / (1024.0 * 1024.0), total.peak / (1024.0 * 1024.0),
+		mesh.current / 1024, texture.current / 1024, text.current / 1024, scene.current / 1024);
+
+	// update the sentence vertex buffer with the new string information
+	result = UpdateSentence(m_sentence5, statsString, 20, 100, 1.f, 1.f, 1.f, deviceContext);
+	if (!result)
+	{
+		return false;
+	}
+
 	return true;
 }
\ No newline at end of file
@@ -3,72 +3,225 @@
 
 
 TextureArrayClass::TextureArrayClass()
+	: m_Pack(nullptr)
 {
-	m_textures[0] = nullptr;
-	m_textures[1] = nullptr;
-	m_textures[2] = nullptr;
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		m_textures[i] = nullptr;
+		m_loose[i] = false;
+	}
 }
 
-bool TextureArrayClass::Initialize(ID3D11Device* device, 
+bool TextureArrayClass::Initialize(ID3D11Device* device, PackFileClass* pack,
 	WCHAR* filename1, WCHAR* filename2, WCHAR* filename3, WCHAR* filename4, WCHAR* filename5)
 {
-	HRESULT result;
+	bool result;
+	WCHAR* filenames[TEXTURE_ARRAY_SIZE] = { filename1, filename2, filename3, filename4, filename5 };
+	char filename[128];
+	size_t length;
 
-	// load the first texture in
-	result = DirectX::CreateDDSTextureFromFile(
-		device,
-		filename1,
-		NULL,
-		&m_textures[0]
-	);
-	if (FAILED(result))
+	// keep the pack and the filenames so the mips can be streamed in later
+	m_Pack = pack;
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
 	{
-		return false;
+		wcstombs_s(&length, filename, sizeof(filename), filenames[i], _TRUNCATE);
+		m_filenames[i] = filename;
 	}
 
-	// load the second texture in
-	result = DirectX::CreateDDSTextureFromFile(
-		device,
-		filename2,
-		NULL,
-		&m_textures[1]
-	);
-	if (FAILED(result))
+	// load only the small mips of each texture in, the rest is streamed on demand
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
 	{
-		return false;
+		result = LoadTexture(device, i, TEXTURE_STREAMING_SIZE);
+		if (!result)
+		{
+			return false;
+		}
 	}
 
+	return true;
+}
 
-	// load the third texture in
-	result = DirectX::CreateDDSTextureFromFile(
-		device,
-		filename3,
-		NULL,
-		&m_textures[2]
-	);
-	if (FAILED(result))
+void TextureArrayClass::Shutdown()
+{
+	// release the texture resources
+	for (int i = 0; i < TEXTURE_ARRAY_SIZE; i++)
+	{
+		if (m_textures[i])
+		{
+			m_textures[i]->Release();
+			m_textures[i] = nullptr;
+		}
+	}
+
+	return;
+}
+
+ID3D11ShaderResourceView* TextureArrayClass::SwapTexture(int index, ID3D11ShaderResourceView* texture, bool loose)
+{
+	ID3D11ShaderResourceView* old;
+
+	if (index < 0 || index >= TEXTURE_ARRAY_SIZE)
+	{
+		return texture;
+	}
+
+	// once the texture was reloaded from the loose file the one in the pack is out of date, the
+	//  mips are streamed from the loose file from then on
+	old = m_textures[index];
+	m_textures[index] = texture;
+	m_loose[index] = m_loose[index] || loose;
+
+	return old;
+}
+
+ID3D11ShaderResourceView** TextureArrayClass::GetTextureArray()
+{
+	return m_textures;
+}
+
+const char* TextureArrayClass::GetFilename(int index)
+{
+	return m_filenames[index].c_str();
+}
+
+bool TextureArrayClass::IsLoose(int index)
+{
+	return m_loose[index];
+}
+
+bool TextureArrayClass::ReadTexture(PackFileClass* pack, const char* filename, bool loose, int maxSize, AssetDataType& asset)
+{
+	std::ifstream fin;
+	const unsigned char* data;
+	const unsigned char* header;
+	unsigned char headerBuffer[TEXTURE_DDS_HEADER_SIZE];
+	unsigned long long size, offset, length;
+	unsigned int fourCC, caps2, dimension, miscFlags, arraySize, value;
+	int width, height, mipCount, bitsPerPixel, blockBytes, topMip, headerSize;
+
+	// an uncompressed texture in the pack is mapped, only the pages that are copied out of it are read
+	//  from the disk. a compressed one is decompressed as a whole, the loader skips its big mips
+	data = nullptr;
+	if (!loose)
+	{
+		if (!pack->Find(filename, data, size))
+		{
+			return pack->Read(filename, asset);
+		}
+		header = data;
+	}
+	else
+	{
+		fin.open(filename, std::ios::in | std::ios::binary | std::ios::ate);
+		if (fin.fail())
+		{
+			return false;
+		}
+
+		size = (unsigned long long)fin.tellg();
+		fin.seekg(0, std::ios::beg);
+		fin.read((char*)headerBuffer, (std::streamsize)std::min<unsigned long long>(size, sizeof(headerBuffer)));
+		header = headerBuffer;
+	}
+
+	if (!TextureStreamerClass::ReadDDSInfo(header, std::min<unsigned long long>(size, TEXTURE_DDS_HEADER_SIZE),
+		width, height, mipCount, bitsPerPixel, blockBytes))
 	{
 		return false;
 	}
 
-	// load the forth texture in
-	result = DirectX::CreateDDSTextureFromFile(
-		device,
-		filename4,
-		NULL,
-		&m_textures[3]
-	);
-	if (FAILED(result))
+	// the mips of a single 2d texture follow the header from the biggest one down, cube maps, volumes,
+	//  arrays and formats whose mip sizes are unknown are read as a whole
+	memcpy(&fourCC, header + 84, sizeof(fourCC));
+	memcpy(&caps2, header + 112, sizeof(caps2));
+	headerSize = 128;
+	dimension = 3;
+	miscFlags = 0;
+	arraySize = 1;
+	if (fourCC == 0x30315844)		// DX10
+	{
+		headerSize = TEXTURE_DDS_HEADER_SIZE;
+		memcpy(&dimension, header + 132, sizeof(dimension));
+		memcpy(&miscFlags, header + 136, sizeof(miscFlags));
+		memcpy(&arraySize, header + 140, sizeof(arraySize));
+	}
+	if ((caps2 & 0x200200) != 0 || dimension != 3 || (miscFlags & 0x4) != 0 || arraySize != 1 ||
+		(bitsPerPixel == 0 && blockBytes == 0))
+	{
+		fin.close();
+		return loose ? PackFileClass::ReadLooseFile(filename, asset) : pack->Read(filename, asset);
+	}
+
+	// skip every mip that is bigger than the max size like the loader would
+	topMip = TextureStreamerClass::GetTopMip(width, height, mipCount, maxSize);
+
+	// the bytes of the mips before the top mip and of the ones that are kept
+	offset = (unsigned long long)headerSize;
+	length = 0;
+	for (int i = 0; i < mipCount; i++)
+	{
+		if (i < topMip)
+		{
+			offset += TextureStreamerClass::GetMipBytes(width, height, bitsPerPixel, blockBytes, i);
+		}
+		else
+		{
+			length += TextureStreamerClass::GetMipBytes(width, height, bitsPerPixel, blockBytes, i);
+		}
+	}
+	if (offset + length > size)
 	{
 		return false;
 	}
 
-	// load the fifth texture in
-	result = DirectX::CreateDDSTextureFromFile(
+	// a dds file of its own with the top mip as the biggest one
+	asset.buffer.resize((size_t)(headerSize + length));
+	memcpy(asset.buffer.data(), header, headerSize);
+
+	value = (unsigned int)std::max(1, height >> topMip);
+	memcpy(asset.buffer.data() + 12, &value, sizeof(value));
+	value = (unsigned int)std::max(1, width >> topMip);
+	memcpy(asset.buffer.data() + 16, &value, sizeof(value));
+	value = (unsigned int)(mipCount - topMip);
+	memcpy(asset.buffer.data() + 28, &value, sizeof(value));
+
+	if (data)
+	{
+		memcpy(asset.buffer.data() + headerSize, data + offset, (size_t)length);
+	}
+	else
+	{
+		fin.seekg((std::streamoff)offset, std::ios::beg);
+		fin.read((char*)asset.buffer.data() + headerSize, (std::streamsize)length);
+		if ((unsigned long long)fin.gcount() != length)
+		{
+			return false;
+		}
+	}
+
+	asset.data = asset.buffer.data();
+	asset.size = asset.buffer.size();
+
+	return true;
+}
+
+bool TextureArrayClass::CreateTexture(ID3D11Device* device, const AssetDataType& asset, int maxSize, ID3D11ShaderResourceView** texture)
+{
+	HRESULT result;
+
+	// create the texture from the DDS file data
+	result = DirectX::CreateDDSTextureFromMemoryEx(
 		device,
-		filename5,
+		asset.data,
+		(size_t)asset.size,
+		maxSize,
+		D3D11_USAGE_DEFAULT,
+		D3D11_BIND_SHADER_RESOURCE,
+		0,
+		0,
+		false,
 		NULL,
-		&m_textures[4]
+		texture
 	);
 	if (FAILED(result))
 	{
@@ -78,31 +231,32 @@ bool TextureArrayClass::Initialize(ID3D11Device* device,
 	return true;
 }
 
-void TextureArrayClass::Shutdown()
+bool TextureArrayClass::LoadTexture(ID3D11Device* device, int index, int maxSize)
 {
-	// release the texture resources
-	if (m_textures[0])
+	bool result;
+	AssetDataType asset;
+	ID3D11ShaderResourceView* texture;
+
+	// get the mips of the texture from the pack or the disk, a reloaded texture only from the disk
+	result = ReadTexture(m_Pack, m_filenames[index].c_str(), m_loose[index], maxSize, asset);
+	if (!result)
 	{
-		m_textures[0]->Release();
-		m_textures[0] = nullptr;
+		return false;
 	}
 
-	if (m_textures[1])
+	// create the texture, skipping the mips that are bigger than the max size
+	result = CreateTexture(device, asset, maxSize, &texture);
+	if (!result)
 	{
-		m_textures[1]->Release();
-		m_textures[1] = nullptr;
+		return false;
 	}
 
-	if (m_textures[2])
+	// replace the old texture only once the new one is complete
+	if (m_textures[index])
 	{
-		m_textures[2]->Release();
-		m_textures[2] = nullptr;
+		m_textures[index]->Release();
 	}
+	m_textures[index] = texture;
 
-	return;
-}
-
-ID3D11ShaderResourceView** TextureArrayClass::GetTextureArray()
-{
-	return m_textures;
-}
+	return true;
+}
\ No newline at end of file
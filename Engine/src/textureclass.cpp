@@ -16,7 +16,7 @@ TextureClass::~TextureClass()
 {
 }
 
-bool TextureClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* filename)
+bool TextureClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceContext, PackFileClass* pack, AssetCacheClass* cache, char* filename)
 {
 	bool result;
 	int height, width;
@@ -26,7 +26,7 @@ bool TextureClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceC
 	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
 
 	// load the targa image data into memory
-	result = LoadTarga(filename, height, width);
+	result = LoadTarga(pack, cache, filename, height, width);
 	if (!result)
 	{
 		return false;
@@ -68,6 +68,7 @@ bool TextureClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceC
 		rowPitch,
 		0
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_UPLOAD_BYTES, (unsigned long long)rowPitch * height);
 
 	// setup the shader resource view description
 	srvDesc.Format = textureDesc.Format;
@@ -98,20 +99,22 @@ bool TextureClass::Initialize(ID3D11Device* device, ID3D11DeviceContext* deviceC
 	return true;
 }
 
-bool TextureClass::InitializeDDS(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* filename)
+bool TextureClass::InitializeDDS(ID3D11Device* device, ID3D11DeviceContext* deviceContext, PackFileClass* pack, char* filename)
 {
 	HRESULT result;
-	ID3D11Resource* texture;
+	AssetDataType asset;
 
-	// convert char to wchar_t
-	wchar_t text_wchar[30];
-	size_t length = strlen(filename);
-	mbstowcs_s(&length, text_wchar, filename, length);
+	// get the DDS file from the pack or the disk
+	if (!pack->Read(filename, asset))
+	{
+		return false;
+	}
 
-	// load the DDS texture in
-	result = DirectX::CreateDDSTextureFromFile(
+	// create the DDS texture from the file data
+	result = DirectX::CreateDDSTextureFromMemory(
 		device,
-		text_wchar,
+		asset.data,
+		(size_t)asset.size,
 		NULL,
 		&m_textureView
 		);
@@ -154,27 +157,54 @@ ID3D11ShaderResourceView* TextureClass::GetTexture()
 	return m_textureView;
 }
 
-bool TextureClass::LoadTarga(char* filename, int& height, int& width)
+bool TextureClass::LoadTarga(PackFileClass* pack, AssetCacheClass* cache, char* filename, int& height, int& width)
 {
-	int error, bpp, imageSize, index, i, j, k;
-	FILE* filePtr;
-	unsigned int count;
+	int bpp, imageSize, index, i, j, k;
+	AssetDataType asset;
+	std::vector<unsigned char> blob;
+	unsigned long long key;
+	int settings[2];
 	TargaHeader targaFileHeader;
-	unsigned char* targaImage;
+	const unsigned char* targaImage;
 
-	// Open the targa file for reading in binary
-	error = fopen_s(&filePtr, filename, "rb");
-	if (error != 0)
+	// get the targa file from the pack or the disk
+	if (!pack->Read(filename, asset))
 	{
 		return false;
 	}
 
+	// an unchanged image is taken from the cache, the blob is the width and height followed by the rgba data
+	key = 0;
+	if (cache)
+	{
+		settings[0] = (int)DXGI_FORMAT_R8G8B8A8_UNORM;
+		settings[1] = 4;
+		key = cache->MakeKey(asset, "targa", TARGA_IMPORTER_VERSION, settings, sizeof(settings));
+		if (cache->Load(key, blob) && blob.size() >= 2 * sizeof(int))
+		{
+			memcpy(&width, blob.data(), sizeof(int));
+			memcpy(&height, blob.data() + sizeof(int), sizeof(int));
+			imageSize = width * height * 4;
+			if (width > 0 && height > 0 && blob.size() == 2 * sizeof(int) + imageSize)
+			{
+				m_targaData = new unsigned char[imageSize];
+				if (!m_targaData)
+				{
+					return false;
+				}
+				memcpy(m_targaData, blob.data() + 2 * sizeof(int), imageSize);
+
+				return true;
+			}
+		}
+	}
+
 	// read in the file header
-	count = (unsigned int)fread(&targaFileHeader, sizeof(TargaHeader), 1, filePtr);
-	if (count != 1)
+	if (asset.size < sizeof(TargaHeader))
 	{
 		return false;
 	}
+	memcpy(&targaFileHeader, asset.data, sizeof(TargaHeader));
 
 	// get the important information from the header
 	height = (int)targaFileHeader.height;
@@ -190,26 +220,12 @@ bool TextureClass::LoadTarga(char* filename, int& height, int& width)
 	// calculate the size of the 32 bit image data
 	imageSize = width * height * 4;
 
-	// allocate memory for the targa image data
-	targaImage = new unsigned char[imageSize];
-	if (!targaImage)
-	{
-		return false;
-	}
-
-	// read in the targa image data
-	count = (unsigned int)fread(targaImage, 1, imageSize, filePtr);
-	if (count != imageSize)
-	{
-		return false;
-	}
-
-	// close the file
-	error = fclose(filePtr);
-	if (error != 0)
+	// the targa image data follows the header
+	if (asset.size < sizeof(TargaHeader) + imageSize)
 	{
 		return false;
 	}
+	targaImage = asset.data + sizeof(TargaHeader);
 
 	// allocate memory for the targa destination data
 	m_targaData = new unsigned char[imageSize];
@@ -245,9 +261,15 @@ bool TextureClass::LoadTarga(char* filename, int& height, int& width)
 		k -= (width * 8);
 	}
 
-	// release the targa image data now that it was copied into the dest array
-	delete[] targaImage;
-	targaImage = nullptr;
+	// store the decoded image for the next run
+	if (cache)
+	{
+		blob.resize(2 * sizeof(int) + imageSize);
+		memcpy(blob.data(), &width, sizeof(int));
+		memcpy(blob.data() + sizeof(int), &height, sizeof(int));
+		memcpy(blob.data() + 2 * sizeof(int), m_targaData, imageSize);
+		cache->Store(key, blob.data(), blob.size());
+	}
 
 	return true;
 }
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "textureloaderclass.h"
+#include "texturearrayclass.h"
+
+TextureLoaderClass::TextureLoaderClass()
+	: m_device(nullptr), m_Pack(nullptr), m_quit(false), m_nextSlot(0), m_failCount(0)
+{
+}
+
+TextureLoaderClass::~TextureLoaderClass()
+{
+	Shutdown();
+}
+
+bool TextureLoaderClass::Initialize(ID3D11Device* device, PackFileClass* pack, int slotCount)
+{
+	SlotType slot;
+
+	if (!device || !pack || slotCount <= 0 || m_thread.joinable())
+	{
+		return false;
+	}
+
+	m_device = device;
+	m_Pack = pack;
+	m_quit = false;
+	m_nextSlot = 0;
+	m_failCount = 0;
+
+	slot.loose = false;
+	slot.maxSize = 0;
+	slot.generation = 0;
+	slot.requested = false;
+	slot.finished = false;
+	slot.texture = nullptr;
+	slot.textureSize = 0;
+	slot.textureGeneration = 0;
+	m_slots.assign(slotCount, slot);
+
+	// the device is free threaded, the textures are created on the loader thread as well
+	m_thread = std::thread(&TextureLoaderClass::Run, this);
+
+	return true;
+}
+
+void TextureLoaderClass::Shutdown()
+{
+	// stop the loader thread, a load in flight is finished first
+	if (m_thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_wake.notify_one();
+		m_thread.join();
+	}
+
+	// release the textures that never made it to a frame boundary
+	for (size_t i = 0; i < m_slots.size(); i++)
+	{
+		if (m_slots[i].texture)
+		{
+			m_slots[i].texture->Release();
+			m_slots[i].texture = nullptr;
+		}
+	}
+	m_slots.clear();
+
+	m_device = nullptr;
+	m_Pack = nullptr;
+
+	return;
+}
+
+bool TextureLoaderClass::Request(int slot, const char* filename, bool loose, int maxSize, unsigned int generation)
+{
+	if (slot < 0 || slot >= (int)m_slots.size())
+	{
+		return false;
+	}
+
+	// a newer request for the slot replaces the one the loader has not started yet
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_slots[slot].filename = filename;
+		m_slots[slot].loose = loose;
+		m_slots[slot].maxSize = maxSize;
+		m_slots[slot].generation = generation;
+		m_slots[slot].requested = true;
+	}
+	m_wake.notify_one();
+
+	return true;
+}
+
+bool TextureLoaderClass::TakeFinished(int slot, ID3D11ShaderResourceView*& texture, int& maxSize, unsigned int& generation)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (slot < 0 || slot >= (int)m_slots.size() || !m_slots[slot].finished)
+	{
+		return false;
+	}
+
+	// the caller owns the texture from now on, a failed load is handed out as nullptr so it can be retried
+	texture = m_slots[slot].texture;
+	maxSize = m_slots[slot].textureSize;
+	generation = m_slots[slot].textureGeneration;
+	m_slots[slot].texture = nullptr;
+	m_slots[slot].finished = false;
+
+	return true;
+}
+
+int TextureLoaderClass::GetFailCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_failCount;
+}
+
+void TextureLoaderClass::Run()
+{
+	AssetDataType asset;
+	ID3D11ShaderResourceView* texture;
+	std::string filename;
+	bool loose, result;
+	int slot, maxSize;
+	unsigned int generation;
+
+	while (true)
+	{
+		// wait for a request, the slots are served round robin so that no texture starves
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			slot = -1;
+			while (!m_quit)
+			{
+				for (int i = 0; i < (int)m_slots.size(); i++)
+				{
+					if (m_slots[(m_nextSlot + i) % m_slots.size()].requested)
+					{
+						slot = (m_nextSlot + i) % (int)m_slots.size();
+						break;
+					}
+				}
+				if (slot >= 0)
+				{
+					break;
+				}
+				m_wake.wait(lock);
+			}
+			if (m_quit)
+			{
+				break;
+			}
+
+			filename = m_slots[slot].filename;
+			loose = m_slots[slot].loose;
+			maxSize = m_slots[slot].maxSize;
+			generation = m_slots[slot].generation;
+			m_slots[slot].requested = false;
+			m_nextSlot = (slot + 1) % (int)m_slots.size();
+		}
+
+		// read only the mips up to the max size and create the texture outside of the lock
+		texture = nullptr;
+		result = TextureArrayClass::ReadTexture(m_Pack, filename.c_str(), loose, maxSize, asset);
+		if (result)
+		{
+			result = TextureArrayClass::CreateTexture(m_device, asset, maxSize, &texture);
+		}
+		asset.buffer.clear();
+		asset.buffer.shrink_to_fit();
+
+		// publish the texture or the failure, a finished one that was never taken is out of date by now
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (!result)
+			{
+				m_failCount++;
+				texture = nullptr;
+			}
+
+			if (m_slots[slot].texture)
+			{
+				m_slots[slot].texture->Release();
+			}
+			m_slots[slot].finished = true;
+			m_slots[slot].texture = texture;
+			m_slots[slot].textureSize = maxSize;
+			m_slots[slot].textureGeneration = generation;
+		}
+	}
+
+	return;
+}
\ No newline at end of file
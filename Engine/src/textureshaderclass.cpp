@@ -349,6 +349,7 @@ bool TextureShaderClass::SetShaderParameters(
 		m_matrixBuffer,
 		0
 		);
+	RenderStatsClass::CountMap(sizeof(MatrixBufferType));
 
 	// set the position of the constant buffer in the vertex shader
 	bufferNumber = 0;
@@ -366,6 +367,7 @@ bool TextureShaderClass::SetShaderParameters(
 		1,			// num views
 		&texture	// shader resource view
 		);
+	RenderStatsClass::Add(RENDER_COUNTER_TEXTURE_BINDS, 1);
 
 	return true;
 }
@@ -386,6 +388,7 @@ void TextureShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int in
 		NULL, 					// only used if shader uses interfaces
 		0						// number of class-instances in the array
 		);
+	RenderStatsClass::CountShader(m_vertexShader);
 
 	// set the sampler state in the pixel shader
 	deviceContext->PSSetSamplers(
@@ -396,6 +399,7 @@ void TextureShaderClass::RenderShader(ID3D11DeviceContext* deviceContext, int in
 
 	// render the triangles
 	deviceContext->DrawIndexed(indexCount, 0, 0);
+	RenderStatsClass::CountDraw(indexCount);
 
 	return;
 }
\ No newline at end of file
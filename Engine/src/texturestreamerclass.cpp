@@ -0,0 +1,575 @@
+#include "texturestreamerclass.h"
+
+TextureStreamerClass::TextureStreamerClass()
+	: m_loadCallback(nullptr), m_userData(nullptr),
+	  m_budget(0), m_residentBytes(0), m_frame(0), m_pixelScale(0.f),
+	  m_loadCount(0), m_evictCount(0), m_failCount(0)
+{
+}
+
+bool TextureStreamerClass::Initialize(unsigned long long budget, int screenHeight, float fieldOfView,
+	LoadCallback loadCallback, void* userData)
+{
+	// a zero sized viewport can never require any detail
+	if (screenHeight <= 0 || fieldOfView <= 0.f)
+	{
+		return false;
+	}
+
+	// store the memory budget and the function that does the actual loading
+	m_budget = budget;
+	m_loadCallback = loadCallback;
+	m_userData = userData;
+
+	// precalculate the factor that converts world size / distance into pixels on screen
+	m_pixelScale = (float)screenHeight / (2.f * tanf(fieldOfView * 0.5f));
+
+	m_residentBytes = 0;
+	m_frame = 0;
+	m_loadCount = 0;
+	m_evictCount = 0;
+	m_failCount = 0;
+
+	return true;
+}
+
+void TextureStreamerClass::Shutdown()
+{
+	// forget all the registered textures, the owners release the actual resources
+	m_textures.clear();
+	m_loadQueue.clear();
+	m_residentBytes = 0;
+
+	return;
+}
+
+int TextureStreamerClass::RegisterTexture(int width, int height, int mipCount,
+	int bitsPerPixel, int blockBytes, int residentMip)
+{
+	TextureInfoType texture;
+
+	if (width <= 0 || height <= 0)
+	{
+		return -1;
+	}
+
+	// clamp the mip chain to what the streamer can track
+	mipCount = std::max(1, std::min(mipCount, STREAMER_MAX_MIPS));
+
+	texture.width = width;
+	texture.height = height;
+	texture.mipCount = mipCount;
+	texture.bitsPerPixel = bitsPerPixel;
+	texture.blockBytes = blockBytes;
+	texture.residentMip = std::max(0, std::min(residentMip, mipCount - 1));
+	texture.requestedMip = mipCount;
+	texture.priority = 0.f;
+	for (int i = 0; i < STREAMER_MAX_MIPS; i++)
+	{
+		texture.lastNeeded[i] = 0;
+	}
+
+	// the caller already loaded the texture up to its resident mip
+	m_residentBytes += CalculateResidentBytes(texture, texture.residentMip);
+
+	m_textures.push_back(texture);
+
+	return (int)m_textures.size() - 1;
+}
+
+int TextureStreamerClass::RegisterFile(const char* filename, int maxSize)
+{
+	std::ifstream fin;
+	unsigned char header[148];
+	std::streamsize count;
+
+	// open the texture file for reading in binary
+	fin.open(filename, std::ios::in | std::ios::binary);
+	if (fin.fail())
+	{
+		return -1;
+	}
+
+	// read in the magic number, the header and the optional dx10 header only
+	fin.read((char*)header, sizeof(header));
+	count = fin.gcount();
+	fin.close();
+
+	return RegisterDDS(header, (unsigned long long)count, maxSize);
+}
+
+int TextureStreamerClass::RegisterDDS(const unsigned char* data, unsigned long long size, int maxSize)
+{
+	int width, height, mipCount, bitsPerPixel, blockBytes, residentMip;
+
+	// read the dimensions and format from the dds header
+	if (!ReadDDSInfo(data, size, width, height, mipCount, bitsPerPixel, blockBytes))
+	{
+		return -1;
+	}
+
+	// the size of a format the streamer does not know is estimated for the budget
+	if (blockBytes == 0 && bitsPerPixel == 0)
+	{
+		bitsPerPixel = STREAMER_UNKNOWN_BITS;
+	}
+
+	// the loader skips every mip that is bigger than the max size (0 loads all of them)
+	residentMip = GetTopMip(width, height, mipCount, maxSize);
+
+	return RegisterTexture(width, height, mipCount, bitsPerPixel, blockBytes, residentMip);
+}
+
+void TextureStreamerClass::BeginFrame()
+{
+	// start a new frame, nothing has been requested yet
+	m_frame++;
+
+	for (size_t i = 0; i < m_textures.size(); i++)
+	{
+		m_textures[i].requestedMip = m_textures[i].mipCount;
+		m_textures[i].priority = 0.f;
+	}
+
+	return;
+}
+
+void TextureStreamerClass::RequestSphere(int textureId, float distance, float radius)
+{
+	float pixels;
+
+	if (textureId < 0 || textureId >= (int)m_textures.size())
+	{
+		return;
+	}
+
+	// the projected diameter of the object on screen is used as the priority
+	pixels = (distance > radius) ? (2.f * radius * m_pixelScale / distance) : 1.e9f;
+
+	Request(textureId, GetRequiredMip(textureId, distance, radius), pixels);
+
+	return;
+}
+
+void TextureStreamerClass::RequestMip(int textureId, int mip)
+{
+	if (textureId < 0 || textureId >= (int)m_textures.size())
+	{
+		return;
+	}
+
+	// explicit requests (2d elements) are drawn 1:1 and always come first
+	Request(textureId, mip, 1.e9f);
+
+	return;
+}
+
+int TextureStreamerClass::Update(int maxLoads)
+{
+	int loads, target;
+	unsigned long long needed;
+
+	// collect every texture that has less detail resident than requested
+	m_loadQueue.clear();
+	for (size_t i = 0; i < m_textures.size(); i++)
+	{
+		if (m_textures[i].requestedMip < m_textures[i].residentMip)
+		{
+			m_loadQueue.push_back((int)i);
+		}
+	}
+
+	// the biggest objects on screen and the biggest deficits are streamed first
+	std::sort(m_loadQueue.begin(), m_loadQueue.end(), [this](int a, int b)
+	{
+		const TextureInfoType& ta = m_textures[a];
+		const TextureInfoType& tb = m_textures[b];
+		if (ta.priority != tb.priority)
+		{
+			return ta.priority > tb.priority;
+		}
+		return (ta.residentMip - ta.requestedMip) > (tb.residentMip - tb.requestedMip);
+	});
+
+	loads = 0;
+	for (size_t i = 0; i < m_loadQueue.size() && loads < maxLoads; i++)
+	{
+		TextureInfoType& texture = m_textures[m_loadQueue[i]];
+
+		// make room for the requested mips, settle for less detail if the budget is too tight
+		target = texture.requestedMip;
+		while (target < texture.residentMip)
+		{
+			needed = CalculateResidentBytes(texture, target) - CalculateResidentBytes(texture, texture.residentMip);
+			if (m_residentBytes + needed <= m_budget || EvictFor(needed, m_loadQueue[i]))
+			{
+				break;
+			}
+			target++;
+		}
+
+		if (target < texture.residentMip && SetResidentMip(m_loadQueue[i], target))
+		{
+			m_loadCount++;
+			loads++;
+		}
+	}
+
+	// the budget may have been lowered, trim whatever is over it
+	EvictFor(0, -1);
+
+	return loads;
+}
+
+void TextureStreamerClass::FailLoad(int textureId, int maxSize)
+{
+	if (textureId < 0 || textureId >= (int)m_textures.size())
+	{
+		return;
+	}
+
+	TextureInfoType& texture = m_textures[textureId];
+
+	// the mips were counted as resident when the load was handed out, count the ones the owner still
+	//  holds instead so the next update asks for the load again
+	m_residentBytes -= CalculateResidentBytes(texture, texture.residentMip);
+	texture.residentMip = GetTopMip(texture.width, texture.height, texture.mipCount, maxSize);
+	m_residentBytes += CalculateResidentBytes(texture, texture.residentMip);
+	m_failCount++;
+
+	return;
+}
+
+int TextureStreamerClass::GetRequiredMip(int textureId, float distance, float radius)
+{
+	const TextureInfoType& texture = m_textures[textureId];
+	float pixels, texels;
+	int mip;
+
+	// inside the object the full detail is needed
+	if (distance <= radius)
+	{
+		return 0;
+	}
+
+	// the texture is assumed to be mapped once around the object
+	pixels = 2.f * radius * m_pixelScale / distance;
+	texels = (float)std::max(texture.width, texture.height);
+	if (pixels < 1.f)
+	{
+		return texture.mipCount - 1;
+	}
+
+	// one texel per pixel
+	mip = (int)floorf(log2f(texels / pixels));
+
+	return std::max(0, std::min(mip, texture.mipCount - 1));
+}
+
+int TextureStreamerClass::GetResidentMip(int textureId)
+{
+	return m_textures[textureId].residentMip;
+}
+
+int TextureStreamerClass::GetMipSize(int textureId, int mip)
+{
+	const TextureInfoType& texture = m_textures[textureId];
+
+	// the larger side of the mip, as used for the max size of the dds loader
+	return std::max(1, std::max(texture.width, texture.height) >> mip);
+}
+
+int TextureStreamerClass::GetTextureCount()
+{
+	return (int)m_textures.size();
+}
+
+unsigned long long TextureStreamerClass::GetResidentBytes()
+{
+	return m_residentBytes;
+}
+
+unsigned long long TextureStreamerClass::GetBudget()
+{
+	return m_budget;
+}
+
+int TextureStreamerClass::GetLoadCount()
+{
+	return m_loadCount;
+}
+
+int TextureStreamerClass::GetEvictCount()
+{
+	return m_evictCount;
+}
+
+int TextureStreamerClass::GetFailCount()
+{
+	return m_failCount;
+}
+
+bool TextureStreamerClass::ReadDDSInfo(const unsigned char* header, unsigned long long size,
+	int& width, int& height, int& mipCount, int& bitsPerPixel, int& blockBytes)
+{
+	unsigned int flags, fourCC, format;
+
+	// little endian dword at a byte offset into the header
+	auto dword = [header](int offset) -> unsigned int
+	{
+		return (unsigned int)header[offset] | ((unsigned int)header[offset + 1] << 8) |
+			((unsigned int)header[offset + 2] << 16) | ((unsigned int)header[offset + 3] << 24);
+	};
+
+	// check the magic number and that the whole header is there
+	if (size < 128 || dword(0) != 0x20534444)		// "DDS "
+	{
+		return false;
+	}
+
+	height = (int)dword(12);
+	width = (int)dword(16);
+	mipCount = std::max(1, (int)dword(28));
+	flags = dword(80);
+	fourCC = dword(84);
+	bitsPerPixel = 0;
+	blockBytes = 0;
+
+	// a format without a four cc is described by its bit count
+	if ((flags & 0x4) == 0)
+	{
+		bitsPerPixel = (int)dword(88);
+		if (bitsPerPixel != 8 && bitsPerPixel != 16 && bitsPerPixel != 24 && bitsPerPixel != 32)
+		{
+			bitsPerPixel = 0;
+		}
+		return true;
+	}
+
+	// find the block size of the compressed formats and the pixel size of the others
+	switch (fourCC)
+	{
+	case 0x31545844:		// DXT1
+	case 0x31495441:		// ATI1
+	case 0x55344342:		// BC4U
+	case 0x53344342:		// BC4S
+		blockBytes = 8;
+		break;
+	case 0x32545844:		// DXT2
+	case 0x33545844:		// DXT3
+	case 0x34545844:		// DXT4
+	case 0x35545844:		// DXT5
+	case 0x32495441:		// ATI2
+	case 0x55354342:		// BC5U
+	case 0x53354342:		// BC5S
+		blockBytes = 16;
+		break;
+	case 0x30315844:		// DX10, the format follows as dxgi format
+		if (size < 148)
+		{
+			return false;
+		}
+		format = dword(128);
+		if ((format >= 70 && format <= 72) || (format >= 79 && format <= 81))
+		{
+			blockBytes = 8;		// BC1, BC4
+		}
+		else if ((format >= 73 && format <= 78) || (format >= 82 && format <= 84) || (format >= 94 && format <= 99))
+		{
+			blockBytes = 16;	// BC2, BC3, BC5, BC6H, BC7
+		}
+		else
+		{
+			bitsPerPixel = GetFormatBits(format);
+		}
+		break;
+	case 36:				// A16B16G16R16
+	case 110:				// Q16W16V16U16
+	case 113:				// A16B16G16R16F
+	case 115:				// G32R32F
+		bitsPerPixel = 64;
+		break;
+	case 111:				// R16F
+	case 117:				// CxV8U8
+		bitsPerPixel = 16;
+		break;
+	case 112:				// G16R16F
+	case 114:				// R32F
+		bitsPerPixel = 32;
+		break;
+	case 116:				// A32B32G32R32F
+		bitsPerPixel = 128;
+		break;
+	default:
+		break;
+	}
+
+	return true;
+}
+
+int TextureStreamerClass::GetFormatBits(unsigned int format)
+{
+	// bits per pixel of the uncompressed dxgi formats whose rows are plain arrays of pixels
+	if (format >= 1 && format <= 4)
+	{
+		return 128;		// R32G32B32A32
+	}
+	if (format >= 5 && format <= 8)
+	{
+		return 96;		// R32G32B32
+	}
+	if (format >= 9 && format <= 22)
+	{
+		return 64;		// R16G16B16A16, R32G32, R32G8X24
+	}
+	if ((format >= 23 && format <= 47) || format == 67 || (format >= 87 && format <= 93))
+	{
+		return 32;		// R10G10B10A2, R11G11B10, R8G8B8A8, R16G16, R32, R24G8, R9G9B9E5, B8G8R8A8
+	}
+	if ((format >= 48 && format <= 59) || format == 85 || format == 86 || format == 115)
+	{
+		return 16;		// R8G8, R16, B5G6R5, B5G5R5A1, B4G4R4A4
+	}
+	if (format >= 60 && format <= 65)
+	{
+		return 8;		// R8, A8
+	}
+
+	// packed, planar and video formats are unknown
+	return 0;
+}
+
+unsigned long long TextureStreamerClass::GetMipBytes(int textureWidth, int textureHeight, int bitsPerPixel, int blockBytes, int mip)
+{
+	unsigned long long width, height;
+
+	width = (unsigned long long)std::max(1, textureWidth >> mip);
+	height = (unsigned long long)std::max(1, textureHeight >> mip);
+
+	// block compressed formats store 4x4 pixel blocks
+	if (blockBytes > 0)
+	{
+		return ((width + 3) / 4) * ((height + 3) / 4) * (unsigned long long)blockBytes;
+	}
+
+	return ((width * (unsigned long long)bitsPerPixel + 7) / 8) * height;
+}
+
+int TextureStreamerClass::GetTopMip(int width, int height, int mipCount, int maxSize)
+{
+	int mip = 0;
+
+	// the first mip that fits the max size like the dds loader picks it, 0 keeps all of them
+	if (maxSize > 0)
+	{
+		while (mip < mipCount - 1 && ((width >> mip) > maxSize || (height >> mip) > maxSize))
+		{
+			mip++;
+		}
+	}
+
+	return mip;
+}
+
+void TextureStreamerClass::Request(int textureId, int mip, float priority)
+{
+	TextureInfoType& texture = m_textures[textureId];
+
+	mip = std::max(0, std::min(mip, texture.mipCount - 1));
+
+	// keep the most detailed request of this frame
+	if (mip < texture.requestedMip)
+	{
+		texture.requestedMip = mip;
+	}
+	if (priority > texture.priority)
+	{
+		texture.priority = priority;
+	}
+
+	// the requested mip and every smaller one are needed this frame
+	for (int i = mip; i < texture.mipCount; i++)
+	{
+		texture.lastNeeded[i] = m_frame;
+	}
+
+	return;
+}
+
+unsigned long long TextureStreamerClass::CalculateMipBytes(const TextureInfoType& texture, int mip)
+{
+	return GetMipBytes(texture.width, texture.height, texture.bitsPerPixel, texture.blockBytes, mip);
+}
+
+unsigned long long TextureStreamerClass::CalculateResidentBytes(const TextureInfoType& texture, int topMip)
+{
+	unsigned long long bytes = 0;
+
+	// the resident mips are always the chain from the top mip down to 1x1
+	for (int i = topMip; i < texture.mipCount; i++)
+	{
+		bytes += CalculateMipBytes(texture, i);
+	}
+
+	return bytes;
+}
+
+bool TextureStreamerClass::EvictFor(unsigned long long bytes, int protectedId)
+{
+	int candidate;
+
+	while (m_residentBytes + bytes > m_budget)
+	{
+		// find the texture whose most detailed mip was needed the longest time ago
+		candidate = -1;
+		for (int i = 0; i < (int)m_textures.size(); i++)
+		{
+			const TextureInfoType& texture = m_textures[i];
+
+			// never evict the smallest mip or anything that is needed this frame
+			if (i == protectedId || texture.residentMip >= texture.mipCount - 1 ||
+				texture.lastNeeded[texture.residentMip] == m_frame)
+			{
+				continue;
+			}
+
+			if (candidate < 0 ||
+				texture.lastNeeded[texture.residentMip] < m_textures[candidate].lastNeeded[m_textures[candidate].residentMip])
+			{
+				candidate = i;
+			}
+		}
+
+		if (candidate < 0)
+		{
+			return false;
+		}
+
+		// drop the most detailed mip of that texture
+		if (!SetResidentMip(candidate, m_textures[candidate].residentMip + 1))
+		{
+			return false;
+		}
+
+		m_evictCount++;
+	}
+
+	return true;
+}
+
+bool TextureStreamerClass::SetResidentMip(int textureId, int mip)
+{
+	TextureInfoType& texture = m_textures[textureId];
+
+	// let the owner of the texture load or release the mips
+	if (m_loadCallback && !m_loadCallback(m_userData, textureId, mip))
+	{
+		return false;
+	}
+
+	m_residentBytes -= CalculateResidentBytes(texture, texture.residentMip);
+	m_residentBytes += CalculateResidentBytes(texture, mip);
+	texture.residentMip = mip;
+
+	return true;
+}
\ No newline at end of file
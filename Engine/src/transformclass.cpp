@@ -0,0 +1,372 @@
+#include "transformclass.h"
+
+// moves the values into the new order, order[i] is where the value at i comes from
+template <class T>
+static void Reorder(std::vector<T>& values, const std::vector<int>& order)
+{
+	std::vector<T> reordered;
+
+	reordered.resize(values.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		reordered[i] = values[order[i]];
+	}
+	values.swap(reordered);
+
+	return;
+}
+
+TransformClass::TransformClass()
+	: m_updatedCount(0), m_sorted(true)
+{
+}
+
+bool TransformClass::Initialize(int nodeCount)
+{
+	Shutdown();
+
+	// room for the nodes so adding them does not copy the arrays around
+	m_orders.reserve(nodeCount);
+	m_ids.reserve(nodeCount);
+	m_parents.reserve(nodeCount);
+	m_subtreeEnds.reserve(nodeCount);
+	m_translations.reserve(nodeCount);
+	m_rotations.reserve(nodeCount);
+	m_scales.reserve(nodeCount);
+	m_worlds.reserve(nodeCount);
+	m_dirty.reserve(nodeCount);
+	m_dirtyNodes.reserve(nodeCount);
+
+	return true;
+}
+
+void TransformClass::Shutdown()
+{
+	m_orders.clear();
+	m_ids.clear();
+	m_parents.clear();
+	m_subtreeEnds.clear();
+	m_translations.clear();
+	m_rotations.clear();
+	m_scales.clear();
+	m_worlds.clear();
+	m_dirty.clear();
+	m_dirtyNodes.clear();
+	m_ranges.clear();
+	m_updatedCount = 0;
+	m_sorted = true;
+
+	return;
+}
+
+int TransformClass::AddNode(int parent)
+{
+	XMFLOAT4X4 world;
+	int id, order, parentOrder;
+
+	if (parent >= (int)m_orders.size())
+	{
+		return -1;
+	}
+
+	// the new node goes to the end
+	id = (int)m_orders.size();
+	order = (int)m_ids.size();
+	parentOrder = parent >= 0 ? m_orders[parent] : -1;
+
+	XMStoreFloat4x4(&world, XMMatrixIdentity());
+
+	m_orders.push_back(order);
+	m_ids.push_back(id);
+	m_parents.push_back(parentOrder);
+	m_subtreeEnds.push_back(order + 1);
+	m_translations.push_back(XMFLOAT3(0.f, 0.f, 0.f));
+	m_rotations.push_back(XMFLOAT4(0.f, 0.f, 0.f, 1.f));
+	m_scales.push_back(XMFLOAT3(1.f, 1.f, 1.f));
+	m_worlds.push_back(world);
+	m_dirty.push_back(0);
+	MarkDirty(order);
+
+	// that is still depth first if the subtree of the parent is the last one, then the subtrees
+	//  of the parent and all its ancestors end after the new node. otherwise the order is built
+	//  again on the next update
+	if (parentOrder >= 0)
+	{
+		if (m_sorted && m_subtreeEnds[parentOrder] == order)
+		{
+			for (int ancestor = parentOrder; ancestor >= 0; ancestor = m_parents[ancestor])
+			{
+				m_subtreeEnds[ancestor] = order + 1;
+			}
+		}
+		else
+		{
+			m_sorted = false;
+		}
+	}
+
+	return id;
+}
+
+void TransformClass::SetLocal(int node, XMFLOAT3 translation, XMFLOAT4 rotation, XMFLOAT3 scale)
+{
+	int order;
+
+	order = m_orders[node];
+	m_translations[order] = translation;
+	m_rotations[order] = rotation;
+	m_scales[order] = scale;
+	MarkDirty(order);
+
+	return;
+}
+
+void TransformClass::SetTranslation(int node, XMFLOAT3 translation)
+{
+	int order;
+
+	order = m_orders[node];
+	m_translations[order] = translation;
+	MarkDirty(order);
+
+	return;
+}
+
+int TransformClass::GetParent(int node)
+{
+	int parent;
+
+	parent = m_parents[m_orders[node]];
+	return parent >= 0 ? m_ids[parent] : -1;
+}
+
+void TransformClass::Update()
+{
+	ProfileZoneClass zone("transform update");
+
+	m_updatedCount = 0;
+
+	// nodes that were added out of order need a new depth first order first
+	if (!m_sorted)
+	{
+		Sort();
+	}
+
+	if (m_dirtyNodes.empty())
+	{
+		return;
+	}
+
+	// in order the dirty nodes inside the subtree of an earlier one are already covered by it,
+	//  the others start a range of their own
+	std::sort(m_dirtyNodes.begin(), m_dirtyNodes.end());
+
+	m_ranges.clear();
+	for (size_t i = 0; i < m_dirtyNodes.size(); i++)
+	{
+		m_dirty[m_dirtyNodes[i]] = 0;
+		if (!m_ranges.empty() && m_dirtyNodes[i] < m_ranges.back().end)
+		{
+			continue;
+		}
+
+		m_ranges.push_back({ m_dirtyNodes[i], m_subtreeEnds[m_dirtyNodes[i]] });
+		m_updatedCount += m_ranges.back().end - m_ranges.back().begin;
+	}
+	m_dirtyNodes.clear();
+
+	// the ranges do not overlap and their parents are clean, so they can be updated on all the threads
+	if (m_updatedCount >= TRANSFORM_PARALLEL_NODES && m_ranges.size() > 1 && JobSystemClass::GetThreadCount() > 1)
+	{
+		JobCounterType counter;
+
+		JobSystemClass::ParallelFor(UpdateJob, this, 0, (int)m_ranges.size(), TRANSFORM_RANGE_GRAIN, &counter);
+		JobSystemClass::Wait(&counter);
+	}
+	else
+	{
+		UpdateJob(this, 0, (int)m_ranges.size());
+	}
+
+	return;
+}
+
+void TransformClass::GetWorldMatrix(int node, XMMATRIX& worldMatrix)
+{
+	worldMatrix = XMLoadFloat4x4(&m_worlds[m_orders[node]]);
+
+	return;
+}
+
+int TransformClass::GetNodeCount()
+{
+	return (int)m_ids.size();
+}
+
+int TransformClass::GetUpdatedCount()
+{
+	return m_updatedCount;
+}
+
+void TransformClass::MarkDirty(int order)
+{
+	// every node is listed once no matter how often it moves
+	if (!m_dirty[order])
+	{
+		m_dirty[order] = 1;
+		m_dirtyNodes.push_back(order);
+	}
+
+	return;
+}
+
+void TransformClass::Sort()
+{
+	std::vector<int> firstChildren, children, stack, order, positions;
+	int nodeCount, node;
+
+	nodeCount = (int)m_ids.size();
+
+	// list the children of every node
+	firstChildren.assign(nodeCount + 1, 0);
+	for (int i = 0; i < nodeCount; i++)
+	{
+		if (m_parents[i] >= 0)
+		{
+			firstChildren[m_parents[i] + 1]++;
+		}
+	}
+	for (int i = 0; i < nodeCount; i++)
+	{
+		firstChildren[i + 1] += firstChildren[i];
+	}
+
+	children.resize(nodeCount);
+	positions = firstChildren;
+	for (int i = 0; i < nodeCount; i++)
+	{
+		if (m_parents[i] >= 0)
+		{
+			children[positions[m_parents[i]]++] = i;
+		}
+	}
+
+	// walk the trees depth first, the children go on the stack backwards to keep their order
+	order.reserve(nodeCount);
+	for (int root = 0; root < nodeCount; root++)
+	{
+		if (m_parents[root] >= 0)
+		{
+			continue;
+		}
+
+		stack.push_back(root);
+		while (!stack.empty())
+		{
+			node = stack.back();
+			stack.pop_back();
+			order.push_back(node);
+
+			for (int child = firstChildren[node + 1] - 1; child >= firstChildren[node]; child--)
+			{
+				stack.push_back(children[child]);
+			}
+		}
+	}
+
+	// where every node goes
+	positions.resize(nodeCount);
+	for (int i = 0; i < nodeCount; i++)
+	{
+		positions[order[i]] = i;
+	}
+
+	for (int i = 0; i < nodeCount; i++)
+	{
+		if (m_parents[i] >= 0)
+		{
+			m_parents[i] = positions[m_parents[i]];
+		}
+	}
+
+	Reorder(m_ids, order);
+	Reorder(m_parents, order);
+	Reorder(m_translations, order);
+	Reorder(m_rotations, order);
+	Reorder(m_scales, order);
+	Reorder(m_worlds, order);
+
+	for (int i = 0; i < nodeCount; i++)
+	{
+		m_orders[m_ids[i]] = i;
+	}
+
+	// a subtree ends where the last subtree of its children ends
+	for (int i = 0; i < nodeCount; i++)
+	{
+		m_subtreeEnds[i] = i + 1;
+	}
+	for (int i = nodeCount - 1; i >= 0; i--)
+	{
+		if (m_parents[i] >= 0)
+		{
+			m_subtreeEnds[m_parents[i]] = std::max(m_subtreeEnds[m_parents[i]], m_subtreeEnds[i]);
+		}
+	}
+
+	// the dirty nodes moved, so all the trees are updated
+	m_dirtyNodes.clear();
+	for (int i = 0; i < nodeCount; i++)
+	{
+		m_dirty[i] = 0;
+		if (m_parents[i] < 0)
+		{
+			m_dirtyNodes.push_back(i);
+		}
+	}
+	m_sorted = true;
+
+	return;
+}
+
+void TransformClass::UpdateRange(int begin, int end)
+{
+	XMMATRIX local;
+	int parent;
+
+	// the local matrices are built and multiplied four lanes at a time by the vector math, the loads
+	//  and stores are unaligned since the heap of a 32 bit build only aligns to 8 bytes
+	for (int i = begin; i < end; i++)
+	{
+		// the rotation with its rows scaled and the translation in the last row
+		local = XMMatrixRotationQuaternion(XMLoadFloat4(&m_rotations[i]));
+		local.r[0] = XMVectorScale(local.r[0], m_scales[i].x);
+		local.r[1] = XMVectorScale(local.r[1], m_scales[i].y);
+		local.r[2] = XMVectorScale(local.r[2], m_scales[i].z);
+		local.r[3] = XMVectorSetW(XMLoadFloat3(&m_translations[i]), 1.f);
+
+		// the parent comes first, its world matrix is already up to date
+		parent = m_parents[i];
+		if (parent >= 0)
+		{
+			local = XMMatrixMultiply(local, XMLoadFloat4x4(&m_worlds[parent]));
+		}
+
+		XMStoreFloat4x4(&m_worlds[i], local);
+	}
+
+	return;
+}
+
+void TransformClass::UpdateJob(void* data, int begin, int end)
+{
+	TransformClass* transforms;
+
+	transforms = (TransformClass*)data;
+	for (int range = begin; range < end; range++)
+	{
+		transforms->UpdateRange(transforms->m_ranges[range].begin, transforms->m_ranges[range].end);
+	}
+
+	return;
+}
\ No newline at end of file
@@ -0,0 +1,302 @@
+#include "visibilityclass.h"
+
+VisibilityClass::VisibilityClass()
+	: m_ModelList(nullptr), m_Frustum(nullptr), m_jobPlaneTests(0), m_screenDepth(0.f), m_sceneVersion(0),
+	  m_valid(false), m_reused(false), m_coherent(true), m_caching(true)
+{
+}
+
+bool VisibilityClass::Initialize(ModelListClass* modelList)
+{
+	m_ModelList = modelList;
+
+	// create the frustum object
+	m_Frustum = new FrustumClass;
+	if (!m_Frustum)
+	{
+		return false;
+	}
+
+	// room for all the models so culling does not allocate
+	m_visibleModels.reserve(m_ModelList->GetModelCount());
+	m_valid = false;
+
+	return true;
+}
+
+void VisibilityClass::Shutdown()
+{
+	// release the frustum object
+	if (m_Frustum)
+	{
+		delete m_Frustum;
+		m_Frustum = nullptr;
+	}
+
+	m_visibleModels.clear();
+	m_visible.clear();
+	m_cullCache.clear();
+	m_chunks.clear();
+	m_ModelList = nullptr;
+	m_valid = false;
+
+	return;
+}
+
+void VisibilityClass::Cull(float screenDepth, XMMATRIX projectionMatrix, XMMATRIX viewMatrix)
+{
+	ProfileZoneClass zone("culling");
+	XMFLOAT4X4 view, projection;
+	unsigned int version;
+	bool sameCamera;
+
+	XMStoreFloat4x4(&view, viewMatrix);
+	XMStoreFloat4x4(&projection, projectionMatrix);
+	version = m_ModelList->GetVersion();
+
+	// the models that moved since the last frame, a full cull has to forget about them as well
+	m_ModelList->TakeMovedModels(m_movedModels);
+
+	sameCamera = m_valid && m_caching && screenDepth == m_screenDepth &&
+		memcmp(&view, &m_viewMatrix, sizeof(view)) == 0 && memcmp(&projection, &m_projectionMatrix, sizeof(projection)) == 0;
+
+	// nothing changed, the visible set of the last frame is still right
+	m_reused = sameCamera && version == m_sceneVersion;
+	if (m_reused)
+	{
+		return;
+	}
+
+	// only models moved if the version went up by one for each of them, then only they are tested.
+	//  once many of them moved the chunks of the full cull are faster than a lookup for every model
+	if (sameCamera && version - m_sceneVersion == (unsigned int)m_movedModels.size() &&
+		(int)m_movedModels.size() <= m_ModelList->GetModelCount() / VISIBILITY_MOVED_FRACTION)
+	{
+		CullMoved();
+		m_sceneVersion = version;
+		return;
+	}
+
+	// otherwise build the frustum and test every model
+	m_Frustum->ConstructFrustum(screenDepth, projectionMatrix, viewMatrix);
+	CullAll();
+
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+	m_screenDepth = screenDepth;
+	m_sceneVersion = version;
+	m_valid = true;
+
+	return;
+}
+
+int VisibilityClass::GetVisibleCount()
+{
+	return (int)m_visibleModels.size();
+}
+
+int VisibilityClass::GetVisibleModel(int index)
+{
+	return m_visibleModels[index];
+}
+
+const int* VisibilityClass::GetVisibleModels()
+{
+	return m_visibleModels.data();
+}
+
+unsigned long long VisibilityClass::GetPlaneTestCount()
+{
+	return m_Frustum->GetPlaneTestCount() + m_jobPlaneTests.load();
+}
+
+bool VisibilityClass::IsReused()
+{
+	return m_reused;
+}
+
+void VisibilityClass::SetCoherent(bool enabled)
+{
+	// without it every model is tested against the planes in order
+	m_coherent = enabled;
+	m_valid = false;
+	for (size_t i = 0; i < m_cullCache.size(); i++)
+	{
+		FrustumClass::ResetCache(m_cullCache[i]);
+	}
+
+	return;
+}
+
+void VisibilityClass::SetCaching(bool enabled)
+{
+	// without it every frame culls all the models
+	m_caching = enabled;
+	m_valid = false;
+
+	return;
+}
+
+void VisibilityClass::CullAll()
+{
+	int modelCount;
+
+	// a new scene may have a different number of models, nothing is known about them
+	modelCount = m_ModelList->GetModelCount();
+	if ((int)m_cullCache.size() != modelCount)
+	{
+		m_cullCache.resize(modelCount);
+		for (int i = 0; i < modelCount; i++)
+		{
+			FrustumClass::ResetCache(m_cullCache[i]);
+		}
+		m_visible.resize(modelCount);
+	}
+	else
+	{
+		// what the last frame found about the moved models no longer holds
+		for (size_t i = 0; i < m_movedModels.size(); i++)
+		{
+			FrustumClass::ResetCache(m_cullCache[m_movedModels[i]]);
+		}
+	}
+
+	// test the bounding spheres chunk by chunk, big scenes on all the threads
+	m_ModelList->GetEntities()->Query(VISIBILITY_COMPONENTS, m_chunks);
+	if (modelCount >= VISIBILITY_PARALLEL_MODELS && JobSystemClass::GetThreadCount() > 1)
+	{
+		JobCounterType counter;
+
+		JobSystemClass::ParallelFor(CullJob, this, 0, (int)m_chunks.size(), 1, &counter);
+		JobSystemClass::Wait(&counter);
+	}
+	else
+	{
+		for (size_t i = 0; i < m_chunks.size(); i++)
+		{
+			CullChunk(*m_Frustum, m_chunks[i]);
+		}
+	}
+
+	// the visible set is built in the order of the models so it does not depend on the chunks
+	m_visibleModels.clear();
+	for (int index = 0; index < modelCount; index++)
+	{
+		if (m_visible[index])
+		{
+			m_visibleModels.push_back(index);
+		}
+	}
+
+	return;
+}
+
+void VisibilityClass::CullMoved()
+{
+	bool visible, changed;
+
+	// test the moved models again, their margins no longer hold
+	changed = false;
+	for (size_t i = 0; i < m_movedModels.size(); i++)
+	{
+		FrustumClass::ResetCache(m_cullCache[m_movedModels[i]]);
+
+		visible = CheckModel(*m_Frustum, m_movedModels[i]);
+		if (visible != (m_visible[m_movedModels[i]] != 0))
+		{
+			m_visible[m_movedModels[i]] = visible;
+			changed = true;
+		}
+	}
+
+	// the visible set only has to be built again if a model came into view or left it
+	if (changed)
+	{
+		m_visibleModels.clear();
+		for (int index = 0; index < (int)m_visible.size(); index++)
+		{
+			if (m_visible[index])
+			{
+				m_visibleModels.push_back(index);
+			}
+		}
+	}
+
+	return;
+}
+
+bool VisibilityClass::CheckModel(FrustumClass& frustum, int index)
+{
+	float positionX, positionY, positionZ, radius;
+	XMFLOAT4 color;
+
+	// a hidden model is never seen
+	if (m_ModelList->GetFlags(index) & ENTITY_FLAG_HIDDEN)
+	{
+		return false;
+	}
+
+	// check if the sphere of the model is in the view frustum, starting from what the last frame found
+	m_ModelList->GetData(index, positionX, positionY, positionZ, radius, color);
+	if (m_coherent)
+	{
+		return frustum.CheckSphere(positionX, positionY, positionZ, radius, m_cullCache[index]);
+	}
+
+	return frustum.CheckSphere(positionX, positionY, positionZ, radius);
+}
+
+void VisibilityClass::CullJob(void* data, int begin, int end)
+{
+	VisibilityClass* visibility;
+	FrustumClass frustum;
+	unsigned long long planeTests;
+
+	// every job tests on its own copy of the frustum so the plane test count is not shared
+	visibility = (VisibilityClass*)data;
+	frustum = *visibility->m_Frustum;
+	planeTests = frustum.GetPlaneTestCount();
+
+	for (int chunk = begin; chunk < end; chunk++)
+	{
+		visibility->CullChunk(frustum, visibility->m_chunks[chunk]);
+	}
+
+	visibility->m_jobPlaneTests += frustum.GetPlaneTestCount() - planeTests;
+
+	return;
+}
+
+void VisibilityClass::CullChunk(FrustumClass& frustum, const EntityChunkType& chunk)
+{
+	PositionComponentType* positions;
+	RadiusComponentType* radii;
+	FlagsComponentType* flags;
+	ModelComponentType* models;
+	int index;
+
+	positions = chunk.Get<PositionComponentType>();
+	radii = chunk.Get<RadiusComponentType>();
+	flags = chunk.Get<FlagsComponentType>();
+	models = chunk.Get<ModelComponentType>();
+
+	// the results are kept by the index of the model, the rows of a chunk are in any order
+	for (int i = 0; i < chunk.count; i++)
+	{
+		index = models[i].index;
+		if (flags[i].flags & ENTITY_FLAG_HIDDEN)
+		{
+			m_visible[index] = false;
+		}
+		else if (m_coherent)
+		{
+			m_visible[index] = frustum.CheckSphere(positions[i].x, positions[i].y, positions[i].z, radii[i].radius, m_cullCache[index]);
+		}
+		else
+		{
+			m_visible[index] = frustum.CheckSphere(positions[i].x, positions[i].y, positions[i].z, radii[i].radius);
+		}
+	}
+
+	return;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "win32platformclass.h"
+
+Win32PlatformClass::Win32PlatformClass()
+	: m_ticksPerMs(0.0), m_timerPeriod(false)
+{
+}
+
+bool Win32PlatformClass::Initialize()
+{
+	LARGE_INTEGER frequency;
+
+	// the clock is the high performance counter
+	if (!QueryPerformanceFrequency(&frequency) || frequency.QuadPart == 0)
+	{
+		return false;
+	}
+	m_ticksPerMs = (double)frequency.QuadPart / 1000.0;
+
+	// sleeps end within about a millisecond instead of a scheduler tick of 15.6
+	m_timerPeriod = timeBeginPeriod(1) == TIMERR_NOERROR;
+
+	return true;
+}
+
+void Win32PlatformClass::Shutdown()
+{
+	if (m_timerPeriod)
+	{
+		timeEndPeriod(1);
+		m_timerPeriod = false;
+	}
+
+	return;
+}
+
+bool Win32PlatformClass::PollEvent(PlatformEventType& event)
+{
+	MSG msg;
+
+	if (!PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+	{
+		return false;
+	}
+
+	// the window procedure still sees every message
+	TranslateMessage(&msg);		// translating like keyboard's virtual key to char
+	DispatchMessage(&msg);		// sends message to our procedure WndProc
+
+	event.time = GetTime();
+	event.x = event.y = 0;
+	event.key = 0;
+	event.down = false;
+
+	switch (msg.message)
+	{
+	case WM_QUIT:
+		event.message = PLATFORM_MESSAGE_QUIT;
+		break;
+	case WM_KEYDOWN:
+	case WM_KEYUP:
+		event.message = PLATFORM_MESSAGE_KEY;
+		event.key = (unsigned int)msg.wParam;
+		event.down = msg.message == WM_KEYDOWN;
+		break;
+	case WM_MOUSEMOVE:
+		event.message = PLATFORM_MESSAGE_MOUSE;
+		event.x = (short)LOWORD(msg.lParam);
+		event.y = (short)HIWORD(msg.lParam);
+		break;
+	default:
+		event.message = PLATFORM_MESSAGE_OTHER;
+		break;
+	}
+
+	return true;
+}
+
+double Win32PlatformClass::GetTime()
+{
+	LARGE_INTEGER ticks;
+
+	QueryPerformanceCounter(&ticks);
+
+	return (double)ticks.QuadPart / m_ticksPerMs;
+}
+
+void Win32PlatformClass::SleepFor(double time)
+{
+	// a sleep of zero gives the rest of the time slice to another thread
+	Sleep(time > 0.0 ? (DWORD)time : 0);
+
+	return;
+}
\ No newline at end of file